@@ -6,11 +6,10 @@
 #include "KawaiiPhysicsBoneConstraintsDataAsset.h"
 #include "KawaiiPhysicsCustomExternalForce.h"
 #include "ExternalForces/KawaiiPhysicsExternalForce.h"
-#if !UE_BUILD_SHIPPING && WITH_EDITORONLY_DATA
 #include "KawaiiPhysicsDeveloperSettings.h"
-#endif
 #include "KawaiiPhysicsLimitsDataAsset.h"
 #include "KawaiiPhysicsSharedCollisionSubsystem.h"
+#include "KawaiiPhysicsSimulationSubsystem.h"
 #include "Animation/AnimInstanceProxy.h"
 #include "Curves/CurveFloat.h"
 #include "Runtime/Launch/Resources/Version.h"
@@ -91,6 +90,76 @@ TAutoConsoleVariable<bool> CVarAnimNodeKawaiiPhysicsUseBoneContainerRefSkeletonW
 	TEXT("a.AnimNode.KawaiiPhysics.UseBoneContainerRefSkeletonWhenInit"), true, TEXT(
 		"flag to revert the behavior of RefSkeleton in InitModifyBones to its previous implementation."));
 
+TAutoConsoleVariable<bool> CVarAnimNodeKawaiiPhysicsSimdIntegration(
+	TEXT("a.AnimNode.KawaiiPhysics.SimdIntegration"), true,
+	TEXT("Verlet積分（速度・減衰・重力・world移動追従・剛性係数）を4ボーン単位のSIMDカーネルで処理する。falseでスカラー経路（ゴールデン値とビット一致） / "
+		"Run the Verlet step (velocity, damping, gravity, world-move follow, stiffness factor) with the 4-bone SIMD kernel. "
+		"false selects the scalar path (bit-identical to the golden values)."));
+
+TAutoConsoleVariable<bool> CVarAnimNodeKawaiiPhysicsSimdNarrowphase(
+	TEXT("a.AnimNode.KawaiiPhysics.SimdNarrowphase"), true,
+	TEXT("Sphere/Capsule/TaperedCapsule/Box コリジョンを4コライダー単位のSIMD判定で絞り込んでから押し出す（結果はスカラー経路とビット一致） / "
+		"Cull sphere, capsule, tapered capsule and box colliders with a 4-collider SIMD test before pushing out "
+		"(results are bit-identical to the scalar path)."));
+
+TAutoConsoleVariable<bool> CVarAnimNodeKawaiiPhysicsColliderCulling(
+	TEXT("a.AnimNode.KawaiiPhysics.ColliderCulling"), true,
+	TEXT("ステップ毎にチェーンの掃引 AABB と重ならないコライダーをコンパイル時に間引き、ボーンループへ持ち込まない / "
+		"Cull colliders that do not overlap the chains' swept AABB when compiling them each step, so they never enter "
+		"the per-bone loop."));
+
+TAutoConsoleVariable<float> CVarAnimNodeKawaiiPhysicsColliderCullingMargin(
+	TEXT("a.AnimNode.KawaiiPhysics.ColliderCullingMargin"), 5.0f,
+	TEXT("コライダーカリング用 AABB に足すマージン（cm）。拘束や押し出しでステップ内に AABB の外へ出る分を見込む / "
+		"Margin (cm) added to the collider culling AABB, covering how far constraints and push-outs can move bones "
+		"outside it within a step."));
+
+TAutoConsoleVariable<int32> CVarAnimNodeKawaiiPhysicsColliderGridMinColliders(
+	TEXT("a.AnimNode.KawaiiPhysics.ColliderGridMinColliders"), 0,
+	TEXT("Plane 以外のコライダーがこの数以上のバッファは一様グリッドで候補を絞る（結果は総当たりとビット一致。0以下で無効）。"
+		"損益分岐点の実測値がまだ無いため既定では無効。KawaiiPhysics.Perf.ColliderGridCrossover が出す "
+		"break_even_colliders を対象環境で測って設定すること / "
+		"Buffers with at least this many non-plane colliders look up candidates in a uniform grid (bit-identical to "
+		"brute force; 0 or less disables it). Disabled by default because no break-even point has been measured yet; "
+		"set it to the break_even_colliders reported by KawaiiPhysics.Perf.ColliderGridCrossover on the target "
+		"hardware."));
+
+TAutoConsoleVariable<bool> CVarAnimNodeKawaiiPhysicsBatchedSimulation(
+	TEXT("a.AnimNode.KawaiiPhysics.BatchedSimulation"), false,
+	TEXT("wind / 外力 / world collision を使わないノードのソルバを、ワールドの全 Actor Tick 後に ParallelFor でまとめて実行する（出力は1フレーム遅れ） / "
+		"Run the solves of nodes without wind, external forces or world collision as one ParallelFor batch after all "
+		"actors of the world have ticked (output lags by one frame)."));
+
+TAutoConsoleVariable<bool> CVarAnimNodeKawaiiPhysicsPipelinedSimulation(
+	TEXT("a.AnimNode.KawaiiPhysics.PipelinedSimulation"), false,
+	TEXT("wind / 外力 / world collision を使わないノードのソルバを評価後にバックグラウンドタスクで実行し、評価は前フレームの結果を出力する"
+		"（出力は1フレーム遅れ。BatchedSimulation より優先） / "
+		"Run the solves of nodes without wind, external forces or world collision as background tasks after evaluation; "
+		"the evaluation outputs the previous frame's result (one frame of latency; takes precedence over BatchedSimulation)."));
+
+TAutoConsoleVariable<bool> CVarAnimNodeKawaiiPhysicsParallelIslands(
+	TEXT("a.AnimNode.KawaiiPhysics.ParallelIslands"), true,
+	TEXT("BoneConstraint 等で繋がっていない root チェーン（アイランド）を ParallelFor で並列にソルブする（結果は逐次と同一） / "
+		"Solve root chains that no BoneConstraint or dummy joins (islands) in parallel with ParallelFor "
+		"(results are identical to the sequential solve)."));
+
+TAutoConsoleVariable<int32> CVarAnimNodeKawaiiPhysicsParallelIslandMinBones(
+	TEXT("a.AnimNode.KawaiiPhysics.ParallelIslandMinBones"), 16,
+	TEXT("並列タスク1つあたりの最小ボーン数。これ未満のアイランドは隣と1タスクにまとめる / "
+		"Minimum bones per parallel task; smaller islands are packed together with their neighbours."));
+
+TAutoConsoleVariable<bool> CVarAnimNodeKawaiiPhysicsColoredBoneConstraints(
+	TEXT("a.AnimNode.KawaiiPhysics.ColoredBoneConstraints"), true,
+	TEXT("BoneConstraint を色（ボーンを共有しない組）ごとに4本ずつ SIMD で解く。falseで元の並び順の逐次スカラー経路"
+		"（解く順序が違うので結果はビット一致しない） / "
+		"Solve the BoneConstraints colour by colour (groups that share no bone), four at a time with SIMD. "
+		"false selects the sequential scalar path in authoring order (a different solve order, so not bit-identical)."));
+
+TAutoConsoleVariable<int32> CVarAnimNodeKawaiiPhysicsBoneConstraintParallelMinColorSize(
+	TEXT("a.AnimNode.KawaiiPhysics.BoneConstraintParallelMinColorSize"), 1024,
+	TEXT("1色の Constraint 数がこれ以上なら、その色のバッチを ParallelFor で分ける（0以下で無効） / "
+		"Colours with at least this many constraints split their batches across ParallelFor (0 or less disables it)."));
+
 // SharedCollision CVars
 TAutoConsoleVariable<int32> CVarSharedCollisionReadMaxAge(
 	TEXT("a.AnimNode.KawaiiPhysics.SharedCollision.ReadMaxAge"), 10,
@@ -142,6 +211,11 @@ DEFINE_STAT(STAT_KawaiiPhysics_NumBridgeDummyBones);
 DEFINE_STAT(STAT_KawaiiPhysics_InsertInterBoneDummyBones);
 DEFINE_STAT(STAT_KawaiiPhysics_BridgeDummy);
 DEFINE_STAT(STAT_KawaiiPhysics_AdjustByLimitsAndLength);
+DEFINE_STAT(STAT_KawaiiPhysics_SolverStateSync);
+DEFINE_STAT(STAT_KawaiiPhysics_ParallelIslands);
+DEFINE_STAT(STAT_KawaiiPhysics_WaitPipelinedSimulation);
+DEFINE_STAT(STAT_KawaiiPhysics_NumBoneIslands);
+DEFINE_STAT(STAT_KawaiiPhysics_CompileColliders);
 DEFINE_STAT(STAT_KawaiiPhysics_NumSphereColliders);
 DEFINE_STAT(STAT_KawaiiPhysics_NumCapsuleColliders);
 DEFINE_STAT(STAT_KawaiiPhysics_NumTaperedCapsuleColliders);
@@ -150,16 +224,35 @@ DEFINE_STAT(STAT_KawaiiPhysics_NumPlanarColliders);
 DEFINE_STAT(STAT_KawaiiPhysics_NumSharedColliders);
 DEFINE_STAT(STAT_KawaiiPhysics_NumMergedBoneConstraints);
 DEFINE_STAT(STAT_KawaiiPhysics_NumWorldCollisionChecks);
+DEFINE_STAT(STAT_KawaiiPhysics_NumWorldCollisionShapes);
+DEFINE_STAT(STAT_KawaiiPhysics_NumColliderPairsBeforeCulling);
+DEFINE_STAT(STAT_KawaiiPhysics_NumColliderPairsAfterCulling);
+DEFINE_STAT(STAT_KawaiiPhysics_NumColliderPairsMasked);
+DEFINE_STAT(STAT_KawaiiPhysics_BoneSegmentCollision);
+DEFINE_STAT(STAT_KawaiiPhysics_BoneConstraintEdgeCollision);
+DEFINE_STAT(STAT_KawaiiPhysics_NumSleepingNodes);
+DEFINE_STAT(STAT_KawaiiPhysics_NumAwakeNodes);
 DEFINE_STAT(STAT_KawaiiPhysics_ModifyBonesMemory);
 
 FAnimNode_KawaiiPhysics::FAnimNode_KawaiiPhysics()
 {
 }
 
+FAnimNode_KawaiiPhysics::~FAnimNode_KawaiiPhysics()
+{
+	// タスクはノードを直接触るので、破棄前に必ず終わらせる
+	WaitPipelinedSimulation();
+}
+
 void FAnimNode_KawaiiPhysics::Initialize_AnyThread(const FAnimationInitializeContext& Context)
 {
 	FAnimNode_SkeletalControlBase::Initialize_AnyThread(Context);
 	const FBoneContainer& RequiredBones = Context.AnimInstanceProxy->GetRequiredBones();
+	BudgetNodeId = Context.GetCurrentNodeId();
+
+	// 保留中のソルバは初期化で状態を変える前に済ませる
+	CompletePipelinedSimulation();
+	RunBatchedSimulation();
 
 	SphericalLimitsData.Empty();
 	CapsuleLimitsData.Empty();
@@ -196,13 +289,32 @@ void FAnimNode_KawaiiPhysics::Initialize_AnyThread(const FAnimationInitializeCon
 	ApplyBoneConstraintDataAsset(RequiredBones);
 
 	ModifyBones.Empty();
+	bColliderRelevanceMasksDirty = true;
 
 	// 最初のフレームでのゼロ除算を回避するため
 	DeltaTimeOld = 1.0f / static_cast<float>(GetEffectiveTargetFramerate());
 
 	// サブステップ状態をリセット
-	SubstepAccumulator = 0.0f;
+	SubstepAccumulator = GetSubstepPhaseOffset();
 	bSubstepPoseInitialized = false;
+	bOutputInterpolationValid = false;
+	OutputInterpolationFromOffsets.Reset();
+	OutputInterpolationToOffsets.Reset();
+
+	// 予算の割り当ては次の Subsystem の割り当てまで毎フレーム更新に戻す
+	SimulationBudgetTier = EKawaiiPhysicsBudgetTier::Full;
+	LastSimulationBudgetTier = EKawaiiPhysicsBudgetTier::Full;
+	BudgetSkippedFrames = 0;
+	BudgetSkippedDeltaTime = 0.0f;
+
+	// 再初期化したら起きた状態から静止判定をやり直す
+	WakeFromSleep();
+	IslandKineticEnergy.Reset();
+
+	// LOD 段階は次の Evaluate で選び直す（再初期化直後はブレンドしない）
+	ActiveLODTier = INDEX_NONE;
+	LODTierBlendAlpha = 1.0f;
+	LODTierBlendFromOffsets.Reset();
 
 	// ノード再初期化時は実行時専用の一時外力と物理設定オーバーライドを破棄する
 	TransientForceStore.Items.Reset();
@@ -250,6 +362,9 @@ void FAnimNode_KawaiiPhysics::CacheBones_AnyThread(const FAnimationCacheBonesCon
 
 void FAnimNode_KawaiiPhysics::ResetDynamics(ETeleportType InTeleportType)
 {
+	// タスクも bOutputInterpolationValid を書くので、先に合流させる
+	CompletePipelinedSimulation();
+
 	TeleportType = InTeleportType;
 	if (bUseWarmUpWhenResetDynamics)
 	{
@@ -257,8 +372,9 @@ void FAnimNode_KawaiiPhysics::ResetDynamics(ETeleportType InTeleportType)
 	}
 
 	// サブステップ：未消費時間を破棄し、ポーズ補間の前フレーム値を次フレームで再初期化させる
-	SubstepAccumulator = 0.0f;
+	SubstepAccumulator = GetSubstepPhaseOffset();
 	bSubstepPoseInitialized = false;
+	bOutputInterpolationValid = false;
 }
 
 int64 FAnimNode_KawaiiPhysics::GenerateTransientForceHandleId()
@@ -387,10 +503,21 @@ void FAnimNode_KawaiiPhysics::RequestStopPhysicsSettingsOverride(const int64 Han
 	TransientForceStore.Queue->PendingSettingsOverrideStops.Emplace(Request);
 }
 
+void FAnimNode_KawaiiPhysics::PreUpdate(const UAnimInstance* InAnimInstance)
+{
+	FAnimNode_SkeletalControlBase::PreUpdate(InAnimInstance);
+
+	// 前フレームのタスクはノードの入力（ModifyBones / DeltaTime など）を読み書きするので、ピンの評価と setter が
+	// それらを書き換える前（Update の前の GameThread）に完了させて結果を取り込む
+	CompletePipelinedSimulation();
+}
+
 void FAnimNode_KawaiiPhysics::UpdateInternal(const FAnimationUpdateContext& Context)
 {
 	FAnimNode_SkeletalControlBase::UpdateInternal(Context);
 
+	// 通常は PreUpdate で取り込み済み。PreUpdate を通らずに Update された場合の保険として、DeltaTime を書き換える前に終わらせる
+	CompletePipelinedSimulation();
 	DeltaTime = Context.GetDeltaTime();
 }
 
@@ -413,6 +540,7 @@ bool FAnimNode_KawaiiPhysics::ShouldReinitModifyBones() const
 	// 配置トポロジ（生成されるダミー数）を左右する設定の変更
 	if (LastInitializedBoneSubdivisionCount != BoneSubdivisionCount ||
 		LastInitializedBoneConstraintSubdivisionCount != BoneConstraintSubdivisionCount ||
+		LastInitializedBoneConstraintEdgeCollision != bBoneConstraintEdgeCollision ||
 		LastInitializedBoneSubdivisionDensifyByRadius != bBoneSubdivisionDensifyByRadius)
 	{
 		return true;
@@ -440,6 +568,10 @@ void FAnimNode_KawaiiPhysics::EvaluateSkeletalControl_AnyThread(FComponentSpaceP
 
 	check(OutBoneTransforms.Num() == 0);
 
+	// 前回登録したソルバがまだ走っていなければ（同フレームの再評価など）、状態を変える前にここで済ませる
+	CompletePipelinedSimulation();
+	RunBatchedSimulation();
+
 	// ランタイム変更（BP setter等でのreinit要求）時の遅延リセット。ポーズに依存せず、無効ルートボーン等での
 	// 早期returnより前に必ず実行する（無効化/タグクリア時に旧Source Slotと古いマージ配列を確実に始末するため）。
 	if (bSharedCollisionNeedsReinit)
@@ -519,6 +651,7 @@ void FAnimNode_KawaiiPhysics::EvaluateSkeletalControl_AnyThread(FComponentSpaceP
 		// 再構築で新規ボーンのPrevPoseLocationが0に戻りsubstep補間が原点へ引かれチラつくため、
 		// flagを戻し次フレーム冒頭で現在ポーズから再開させる
 		bSubstepPoseInitialized = false;
+		bOutputInterpolationValid = false;
 
 		// 再初期化（設定変更）時はノード警告を再通知できるようガードを戻す
 		KAWAII_RESET_NODE_WARNING_ONCE(bSimBaseBoneInvalidWarned);
@@ -531,6 +664,8 @@ void FAnimNode_KawaiiPhysics::EvaluateSkeletalControl_AnyThread(FComponentSpaceP
 	ApplyPhysicsAsset(BoneContainer);
 	ApplyMirrorLimits(BoneContainer);
 	ApplyBoneConstraintDataAsset(BoneContainer);
+	// DataAsset 由来の limit を作り直したのでマスクも作り直す（ライブ編集の BoneFilter もここで反映）
+	bColliderRelevanceMasksDirty = true;
 
 	// ライブ編集用（コンパイル前に同期）
 	if (GUnrealEd && !GUnrealEd->IsPlayingSessionInEditor())
@@ -557,8 +692,14 @@ void FAnimNode_KawaiiPhysics::EvaluateSkeletalControl_AnyThread(FComponentSpaceP
 		InitModifyBones(Output, BoneContainer);
 		InitSyncBones(Output);
 		InitBoneConstraints();
+		// bridge dummy の追加（InitBoneConstraints）まで済んでからボーン分類を確定する
+		BuildBoneCategories();
+		BuildBoneIslands();
+		OutputSlots.Build(ModifyBones, BoneLayoutGeneration);
+		bColliderRelevanceMasksDirty = true;
 		LastInitializedBoneSubdivisionCount = BoneSubdivisionCount;
 		LastInitializedBoneConstraintSubdivisionCount = BoneConstraintSubdivisionCount;
+		LastInitializedBoneConstraintEdgeCollision = bBoneConstraintEdgeCollision;
 		LastInitializedBoneSubdivisionDensifyByRadius = bBoneSubdivisionDensifyByRadius;
 		LastInitializedRadius = PhysicsSettings.Radius;
 		LastInitializedDummyBoneLength = DummyBoneLength;
@@ -603,7 +744,7 @@ void FAnimNode_KawaiiPhysics::EvaluateSkeletalControl_AnyThread(FComponentSpaceP
 		if (BridgeDummyWarningThreshold > 0 && BridgeDummyCount > BridgeDummyWarningThreshold)
 		{
 			KAWAII_LOG_NODE_WARNING(LogAnimation,
-				TEXT("KawaiiPhysics: %d bridge collision-proxy dummy bones and %d merged bone constraints generated (warning threshold: %d). This may impact performance. Consider reducing BoneConstraintSubdivisionCount or raising BridgeDummyWarningThreshold in Kawaii Physics project settings."),
+				TEXT("KawaiiPhysics: %d bridge collision-proxy dummy bones and %d merged bone constraints generated (warning threshold: %d). This may impact performance. Consider reducing BoneConstraintSubdivisionCount, enabling bBoneConstraintEdgeCollision or raising BridgeDummyWarningThreshold in Kawaii Physics project settings."),
 				BridgeDummyCount, MergedBoneConstraints.Num(), BridgeDummyWarningThreshold);
 		}
 #endif
@@ -611,6 +752,12 @@ void FAnimNode_KawaiiPhysics::EvaluateSkeletalControl_AnyThread(FComponentSpaceP
 
 	}
 
+	// コライダーの関連マスクは limit とボーン構成の両方に依存するので、どちらかを作り直した後に作る
+	if (bColliderRelevanceMasksDirty)
+	{
+		BuildColliderRelevanceMasks(BoneContainer.GetReferenceSkeleton());
+	}
+
 	// 倍率オーバーライドは UpdatePhysicsSettingsOfModifyBones より前に取り込み、このフレームの倍率を確定させる
 	const bool bHasActiveSettingsOverride = ConsumeAndAdvancePhysicsSettingsOverrides(DeltaTime);
 
@@ -701,7 +848,13 @@ void FAnimNode_KawaiiPhysics::EvaluateSkeletalControl_AnyThread(FComponentSpaceP
 	               SharedBoxLimits.Num() + SharedPlanarLimits.Num());
 	SET_DWORD_STAT(STAT_KawaiiPhysics_NumMergedBoneConstraints, MergedBoneConstraints.Num());
 	SET_MEMORY_STAT(STAT_KawaiiPhysics_ModifyBonesMemory,
-	                ModifyBones.GetAllocatedSize() + MergedBoneConstraints.GetAllocatedSize());
+	                ModifyBones.GetAllocatedSize() + MergedBoneConstraints.GetAllocatedSize() +
+	                SolverState.GetAllocatedSize() + CompiledColliders.GetAllocatedSize() +
+	                CompiledSharedColliders.GetAllocatedSize() + BoneCategories.GetAllocatedSize() +
+	                BoneTopology.GetAllocatedSize() + OutputSlots.GetAllocatedSize() +
+	                BoneIslands.GetAllocatedSize() + BoneConstraintColors.GetAllocatedSize() +
+	                AsyncWorldContactPlanesWS.GetAllocatedSize() + AsyncWorldContactPlanes.GetAllocatedSize() +
+	                CompiledWorldColliders.GetAllocatedSize());
 
 	UpdateModifyBonesPoseTransform(Output, BoneContainer);
 	ApplySyncBones(Output, BoneContainer);
@@ -717,6 +870,29 @@ void FAnimNode_KawaiiPhysics::EvaluateSkeletalControl_AnyThread(FComponentSpaceP
 	{
 		WarmUp(Output, BoneContainer, ComponentTransform);
 		bNeedWarmUp = false;
+		// 空回しのステップ同士を補間しない / Do not interpolate between warm-up steps
+		bOutputInterpolationValid = false;
+	}
+
+	// LOD 段階を選ぶ。画面サイズとカメラ距離は Subsystem が全 Actor Tick 後に書き込んだ前フレームの値
+	if (!LODTiers.IsEmpty())
+	{
+		if (UKawaiiPhysicsSimulationSubsystem* Subsystem = CachedSimulationSubsystem.Get())
+		{
+			Subsystem->RequestLODViewMetrics(this, CachedSimulationOwner);
+		}
+	}
+	UpdateLODTier();
+
+	// 次フレームの更新頻度の割り当てに参加する（Frozen 中も登録し、予算が空けば復帰できるようにする）。
+	// 見積もりは Reduced で繰り越した時間を足す前の、このフレームの dt で行う
+	if (GetDefault<UKawaiiPhysicsDeveloperSettings>()->bUseSimulationBudget)
+	{
+		if (UKawaiiPhysicsSimulationSubsystem* Subsystem = CachedSimulationSubsystem.Get())
+		{
+			Subsystem->ReportSimulationCost(this, CachedSimulationOwner, EstimateSimulationCostMs(), Significance,
+			                                BudgetComponentId, BudgetNodeId);
+		}
 	}
 
 	// WorldSpaceでテレポートした場合はシミュレートをスキップする
@@ -732,11 +908,22 @@ void FAnimNode_KawaiiPhysics::EvaluateSkeletalControl_AnyThread(FComponentSpaceP
 		}
 
 		// テレポート時はサブステップの未消費時間を破棄し、ポーズ補間を次フレームで再初期化
-		SubstepAccumulator = 0.0f;
+		SubstepAccumulator = GetSubstepPhaseOffset();
 		bSubstepPoseInitialized = false;
+		bOutputInterpolationValid = false;
 		PreSkelCompTransformConsumeFraction = 1.0f;
+		WakeFromSleep();
 	}
-	else
+	else if (!ShouldSimulateUnderBudget())
+	{
+		HoldSimulationForBudget(Output, ComponentTransform);
+	}
+	else if (UpdateSleepState(bHasActiveSettingsOverride))
+	{
+		// 静止中はシミュレーションとコリジョンを省き、前回の結果をそのまま出力する
+		PreSkelCompTransformConsumeFraction = 1.0f;
+	}
+	else if (!TryPreparePipelinedSimulation(Output) && !TryEnqueueBatchedSimulation(Output))
 	{
 		SimulateModifyBones(Output, ComponentTransform);
 	}
@@ -747,7 +934,27 @@ void FAnimNode_KawaiiPhysics::EvaluateSkeletalControl_AnyThread(FComponentSpaceP
 		WriteSharedCollisionToSubsystem(Output, ComponentTransform);
 	}
 
+	// 固定サブステップの合間は直前2ステップの補間結果を、LOD 段階の切り替え直後は切り替え前の揺れからなじませた結果を出力する
+	const bool bOutputInterpolating = BeginOutputInterpolation();
+	const bool bLODTierBlending = BeginLODTierBlend();
 	ApplySimulateResult(Output, BoneContainer, OutBoneTransforms);
+	if (bLODTierBlending)
+	{
+		EndLODTierBlend();
+	}
+	if (bOutputInterpolating)
+	{
+		EndOutputInterpolation();
+	}
+
+	if (bSleeping)
+	{
+		INC_DWORD_STAT(STAT_KawaiiPhysics_NumSleepingNodes);
+	}
+	else
+	{
+		INC_DWORD_STAT(STAT_KawaiiPhysics_NumAwakeNodes);
+	}
 
 	TeleportType = ETeleportType::None;
 	// サブステップで未消費の実時間がある場合、PreSkelCompTransform を消費割合だけ前進させ、
@@ -776,6 +983,9 @@ void FAnimNode_KawaiiPhysics::EvaluateSkeletalControl_AnyThread(FComponentSpaceP
 #if WITH_EDITORONLY_DATA
 	LastEvaluatedTime = FPlatformTime::Seconds();
 #endif
+
+	// 出力を書き終えてからソルバを起動し、このフレームの結果は次の評価で出力する
+	LaunchPipelinedSimulation();
 }
 
 bool FAnimNode_KawaiiPhysics::IsValidToEvaluate(const USkeleton* Skeleton, const FBoneContainer& RequiredBones)
@@ -814,10 +1024,13 @@ void FAnimNode_KawaiiPhysics::OnInitializeAnimInstance(const FAnimInstanceProxy*
 		if (const UWorld* World = InAnimInstance->GetWorld())
 		{
 			CachedSharedCollisionSubsystem = World->GetSubsystem<UKawaiiPhysicsSharedCollisionSubsystem>();
+			CachedSimulationSubsystem = World->GetSubsystem<UKawaiiPhysicsSimulationSubsystem>();
 		}
+		CachedSimulationOwner = InAnimInstance;
 		if (const USkeletalMeshComponent* SkelComp = InAnimInstance->GetSkelMeshComponent())
 		{
 			CachedSharedCollisionOwnerActor = SkelComp->GetOwner();
+			BudgetComponentId = SkelComp->GetUniqueID();
 		}
 	}
 
@@ -2,6 +2,7 @@
 
 #include "AnimNode_KawaiiPhysics.h"
 
+#include "Algo/BinarySearch.h"
 #include "Animation/MirrorDataTable.h"
 #include "AnimationRuntime.h"
 #include "KawaiiPhysicsMirrorUtils.h"
@@ -10,12 +11,15 @@
 #include "ExternalForces/KawaiiPhysicsExternalForce.h"
 #include "KawaiiPhysicsLimitsDataAsset.h"
 #include "KawaiiPhysicsSharedCollisionSubsystem.h"
+#include "KawaiiPhysicsSimulationSubsystem.h"
 #include "Animation/AnimInstanceProxy.h"
 #include "Curves/CurveFloat.h"
 #include "Runtime/Launch/Resources/Version.h"
 #include "SceneInterface.h"
 #include "PhysicsEngine/PhysicsAsset.h"
 #include "PhysicsEngine/TaperedCapsuleElem.h"
+#include "PhysicsEngine/BodySetup.h"
+#include "Components/PrimitiveComponent.h"
 #include "Engine/World.h"
 #include "PhysicsEngine/PhysicsSettings.h"
 #include "Templates/RemoveReference.h"
@@ -36,6 +40,7 @@
 #include "KawaiiPhysics.h"
 #include "AnimNode_KawaiiPhysicsInternal.h"
 #include "KawaiiPhysicsNodeWarning.h"
+#include "KawaiiPhysicsCollisionKernels.h"
 
 void FAnimNode_KawaiiPhysics::ApplyLimitsDataAsset(const FBoneContainer& RequiredBones)
 {
@@ -98,6 +103,7 @@ void FAnimNode_KawaiiPhysics::ApplyPhysicsAsset(const FBoneContainer& RequiredBo
 	RemoveAllSourcePhysicsAssets(TaperedCapsuleLimitsData);
 	RemoveAllSourcePhysicsAssets(BoxLimitsData);
 
+	// PhysicsAsset のボディは BoneFilter を持たないので、生成した limit は全ボーンと判定する（絞るのは bAutoColliderRelevance だけ）
 	if (PhysicsAssetForLimits)
 	{
 		for (const auto& BodySetup : PhysicsAssetForLimits->SkeletalBodySetups)
@@ -495,216 +501,1285 @@ void FAnimNode_KawaiiPhysics::AdjustByWorldCollision(FComponentSpacePoseContext&
 
 	/** トレースはゲームスレッド上で実行されないため、TraceTag はデバッグトレースを描画しない */
 	FCollisionQueryParams Params(SCENE_QUERY_STAT(KawaiiCollision));
+	ECollisionChannel TraceChannel;
+	FCollisionResponseParams ResponseParams;
+	MakeWorldCollisionQuery(OwningComp, TraceChannel, Params, ResponseParams);
+	const UWorld* World = OwningComp->GetWorld();
+
+	const FVector TraceStartLocationWS =
+		ConvertSimulationSpaceLocation(Output, SimulationSpace, EKawaiiPhysicsSimulationSpace::WorldSpace,
+		                               Bone.PrevLocation);
+	const FVector TraceEndLocationWS =
+		ConvertSimulationSpaceLocation(Output, SimulationSpace, EKawaiiPhysicsSimulationSpace::WorldSpace,
+		                               Bone.Location);
+
+	if (bIgnoreSelfComponent)
+	{
+		// sphere sweep
+		FHitResult Result;
+		bool bHit = World->SweepSingleByChannel(
+			Result, TraceStartLocationWS, TraceEndLocationWS, FQuat::Identity,
+			TraceChannel, FCollisionShape::MakeSphere(Bone.PhysicsSettings.Radius), Params, ResponseParams);
+		if (bHit)
+		{
+			if (Result.bStartPenetrating)
+			{
+				Bone.Location =
+					ConvertSimulationSpaceLocation(Output, EKawaiiPhysicsSimulationSpace::WorldSpace, SimulationSpace,
+					                               TraceEndLocationWS + Result.Normal * Result.PenetrationDepth);
+			}
+			else
+			{
+				Bone.Location =
+					ConvertSimulationSpaceLocation(Output, EKawaiiPhysicsSimulationSpace::WorldSpace, SimulationSpace,
+					                               Result.Location);
+			}
+		}
+	}
+	else
+	{
+		// sphere sweep（ヒット後に対象ボーンを除外）
+		WorldCollisionHitsScratch.Reset();
+		bool bHit = World->SweepMultiByChannel(WorldCollisionHitsScratch, TraceStartLocationWS,
+		                                       TraceEndLocationWS, FQuat::Identity, TraceChannel,
+		                                       FCollisionShape::MakeSphere(Bone.PhysicsSettings.Radius), Params,
+		                                       ResponseParams);
+		if (!bHit)
+		{
+			return;
+		}
+
+		for (const auto& Result : WorldCollisionHitsScratch)
+		{
+			if (!Result.bBlockingHit)
+			{
+				continue;
+			}
+
+			// 無視対象でないブロッキングヒットを採用
+			if (!IsIgnoredWorldCollisionHit(Result, Bone, OwningComp))
+			{
+				if (Result.bStartPenetrating)
+				{
+					Bone.Location =
+						ConvertSimulationSpaceLocation(Output, EKawaiiPhysicsSimulationSpace::WorldSpace,
+						                               SimulationSpace,
+						                               TraceEndLocationWS + Result.Normal * Result.PenetrationDepth);
+				}
+				else
+				{
+					Bone.Location =
+						ConvertSimulationSpaceLocation(Output, EKawaiiPhysicsSimulationSpace::WorldSpace,
+						                               SimulationSpace,
+						                               Result.Location);
+				}
+				break;
+			}
+		}
+	}
+}
+
+void FAnimNode_KawaiiPhysics::MakeWorldCollisionQuery(const USkeletalMeshComponent* OwningComp,
+                                                      ECollisionChannel& OutTraceChannel,
+                                                      FCollisionQueryParams& OutQueryParams,
+                                                      FCollisionResponseParams& OutResponseParams) const
+{
+	if (bIgnoreSelfComponent)
+	{
+		OutQueryParams.AddIgnoredComponent(OwningComp);
+	}
+
+	// コンポーネントからコリジョン設定を取得
+	OutTraceChannel = bOverrideCollisionParams
+		                  ? CollisionChannelSettings.GetObjectType()
+		                  : OwningComp->GetCollisionObjectType();
+	OutResponseParams = bOverrideCollisionParams
+		                    ? FCollisionResponseParams(CollisionChannelSettings.GetResponseToChannels())
+		                    : FCollisionResponseParams(OwningComp->GetCollisionResponseToChannels());
+}
+
+bool FAnimNode_KawaiiPhysics::IsIgnoredWorldCollisionHit(const FHitResult& Result,
+                                                         const FKawaiiPhysicsModifyBone& Bone,
+                                                         const USkeletalMeshComponent* OwningComp)
+{
+	if (Result.Component != OwningComp || Result.BoneName == NAME_None)
+	{
+		return false;
+	}
+
+	return Result.BoneName == Bone.BoneRef.BoneName || IsIgnoredWorldCollisionBone(Result.BoneName);
+}
+
+bool FAnimNode_KawaiiPhysics::IsIgnoredWorldCollisionBone(const FName BoneName)
+{
+	for (const auto& BoneRef : IgnoreBones)
+	{
+		if (BoneRef.BoneName == BoneName)
+		{
+			return true;
+		}
+	}
+
+	if (IgnoreBoneNamePrefixCache != IgnoreBoneNamePrefix)
+	{
+		IgnoreBoneNamePrefixCache = IgnoreBoneNamePrefix;
+		IgnoreBoneNamePrefixStrings.Reset(IgnoreBoneNamePrefix.Num());
+		for (const FName& BoneNamePrefix : IgnoreBoneNamePrefix)
+		{
+			if (!BoneNamePrefix.IsNone())
+			{
+				IgnoreBoneNamePrefixStrings.Add(BoneNamePrefix.ToString());
+			}
+		}
+	}
+
+	// プレフィックス未設定（一般的なケース）ではToString自体を回避
+	if (!IgnoreBoneNamePrefixStrings.IsEmpty())
+	{
+		const FString ResultBoneNameString = BoneName.ToString();
+		for (const FString& BoneNamePrefix : IgnoreBoneNamePrefixStrings)
+		{
+			if (ResultBoneNameString.StartsWith(BoneNamePrefix))
+			{
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+void FAnimNode_KawaiiPhysics::UpdateAsyncWorldCollision(FComponentSpacePoseContext& Output,
+                                                        const USkeletalMeshComponent* OwningComp)
+{
+	SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_WorldCollision);
+
+	const int32 NumBones = ModifyBones.Num();
+	if (AsyncWorldContactPlanesWS.Num() != NumBones)
+	{
+		// ボーン構成が変わったら古いバッチの index は使えないので、接触なしから始める
+		AsyncWorldContactPlanesWS.Reset();
+		AsyncWorldContactPlanesWS.SetNumZeroed(NumBones);
+	}
+	else if (AsyncWorldCollision.IsValid() && AsyncWorldCollision->ConsumeResults(AsyncWorldResultsScratch))
+	{
+		// 揃ったバッチで接触平面を置き換える。平面は同期経路の押し出し先（球の中心）を通り、中心がその裏へ入らないようにする
+		FMemory::Memzero(AsyncWorldContactPlanesWS.GetData(), AsyncWorldContactPlanesWS.Num() * sizeof(FPlane));
+		for (const FKawaiiPhysicsAsyncWorldCollision::FSweepResult& Result : AsyncWorldResultsScratch)
+		{
+			if (!ModifyBones.IsValidIndex(Result.BoneIndex))
+			{
+				continue;
+			}
+
+			const FKawaiiPhysicsModifyBone& Bone = ModifyBones[Result.BoneIndex];
+			for (const FHitResult& Hit : Result.Hits)
+			{
+				if (!Hit.bBlockingHit || IsIgnoredWorldCollisionHit(Hit, Bone, OwningComp))
+				{
+					continue;
+				}
+
+				const FVector ContactLocation = Hit.bStartPenetrating
+					                                ? Hit.TraceStart + Hit.Normal * Hit.PenetrationDepth
+					                                : Hit.Location;
+				AsyncWorldContactPlanesWS[Result.BoneIndex] = FPlane(ContactLocation, Hit.Normal);
+				break;
+			}
+		}
+	}
+
+	// 平面はワールドに固定なので、コンポーネントの移動に合わせて評価毎にシミュレーション空間へ変換する
+	AsyncWorldContactPlanes.SetNumUninitialized(NumBones);
+	for (int32 i = 0; i < NumBones; ++i)
+	{
+		const FPlane& PlaneWS = AsyncWorldContactPlanesWS[i];
+		const FVector NormalWS(PlaneWS.X, PlaneWS.Y, PlaneWS.Z);
+		if (NormalWS.IsZero())
+		{
+			AsyncWorldContactPlanes[i] = FPlane(0.0, 0.0, 0.0, 0.0);
+			continue;
+		}
+
+		const FVector Origin = ConvertSimulationSpaceLocation(Output, EKawaiiPhysicsSimulationSpace::WorldSpace,
+		                                                      SimulationSpace, NormalWS * PlaneWS.W);
+		const FVector Normal = ConvertSimulationSpaceVector(Output, EKawaiiPhysicsSimulationSpace::WorldSpace,
+		                                                    SimulationSpace, NormalWS).GetSafeNormal();
+		AsyncWorldContactPlanes[i] = FPlane(Origin, Normal);
+	}
+
+	// このフレームのスイープはステップ前の位置から引く
+	AsyncWorldSweepStartScratch = SolverState.Location;
+}
+
+void FAnimNode_KawaiiPhysics::StageAsyncWorldCollision(FComponentSpacePoseContext& Output,
+                                                       const USkeletalMeshComponent* OwningComp)
+{
+	SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_WorldCollision);
+
+	UKawaiiPhysicsSimulationSubsystem* Subsystem = CachedSimulationSubsystem.Get();
+	if (!OwningComp || !Subsystem)
+	{
+		return;
+	}
+	if (!AsyncWorldCollision.IsValid())
+	{
+		AsyncWorldCollision = MakeShared<FKawaiiPhysicsAsyncWorldCollision, ESPMode::ThreadSafe>();
+	}
+
+	// 同期経路と同じく simulate 対象ボーン + bridge dummy。始点はステップ前の位置、終点は次の評価で進む先まで
+	// （このフレームの移動量をもう1回分延長）を覆う
+	AsyncWorldSweepsScratch.Reset();
+	auto AddSweep = [this, &Output](const int32 i)
+	{
+		const float Radius = SolverState.Radius[i];
+		if (Radius <= KINDA_SMALL_NUMBER)
+		{
+			return;
+		}
+
+		const FVector& End = SolverState.Location[i];
+		const FVector& Start = AsyncWorldSweepStartScratch.IsValidIndex(i) ? AsyncWorldSweepStartScratch[i] : End;
+		FKawaiiPhysicsAsyncWorldCollision::FSweep& Sweep = AsyncWorldSweepsScratch.AddDefaulted_GetRef();
+		Sweep.BoneIndex = i;
+		Sweep.Start = ConvertSimulationSpaceLocation(Output, SimulationSpace, EKawaiiPhysicsSimulationSpace::WorldSpace,
+		                                             Start);
+		Sweep.End = ConvertSimulationSpaceLocation(Output, SimulationSpace, EKawaiiPhysicsSimulationSpace::WorldSpace,
+		                                           End + (End - Start));
+		Sweep.Radius = Radius;
+	};
+	for (const int32 i : BoneCategories.Simulated)
+	{
+		AddSweep(i);
+	}
+	for (const int32 i : BoneCategories.BridgeDummies)
+	{
+		if (!SolverState.HasFlag(i, FKawaiiPhysicsSolverState::EFlags::Flag_SkipSimulate))
+		{
+			AddSweep(i);
+		}
+	}
+
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(KawaiiCollision));
+	ECollisionChannel TraceChannel;
+	FCollisionResponseParams ResponseParams;
+	MakeWorldCollisionQuery(OwningComp, TraceChannel, Params, ResponseParams);
+	AsyncWorldCollision->StageSweeps(AsyncWorldSweepsScratch, TraceChannel, Params, ResponseParams,
+	                                 !bIgnoreSelfComponent);
+	Subsystem->EnqueueAsyncWorldCollision(AsyncWorldCollision.ToSharedRef());
+}
+
+void FAnimNode_KawaiiPhysics::UpdateWorldCollisionBroadphase(FComponentSpacePoseContext& Output,
+                                                             const USkeletalMeshComponent* OwningComp)
+{
+	SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_WorldCollision);
+
+	WorldSphericalLimits.Reset();
+	WorldCapsuleLimits.Reset();
+	WorldTaperedCapsuleLimits.Reset();
+	WorldBoxLimits.Reset();
+	CompiledWorldColliders.Reset();
+
+	const UWorld* World = OwningComp ? OwningComp->GetWorld() : nullptr;
+	if (!World)
+	{
+		return;
+	}
+
+	// 同期スイープの対象（simulate 対象ボーン + bridge dummy）を半径込みで囲むワールド空間の AABB
+	FBox ChainBounds(ForceInit);
+	auto AddBounds = [this, &Output, &ChainBounds](const int32 i)
+	{
+		const FVector LocationWS = ConvertSimulationSpaceLocation(
+			Output, SimulationSpace, EKawaiiPhysicsSimulationSpace::WorldSpace, SolverState.Location[i]);
+		ChainBounds += FBox::BuildAABB(LocationWS, FVector(SolverState.Radius[i]));
+	};
+	for (const int32 i : BoneCategories.Simulated)
+	{
+		AddBounds(i);
+	}
+	for (const int32 i : BoneCategories.BridgeDummies)
+	{
+		AddBounds(i);
+	}
+	if (!ChainBounds.IsValid)
+	{
+		return;
+	}
+	ChainBounds = ChainBounds.ExpandBy(FMath::Max(WorldCollisionQueryRadius, 0.0f));
+
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(KawaiiCollisionBroadphase));
+	ECollisionChannel TraceChannel;
+	FCollisionResponseParams ResponseParams;
+	MakeWorldCollisionQuery(OwningComp, TraceChannel, Params, ResponseParams);
+
+	WorldCollisionOverlapsScratch.Reset();
+	World->OverlapMultiByChannel(WorldCollisionOverlapsScratch, ChainBounds.GetCenter(), FQuat::Identity, TraceChannel,
+	                             FCollisionShape::MakeBox(ChainBounds.GetExtent()), Params, ResponseParams);
+
+	for (const FOverlapResult& Overlap : WorldCollisionOverlapsScratch)
+	{
+		// スイープと同じくブロッキングの相手だけを押し出しに使う
+		const UPrimitiveComponent* Component = Overlap.GetComponent();
+		if (!Overlap.bBlockingHit || !Component)
+		{
+			continue;
+		}
+
+		const FBodyInstance* Body = Component->GetBodyInstance(NAME_None, true, Overlap.ItemIndex);
+		if (!Body || !Body->GetBodySetup())
+		{
+			continue;
+		}
+
+		// 自コンポーネントのボディ: IgnoreBones / IgnoreBoneNamePrefix に加え、このノードが動かすボーンのボディも除く
+		// （スイープ経路は当該ボーン自身のボディだけを除くが、ここではボーン毎に形状を分けないため）
+		if (Component == OwningComp)
+		{
+			const FName BodyBoneName = Body->GetBodySetup()->BoneName;
+			if (BodyBoneName != NAME_None &&
+				(IsIgnoredWorldCollisionBone(BodyBoneName) ||
+					ModifyBones.ContainsByPredicate([BodyBoneName](const FKawaiiPhysicsModifyBone& Bone)
+					{
+						return Bone.BoneRef.BoneName == BodyBoneName;
+					})))
+			{
+				continue;
+			}
+		}
+
+		AddWorldCollisionBodyShapes(Output, *Body);
+	}
+
+	// 形状はフレーム内で動かないので、コンパイル（SIMD ブロック含む）もフレーム毎に1回
+	CompiledWorldColliders.Append(WorldSphericalLimits);
+	CompiledWorldColliders.Append(WorldCapsuleLimits);
+	CompiledWorldColliders.Append(WorldTaperedCapsuleLimits);
+	CompiledWorldColliders.Append(WorldBoxLimits);
+	if (CVarAnimNodeKawaiiPhysicsSimdNarrowphase.GetValueOnAnyThread())
+	{
+		CompiledWorldColliders.BuildSimdBlocks();
+	}
+
+	SET_DWORD_STAT(STAT_KawaiiPhysics_NumWorldCollisionShapes,
+	               WorldSphericalLimits.Num() + WorldCapsuleLimits.Num() + WorldTaperedCapsuleLimits.Num() +
+	               WorldBoxLimits.Num());
+}
+
+void FAnimNode_KawaiiPhysics::AddWorldCollisionBodyShapes(FComponentSpacePoseContext& Output,
+                                                          const FBodyInstance& Body)
+{
+	AddWorldCollisionAggGeomShapes(Output, Body.GetBodySetup()->AggGeom, Body.GetUnrealWorldTransform());
+}
+
+void FAnimNode_KawaiiPhysics::AddWorldCollisionAggGeomShapes(FComponentSpacePoseContext& Output,
+                                                             const FKAggregateGeom& AggGeom,
+                                                             FTransform BodyTransform)
+{
+	// スケールは要素側（GetFinalScaled）へ焼き込み、ボディのトランスフォームは回転と位置だけにする
+	const FVector Scale3D = BodyTransform.GetScale3D();
+	BodyTransform.RemoveScaling();
+
+	auto ToSimulationSpace = [this, &Output, &BodyTransform](FCollisionLimitBase& Limit, const FVector& Center,
+	                                                         const FQuat& Rotation)
+	{
+		const FTransform LimitTransform = ConvertSimulationSpaceTransform(
+			Output, EKawaiiPhysicsSimulationSpace::WorldSpace, SimulationSpace,
+			FTransform(BodyTransform.GetRotation() * Rotation, BodyTransform.TransformPosition(Center)));
+		Limit.Location = LimitTransform.GetLocation();
+		Limit.Rotation = LimitTransform.GetRotation();
+		Limit.bEnable = true;
+	};
+
+	for (const FKSphereElem& Elem : AggGeom.SphereElems)
+	{
+		const FKSphereElem Scaled = Elem.GetFinalScaled(Scale3D, FTransform::Identity);
+		FSphericalLimit& Limit = WorldSphericalLimits.AddDefaulted_GetRef();
+		ToSimulationSpace(Limit, Scaled.Center, FQuat::Identity);
+		Limit.Radius = Scaled.Radius;
+	}
+	for (const FKSphylElem& Elem : AggGeom.SphylElems)
+	{
+		const FKSphylElem Scaled = Elem.GetFinalScaled(Scale3D, FTransform::Identity);
+		FCapsuleLimit& Limit = WorldCapsuleLimits.AddDefaulted_GetRef();
+		ToSimulationSpace(Limit, Scaled.Center, Scaled.Rotation.Quaternion());
+		Limit.Radius = Scaled.Radius;
+		Limit.Length = Scaled.Length;
+	}
+	for (const FKTaperedCapsuleElem& Elem : AggGeom.TaperedCapsuleElems)
+	{
+		const FKTaperedCapsuleElem Scaled = Elem.GetFinalScaled(Scale3D, FTransform::Identity);
+		FTaperedCapsuleLimit& Limit = WorldTaperedCapsuleLimits.AddDefaulted_GetRef();
+		ToSimulationSpace(Limit, Scaled.Center, Scaled.Rotation.Quaternion());
+		Limit.Radius0 = Scaled.Radius0;
+		Limit.Radius1 = Scaled.Radius1;
+		Limit.Length = Scaled.Length;
+	}
+	for (const FKBoxElem& Elem : AggGeom.BoxElems)
+	{
+		const FKBoxElem Scaled = Elem.GetFinalScaled(Scale3D, FTransform::Identity);
+		FBoxLimit& Limit = WorldBoxLimits.AddDefaulted_GetRef();
+		ToSimulationSpace(Limit, Scaled.Center, Scaled.Rotation.Quaternion());
+		Limit.Extent = FVector(Scaled.X, Scaled.Y, Scaled.Z) / 2.0f;
+	}
+	// 凸包（ConvexElems）は扱わない。平面の集合を持てる Limit が無く、ボックスで近似すると斜めの面の手前（箱の角）で
+	// 押し出してしまうため。凸包だけのボディは Broadphase では判定されない
+}
+
+void FAnimNode_KawaiiPhysics::AdjustByAsyncWorldContact(FVector& Location, const int32 BoneIndex) const
+{
+	if (!AsyncWorldContactPlanes.IsValidIndex(BoneIndex))
+	{
+		return;
+	}
+
+	// 法線0（接触なし）の平面は距離も0になり何もしない
+	const FPlane& Plane = AsyncWorldContactPlanes[BoneIndex];
+	const double Distance = Plane.PlaneDot(Location);
+	if (Distance < 0.0)
+	{
+		Location -= FVector(Plane.X, Plane.Y, Plane.Z) * Distance;
+	}
+}
+
+void FAnimNode_KawaiiPhysics::AdjustBySphereCollision(FKawaiiPhysicsModifyBone& Bone, TArray<FSphericalLimit>& Limits)
+{
+	AdjustBySphereCollision(Bone.Location, Bone.PhysicsSettings.Radius, Limits);
+}
+
+void FAnimNode_KawaiiPhysics::AdjustBySphereCollision(FVector& Location, const float Radius,
+                                                      TArray<FSphericalLimit>& Limits)
+{
+	for (auto& Sphere : Limits)
+	{
+		if (!Sphere.bEnable || Sphere.Radius <= 0.0f)
+		{
+			continue;
+		}
+
+		KawaiiPhysicsCollision::PushOutSphere(Location, Radius, Sphere.Location, Sphere.Radius,
+		                                      Sphere.LimitType == ESphericalLimitType::Inner);
+	}
+}
+
+namespace
+{
+	// 参照ポーズのコンポーネント空間トランスフォーム（親は常に子より小さい index）
+	void BuildComponentSpaceRefPose(const FReferenceSkeleton& RefSkeleton, TArray<FTransform>& OutTransforms)
+	{
+		const TArray<FTransform>& RefBonePose = RefSkeleton.GetRefBonePose();
+		OutTransforms.SetNum(RefBonePose.Num());
+		for (int32 BoneIndex = 0; BoneIndex < RefBonePose.Num(); ++BoneIndex)
+		{
+			const int32 ParentIndex = RefSkeleton.GetParentIndex(BoneIndex);
+			OutTransforms[BoneIndex] = OutTransforms.IsValidIndex(ParentIndex)
+				                           ? RefBonePose[BoneIndex] * OutTransforms[ParentIndex]
+				                           : RefBonePose[BoneIndex];
+		}
+	}
+
+	// BoneIndex が RootIndex 自身かその子孫か
+	bool IsBoneUnder(const FReferenceSkeleton& RefSkeleton, int32 BoneIndex, const int32 RootIndex)
+	{
+		for (; BoneIndex != INDEX_NONE; BoneIndex = RefSkeleton.GetParentIndex(BoneIndex))
+		{
+			if (BoneIndex == RootIndex)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// BoneIndex から OtherIndex との共通祖先までの参照ポーズでのチェーン長（BoneIndex が OtherIndex の祖先なら 0）。
+	// アニメーションで BoneIndex が共通祖先まわりに動ける距離の上限
+	float GetChainLengthFromCommonAncestor(const FReferenceSkeleton& RefSkeleton, int32 BoneIndex,
+	                                       const int32 OtherIndex)
+	{
+		const TArray<FTransform>& RefBonePose = RefSkeleton.GetRefBonePose();
+		float Length = 0.0f;
+		for (; BoneIndex != INDEX_NONE && !IsBoneUnder(RefSkeleton, OtherIndex, BoneIndex);
+		       BoneIndex = RefSkeleton.GetParentIndex(BoneIndex))
+		{
+			Length += static_cast<float>(RefBonePose[BoneIndex].GetTranslation().Size());
+		}
+		return Length;
+	}
+
+	// ダミーは元になった実ボーンで判定する（ボーン間 / ブリッジは両端のどちらか、末端ダミーは親）。
+	// 実ボーンまで辿れないものは判定対象に残す
+	template <typename TPredicate>
+	bool MatchesRealBone(const TArray<FKawaiiPhysicsModifyBone>& Bones, const int32 Index, const TPredicate& Predicate)
+	{
+		const FKawaiiPhysicsModifyBone& Bone = Bones[Index];
+		if (Bone.bBridgeDummy || Bone.bInterBoneDummy)
+		{
+			const bool bHasFirst = Bones.IsValidIndex(Bone.InterBoneRealParentIndex);
+			const bool bHasSecond = Bones.IsValidIndex(Bone.InterBoneRealChildIndex);
+			if (!bHasFirst && !bHasSecond)
+			{
+				return true;
+			}
+			return (bHasFirst && MatchesRealBone(Bones, Bone.InterBoneRealParentIndex, Predicate)) ||
+				(bHasSecond && MatchesRealBone(Bones, Bone.InterBoneRealChildIndex, Predicate));
+		}
+		if (Bone.bDummy)
+		{
+			return !Bones.IsValidIndex(Bone.ParentIndex) || Bone.ParentIndex >= Index ||
+				MatchesRealBone(Bones, Bone.ParentIndex, Predicate);
+		}
+		return Predicate(Bone);
+	}
+
+	// 到達判定に使うコライダーの外接球の半径（中心は DrivingBone からのオフセット位置）。
+	// 負なら遠くからでも押し出し得るので自動判定しない（Inner スフィア / 負の Extent の Box / 平面）
+	float GetRelevanceBoundingRadius(const FSphericalLimit& Limit)
+	{
+		return Limit.LimitType == ESphericalLimitType::Inner ? -1.0f : FMath::Max(Limit.Radius, 0.0f);
+	}
+
+	float GetRelevanceBoundingRadius(const FCapsuleLimit& Limit)
+	{
+		return FMath::Max(Limit.Radius, 0.0f) + FMath::Max(Limit.Length, 0.0f) * 0.5f;
+	}
+
+	float GetRelevanceBoundingRadius(const FTaperedCapsuleLimit& Limit)
+	{
+		return FMath::Max3(Limit.Radius0, Limit.Radius1, 0.0f) + FMath::Max(Limit.Length, 0.0f) * 0.5f;
+	}
+
+	float GetRelevanceBoundingRadius(const FBoxLimit& Limit)
+	{
+		return Limit.Extent.GetMin() < 0.0 ? -1.0f : static_cast<float>(Limit.Extent.Size());
+	}
+
+	float GetRelevanceBoundingRadius(const FPlanarLimit&)
+	{
+		return -1.0f;
+	}
+}
+
+void FAnimNode_KawaiiPhysics::BuildColliderRelevanceMasks(const FReferenceSkeleton& RefSkeleton)
+{
+	bColliderRelevanceMasksDirty = false;
+	ColliderRelevanceMasks.Reset();
+	const int32 NumBones = ModifyBones.Num();
+	ColliderRelevanceMaskWords = FMath::DivideAndRoundUp(NumBones, 32);
+
+	TArray<FTransform> CSRefPose;
+	BuildComponentSpaceRefPose(RefSkeleton, CSRefPose);
+	const auto FindRefBone = [&RefSkeleton](const FName BoneName)
+	{
+		return BoneName.IsNone() ? INDEX_NONE : RefSkeleton.FindBoneIndex(BoneName);
+	};
+
+	// ボーンごとのチェーン root（ParentIndex を辿った先の実ボーン）。bridge dummy は縦階層を持たないので持たない
+	TArray<int32> ChainRootRefBones;
+	ChainRootRefBones.Init(INDEX_NONE, NumBones);
+	for (int32 i = 0; i < NumBones; ++i)
+	{
+		const FKawaiiPhysicsModifyBone& Bone = ModifyBones[i];
+		if (Bone.bBridgeDummy)
+		{
+			continue;
+		}
+		ChainRootRefBones[i] = Bone.ParentIndex >= 0 && Bone.ParentIndex < i
+			                       ? ChainRootRefBones[Bone.ParentIndex]
+			                       : FindRefBone(Bone.BoneRef.BoneName);
+	}
+
+	// 参照ポーズでチェーン root から「root からの長さ + ボーン半径 + 余裕」の球に、コライダーの外接球が届くか。
+	// チェーン root と DrivingBone はどちらも共通祖先まわりに回れるので、共通祖先から両方までのチェーン長を足す。
+	// コライダー中心も DrivingBone まわりに回るので OffsetLocation の長さも足す。
+	// bridge dummy は2本のチェーンの間を動くので常に届くとみなす（BoneFilter でだけ絞る）
+	const float Margin = FMath::Max(ColliderRelevanceMargin, 0.0f);
+	const auto CanReach = [&](const int32 i, const int32 DrivingRefBone, const FVector& ColliderLocation,
+	                          const float ColliderRadius, const float OffsetLength)
+	{
+		const FKawaiiPhysicsModifyBone& Bone = ModifyBones[i];
+		const int32 RootRefBone = ChainRootRefBones[i];
+		if (Bone.bBridgeDummy || !CSRefPose.IsValidIndex(RootRefBone))
+		{
+			return true;
+		}
+		const double Reach = Bone.LengthFromRoot + FMath::Max(Bone.PhysicsSettings.Radius, PhysicsSettings.Radius) +
+			GetChainLengthFromCommonAncestor(RefSkeleton, DrivingRefBone, RootRefBone) +
+			GetChainLengthFromCommonAncestor(RefSkeleton, RootRefBone, DrivingRefBone) + OffsetLength + ColliderRadius +
+			Margin;
+		return FVector::DistSquared(CSRefPose[RootRefBone].GetLocation(), ColliderLocation) <= FMath::Square(Reach);
+	};
+
+	TArray<int32> FilterRootRefBones;
+	int32 NumMaskedPairs = 0;
+	auto BuildMasks = [&](auto& Limits)
+	{
+		for (auto& Limit : Limits)
+		{
+			Limit.CachedRelevanceMask = INDEX_NONE;
+
+			const FKawaiiPhysicsLimitBoneFilter& Filter = Limit.BoneFilter;
+			const float BoundingRadius = GetRelevanceBoundingRadius(Limit);
+			const int32 DrivingRefBone = FindRefBone(Limit.DrivingBone.BoneName);
+			const bool bAuto = bAutoColliderRelevance && BoundingRadius >= 0.0f && CSRefPose.IsValidIndex(DrivingRefBone);
+			if (Filter.IsEmpty() && !bAuto)
+			{
+				continue;
+			}
+
+			FilterRootRefBones.Reset();
+			for (const FBoneReference& FilterRoot : Filter.RootBones)
+			{
+				FilterRootRefBones.Add(FindRefBone(FilterRoot.BoneName));
+			}
+			const auto MatchesFilter = [&](const FKawaiiPhysicsModifyBone& Bone)
+			{
+				if (Filter.IsEmpty())
+				{
+					return true;
+				}
+				const bool bListed = Filter.Bones.ContainsByPredicate([&Bone](const FBoneReference& FilterBone)
+				{
+					return FilterBone.BoneName == Bone.BoneRef.BoneName;
+				});
+				if (bListed)
+				{
+					return true;
+				}
+				const int32 RefBone = FindRefBone(Bone.BoneRef.BoneName);
+				return RefBone != INDEX_NONE && FilterRootRefBones.ContainsByPredicate([&](const int32 FilterRoot)
+				{
+					return FilterRoot != INDEX_NONE && IsBoneUnder(RefSkeleton, RefBone, FilterRoot);
+				});
+			};
+
+			const FVector ColliderLocation = bAuto
+				                                 ? CSRefPose[DrivingRefBone].TransformPosition(Limit.OffsetLocation)
+				                                 : FVector::ZeroVector;
+			const float OffsetLength = static_cast<float>(Limit.OffsetLocation.Size());
+			const int32 Offset = ColliderRelevanceMasks.AddZeroed(ColliderRelevanceMaskWords);
+			int32 NumExcluded = 0;
+			for (int32 i = 0; i < NumBones; ++i)
+			{
+				const bool bRelevant = MatchesRealBone(ModifyBones, i, MatchesFilter) &&
+					(!bAuto || CanReach(i, DrivingRefBone, ColliderLocation, BoundingRadius, OffsetLength));
+				if (bRelevant)
+				{
+					ColliderRelevanceMasks[Offset + i / 32] |= 1u << (i % 32);
+				}
+				else
+				{
+					++NumExcluded;
+					NumMaskedPairs += ModifyBones[i].bSkipSimulate ? 0 : 1;
+				}
+			}
+
+			// 全ボーンと判定するならマスクは持たない
+			if (NumExcluded == 0)
+			{
+				ColliderRelevanceMasks.SetNum(Offset);
+				continue;
+			}
+			Limit.CachedRelevanceMask = Offset;
+		}
+	};
+
+	BuildMasks(SphericalLimits);
+	BuildMasks(SphericalLimitsData);
+	BuildMasks(CapsuleLimits);
+	BuildMasks(CapsuleLimitsData);
+	BuildMasks(TaperedCapsuleLimits);
+	BuildMasks(TaperedCapsuleLimitsData);
+	BuildMasks(BoxLimits);
+	BuildMasks(BoxLimitsData);
+	BuildMasks(PlanarLimits);
+	BuildMasks(PlanarLimitsData);
+
+	SET_DWORD_STAT(STAT_KawaiiPhysics_NumColliderPairsMasked, NumMaskedPairs);
+}
+
+FBox FAnimNode_KawaiiPhysics::ComputeCollisionCullBounds() const
+{
+	FBox Bounds(ForceInit);
+	if (!CVarAnimNodeKawaiiPhysicsColliderCulling.GetValueOnAnyThread())
+	{
+		return Bounds;
+	}
+
+	// 積分前（アイランド経路）/ 後（逐次経路）のどちらから呼ばれても同じステップの移動範囲を覆うよう、
+	// 前回位置と1ステップ先の外挿位置も含める
+	const FKawaiiPhysicsSolverState& State = SolverState;
+	float MaxRadius = 0.0f;
+	auto AddBone = [&](const int32 i)
+	{
+		const FVector& Location = State.Location[i];
+		const FVector& PrevLocation = State.PrevLocation[i];
+		Bounds += Location;
+		Bounds += PrevLocation;
+		Bounds += Location + (Location - PrevLocation);
+		Bounds += State.PoseLocation[i];
+		MaxRadius = FMath::Max(MaxRadius, State.Radius[i]);
+	};
+	for (const int32 i : BoneCategories.Simulated)
+	{
+		AddBone(i);
+	}
+	for (const int32 i : BoneCategories.BridgeDummies)
+	{
+		AddBone(i);
+	}
+
+	if (!Bounds.IsValid)
+	{
+		return Bounds;
+	}
+	const float Margin = FMath::Max(CVarAnimNodeKawaiiPhysicsColliderCullingMargin.GetValueOnAnyThread(), 0.0f);
+	return Bounds.ExpandBy(MaxRadius + Margin);
+}
+
+void FAnimNode_KawaiiPhysics::PrepareCollisionShapeCaches()
+{
+	SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_CompileColliders);
+
+	// キャッシュは operator= に意図的に載せていない（フィールド追加漏れで静かに陳腐化するため）。
+	// またコピー構築（Shared 経路の auto Converted = Limit 等）は古いキャッシュ値ごと運ぶため、
+	// AdjustBy* の前に必ず本関数で再計算することが正しさの前提。
+	// 同時に、有効かつ非縮退の limit だけを形状別 SoA バッファへ詰める。配列の結合順は従来の
+	// AdjustBy* 呼び出し順（AnimNode → DataAsset）と同じにし、押し出しの適用順を変えない。
+	// バッファに詰めない側（LOD で止めた自ノード分 / 未使用の共有コリジョン）もキャッシュだけは毎ステップ更新する。
+	// 有効へ戻した直後のステップや単体の AdjustBy* が、止めていた間の古い値を見ないようにするため
+	auto UpdateEnabledCaches = [](auto& Limits)
+	{
+		for (auto& Limit : Limits)
+		{
+			if (Limit.bEnable)
+			{
+				Limit.UpdateRuntimeCache();
+			}
+		}
+	};
+
+	// LOD 段階で止めたカテゴリは空のバッファにして判定ごと省く。
+	// チェーンの掃引 AABB と重ならないコライダーはここで間引き、ボーンループに持ち込まない（残る順序は変えない）。
+	// 関連マスクは自ノード分にだけ付ける（共有コリジョンの limit は送信側ノードのボーン構成で作られている）
+	const FKawaiiPhysicsLODTier* LODTier = GetActiveLODTier();
+	const FBox CullBounds = ComputeCollisionCullBounds();
+	CompiledColliders.Reset();
+	CompiledColliders.CullBounds = CullBounds;
+	if (ColliderRelevanceMaskWords == FMath::DivideAndRoundUp(ModifyBones.Num(), 32))
+	{
+		CompiledColliders.RelevanceMasks = ColliderRelevanceMasks;
+		CompiledColliders.RelevanceMaskWords = ColliderRelevanceMaskWords;
+	}
+	if (!LODTier || LODTier->bEnableCollision)
+	{
+		CompiledColliders.Append(SphericalLimits);
+		CompiledColliders.Append(SphericalLimitsData);
+		CompiledColliders.Append(CapsuleLimits);
+		CompiledColliders.Append(CapsuleLimitsData);
+		CompiledColliders.Append(TaperedCapsuleLimits);
+		CompiledColliders.Append(TaperedCapsuleLimitsData);
+		CompiledColliders.Append(BoxLimits);
+		CompiledColliders.Append(BoxLimitsData);
+		CompiledColliders.Append(PlanarLimits);
+		CompiledColliders.Append(PlanarLimitsData);
+	}
+	else
+	{
+		UpdateEnabledCaches(CapsuleLimits);
+		UpdateEnabledCaches(CapsuleLimitsData);
+		UpdateEnabledCaches(TaperedCapsuleLimits);
+		UpdateEnabledCaches(TaperedCapsuleLimitsData);
+		UpdateEnabledCaches(BoxLimits);
+		UpdateEnabledCaches(BoxLimitsData);
+		UpdateEnabledCaches(PlanarLimits);
+		UpdateEnabledCaches(PlanarLimitsData);
+	}
+
+	// 共有コリジョンは自ノード分の後に別バッファで適用する（従来順序の維持）
+	CompiledSharedColliders.Reset();
+	CompiledSharedColliders.CullBounds = CullBounds;
+	if (bUseSharedCollision && !bSharedCollisionSource && (!LODTier || LODTier->bEnableSharedCollision))
+	{
+		CompiledSharedColliders.Append(SharedSphericalLimits);
+		CompiledSharedColliders.Append(SharedCapsuleLimits);
+		CompiledSharedColliders.Append(SharedTaperedCapsuleLimits);
+		CompiledSharedColliders.Append(SharedBoxLimits);
+		CompiledSharedColliders.Append(SharedPlanarLimits);
+	}
+	else
+	{
+		UpdateEnabledCaches(SharedCapsuleLimits);
+		UpdateEnabledCaches(SharedTaperedCapsuleLimits);
+		UpdateEnabledCaches(SharedBoxLimits);
+		UpdateEnabledCaches(SharedPlanarLimits);
+	}
+
+	// コライダーが多いバッファだけ一様グリッドで候補を絞る（少ないうちは総当たり / SIMD の方が速い）
+	const int32 GridMinColliders = CVarAnimNodeKawaiiPhysicsColliderGridMinColliders.GetValueOnAnyThread();
+	CompiledColliders.BuildGrid(GridMinColliders);
+	CompiledSharedColliders.BuildGrid(GridMinColliders);
+
+	bUseSimdNarrowphase = CVarAnimNodeKawaiiPhysicsSimdNarrowphase.GetValueOnAnyThread();
+	if (bUseSimdNarrowphase)
+	{
+		if (!CompiledColliders.Grid.IsValid())
+		{
+			CompiledColliders.BuildSimdBlocks();
+		}
+		if (!CompiledSharedColliders.Grid.IsValid())
+		{
+			CompiledSharedColliders.BuildSimdBlocks();
+		}
+	}
+
+#if STATS
+	const int32 NumCollidingBones = BoneCategories.Simulated.Num() +
+		(ShouldSimulateDummyBones() ? BoneCategories.BridgeDummies.Num() : 0);
+	const int32 NumCandidates = CompiledColliders.Num() + CompiledSharedColliders.Num();
+	const int32 NumCulled = CompiledColliders.NumCulled + CompiledSharedColliders.NumCulled;
+	SET_DWORD_STAT(STAT_KawaiiPhysics_NumColliderPairsBeforeCulling, NumCollidingBones * (NumCandidates + NumCulled));
+	SET_DWORD_STAT(STAT_KawaiiPhysics_NumColliderPairsAfterCulling, NumCollidingBones * NumCandidates);
+#endif
+}
+
+namespace
+{
+	using FColliderBuffer = FKawaiiPhysicsColliderBuffer;
+	using FRelevanceFilter = FColliderBuffer::FRelevanceFilter;
+
+	void PushOutGridKey(FVector& Location, const float Radius, const FColliderBuffer& Colliders, const uint32 Key,
+	                    const FRelevanceFilter& Relevance)
+	{
+		using namespace KawaiiPhysicsCollision;
+
+		const int32 i = FColliderBuffer::GetGridKeyIndex(Key);
+		switch (FColliderBuffer::GetGridKeyShape(Key))
+		{
+		case FColliderBuffer::EGridShape::Sphere:
+			if (Relevance.Skips(Colliders.Spheres.RelevanceMask, i))
+			{
+				break;
+			}
+			PushOutSphere(Location, Radius, Colliders.Spheres.Center[i], Colliders.Spheres.Radius[i],
+			              Colliders.Spheres.bInner[i] != 0);
+			break;
+		case FColliderBuffer::EGridShape::Capsule:
+			if (Relevance.Skips(Colliders.Capsules.RelevanceMask, i))
+			{
+				break;
+			}
+			PushOutCapsule(Location, Radius, Colliders.Capsules.Start[i], Colliders.Capsules.End[i],
+			               Colliders.Capsules.Radius[i], Colliders.Capsules.FallbackPushDir[i]);
+			break;
+		case FColliderBuffer::EGridShape::TaperedCapsule:
+			if (Relevance.Skips(Colliders.TaperedCapsules.RelevanceMask, i))
+			{
+				break;
+			}
+			PushOutTaperedCapsule(Location, Radius, Colliders.TaperedCapsules.Start[i],
+			                      Colliders.TaperedCapsules.Segment[i], Colliders.TaperedCapsules.SegmentSizeSq[i],
+			                      Colliders.TaperedCapsules.Radius0[i], Colliders.TaperedCapsules.Radius1[i],
+			                      Colliders.TaperedCapsules.FallbackPushDir[i]);
+			break;
+		case FColliderBuffer::EGridShape::Box:
+			if (Relevance.Skips(Colliders.Boxes.RelevanceMask, i))
+			{
+				break;
+			}
+			PushOutBox(Location, Radius, Colliders.Boxes.Transform[i], Colliders.Boxes.Extent[i]);
+			break;
+		}
+	}
+
+	// Key 以降（適用順で後ろ）の Plane 以外の全コライダーを総当たりで確定する
+	void PushOutFromGridKey(FVector& Location, const float Radius, const FColliderBuffer& Colliders, const uint32 Key,
+	                        const FRelevanceFilter& Relevance)
+	{
+		const int32 NumPerShape[] = {
+			Colliders.Spheres.Num(), Colliders.Capsules.Num(), Colliders.TaperedCapsules.Num(), Colliders.Boxes.Num()
+		};
+		const int32 FirstShape = static_cast<int32>(FColliderBuffer::GetGridKeyShape(Key));
+		constexpr int32 NumShapes = static_cast<int32>(UE_ARRAY_COUNT(NumPerShape));
+		for (int32 Shape = FirstShape; Shape < NumShapes; ++Shape)
+		{
+			const FColliderBuffer::EGridShape GridShape = static_cast<FColliderBuffer::EGridShape>(Shape);
+			for (int32 i = Shape == FirstShape ? FColliderBuffer::GetGridKeyIndex(Key) : 0; i < NumPerShape[Shape]; ++i)
+			{
+				PushOutGridKey(Location, Radius, Colliders, FColliderBuffer::MakeGridKey(GridShape, i), Relevance);
+			}
+		}
+	}
+
+	// ボーンの球が1セルに収まればそのセルのキー列だけを順に確定する。押し出しで動いたらセルを引き直し、
+	// 新しいセルの列の「今確定したキーより後ろ」から続ける（どのセルの列もキー昇順なので適用順は総当たりと同一）。
+	// 複数セルにまたがる位置ではそこから先を総当たりに切り替える。
+	void PushOutGridCandidates(FVector& Location, const float Radius, const FColliderBuffer& Colliders,
+	                           const FRelevanceFilter& Relevance)
+	{
+		const FColliderBuffer::FGrid& Grid = Colliders.Grid;
+		// SIMD 判定と同じく、スカラー側の float 丸めを上回る幅だけ問い合わせ範囲を広げる（当たり漏れ厳禁）
+		const double QueryExtent = FMath::Abs(Radius) * (1.0 + 1.0e-4) + 1.0e-3;
+
+		int32 Cell;
+		if (!Grid.FindCell(Location, QueryExtent, Cell))
+		{
+			PushOutFromGridKey(Location, Radius, Colliders, 0, Relevance);
+			return;
+		}
+
+		TConstArrayView<uint32> Entries = Grid.GetCellEntries(Cell);
+		for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); ++EntryIndex)
+		{
+			const uint32 Key = Entries[EntryIndex];
+			const FVector PrevLocation = Location;
+			PushOutGridKey(Location, Radius, Colliders, Key, Relevance);
+			if (Location == PrevLocation)
+			{
+				continue;
+			}
+
+			int32 NewCell;
+			if (!Grid.FindCell(Location, QueryExtent, NewCell))
+			{
+				PushOutFromGridKey(Location, Radius, Colliders, Key + 1, Relevance);
+				return;
+			}
+			if (NewCell != Cell)
+			{
+				Cell = NewCell;
+				Entries = Grid.GetCellEntries(Cell);
+				EntryIndex = Algo::UpperBound(Entries, Key) - 1;
+			}
+		}
+	}
+}
+
+void FAnimNode_KawaiiPhysics::AdjustByColliderBuffer(FVector& Location, const FVector& PrevLocation, const float Radius,
+                                                     const FKawaiiPhysicsColliderBuffer& Colliders,
+                                                     const int32 BoneIndex) const
+{
+	using namespace KawaiiPhysicsCollision;
+
+	// 関連マスクで外れたコライダーは確定処理の直前にビット1つで飛ばす（マスクが無ければ常に判定）
+	const FKawaiiPhysicsColliderBuffer::FRelevanceFilter Relevance = Colliders.MakeRelevanceFilter(BoneIndex);
+
+	const FKawaiiPhysicsColliderBuffer::FSpheres& Spheres = Colliders.Spheres;
+	const FKawaiiPhysicsColliderBuffer::FCapsules& Capsules = Colliders.Capsules;
+	const FKawaiiPhysicsColliderBuffer::FTaperedCapsules& TaperedCapsules = Colliders.TaperedCapsules;
+	const FKawaiiPhysicsColliderBuffer::FBoxes& Boxes = Colliders.Boxes;
+	if (Colliders.Grid.IsValid())
+	{
+		PushOutGridCandidates(Location, Radius, Colliders, Relevance);
+	}
+	else if (bUseSimdNarrowphase)
+	{
+		PushOutSpheresSimd(Location, Radius, Spheres, Relevance);
+		PushOutCapsulesSimd(Location, Radius, Capsules, Relevance);
+		PushOutTaperedCapsulesSimd(Location, Radius, TaperedCapsules, Relevance);
+		PushOutBoxesSimd(Location, Radius, Boxes, Relevance);
+	}
+	else
+	{
+		for (int32 i = 0; i < Spheres.Num(); ++i)
+		{
+			if (Relevance.Skips(Spheres.RelevanceMask, i))
+			{
+				continue;
+			}
+			PushOutSphere(Location, Radius, Spheres.Center[i], Spheres.Radius[i], Spheres.bInner[i] != 0);
+		}
 
-	if (bIgnoreSelfComponent)
-	{
-		Params.AddIgnoredComponent(OwningComp);
+		for (int32 i = 0; i < Capsules.Num(); ++i)
+		{
+			if (Relevance.Skips(Capsules.RelevanceMask, i))
+			{
+				continue;
+			}
+			PushOutCapsule(Location, Radius, Capsules.Start[i], Capsules.End[i], Capsules.Radius[i],
+			               Capsules.FallbackPushDir[i]);
+		}
+
+		for (int32 i = 0; i < TaperedCapsules.Num(); ++i)
+		{
+			if (Relevance.Skips(TaperedCapsules.RelevanceMask, i))
+			{
+				continue;
+			}
+			PushOutTaperedCapsule(Location, Radius, TaperedCapsules.Start[i], TaperedCapsules.Segment[i],
+			                      TaperedCapsules.SegmentSizeSq[i], TaperedCapsules.Radius0[i],
+			                      TaperedCapsules.Radius1[i], TaperedCapsules.FallbackPushDir[i]);
+		}
+
+		for (int32 i = 0; i < Boxes.Num(); ++i)
+		{
+			if (Relevance.Skips(Boxes.RelevanceMask, i))
+			{
+				continue;
+			}
+			PushOutBox(Location, Radius, Boxes.Transform[i], Boxes.Extent[i]);
+		}
 	}
 
-	// コンポーネントからコリジョン設定を取得
-	ECollisionChannel TraceChannel = bOverrideCollisionParams
-		                                 ? CollisionChannelSettings.GetObjectType()
-		                                 : OwningComp->GetCollisionObjectType();
-	FCollisionResponseParams ResponseParams = bOverrideCollisionParams
-		                                          ? FCollisionResponseParams(
-			                                          CollisionChannelSettings.GetResponseToChannels())
-		                                          : FCollisionResponseParams(
-			                                          OwningComp->GetCollisionResponseToChannels());
-	const UWorld* World = OwningComp->GetWorld();
+	const FKawaiiPhysicsColliderBuffer::FPlanes& Planes = Colliders.Planes;
+	for (int32 i = 0; i < Planes.Num(); ++i)
+	{
+		if (Relevance.Skips(Planes.RelevanceMask, i))
+		{
+			continue;
+		}
+		PushOutPlane(Location, PrevLocation, Radius, Planes.Plane[i], Planes.Normal[i]);
+	}
+}
 
-	const FVector TraceStartLocationWS =
-		ConvertSimulationSpaceLocation(Output, SimulationSpace, EKawaiiPhysicsSimulationSpace::WorldSpace,
-		                               Bone.PrevLocation);
-	const FVector TraceEndLocationWS =
-		ConvertSimulationSpaceLocation(Output, SimulationSpace, EKawaiiPhysicsSimulationSpace::WorldSpace,
-		                               Bone.Location);
+namespace
+{
+	// 区間の両端の球を包む AABB が掛かるセル範囲（SIMD / 点の Grid 判定と同じく float 丸め分だけ広げる）
+	void GetBoneSegmentCellRange(const FColliderBuffer::FGrid& Grid, const FVector& LocationA, const FVector& LocationB,
+	                             const float RadiusA, const float RadiusB, FIntVector& OutMin, FIntVector& OutMax)
+	{
+		const double QueryExtent = FMath::Max(FMath::Abs(RadiusA), FMath::Abs(RadiusB)) * (1.0 + 1.0e-4) + 1.0e-3;
+		OutMin = Grid.GetCellCoord(LocationA.ComponentMin(LocationB) - FVector(QueryExtent));
+		OutMax = Grid.GetCellCoord(LocationA.ComponentMax(LocationB) + FVector(QueryExtent));
+	}
 
-	if (bIgnoreSelfComponent)
+	// 区間をキー1つのコライダーと判定し、接触なら端点へ配分する（Box / Inner スフィアは対象外）。
+	// どちらの端点とも無関係なコライダーは飛ばす
+	void PushOutBoneSegmentKey(FVector& LocationA, FVector& LocationB, const float RadiusA, const float RadiusB,
+	                           const bool bMovableA, const bool bMovableB, const FColliderBuffer& Colliders,
+	                           const FRelevanceFilter& RelevanceA, const FRelevanceFilter& RelevanceB, const uint32 Key)
 	{
-		// sphere sweep
-		FHitResult Result;
-		bool bHit = World->SweepSingleByChannel(
-			Result, TraceStartLocationWS, TraceEndLocationWS, FQuat::Identity,
-			TraceChannel, FCollisionShape::MakeSphere(Bone.PhysicsSettings.Radius), Params, ResponseParams);
-		if (bHit)
+		using namespace KawaiiPhysicsCollision;
+
+		const auto SkipsBoth = [&](const TArray<int32>& ShapeMasks, const int32 i)
 		{
-			if (Result.bStartPenetrating)
+			return RelevanceA.Skips(ShapeMasks, i) && RelevanceB.Skips(ShapeMasks, i);
+		};
+
+		const int32 i = FColliderBuffer::GetGridKeyIndex(Key);
+		float T;
+		FVector Push;
+		bool bHit = false;
+		switch (FColliderBuffer::GetGridKeyShape(Key))
+		{
+		case FColliderBuffer::EGridShape::Sphere:
 			{
-				Bone.Location =
-					ConvertSimulationSpaceLocation(Output, EKawaiiPhysicsSimulationSpace::WorldSpace, SimulationSpace,
-					                               TraceEndLocationWS + Result.Normal * Result.PenetrationDepth);
+				const FColliderBuffer::FSpheres& Spheres = Colliders.Spheres;
+				bHit = !Spheres.bInner[i] && !SkipsBoth(Spheres.RelevanceMask, i) &&
+					ComputeSegmentSphereContact(LocationA, LocationB, RadiusA, RadiusB, Spheres.Center[i],
+					                            Spheres.Radius[i], T, Push);
+				break;
 			}
-			else
+		case FColliderBuffer::EGridShape::Capsule:
 			{
-				Bone.Location =
-					ConvertSimulationSpaceLocation(Output, EKawaiiPhysicsSimulationSpace::WorldSpace, SimulationSpace,
-					                               Result.Location);
+				const FColliderBuffer::FCapsules& Capsules = Colliders.Capsules;
+				bHit = !SkipsBoth(Capsules.RelevanceMask, i) &&
+					ComputeSegmentCapsuleContact(LocationA, LocationB, RadiusA, RadiusB, Capsules.Start[i],
+					                             Capsules.End[i], Capsules.Radius[i], Capsules.Radius[i],
+					                             Capsules.FallbackPushDir[i], T, Push);
+				break;
+			}
+		case FColliderBuffer::EGridShape::TaperedCapsule:
+			{
+				const FColliderBuffer::FTaperedCapsules& TaperedCapsules = Colliders.TaperedCapsules;
+				const FVector& Start = TaperedCapsules.Start[i];
+				bHit = !SkipsBoth(TaperedCapsules.RelevanceMask, i) &&
+					ComputeSegmentCapsuleContact(LocationA, LocationB, RadiusA, RadiusB, Start,
+					                             Start + TaperedCapsules.Segment[i], TaperedCapsules.Radius0[i],
+					                             TaperedCapsules.Radius1[i], TaperedCapsules.FallbackPushDir[i], T,
+					                             Push);
+				break;
+			}
+		case FColliderBuffer::EGridShape::Box:
+			break;
+		}
+		if (bHit)
+		{
+			ApplySegmentPush(LocationA, LocationB, bMovableA, bMovableB, T, Push);
+		}
+	}
+
+	// Key 以降（適用順で後ろ）の Sphere / Capsule / TaperedCapsule を総当たりで判定する
+	void PushOutBoneSegmentFromKey(FVector& LocationA, FVector& LocationB, const float RadiusA, const float RadiusB,
+	                               const bool bMovableA, const bool bMovableB, const FColliderBuffer& Colliders,
+	                               const FRelevanceFilter& RelevanceA, const FRelevanceFilter& RelevanceB,
+	                               const uint32 Key)
+	{
+		const int32 NumPerShape[] = {
+			Colliders.Spheres.Num(), Colliders.Capsules.Num(), Colliders.TaperedCapsules.Num()
+		};
+		const int32 FirstShape = static_cast<int32>(FColliderBuffer::GetGridKeyShape(Key));
+		constexpr int32 NumShapes = static_cast<int32>(UE_ARRAY_COUNT(NumPerShape));
+		for (int32 Shape = FirstShape; Shape < NumShapes; ++Shape)
+		{
+			const FColliderBuffer::EGridShape GridShape = static_cast<FColliderBuffer::EGridShape>(Shape);
+			for (int32 i = Shape == FirstShape ? FColliderBuffer::GetGridKeyIndex(Key) : 0; i < NumPerShape[Shape]; ++i)
+			{
+				PushOutBoneSegmentKey(LocationA, LocationB, RadiusA, RadiusB, bMovableA, bMovableB, Colliders,
+				                      RelevanceA, RelevanceB, FColliderBuffer::MakeGridKey(GridShape, i));
 			}
 		}
 	}
-	else
+
+	// 1本の区間（ボーン親→子 / BoneConstraint の辺）をバッファの Sphere / Capsule / TaperedCapsule と判定し、接触ごとに端点へ配分する。
+	// Box / Plane / Inner スフィアは区間判定の対象外で端点の判定だけに任せるため、端点の間だけが薄い Box や Plane を
+	// 横切る場合は今も素通りする。
+	// Grid があれば区間の AABB が掛かるセルのキーだけを昇順に判定する（適用順は総当たりと同一）。押し出しで AABB が
+	// そのセル範囲をはみ出したら、そこから先を総当たりに切り替える
+	void PushOutBoneSegment(FVector& LocationA, FVector& LocationB, const float RadiusA, const float RadiusB,
+	                        const bool bMovableA, const bool bMovableB, const FKawaiiPhysicsColliderBuffer& Colliders,
+	                        const FRelevanceFilter& RelevanceA, const FRelevanceFilter& RelevanceB)
 	{
-		// sphere sweep（ヒット後に対象ボーンを除外）
-		WorldCollisionHitsScratch.Reset();
-		bool bHit = World->SweepMultiByChannel(WorldCollisionHitsScratch, TraceStartLocationWS,
-		                                       TraceEndLocationWS, FQuat::Identity, TraceChannel,
-		                                       FCollisionShape::MakeSphere(Bone.PhysicsSettings.Radius), Params,
-		                                       ResponseParams);
-		if (!bHit)
+		const FColliderBuffer::FGrid& Grid = Colliders.Grid;
+		if (!Grid.IsValid())
 		{
+			PushOutBoneSegmentFromKey(LocationA, LocationB, RadiusA, RadiusB, bMovableA, bMovableB, Colliders,
+			                          RelevanceA, RelevanceB, 0);
 			return;
 		}
 
-		bool IsIgnoreHit;
-		if (IgnoreBoneNamePrefixCache != IgnoreBoneNamePrefix)
+		FIntVector CellMin, CellMax;
+		GetBoneSegmentCellRange(Grid, LocationA, LocationB, RadiusA, RadiusB, CellMin, CellMax);
+
+		TArray<uint32, TInlineAllocator<64>> Candidates;
+		for (int32 Z = CellMin.Z; Z <= CellMax.Z; ++Z)
 		{
-			IgnoreBoneNamePrefixCache = IgnoreBoneNamePrefix;
-			IgnoreBoneNamePrefixStrings.Reset(IgnoreBoneNamePrefix.Num());
-			for (const FName& BoneNamePrefix : IgnoreBoneNamePrefix)
+			for (int32 Y = CellMin.Y; Y <= CellMax.Y; ++Y)
 			{
-				if (!BoneNamePrefix.IsNone())
+				for (int32 X = CellMin.X; X <= CellMax.X; ++X)
 				{
-					IgnoreBoneNamePrefixStrings.Add(BoneNamePrefix.ToString());
+					Candidates.Append(Grid.GetCellEntries(Grid.GetCellIndex(FIntVector(X, Y, Z))));
 				}
 			}
 		}
+		// 複数セルに入ったキーは並べて隣り合わせ、2回目以降を飛ばす
+		Candidates.Sort();
 
-		for (const auto& Result : WorldCollisionHitsScratch)
+		for (int32 CandidateIndex = 0; CandidateIndex < Candidates.Num(); ++CandidateIndex)
 		{
-			if (!Result.bBlockingHit)
+			const uint32 Key = Candidates[CandidateIndex];
+			if (CandidateIndex > 0 && Candidates[CandidateIndex - 1] == Key)
 			{
 				continue;
 			}
 
-			// このヒットを無視すべきか？
-			IsIgnoreHit = false;
-			if (Result.Component == OwningComp && Result.BoneName != NAME_None)
+			const FVector PrevLocationA = LocationA;
+			const FVector PrevLocationB = LocationB;
+			PushOutBoneSegmentKey(LocationA, LocationB, RadiusA, RadiusB, bMovableA, bMovableB, Colliders, RelevanceA,
+			                      RelevanceB, Key);
+			if (LocationA == PrevLocationA && LocationB == PrevLocationB)
 			{
-				IsIgnoreHit = Result.BoneName == Bone.BoneRef.BoneName;
-				if (!IsIgnoreHit)
-				{
-					for (const auto& BoneRef : IgnoreBones)
-					{
-						if (BoneRef.BoneName == Result.BoneName)
-						{
-							IsIgnoreHit = true;
-							break;
-						}
-					}
-				}
-				// プレフィックス未設定（一般的なケース）ではToString自体を回避
-				if (!IsIgnoreHit && !IgnoreBoneNamePrefixStrings.IsEmpty())
-				{
-					const FString ResultBoneNameString = Result.BoneName.ToString();
-					for (const FString& BoneNamePrefix : IgnoreBoneNamePrefixStrings)
-					{
-						if (ResultBoneNameString.StartsWith(BoneNamePrefix))
-						{
-							IsIgnoreHit = true;
-							break;
-						}
-					}
-				}
+				continue;
 			}
 
-			// 無視対象でないブロッキングヒットを採用
-			if (!IsIgnoreHit)
+			FIntVector NewCellMin, NewCellMax;
+			GetBoneSegmentCellRange(Grid, LocationA, LocationB, RadiusA, RadiusB, NewCellMin, NewCellMax);
+			const bool bInside = NewCellMin.X >= CellMin.X && NewCellMin.Y >= CellMin.Y && NewCellMin.Z >= CellMin.Z &&
+				NewCellMax.X <= CellMax.X && NewCellMax.Y <= CellMax.Y && NewCellMax.Z <= CellMax.Z;
+			if (!bInside)
 			{
-				if (Result.bStartPenetrating)
-				{
-					Bone.Location =
-						ConvertSimulationSpaceLocation(Output, EKawaiiPhysicsSimulationSpace::WorldSpace,
-						                               SimulationSpace,
-						                               TraceEndLocationWS + Result.Normal * Result.PenetrationDepth);
-				}
-				else
-				{
-					Bone.Location =
-						ConvertSimulationSpaceLocation(Output, EKawaiiPhysicsSimulationSpace::WorldSpace,
-						                               SimulationSpace,
-						                               Result.Location);
-				}
-				break;
+				PushOutBoneSegmentFromKey(LocationA, LocationB, RadiusA, RadiusB, bMovableA, bMovableB, Colliders,
+				                          RelevanceA, RelevanceB, Key + 1);
+				return;
 			}
 		}
 	}
 }
 
-void FAnimNode_KawaiiPhysics::AdjustBySphereCollision(FKawaiiPhysicsModifyBone& Bone, TArray<FSphericalLimit>& Limits)
+void FAnimNode_KawaiiPhysics::AdjustBoneSegmentsByCollision(const TArray<int32>& Bones)
 {
-	for (auto& Sphere : Limits)
+	SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_BoneSegmentCollision);
+	using EFlags = FKawaiiPhysicsSolverState::EFlags;
+	FKawaiiPhysicsSolverState& State = SolverState;
+
+	for (const int32 i : Bones)
 	{
-		if (!Sphere.bEnable || Sphere.Radius <= 0.0f)
+		// inter-bone dummy は実ボーン間の区間の途中にあるので、区間は実ボーン（と末端 dummy）から実親へ張る
+		if (State.HasFlag(i, EFlags::Flag_InterBoneDummy))
 		{
 			continue;
 		}
-
-		if (Sphere.LimitType == ESphericalLimitType::Outer)
+		int32 ParentIndex = State.ParentIndex[i];
+		if (State.Location.IsValidIndex(ParentIndex) && State.HasFlag(ParentIndex, EFlags::Flag_InterBoneDummy))
 		{
-			const float LimitDistanceOuter = Sphere.Radius + Bone.PhysicsSettings.Radius;
-			const FVector Delta = Bone.Location - Sphere.Location;
-			const float DistSq = Delta.SizeSquared();
-			if (DistSq > LimitDistanceOuter * LimitDistanceOuter)
-			{
-				continue;
-			}
-
-			const float Dist = FMath::Sqrt(DistSq);
-			if (Dist > KINDA_SMALL_NUMBER)
-			{
-				Bone.Location += (LimitDistanceOuter - Dist) * (Delta / Dist);
-			}
+			ParentIndex = State.InterBoneRealParentIndex[ParentIndex];
 		}
-		else
+		if (!State.Location.IsValidIndex(ParentIndex))
 		{
-			// ボーン半径≥スフィア半径だと内半径(=スフィア半径−ボーン半径)が負になり反対側へ飛ぶ。Max(...,0)で中心にピン留めして回避。
-			const float LimitDistanceInner = FMath::Max(Sphere.Radius - Bone.PhysicsSettings.Radius, 0.0f);
-			const FVector Delta = Bone.Location - Sphere.Location;
-			const float DistSq = Delta.SizeSquared();
-			if (DistSq < LimitDistanceInner * LimitDistanceInner)
-			{
-				continue;
-			}
-
-			const float Dist = FMath::Sqrt(DistSq);
-			Bone.Location = Dist > KINDA_SMALL_NUMBER
-				                ? Sphere.Location + LimitDistanceInner * (Delta / Dist)
-				                : Sphere.Location;
+			continue;
 		}
+
+		// kinematic root / skip 中の親は動かさず、子だけで接触点を戻す
+		const bool bMovableParent = !State.HasFlag(ParentIndex, EFlags::Flag_SkipSimulate);
+		const bool bMovable = !State.HasFlag(i, EFlags::Flag_SkipSimulate);
+		FVector& ParentLocation = State.Location[ParentIndex];
+		FVector& Location = State.Location[i];
+		const float ParentRadius = State.Radius[ParentIndex];
+		const float Radius = State.Radius[i];
+		PushOutBoneSegment(ParentLocation, Location, ParentRadius, Radius, bMovableParent, bMovable, CompiledColliders,
+		                   CompiledColliders.MakeRelevanceFilter(ParentIndex), CompiledColliders.MakeRelevanceFilter(i));
+		PushOutBoneSegment(ParentLocation, Location, ParentRadius, Radius, bMovableParent, bMovable,
+		                   CompiledSharedColliders, FRelevanceFilter(), FRelevanceFilter());
 	}
 }
 
-void FAnimNode_KawaiiPhysics::PrepareCollisionShapeCaches()
+void FAnimNode_KawaiiPhysics::AdjustBoneConstraintEdgesByCollision(const TArray<int32>* ConstraintIndices)
 {
-	// キャッシュは operator= に意図的に載せていない（フィールド追加漏れで静かに陳腐化するため）。
-	// またコピー構築（Shared 経路の auto Converted = Limit 等）は古いキャッシュ値ごと運ぶため、
-	// AdjustBy* の前に必ず本関数で再計算することが正しさの前提。
-	auto UpdateEnabledCaches = [](auto& Limits)
+	SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_BoneConstraintEdgeCollision);
+	using EFlags = FKawaiiPhysicsSolverState::EFlags;
+	FKawaiiPhysicsSolverState& State = SolverState;
+
+	auto AdjustEdge = [&](const FModifyBoneConstraint& Constraint)
 	{
-		for (auto& Limit : Limits)
+		// bridge dummy と同じく、分割から除外された Constraint は辺としても判定しない
+		if (Constraint.bExcludeFromSubdivision)
 		{
-			if (Limit.bEnable)
-			{
-				Limit.UpdateRuntimeCache();
-			}
+			return;
+		}
+		const int32 I1 = Constraint.ModifyBoneIndex1;
+		const int32 I2 = Constraint.ModifyBoneIndex2;
+		if (!State.Location.IsValidIndex(I1) || !State.Location.IsValidIndex(I2))
+		{
+			return;
 		}
+		const bool bMovable1 = !State.HasFlag(I1, EFlags::Flag_SkipSimulate);
+		const bool bMovable2 = !State.HasFlag(I2, EFlags::Flag_SkipSimulate);
+		if (!bMovable1 && !bMovable2)
+		{
+			return;
+		}
+
+		FVector& Location1 = State.Location[I1];
+		FVector& Location2 = State.Location[I2];
+		const float Radius1 = State.Radius[I1];
+		const float Radius2 = State.Radius[I2];
+		PushOutBoneSegment(Location1, Location2, Radius1, Radius2, bMovable1, bMovable2, CompiledColliders,
+		                   CompiledColliders.MakeRelevanceFilter(I1), CompiledColliders.MakeRelevanceFilter(I2));
+		PushOutBoneSegment(Location1, Location2, Radius1, Radius2, bMovable1, bMovable2, CompiledSharedColliders,
+		                   FRelevanceFilter(), FRelevanceFilter());
 	};
 
-	UpdateEnabledCaches(CapsuleLimits);
-	UpdateEnabledCaches(CapsuleLimitsData);
-	UpdateEnabledCaches(SharedCapsuleLimits);
-	UpdateEnabledCaches(TaperedCapsuleLimits);
-	UpdateEnabledCaches(TaperedCapsuleLimitsData);
-	UpdateEnabledCaches(SharedTaperedCapsuleLimits);
-	UpdateEnabledCaches(BoxLimits);
-	UpdateEnabledCaches(BoxLimitsData);
-	UpdateEnabledCaches(SharedBoxLimits);
-	UpdateEnabledCaches(PlanarLimits);
-	UpdateEnabledCaches(PlanarLimitsData);
-	UpdateEnabledCaches(SharedPlanarLimits);
+	if (ConstraintIndices)
+	{
+		for (const int32 ConstraintIndex : *ConstraintIndices)
+		{
+			AdjustEdge(MergedBoneConstraints[ConstraintIndex]);
+		}
+	}
+	else
+	{
+		for (const FModifyBoneConstraint& Constraint : MergedBoneConstraints)
+		{
+			AdjustEdge(Constraint);
+		}
+	}
 }
 
 void FAnimNode_KawaiiPhysics::AdjustByCapsuleCollision(FKawaiiPhysicsModifyBone& Bone, TArray<FCapsuleLimit>& Limits)
+{
+	AdjustByCapsuleCollision(Bone.Location, Bone.PhysicsSettings.Radius, Limits);
+}
+
+void FAnimNode_KawaiiPhysics::AdjustByCapsuleCollision(FVector& Location, const float Radius,
+                                                       TArray<FCapsuleLimit>& Limits)
 {
 	for (auto& Capsule : Limits)
 	{
@@ -713,27 +1788,19 @@ void FAnimNode_KawaiiPhysics::AdjustByCapsuleCollision(FKawaiiPhysicsModifyBone&
 			continue;
 		}
 
-		FVector StartPoint = Capsule.CachedStartPoint;
-		FVector EndPoint = Capsule.CachedEndPoint;
-		const float DistSquared = FMath::PointDistToSegmentSquared(Bone.Location, StartPoint, EndPoint);
-
-		const float LimitDistance = Bone.PhysicsSettings.Radius + Capsule.Radius;
-		if (DistSquared < LimitDistance * LimitDistance)
-		{
-			FVector ClosestPoint = FMath::ClosestPointOnSegment(Bone.Location, StartPoint, EndPoint);
-			FVector PushDir = (Bone.Location - ClosestPoint).GetSafeNormal();
-			if (PushDir.IsNearlyZero())
-			{
-				// ボーンがカプセル軸上に乗ると押し出し方向が消えるため軸直交方向を代替に使う
-				PushDir = Capsule.CachedFallbackPushDir;
-			}
-			Bone.Location = ClosestPoint + PushDir * LimitDistance;
-		}
+		KawaiiPhysicsCollision::PushOutCapsule(Location, Radius, Capsule.CachedStartPoint, Capsule.CachedEndPoint,
+		                                       Capsule.Radius, Capsule.CachedFallbackPushDir);
 	}
 }
 
 void FAnimNode_KawaiiPhysics::AdjustByTaperedCapsuleCollision(FKawaiiPhysicsModifyBone& Bone,
                                                               TArray<FTaperedCapsuleLimit>& Limits)
+{
+	AdjustByTaperedCapsuleCollision(Bone.Location, Bone.PhysicsSettings.Radius, Limits);
+}
+
+void FAnimNode_KawaiiPhysics::AdjustByTaperedCapsuleCollision(FVector& Location, const float Radius,
+                                                              TArray<FTaperedCapsuleLimit>& Limits)
 {
 	for (auto& TaperedCapsule : Limits)
 	{
@@ -742,37 +1809,30 @@ void FAnimNode_KawaiiPhysics::AdjustByTaperedCapsuleCollision(FKawaiiPhysicsModi
 			continue;
 		}
 
-		FVector ClosestPoint = TaperedCapsule.Location;
-		// 負の半径が入り得るため、使用する半径は0以上に丸める。
-		float TaperedRadius = FMath::Max(FMath::Max(TaperedCapsule.Radius0, TaperedCapsule.Radius1), 0.0f);
-
 		if (TaperedCapsule.Length > KINDA_SMALL_NUMBER)
 		{
-			const FVector StartPoint = TaperedCapsule.CachedStartPoint;
-			const FVector Segment = TaperedCapsule.CachedSegment;
-			const float T = FMath::Clamp(FVector::DotProduct(Bone.Location - StartPoint, Segment) / TaperedCapsule.CachedSegmentSizeSq,
-			                             0.0f, 1.0f);
-			ClosestPoint = StartPoint + Segment * T;
-			// Chaos PhiWithNormal 準拠の近似（厳密な2球凸包SDFではない）
-			TaperedRadius = FMath::Max(FMath::Lerp(TaperedCapsule.Radius0, TaperedCapsule.Radius1, T), 0.0f);
+			KawaiiPhysicsCollision::PushOutTaperedCapsule(
+				Location, Radius, TaperedCapsule.CachedStartPoint, TaperedCapsule.CachedSegment,
+				TaperedCapsule.CachedSegmentSizeSq, TaperedCapsule.Radius0, TaperedCapsule.Radius1,
+				TaperedCapsule.CachedFallbackPushDir);
 		}
-
-		const float LimitDistance = Bone.PhysicsSettings.Radius + TaperedRadius;
-		const float DistSquared = (Bone.Location - ClosestPoint).SizeSquared();
-		if (DistSquared < LimitDistance * LimitDistance)
+		else
 		{
-			FVector PushDir = (Bone.Location - ClosestPoint).GetSafeNormal();
-			if (PushDir.IsNearlyZero())
-			{
-				// ボーンがカプセル軸上に乗ると押し出し方向が消えるため軸直交方向を代替に使う
-				PushDir = TaperedCapsule.CachedFallbackPushDir;
-			}
-			Bone.Location = ClosestPoint + PushDir * LimitDistance;
+			// 長さ0は中心・最大半径の球として扱う
+			const float MaxRadius = FMath::Max(FMath::Max(TaperedCapsule.Radius0, TaperedCapsule.Radius1), 0.0f);
+			KawaiiPhysicsCollision::PushOutTaperedCapsule(Location, Radius, TaperedCapsule.Location,
+			                                              FVector::ZeroVector, 1.0, MaxRadius, MaxRadius,
+			                                              TaperedCapsule.CachedFallbackPushDir);
 		}
 	}
 }
 
 void FAnimNode_KawaiiPhysics::AdjustByBoxCollision(FKawaiiPhysicsModifyBone& Bone, TArray<FBoxLimit>& Limits)
+{
+	AdjustByBoxCollision(Bone.Location, Bone.PhysicsSettings.Radius, Limits);
+}
+
+void FAnimNode_KawaiiPhysics::AdjustByBoxCollision(FVector& Location, const float Radius, TArray<FBoxLimit>& Limits)
 {
 	for (auto& Box : Limits)
 	{
@@ -781,59 +1841,17 @@ void FAnimNode_KawaiiPhysics::AdjustByBoxCollision(FKawaiiPhysicsModifyBone& Bon
 			continue;
 		}
 
-		FTransform BoxTransform = Box.CachedBoxTransform;
-		float SphereRadius = Bone.PhysicsSettings.Radius;
-
-		FVector LocalSphereCenter = BoxTransform.InverseTransformPosition(Bone.Location);
-		FBox LocalBox = Box.CachedLocalBox;
-		if (FMath::SphereAABBIntersection(FSphere(LocalSphereCenter, SphereRadius), LocalBox))
-		{
-			// Sphere の中心に最も近い Box 上の点を計算
-			FVector ClosestPoint = LocalSphereCenter;
-			ClosestPoint.X = FMath::Clamp(ClosestPoint.X, LocalBox.Min.X, LocalBox.Max.X);
-			ClosestPoint.Y = FMath::Clamp(ClosestPoint.Y, LocalBox.Min.Y, LocalBox.Max.Y);
-			ClosestPoint.Z = FMath::Clamp(ClosestPoint.Z, LocalBox.Min.Z, LocalBox.Max.Z);
-
-			FVector PushOutVector = LocalSphereCenter - ClosestPoint;
-			float Distance = PushOutVector.Size();
-
-			// ボーンスフィアが Box 内部に完全に埋没している場合は強制的に押し出す。
-			if (PushOutVector.IsNearlyZero())
-			{
-				PushOutVector = LocalSphereCenter;
-				Distance = SphereRadius;
-
-				// 中心一致時は半径方向が定まらず GetSafeNormal()==0 で動かなくなるため、最近面（最小貫通軸）を選ぶ。
-				if (PushOutVector.IsNearlyZero())
-				{
-					const FVector Penetration = Box.Extent - LocalSphereCenter.GetAbs();
-					if (Penetration.X <= Penetration.Y && Penetration.X <= Penetration.Z)
-					{
-						PushOutVector = FVector(LocalSphereCenter.X >= 0.0 ? 1.0 : -1.0, 0.0, 0.0);
-					}
-					else if (Penetration.Y <= Penetration.Z)
-					{
-						PushOutVector = FVector(0.0, LocalSphereCenter.Y >= 0.0 ? 1.0 : -1.0, 0.0);
-					}
-					else
-					{
-						PushOutVector = FVector(0.0, 0.0, LocalSphereCenter.Z >= 0.0 ? 1.0 : -1.0);
-					}
-				}
-			}
-
-			// 押し出し
-			if (Distance <= SphereRadius)
-			{
-				FVector PushOutDirection = PushOutVector.GetSafeNormal();
-				FVector NewLocalSphereCenter = ClosestPoint + PushOutDirection * SphereRadius;
-				Bone.Location = BoxTransform.TransformPosition(NewLocalSphereCenter);
-			}
-		}
+		KawaiiPhysicsCollision::PushOutBox(Location, Radius, Box.CachedBoxTransform, Box.Extent);
 	}
 }
 
 void FAnimNode_KawaiiPhysics::AdjustByPlanerCollision(FKawaiiPhysicsModifyBone& Bone, TArray<FPlanarLimit>& Limits)
+{
+	AdjustByPlanerCollision(Bone.Location, Bone.PrevLocation, Bone.PhysicsSettings.Radius, Limits);
+}
+
+void FAnimNode_KawaiiPhysics::AdjustByPlanerCollision(FVector& Location, const FVector& PrevLocation, const float Radius,
+                                                      TArray<FPlanarLimit>& Limits)
 {
 	for (auto& Planar : Limits)
 	{
@@ -842,15 +1860,7 @@ void FAnimNode_KawaiiPhysics::AdjustByPlanerCollision(FKawaiiPhysicsModifyBone&
 			continue;
 		}
 
-		FVector PointOnPlane = FVector::PointPlaneProject(Bone.Location, Planar.Plane);
-		const float DistSquared = (Bone.Location - PointOnPlane).SizeSquared();
-
-		FVector IntersectionPoint;
-		if (DistSquared < Bone.PhysicsSettings.Radius * Bone.PhysicsSettings.Radius ||
-			FMath::SegmentPlaneIntersection(Bone.Location, Bone.PrevLocation, Planar.Plane, IntersectionPoint))
-		{
-			Bone.Location = PointOnPlane + Planar.CachedNormal * Bone.PhysicsSettings.Radius;
-		}
+		KawaiiPhysicsCollision::PushOutPlane(Location, PrevLocation, Radius, Planar.Plane, Planar.CachedNormal);
 	}
 }
 
@@ -858,16 +1868,36 @@ void FAnimNode_KawaiiPhysics::AdjustByAngleLimit(
 	FKawaiiPhysicsModifyBone& Bone,
 	const FKawaiiPhysicsModifyBone& ParentBone)
 {
-	if (Bone.PhysicsSettings.LimitAngle == 0.0f)
+	AdjustByAngleLimit(Bone.Location, Bone.PoseLocation, ParentBone.Location, ParentBone.PoseLocation,
+	                   ParentBone.PoseRotation, Bone.PhysicsSettings.LimitAngle);
+}
+
+void FAnimNode_KawaiiPhysics::AdjustByAngleLimit(FVector& Location, const FVector& PoseLocation,
+                                                 const FVector& ParentLocation, const FVector& ParentPoseLocation,
+                                                 const FQuat& ParentPoseRotation, const float LimitAngle)
+{
+	if (LimitAngle == 0.0f)
+	{
+		return;
+	}
+
+	AdjustByAngleLimit(Location, ParentLocation, (PoseLocation - ParentPoseLocation).GetSafeNormal(),
+	                   ParentPoseRotation, LimitAngle);
+}
+
+void FAnimNode_KawaiiPhysics::AdjustByAngleLimit(FVector& Location, const FVector& ParentLocation,
+                                                 const FVector& PoseDir, const FQuat& ParentPoseRotation,
+                                                 const float LimitAngle)
+{
+	if (LimitAngle == 0.0f)
 	{
 		return;
 	}
 
-	FVector BoneDir = (Bone.Location - ParentBone.Location).GetSafeNormal();
-	const FVector PoseDir = (Bone.PoseLocation - ParentBone.PoseLocation).GetSafeNormal();
+	FVector BoneDir = (Location - ParentLocation).GetSafeNormal();
 	const FVector Axis = FVector::CrossProduct(PoseDir, BoneDir);
 	const float Angle = FMath::Atan2(Axis.Size(), FVector::DotProduct(PoseDir, BoneDir));
-	const float AngleOverLimit = FMath::RadiansToDegrees(Angle) - Bone.PhysicsSettings.LimitAngle;
+	const float AngleOverLimit = FMath::RadiansToDegrees(Angle) - LimitAngle;
 
 	if (AngleOverLimit > 0.0f)
 	{
@@ -875,15 +1905,21 @@ void FAnimNode_KawaiiPhysics::AdjustByAngleLimit(
 		if (RotationAxis.IsNearlyZero())
 		{
 			// PoseDirとBoneDirがほぼ反平行だと回転軸が消えるため、親の側方軸を代替に使う
-			RotationAxis = ParentBone.PoseRotation.GetAxisX();
+			RotationAxis = ParentPoseRotation.GetAxisX();
 		}
 		BoneDir = BoneDir.RotateAngleAxis(-AngleOverLimit, RotationAxis);
-		Bone.Location = BoneDir * (Bone.Location - ParentBone.Location).Size() + ParentBone.Location;
+		Location = BoneDir * (Location - ParentLocation).Size() + ParentLocation;
 	}
 }
 
 void FAnimNode_KawaiiPhysics::AdjustByPlanarConstraint(FKawaiiPhysicsModifyBone& Bone,
                                                        const FKawaiiPhysicsModifyBone& ParentBone)
+{
+	AdjustByPlanarConstraint(Bone.Location, ParentBone.Location, ParentBone.PoseRotation);
+}
+
+void FAnimNode_KawaiiPhysics::AdjustByPlanarConstraint(FVector& Location, const FVector& ParentLocation,
+                                                       const FQuat& ParentPoseRotation)
 {
 	if (PlanarConstraint != EPlanarConstraint::None)
 	{
@@ -891,19 +1927,19 @@ void FAnimNode_KawaiiPhysics::AdjustByPlanarConstraint(FKawaiiPhysicsModifyBone&
 		switch (PlanarConstraint)
 		{
 		case EPlanarConstraint::X:
-			Plane = FPlane(ParentBone.Location, ParentBone.PoseRotation.GetAxisX());
+			Plane = FPlane(ParentLocation, ParentPoseRotation.GetAxisX());
 			break;
 		case EPlanarConstraint::Y:
-			Plane = FPlane(ParentBone.Location, ParentBone.PoseRotation.GetAxisY());
+			Plane = FPlane(ParentLocation, ParentPoseRotation.GetAxisY());
 			break;
 		case EPlanarConstraint::Z:
-			Plane = FPlane(ParentBone.Location, ParentBone.PoseRotation.GetAxisZ());
+			Plane = FPlane(ParentLocation, ParentPoseRotation.GetAxisZ());
 			break;
 		case EPlanarConstraint::None:
 			break;
 		default: ;
 		}
-		Bone.Location = FVector::PointPlaneProject(Bone.Location, Plane);
+		Location = FVector::PointPlaneProject(Location, Plane);
 	}
 }
 
@@ -918,58 +1954,83 @@ static constexpr float XPBDComplianceValues[] =
 	0.0001f, // 1.0  x 10^(-3) (M^2/N) Fat
 };
 
-void FAnimNode_KawaiiPhysics::AdjustByBoneConstraints()
+void FAnimNode_KawaiiPhysics::AdjustByBoneConstraints(TArray<FVector>& Locations)
 {
 	SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_AdjustByBoneConstraint);
 
 	for (FModifyBoneConstraint& BoneConstraint : MergedBoneConstraints)
 	{
-		// IsValid()はLength>0のみ確認するため、indexの範囲も明示的に検証（堅牢化）
-		if (!BoneConstraint.IsValid() ||
-			!ModifyBones.IsValidIndex(BoneConstraint.ModifyBoneIndex1) ||
-			!ModifyBones.IsValidIndex(BoneConstraint.ModifyBoneIndex2))
-		{
-			continue;
-		}
+		AdjustByBoneConstraint(BoneConstraint, Locations);
+	}
+}
 
-		FKawaiiPhysicsModifyBone& ModifyBone1 = ModifyBones[BoneConstraint.ModifyBoneIndex1];
-		FKawaiiPhysicsModifyBone& ModifyBone2 = ModifyBones[BoneConstraint.ModifyBoneIndex2];
-		EXPBDComplianceType ComplianceType = BoneConstraint.bOverrideCompliance
-			                                     ? BoneConstraint.ComplianceType
-			                                     : BoneConstraintGlobalComplianceType;
+void FAnimNode_KawaiiPhysics::AdjustByBoneConstraints(TArray<FVector>& Locations,
+                                                      const TArray<int32>& ConstraintIndices)
+{
+	SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_AdjustByBoneConstraint);
 
-		FVector Delta = ModifyBone2.Location - ModifyBone1.Location;
-		float DeltaLength = Delta.Size();
-		if (DeltaLength <= 0.0f)
-		{
-			continue;
-		}
+	for (const int32 ConstraintIndex : ConstraintIndices)
+	{
+		AdjustByBoneConstraint(MergedBoneConstraints[ConstraintIndex], Locations);
+	}
+}
 
-		// PBD
-		// Delta *= (DeltaLength - BoneConstraint.Length) / DeltaLength * 0.5f;
-		// ModifyBone1.Location += Delta * Stiffness;
-		// ModifyBone2.Location -= Delta * Stiffness;
+void FAnimNode_KawaiiPhysics::AdjustByBoneConstraint(FModifyBoneConstraint& BoneConstraint,
+                                                     TArray<FVector>& Locations)
+{
+	// IsValid()はLength>0のみ確認するため、indexの範囲も明示的に検証（堅牢化）
+	if (!BoneConstraint.IsValid() ||
+		!Locations.IsValidIndex(BoneConstraint.ModifyBoneIndex1) ||
+		!Locations.IsValidIndex(BoneConstraint.ModifyBoneIndex2))
+	{
+		return;
+	}
 
-		// XBPD
-		float Constraint = DeltaLength - BoneConstraint.Length;
-		// enum 値の破損や将来の追加に備え、インデックスを配列範囲内へクランプ。
-		const int32 ComplianceIndex = FMath::Clamp(static_cast<int32>(ComplianceType), 0,
-		                                           static_cast<int32>(UE_ARRAY_COUNT(XPBDComplianceValues)) - 1);
-		float Compliance = XPBDComplianceValues[ComplianceIndex];
-		// 極小 StepDt で compliance が発散しないようガード。
-		const float StepDt = FMath::Max(GetStepDeltaTime(), KINDA_SMALL_NUMBER);
-		Compliance /= StepDt * StepDt;
-		float DeltaLambda = (Constraint - Compliance * BoneConstraint.Lambda) / (2 + Compliance); // 2 = SumMass
-		Delta = (Delta / DeltaLength) * DeltaLambda;
+	FVector& Location1 = Locations[BoneConstraint.ModifyBoneIndex1];
+	FVector& Location2 = Locations[BoneConstraint.ModifyBoneIndex2];
 
-		ModifyBone1.Location += Delta;
-		ModifyBone2.Location -= Delta;
-		BoneConstraint.Lambda += DeltaLambda;
+	FVector Delta = Location2 - Location1;
+	float DeltaLength = Delta.Size();
+	if (DeltaLength <= 0.0f)
+	{
+		return;
 	}
+
+	// PBD
+	// Delta *= (DeltaLength - BoneConstraint.Length) / DeltaLength * 0.5f;
+	// ModifyBone1.Location += Delta * Stiffness;
+	// ModifyBone2.Location -= Delta * Stiffness;
+
+	// XBPD
+	const float DeltaLambda = ComputeBoneConstraintDeltaLambda(BoneConstraint, DeltaLength);
+	Delta = (Delta / DeltaLength) * DeltaLambda;
+
+	Location1 += Delta;
+	Location2 -= Delta;
+	BoneConstraint.Lambda += DeltaLambda;
+}
+
+float FAnimNode_KawaiiPhysics::ComputeBoneConstraintDeltaLambda(const FModifyBoneConstraint& BoneConstraint,
+                                                                const float DeltaLength) const
+{
+	const EXPBDComplianceType ComplianceType = BoneConstraint.bOverrideCompliance
+		                                           ? BoneConstraint.ComplianceType
+		                                           : BoneConstraintGlobalComplianceType;
+
+	float Constraint = DeltaLength - BoneConstraint.Length;
+	// enum 値の破損や将来の追加に備え、インデックスを配列範囲内へクランプ。
+	const int32 ComplianceIndex = FMath::Clamp(static_cast<int32>(ComplianceType), 0,
+	                                           static_cast<int32>(UE_ARRAY_COUNT(XPBDComplianceValues)) - 1);
+	float Compliance = XPBDComplianceValues[ComplianceIndex];
+	// 極小 StepDt で compliance が発散しないようガード。
+	const float StepDt = FMath::Max(GetStepDeltaTime(), KINDA_SMALL_NUMBER);
+	Compliance /= StepDt * StepDt;
+	return (Constraint - Compliance * BoneConstraint.Lambda) / (2 + Compliance); // 2 = SumMass
 }
 
 void FAnimNode_KawaiiPhysics::InitBoneConstraints()
 {
+	++BoneConstraintGeneration;
 	MergedBoneConstraints = BoneConstraints;
 	MergedBoneConstraints.Append(BoneConstraintsData);
 
@@ -1004,24 +2065,25 @@ void FAnimNode_KawaiiPhysics::InitBoneConstraints()
 		if (bAutoAddChildDummyBoneConstraint)
 		{
 			// tip dummy constraint（inter-bone dummyを除外）
-			const int32 ChildDummyBoneIndex1 = ModifyBones[Constraint.ModifyBoneIndex1].ChildIndices.IndexOfByPredicate(
-				[&](int32 Index)
-				{
-					return Index >= 0 && ModifyBones[Index].bDummy && !ModifyBones[Index].bInterBoneDummy;
-				});
-			const int32 ChildDummyBoneIndex2 = ModifyBones[Constraint.ModifyBoneIndex2].ChildIndices.IndexOfByPredicate(
-				[&](int32 Index)
+			auto FindChildTipDummy = [&](const int32 BoneIdx) -> int32
+			{
+				for (const int32 ChildIdx : BoneTopology.GetChildren(BoneIdx))
 				{
-					return Index >= 0 && ModifyBones[Index].bDummy && !ModifyBones[Index].bInterBoneDummy;
-				});
+					if (ModifyBones[ChildIdx].bDummy && !ModifyBones[ChildIdx].bInterBoneDummy)
+					{
+						return ChildIdx;
+					}
+				}
+				return INDEX_NONE;
+			};
+			const int32 ChildDummyBoneIndex1 = FindChildTipDummy(Constraint.ModifyBoneIndex1);
+			const int32 ChildDummyBoneIndex2 = FindChildTipDummy(Constraint.ModifyBoneIndex2);
 
 			if (ChildDummyBoneIndex1 >= 0 && ChildDummyBoneIndex2 >= 0)
 			{
 				FModifyBoneConstraint NewDummyBoneConstraint;
-				NewDummyBoneConstraint.ModifyBoneIndex1 = ModifyBones[Constraint.ModifyBoneIndex1].ChildIndices[
-					ChildDummyBoneIndex1];
-				NewDummyBoneConstraint.ModifyBoneIndex2 = ModifyBones[Constraint.ModifyBoneIndex2].ChildIndices[
-					ChildDummyBoneIndex2];
+				NewDummyBoneConstraint.ModifyBoneIndex1 = ChildDummyBoneIndex1;
+				NewDummyBoneConstraint.ModifyBoneIndex2 = ChildDummyBoneIndex2;
 				NewDummyBoneConstraint.Length =
 					(ModifyBones[NewDummyBoneConstraint.ModifyBoneIndex1].Location - ModifyBones[NewDummyBoneConstraint.
 						ModifyBoneIndex2].Location).
@@ -1036,18 +2098,18 @@ void FAnimNode_KawaiiPhysics::InitBoneConstraints()
 			auto CollectInterBoneDummies = [&](int32 BoneIdx) -> TArray<int32>
 			{
 				TArray<int32> Dummies;
-				for (const int32 ChildIdx : ModifyBones[BoneIdx].ChildIndices)
+				for (const int32 ChildIdx : BoneTopology.GetChildren(BoneIdx))
 				{
-					if (ChildIdx >= 0 && ModifyBones[ChildIdx].bInterBoneDummy)
+					if (ModifyBones[ChildIdx].bInterBoneDummy)
 					{
 						int32 Idx = ChildIdx;
 						while (Idx >= 0 && ModifyBones[Idx].bInterBoneDummy)
 						{
 							Dummies.Add(Idx);
 							int32 NextIdx = -1;
-							for (const int32 CI : ModifyBones[Idx].ChildIndices)
+							for (const int32 CI : BoneTopology.GetChildren(Idx))
 							{
-								if (CI >= 0 && ModifyBones[CI].bInterBoneDummy)
+								if (ModifyBones[CI].bInterBoneDummy)
 								{
 									NextIdx = CI;
 									break;
@@ -1060,9 +2122,9 @@ void FAnimNode_KawaiiPhysics::InitBoneConstraints()
 						if (Dummies.Num() > 0)
 						{
 							const int32 LastDummy = Dummies.Last();
-							for (const int32 CI : ModifyBones[LastDummy].ChildIndices)
+							for (const int32 CI : BoneTopology.GetChildren(LastDummy))
 							{
-								if (CI >= 0 && ModifyBones[CI].bDummy && !ModifyBones[CI].bInterBoneDummy)
+								if (ModifyBones[CI].bDummy && !ModifyBones[CI].bInterBoneDummy)
 								{
 									Dummies.Add(CI);
 									break;
@@ -1098,17 +2160,22 @@ void FAnimNode_KawaiiPhysics::InitBoneConstraints()
 
 	// 横方向Constraintに沿って bridge dummy（コリジョンセンサー）を挿入。元Constraintは温存し、反映は毎フレームの直接変位転送（SimulateModifyBones）が行う。
 	InsertBridgeDummiesForConstraints();
+
+	// ボーンを共有しない Constraint ごとに色分けする。配列は元の並びのまま残し、色順は BoneConstraintColors の index 列だけが持つ
+	BoneConstraintColors.Build(MergedBoneConstraints, ModifyBones.Num(), BoneConstraintGeneration);
 }
 
 void FAnimNode_KawaiiPhysics::InsertBridgeDummiesForConstraints()
 {
-	if (BoneConstraintSubdivisionCount <= 0)
+	// 辺コリジョンは Constraint の辺そのものを判定するので bridge dummy を置かない
+	if (BoneConstraintSubdivisionCount <= 0 || bBoneConstraintEdgeCollision)
 	{
 		return;
 	}
 
 
 	const FRichCurve* RadiusCurve = RadiusCurveData.GetRichCurveConst();
+	bool bAddedBridgeDummy = false;
 
 	// 元のMergedBoneConstraintsは置換せず温存（列間隔の剛性を維持）。bridge dummy を ModifyBones に追加するだけ。
 	// MergedBoneConstraints を変更しないため、ModifyBones が拡張されても range-for は安全。
@@ -1177,8 +2244,14 @@ void FAnimNode_KawaiiPhysics::InsertBridgeDummiesForConstraints()
 
 			const int32 Idx = ModifyBones.Add(BridgeDummy);
 			ModifyBones[Idx].Index = Idx;
+			bAddedBridgeDummy = true;
 		}
 	}
+
+	if (bAddedBridgeDummy)
+	{
+		++BoneLayoutGeneration;
+	}
 }
 
 // -------------------------------------------------------------------
@@ -45,6 +45,15 @@ DECLARE_CYCLE_STAT_EXTERN(TEXT("KawaiiPhysics_BridgeDummy"), STAT_KawaiiPhysics_
 // 角度制限 + 平面制約 + ボーン長復元のO(N)ループ（従来SimulateModifyBonesに埋没） / Angle limit + planar constraint + bone-length restore O(N) loop (was hidden in SimulateModifyBones)
 DECLARE_CYCLE_STAT_EXTERN(TEXT("KawaiiPhysics_AdjustByLimitsAndLength"), STAT_KawaiiPhysics_AdjustByLimitsAndLength, STATGROUP_Anim, KAWAIIPHYSICS_API);
 
+// SoAソルバ状態と ModifyBones 間の同期（Gather/Scatter）コスト / Sync cost between the SoA solver state and ModifyBones (gather/scatter)
+DECLARE_CYCLE_STAT_EXTERN(TEXT("KawaiiPhysics_SolverStateSync"), STAT_KawaiiPhysics_SolverStateSync, STATGROUP_Anim, KAWAIIPHYSICS_API);
+// 独立した root チェーン（アイランド）の並列ソルブ / Parallel solve of independent root chains (islands)
+DECLARE_CYCLE_STAT_EXTERN(TEXT("KawaiiPhysics_ParallelIslands"), STAT_KawaiiPhysics_ParallelIslands, STATGROUP_Anim, KAWAIIPHYSICS_API);
+// パイプライン実行のタスク完了待ち（評価のクリティカルパスに残った分） / Wait for the pipelined task (what remains on the evaluation critical path)
+DECLARE_CYCLE_STAT_EXTERN(TEXT("KawaiiPhysics_WaitPipelinedSimulation"), STAT_KawaiiPhysics_WaitPipelinedSimulation, STATGROUP_Anim, KAWAIIPHYSICS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("KawaiiPhysics_NumBoneIslands"), STAT_KawaiiPhysics_NumBoneIslands, STATGROUP_Anim, KAWAIIPHYSICS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("KawaiiPhysics_CompileColliders"), STAT_KawaiiPhysics_CompileColliders, STATGROUP_Anim, KAWAIIPHYSICS_API);
+
 // 入力規模カウンタ（負荷=N×L等の相関用） / Input-size counters (correlate load = N×L, etc.)
 DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("KawaiiPhysics_NumSphereColliders"), STAT_KawaiiPhysics_NumSphereColliders, STATGROUP_Anim, KAWAIIPHYSICS_API);
 DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("KawaiiPhysics_NumCapsuleColliders"), STAT_KawaiiPhysics_NumCapsuleColliders, STATGROUP_Anim, KAWAIIPHYSICS_API);
@@ -55,6 +64,19 @@ DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("KawaiiPhysics_NumSharedColliders"), STAT
 DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("KawaiiPhysics_NumMergedBoneConstraints"), STAT_KawaiiPhysics_NumMergedBoneConstraints, STATGROUP_Anim, KAWAIIPHYSICS_API);
 // 毎フレームに発行したワールドコリジョンのスイープ回数（anim threadからの同期トレース） / World-collision sweeps issued per frame (sync traces from the anim thread)
 DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("KawaiiPhysics_NumWorldCollisionChecks"), STAT_KawaiiPhysics_NumWorldCollisionChecks, STATGROUP_Anim, KAWAIIPHYSICS_API);
+// Broadphase の重なり判定で集めた単純コリジョン形状の数 / Simple collision shapes gathered by the Broadphase overlap query
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("KawaiiPhysics_NumWorldCollisionShapes"), STAT_KawaiiPhysics_NumWorldCollisionShapes, STATGROUP_Anim, KAWAIIPHYSICS_API);
+// 1ステップのコリジョン対象ボーン×コライダーの組数（チェーン AABB でのカリング前 / 後） / Colliding bone x collider pairs per step (before / after culling against the chain AABB)
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("KawaiiPhysics_NumColliderPairsBeforeCulling"), STAT_KawaiiPhysics_NumColliderPairsBeforeCulling, STATGROUP_Anim, KAWAIIPHYSICS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("KawaiiPhysics_NumColliderPairsAfterCulling"), STAT_KawaiiPhysics_NumColliderPairsAfterCulling, STATGROUP_Anim, KAWAIIPHYSICS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("KawaiiPhysics_NumColliderPairsMasked"), STAT_KawaiiPhysics_NumColliderPairsMasked, STATGROUP_Anim, KAWAIIPHYSICS_API);
+// ボーン区間（親→子）のコリジョン / Bone segment (parent -> child) collision
+DECLARE_CYCLE_STAT_EXTERN(TEXT("KawaiiPhysics_BoneSegmentCollision"), STAT_KawaiiPhysics_BoneSegmentCollision, STATGROUP_Anim, KAWAIIPHYSICS_API);
+// BoneConstraint の辺のコリジョン / Bone constraint edge collision
+DECLARE_CYCLE_STAT_EXTERN(TEXT("KawaiiPhysics_BoneConstraintEdgeCollision"), STAT_KawaiiPhysics_BoneConstraintEdgeCollision, STATGROUP_Anim, KAWAIIPHYSICS_API);
+// 静止判定でシミュレーションを止めている / 動かしているノード数 / Nodes asleep (simulation skipped) / awake
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("KawaiiPhysics_NumSleepingNodes"), STAT_KawaiiPhysics_NumSleepingNodes, STATGROUP_Anim, KAWAIIPHYSICS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("KawaiiPhysics_NumAwakeNodes"), STAT_KawaiiPhysics_NumAwakeNodes, STATGROUP_Anim, KAWAIIPHYSICS_API);
 
 // ModifyBones / MergedBoneConstraints のアロケーション量（subdivision/bridge dummyによる膨張の可視化） / Allocated size of ModifyBones / MergedBoneConstraints (visualize growth from subdivision/bridge dummies)
 DECLARE_MEMORY_STAT_EXTERN(TEXT("KawaiiPhysics_ModifyBonesMemory"), STAT_KawaiiPhysics_ModifyBonesMemory, STATGROUP_Anim, KAWAIIPHYSICS_API);
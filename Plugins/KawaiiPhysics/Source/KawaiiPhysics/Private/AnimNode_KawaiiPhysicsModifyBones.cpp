@@ -34,6 +34,9 @@
 
 void FAnimNode_KawaiiPhysics::InitializeBoneReferences(const FBoneContainer& RequiredBones)
 {
+	// 保留中のソルバはボーン分類を作り直す前に済ませる
+	RunBatchedSimulation();
+
 	auto Initialize = [&RequiredBones](auto& Targets)
 	{
 		for (auto& Target : Targets)
@@ -52,6 +55,9 @@ void FAnimNode_KawaiiPhysics::InitializeBoneReferences(const FBoneContainer& Req
 	{
 		Bone.BoneRef.Initialize(RequiredBones);
 	}
+	// BoneRef の解決結果が skip 分類と出力スロットに効くため作り直させる
+	BoneCategories.Reset();
+	OutputSlots.Reset();
 
 	SimulationBaseBone.Initialize(RequiredBones);
 
@@ -80,6 +86,9 @@ void FAnimNode_KawaiiPhysics::InitModifyBones(FComponentSpacePoseContext& Output
 {
 	SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_InitModifyBones);
 
+	// ボーン構成から作るキャッシュ（分類 / 出力スロット）を、ボーン数が同じでも作り直させる
+	++BoneLayoutGeneration;
+
 	// https://github.com/pafuhana1213/KawaiiPhysics/issues/174
 	// SkeletonAssetがnull（クック失敗/参照切れ）の場合はBoneContainerのRefSkeletonにフォールバックしてクラッシュを避ける
 	const USkeleton* SkeletonAsset =
@@ -96,8 +105,12 @@ void FAnimNode_KawaiiPhysics::InitModifyBones(FComponentSpacePoseContext& Output
 		              InExcludeBones);
 		if (Bones.Num() > 0)
 		{
+			// 親は常に子より小さい index なので、index 順に1回走査すれば親の LengthFromRoot は確定済み
 			float TotalBoneLength = 0.0f;
-			CalcBoneLength(Bones[0], Bones, BoneContainer.GetRefPoseArray(), TotalBoneLength);
+			for (FKawaiiPhysicsModifyBone& Bone : Bones)
+			{
+				CalcBoneLength(Bone, Bones, BoneContainer.GetRefPoseArray(), TotalBoneLength);
+			}
 
 			for (auto& Bone : Bones)
 			{
@@ -111,10 +124,6 @@ void FAnimNode_KawaiiPhysics::InitModifyBones(FComponentSpacePoseContext& Output
 				{
 					Bone.ParentIndex += ModifyBones.Num();
 				}
-				for (auto& ChildIndex : Bone.ChildIndices)
-				{
-					ChildIndex += ModifyBones.Num();
-				}
 				if (Bone.InterBoneRealParentIndex >= 0)
 				{
 					Bone.InterBoneRealParentIndex += ModifyBones.Num();
@@ -137,6 +146,38 @@ void FAnimNode_KawaiiPhysics::InitModifyBones(FComponentSpacePoseContext& Output
 			             ? AdditionalRootBone.OverrideExcludeBones
 			             : ExcludeBones);
 	}
+
+	// 子の隣接リストは ParentIndex が確定してから一括で作る（後から追加される bridge dummy は親子関係を持たない）
+	BoneTopology.Build(ModifyBones);
+}
+
+void FAnimNode_KawaiiPhysics::BuildBoneCategories()
+{
+	for (FKawaiiPhysicsModifyBone& Bone : ModifyBones)
+	{
+		// bridge dummyは縦親(ParentIndex<0)を持たないが、コリジョン代理として非skipにする
+		// （LOD による skip はフレーム毎に SimulateOnce が判定し直す）
+		if (Bone.bBridgeDummy)
+		{
+			Bone.bSkipSimulate = false;
+			continue;
+		}
+
+		// LOD で無効な実ボーン / root（kinematic。実ポーズ追従は SimulateOnce でステップ毎に行う）
+		Bone.bSkipSimulate = (Bone.BoneRef.BoneIndex < 0 && !Bone.bDummy) || Bone.ParentIndex < 0;
+	}
+
+	BoneCategories.Build(ModifyBones, BoneLayoutGeneration);
+
+	// アイランドは分類リストを振り分けて作るので、分類を作り直したら次の PrepareSimulateModifyBones で作り直させる
+	BoneIslands.Reset();
+}
+
+void FAnimNode_KawaiiPhysics::BuildBoneIslands()
+{
+	BoneIslands.Build(ModifyBones, MergedBoneConstraints, BoneCategories,
+	                  CVarAnimNodeKawaiiPhysicsParallelIslandMinBones.GetValueOnAnyThread());
+	SET_DWORD_STAT(STAT_KawaiiPhysics_NumBoneIslands, BoneIslands.Num());
 }
 
 int32 FAnimNode_KawaiiPhysics::AddModifyBone(TArray<FKawaiiPhysicsModifyBone>& InModifyBones,
@@ -197,7 +238,6 @@ int32 FAnimNode_KawaiiPhysics::AddModifyBone(TArray<FKawaiiPhysicsModifyBone>& I
 			                                           InExcludeBones);
 			if (ChildModifyBoneIndex >= 0)
 			{
-				InModifyBones[EffectiveParentIndex].ChildIndices.Add(ChildModifyBoneIndex);
 				InModifyBones[ChildModifyBoneIndex].ParentIndex = EffectiveParentIndex;
 				AddedChildBone = true;
 
@@ -205,7 +245,7 @@ int32 FAnimNode_KawaiiPhysics::AddModifyBone(TArray<FKawaiiPhysicsModifyBone>& I
 			}
 			else if (InsertedInterBoneDummyIndices.Num() > 0)
 			{
-				RollbackInterBoneDummyBones(InModifyBones, ModifyBoneIndex, InsertedInterBoneDummyIndices);
+				RollbackInterBoneDummyBones(InModifyBones, InsertedInterBoneDummyIndices);
 			}
 		}
 	}
@@ -240,7 +280,6 @@ int32 FAnimNode_KawaiiPhysics::AddModifyBone(TArray<FKawaiiPhysicsModifyBone>& I
 		}
 
 		int32 DummyBoneIndex = InModifyBones.Add(DummyModifyBone);
-		InModifyBones[EffectiveParentIndex].ChildIndices.Add(DummyBoneIndex);
 		InModifyBones[DummyBoneIndex].Index = DummyBoneIndex;
 		InModifyBones[DummyBoneIndex].ParentIndex = EffectiveParentIndex;
 
@@ -367,7 +406,6 @@ int32 FAnimNode_KawaiiPhysics::InsertInterBoneDummyBonesCore(TArray<FKawaiiPhysi
 
 		const int32 DummyIdx = InModifyBones.Add(InterDummy);
 		InModifyBones[DummyIdx].Index = DummyIdx;
-		InModifyBones[EffectiveParentIndex].ChildIndices.Add(DummyIdx);
 		InModifyBones[DummyIdx].ParentIndex = EffectiveParentIndex;
 		EffectiveParentIndex = DummyIdx;
 		OutInsertedInterBoneDummyIndices.Add(DummyIdx);
@@ -388,11 +426,11 @@ void FAnimNode_KawaiiPhysics::FinalizeInterBoneDummyBones(TArray<FKawaiiPhysicsM
 }
 
 void FAnimNode_KawaiiPhysics::RollbackInterBoneDummyBones(TArray<FKawaiiPhysicsModifyBone>& InModifyBones,
-                                                          const int32 ParentModifyBoneIndex,
                                                           const TArray<int32>& InsertedInterBoneDummyIndices) const
 {
 	// 子ボーンが無効（Excluded等） → 挿入済みダミーをクリーンアップ
 	// ダミーは配列末尾に連続しているため逆順で安全に削除可能
+	// （子の隣接リストは ParentIndex から後で作るため、削除したダミーは親の子にも現れない）
 	for (int32 k = InsertedInterBoneDummyIndices.Num() - 1; k >= 0; k--)
 	{
 		const int32 DummyIdx = InsertedInterBoneDummyIndices[k];
@@ -401,10 +439,6 @@ void FAnimNode_KawaiiPhysics::RollbackInterBoneDummyBones(TArray<FKawaiiPhysicsM
 			InModifyBones.RemoveAt(DummyIdx);
 		}
 	}
-	InModifyBones[ParentModifyBoneIndex].ChildIndices.RemoveAll([&](int32 Idx)
-	{
-		return InsertedInterBoneDummyIndices.Contains(Idx);
-	});
 }
 
 int32 FAnimNode_KawaiiPhysics::CollectChildBones(const FReferenceSkeleton& RefSkeleton, const int32 ParentBoneIndex,
@@ -456,11 +490,6 @@ void FAnimNode_KawaiiPhysics::CalcBoneLength(FKawaiiPhysicsModifyBone& Bone,
 
 		TotalBoneLength = FMath::Max(TotalBoneLength, Bone.LengthFromRoot);
 	}
-
-	for (const int32 ChildIndex : Bone.ChildIndices)
-	{
-		CalcBoneLength(InModifyBones[ChildIndex], InModifyBones, RefBonePose, TotalBoneLength);
-	}
 }
 
 
@@ -0,0 +1,532 @@
+﻿// Copyright 2019-2026 pafuhana1213. All Rights Reserved.
+
+#include "AnimNode_KawaiiPhysics.h"
+
+#include "Async/ParallelFor.h"
+#include "Math/VectorRegister.h"
+
+#include "AnimNode_KawaiiPhysicsInternal.h"
+#include "KawaiiPhysicsCollisionKernels.h"
+
+// SolverState 上で動く SIMD カーネル。
+// 位置は LWC の double のまま、4ボーン分の X/Y/Z をそれぞれ1レジスタへ転置して処理する。
+// 演算列はスカラー経路（ComputeVerletStepVelocity ～ ApplyWorldMoveFollowNonBaseBone）と同じ順序に揃え、
+// 剛性係数もスカラー経路と同じ SolverState.StiffnessFactor（UpdateStepInvariants で評価毎に1回）を使う。
+// 後半はコリジョンのナローフェーズ。4コライダー分を同じく転置したブロックで保守的に判定し、押し出しの確定は
+// KawaiiPhysicsCollisionKernels.h のスカラー関数に任せる（こちらはスカラー経路とビット一致）。
+// 最後は BoneConstraint の色ごとのバッチ。同色の4本はボーンを共有しないので、レーン毎に独立に解いて書き戻せる。
+
+namespace
+{
+	struct FVectorLanes4
+	{
+		VectorRegister4Double X;
+		VectorRegister4Double Y;
+		VectorRegister4Double Z;
+	};
+
+	FORCEINLINE VectorRegister4Double SplatDouble(const double Value)
+	{
+		return MakeVectorRegisterDouble(Value, Value, Value, Value);
+	}
+
+	FORCEINLINE FVectorLanes4 SplatLanes(const FVector& V)
+	{
+		return {SplatDouble(V.X), SplatDouble(V.Y), SplatDouble(V.Z)};
+	}
+
+	FORCEINLINE FVectorLanes4 LoadLanes(const FVector* Stream, const int32 (&Indices)[4])
+	{
+		const FVector& A = Stream[Indices[0]];
+		const FVector& B = Stream[Indices[1]];
+		const FVector& C = Stream[Indices[2]];
+		const FVector& D = Stream[Indices[3]];
+		return {
+			MakeVectorRegisterDouble(A.X, B.X, C.X, D.X),
+			MakeVectorRegisterDouble(A.Y, B.Y, C.Y, D.Y),
+			MakeVectorRegisterDouble(A.Z, B.Z, C.Z, D.Z)
+		};
+	}
+
+	FORCEINLINE void StoreLanes(const FVectorLanes4& Lanes, FVector* Stream, const int32 (&Indices)[4],
+	                            const int32 NumLanes)
+	{
+		double X[4];
+		double Y[4];
+		double Z[4];
+		VectorStore(Lanes.X, X);
+		VectorStore(Lanes.Y, Y);
+		VectorStore(Lanes.Z, Z);
+		for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+		{
+			Stream[Indices[Lane]] = FVector(X[Lane], Y[Lane], Z[Lane]);
+		}
+	}
+
+	// Mask の立っているレーンだけ書き戻す
+	FORCEINLINE void StoreMaskedLanes(const FVectorLanes4& Lanes, FVector* Stream, const int32 (&Indices)[4],
+	                                  const int32 Mask)
+	{
+		double X[4];
+		double Y[4];
+		double Z[4];
+		VectorStore(Lanes.X, X);
+		VectorStore(Lanes.Y, Y);
+		VectorStore(Lanes.Z, Z);
+		for (int32 Lane = 0; Lane < 4; ++Lane)
+		{
+			if (Mask & (1 << Lane))
+			{
+				Stream[Indices[Lane]] = FVector(X[Lane], Y[Lane], Z[Lane]);
+			}
+		}
+	}
+
+	FORCEINLINE FVectorLanes4 Add(const FVectorLanes4& A, const FVectorLanes4& B)
+	{
+		return {VectorAdd(A.X, B.X), VectorAdd(A.Y, B.Y), VectorAdd(A.Z, B.Z)};
+	}
+
+	FORCEINLINE FVectorLanes4 Sub(const FVectorLanes4& A, const FVectorLanes4& B)
+	{
+		return {VectorSubtract(A.X, B.X), VectorSubtract(A.Y, B.Y), VectorSubtract(A.Z, B.Z)};
+	}
+
+	FORCEINLINE FVectorLanes4 Mul(const FVectorLanes4& A, const VectorRegister4Double& S)
+	{
+		return {VectorMultiply(A.X, S), VectorMultiply(A.Y, S), VectorMultiply(A.Z, S)};
+	}
+
+	// FVector::CrossProduct と同じ項の順序
+	FORCEINLINE FVectorLanes4 Cross(const FVectorLanes4& A, const FVectorLanes4& B)
+	{
+		return {
+			VectorSubtract(VectorMultiply(A.Y, B.Z), VectorMultiply(A.Z, B.Y)),
+			VectorSubtract(VectorMultiply(A.Z, B.X), VectorMultiply(A.X, B.Z)),
+			VectorSubtract(VectorMultiply(A.X, B.Y), VectorMultiply(A.Y, B.X))
+		};
+	}
+
+	// FQuat::RotateVector と同じ式: V' = V + W*TT + (Q x TT), TT = 2*(Q x V)
+	FORCEINLINE FVectorLanes4 RotateLanes(const FVectorLanes4& V, const FVectorLanes4& Q, const VectorRegister4Double& W,
+	                                      const VectorRegister4Double& Two)
+	{
+		const FVectorLanes4 TT = Mul(Cross(Q, V), Two);
+		return Add(Add(V, Mul(TT, W)), Cross(Q, TT));
+	}
+
+	FORCEINLINE FVectorLanes4 LoadBlockLanes(const double* X, const double* Y, const double* Z)
+	{
+		return {VectorLoad(X), VectorLoad(Y), VectorLoad(Z)};
+	}
+
+	FORCEINLINE VectorRegister4Double Dot(const FVectorLanes4& A, const FVectorLanes4& B)
+	{
+		return VectorMultiplyAdd(A.X, B.X, VectorMultiplyAdd(A.Y, B.Y, VectorMultiply(A.Z, B.Z)));
+	}
+
+	// ナローフェーズの候補判定: DistSq < (|BoneRadius| + ColliderRadius) を相対・絶対マージンで少し広げた2乗。
+	// スカラー側は float の距離比較や T の float 丸めを含むため、その誤差を十分に上回る幅を取る（当たり漏れ厳禁、誤検出は可）。
+	FORCEINLINE int32 CandidateMask(const VectorRegister4Double& DistSq, const VectorRegister4Double& BoneRadius,
+	                                const VectorRegister4Double& ColliderRadius)
+	{
+		const VectorRegister4Double Limit = VectorMultiplyAdd(VectorAdd(BoneRadius, ColliderRadius),
+		                                                      SplatDouble(1.0 + 1.0e-4), SplatDouble(1.0e-3));
+		return VectorMaskBits(VectorCompareGT(VectorMultiply(Limit, Limit), DistSq));
+	}
+
+	// ブロック毎に判定し、候補のあるブロックは最初の候補レーンからブロック末尾までをスカラーで順に確定する。
+	// 候補より前のレーンは同じ位置で「当たらない」と判定済みなので飛ばしても結果は変わらない。
+	// 確定で位置が動くため、次のブロックは新しい位置で判定し直す（適用順はスカラー経路と同一）。
+	template <typename TBlock, typename TTest, typename TResolve>
+	FORCEINLINE void ForEachCandidate(FVector& Location, const TArray<TBlock>& Blocks, const int32 NumColliders,
+	                                  const TTest& Test, const TResolve& Resolve)
+	{
+		constexpr int32 BlockSize = FKawaiiPhysicsColliderBuffer::SimdBlockSize;
+		for (int32 BlockIndex = 0; BlockIndex < Blocks.Num(); ++BlockIndex)
+		{
+			const int32 Mask = Test(Blocks[BlockIndex], SplatLanes(Location));
+			if (Mask == 0)
+			{
+				continue;
+			}
+
+			const int32 Begin = BlockIndex * BlockSize + static_cast<int32>(FMath::CountTrailingZeros(
+				static_cast<uint32>(Mask)));
+			const int32 End = FMath::Min((BlockIndex + 1) * BlockSize, NumColliders);
+			for (int32 ColliderIndex = Begin; ColliderIndex < End; ++ColliderIndex)
+			{
+				Resolve(ColliderIndex);
+			}
+		}
+	}
+
+	// 線分（Start + Segment * T）までの距離の2乗。T は RcpSegmentSizeSq で求めて [0,1] に丸める
+	FORCEINLINE VectorRegister4Double SegmentDistSq(const FKawaiiPhysicsColliderBuffer::FCapsuleBlock& Block,
+	                                                const FVectorLanes4& Point)
+	{
+		const FVectorLanes4 Delta = Sub(Point, LoadBlockLanes(Block.StartX, Block.StartY, Block.StartZ));
+		const FVectorLanes4 Segment = LoadBlockLanes(Block.SegmentX, Block.SegmentY, Block.SegmentZ);
+		const VectorRegister4Double T = VectorMin(
+			VectorMax(VectorMultiply(Dot(Delta, Segment), VectorLoad(Block.RcpSegmentSizeSq)),
+			          GlobalVectorConstants::DoubleZero), GlobalVectorConstants::DoubleOne);
+		const FVectorLanes4 Offset = Sub(Delta, Mul(Segment, T));
+		return Dot(Offset, Offset);
+	}
+}
+
+namespace KawaiiPhysicsCollision
+{
+	void PushOutSpheresSimd(FVector& Location, const float Radius, const FKawaiiPhysicsColliderBuffer::FSpheres& Spheres,
+	                        const FRelevanceFilter& Relevance)
+	{
+		const VectorRegister4Double BoneRadius = SplatDouble(FMath::Abs(Radius));
+		ForEachCandidate(Location, Spheres.Blocks, Spheres.Num(),
+		                 [&BoneRadius](const FKawaiiPhysicsColliderBuffer::FSphereBlock& Block,
+		                               const FVectorLanes4& Point)
+		                 {
+			                 const FVectorLanes4 Delta =
+				                 Sub(Point, LoadBlockLanes(Block.CenterX, Block.CenterY, Block.CenterZ));
+			                 return CandidateMask(Dot(Delta, Delta), BoneRadius, VectorLoad(Block.Radius));
+		                 },
+		                 [&](const int32 i)
+		                 {
+			                 if (Relevance.Skips(Spheres.RelevanceMask, i))
+			                 {
+				                 return;
+			                 }
+			                 PushOutSphere(Location, Radius, Spheres.Center[i], Spheres.Radius[i],
+			                               Spheres.bInner[i] != 0);
+		                 });
+	}
+
+	void PushOutCapsulesSimd(FVector& Location, const float Radius,
+	                         const FKawaiiPhysicsColliderBuffer::FCapsules& Capsules, const FRelevanceFilter& Relevance)
+	{
+		const VectorRegister4Double BoneRadius = SplatDouble(FMath::Abs(Radius));
+		ForEachCandidate(Location, Capsules.Blocks, Capsules.Num(),
+		                 [&BoneRadius](const FKawaiiPhysicsColliderBuffer::FCapsuleBlock& Block,
+		                               const FVectorLanes4& Point)
+		                 {
+			                 return CandidateMask(SegmentDistSq(Block, Point), BoneRadius, VectorLoad(Block.Radius));
+		                 },
+		                 [&](const int32 i)
+		                 {
+			                 if (Relevance.Skips(Capsules.RelevanceMask, i))
+			                 {
+				                 return;
+			                 }
+			                 PushOutCapsule(Location, Radius, Capsules.Start[i], Capsules.End[i], Capsules.Radius[i],
+			                                Capsules.FallbackPushDir[i]);
+		                 });
+	}
+
+	void PushOutTaperedCapsulesSimd(FVector& Location, const float Radius,
+	                                const FKawaiiPhysicsColliderBuffer::FTaperedCapsules& TaperedCapsules,
+	                                const FRelevanceFilter& Relevance)
+	{
+		const VectorRegister4Double BoneRadius = SplatDouble(FMath::Abs(Radius));
+		ForEachCandidate(Location, TaperedCapsules.Blocks, TaperedCapsules.Num(),
+		                 [&BoneRadius](const FKawaiiPhysicsColliderBuffer::FCapsuleBlock& Block,
+		                               const FVectorLanes4& Point)
+		                 {
+			                 return CandidateMask(SegmentDistSq(Block, Point), BoneRadius, VectorLoad(Block.Radius));
+		                 },
+		                 [&](const int32 i)
+		                 {
+			                 if (Relevance.Skips(TaperedCapsules.RelevanceMask, i))
+			                 {
+				                 return;
+			                 }
+			                 PushOutTaperedCapsule(Location, Radius, TaperedCapsules.Start[i],
+			                                       TaperedCapsules.Segment[i], TaperedCapsules.SegmentSizeSq[i],
+			                                       TaperedCapsules.Radius0[i], TaperedCapsules.Radius1[i],
+			                                       TaperedCapsules.FallbackPushDir[i]);
+		                 });
+	}
+
+	void PushOutBoxesSimd(FVector& Location, const float Radius, const FKawaiiPhysicsColliderBuffer::FBoxes& Boxes,
+	                      const FRelevanceFilter& Relevance)
+	{
+		const VectorRegister4Double BoneRadius = SplatDouble(FMath::Abs(Radius));
+		const VectorRegister4Double Two = SplatDouble(2.0);
+		ForEachCandidate(Location, Boxes.Blocks, Boxes.Num(),
+		                 [&BoneRadius, &Two](const FKawaiiPhysicsColliderBuffer::FBoxBlock& Block,
+		                                     const FVectorLanes4& Point)
+		                 {
+			                 // ローカル空間へ（共役クォータニオンで回転 = FQuat::UnrotateVector）
+			                 const FVectorLanes4 Delta =
+				                 Sub(Point, LoadBlockLanes(Block.CenterX, Block.CenterY, Block.CenterZ));
+			                 const FVectorLanes4 InvAxis = {
+				                 VectorNegate(VectorLoad(Block.RotationX)), VectorNegate(VectorLoad(Block.RotationY)),
+				                 VectorNegate(VectorLoad(Block.RotationZ))
+			                 };
+			                 const FVectorLanes4 Local = RotateLanes(Delta, InvAxis, VectorLoad(Block.RotationW), Two);
+			                 // AABB の外側へはみ出した分だけが距離になる
+			                 const FVectorLanes4 Outside = {
+				                 VectorMax(VectorSubtract(VectorAbs(Local.X), VectorLoad(Block.ExtentX)),
+				                           GlobalVectorConstants::DoubleZero),
+				                 VectorMax(VectorSubtract(VectorAbs(Local.Y), VectorLoad(Block.ExtentY)),
+				                           GlobalVectorConstants::DoubleZero),
+				                 VectorMax(VectorSubtract(VectorAbs(Local.Z), VectorLoad(Block.ExtentZ)),
+				                           GlobalVectorConstants::DoubleZero)
+			                 };
+			                 return CandidateMask(Dot(Outside, Outside), BoneRadius, GlobalVectorConstants::DoubleZero);
+		                 },
+		                 [&](const int32 i)
+		                 {
+			                 if (Relevance.Skips(Boxes.RelevanceMask, i))
+			                 {
+				                 return;
+			                 }
+			                 PushOutBox(Location, Radius, Boxes.Transform[i], Boxes.Extent[i]);
+		                 });
+	}
+}
+
+namespace
+{
+	// 積分カーネルがステップ毎に読む入力（ノードのメンバから1回だけ集める）
+	struct FIntegrationStepInputs
+	{
+		float StepDt = 0.0f;
+		float DeltaTimeOld = 0.0f;
+		FVector Gravity = FVector::ZeroVector;
+		bool bUseLegacyGravity = false;
+		FVector SimpleExternalForce = FVector::ZeroVector;
+		bool bFollowWorldMove = false;
+		FVector SkelCompMoveVector = FVector::ZeroVector;
+		FQuat SkelCompMoveRotation = FQuat::Identity;
+	};
+
+	// 端数バッチは最後の有効ボーンで埋める（書き戻しは有効レーンのみ）
+	FORCEINLINE int32 GatherBatchIndices(const TArray<int32>& ActiveBones, const int32 Batch, int32 (&Indices)[4])
+	{
+		const int32 NumLanes = FMath::Min(4, ActiveBones.Num() - Batch);
+		for (int32 Lane = 0; Lane < 4; ++Lane)
+		{
+			Indices[Lane] = ActiveBones[Batch + FMath::Min(Lane, NumLanes - 1)];
+		}
+		return NumLanes;
+	}
+
+	// 位置更新（LWC の絶対位置のまま double レーンで）
+	void IntegratePositions(FKawaiiPhysicsSolverState& State, const TArray<int32>& ActiveBones,
+	                        const FIntegrationStepInputs& In)
+	{
+		// FVector::operator/(Scale) と同じく逆数を掛ける
+		const VectorRegister4Double RDeltaTimeOld =
+			SplatDouble(1.0 / static_cast<double>(FMath::Max(In.DeltaTimeOld, KINDA_SMALL_NUMBER)));
+		const VectorRegister4Double StepDtLanes = SplatDouble(In.StepDt);
+		const FVectorLanes4 ZeroLanes = SplatLanes(FVector::ZeroVector);
+		const FVectorLanes4 GravityVelocityStep = SplatLanes(In.Gravity * In.StepDt);
+		const FVectorLanes4 LegacyGravityOffset = SplatLanes(0.5 * In.Gravity * In.StepDt * In.StepDt);
+		const bool bApplySimpleExternalForce = !In.SimpleExternalForce.IsNearlyZero();
+		const FVectorLanes4 SimpleExternalForceStep = SplatLanes(In.SimpleExternalForce * In.StepDt);
+		const FVectorLanes4 SkelCompMove = SplatLanes(In.SkelCompMoveVector);
+		const FVectorLanes4 SkelCompRotAxis = SplatLanes(
+			FVector(In.SkelCompMoveRotation.X, In.SkelCompMoveRotation.Y, In.SkelCompMoveRotation.Z));
+		const VectorRegister4Double SkelCompRotW = SplatDouble(In.SkelCompMoveRotation.W);
+		const VectorRegister4Double Two = SplatDouble(2.0f);
+
+		FVector* Locations = State.Location.GetData();
+		FVector* PrevLocations = State.PrevLocation.GetData();
+		const float* Damping = State.Damping.GetData();
+		const float* WorldDampingLocation = State.WorldDampingLocation.GetData();
+		const float* WorldDampingRotation = State.WorldDampingRotation.GetData();
+
+		for (int32 Batch = 0; Batch < ActiveBones.Num(); Batch += 4)
+		{
+			int32 Indices[4];
+			const int32 NumLanes = GatherBatchIndices(ActiveBones, Batch, Indices);
+
+			FVectorLanes4 Location = LoadLanes(Locations, Indices);
+			FVectorLanes4 PrevLocation = LoadLanes(PrevLocations, Indices);
+
+			// 速度の再構成 → damping → +wind(この経路では0。スカラー経路と同じ演算列を保つ) → gravity
+			FVectorLanes4 Velocity = Mul(Sub(Location, PrevLocation), RDeltaTimeOld);
+			PrevLocation = Location;
+			Velocity = Mul(Velocity, MakeVectorRegisterDouble(
+				               1.0f - Damping[Indices[0]], 1.0f - Damping[Indices[1]],
+				               1.0f - Damping[Indices[2]], 1.0f - Damping[Indices[3]]));
+			Velocity = Add(Velocity, ZeroLanes);
+			if (!In.bUseLegacyGravity)
+			{
+				Velocity = Add(Velocity, GravityVelocityStep);
+			}
+			else
+			{
+				Location = Add(Location, LegacyGravityOffset);
+			}
+
+			// 位置積分 + simple external force
+			Location = Add(Location, Mul(Velocity, StepDtLanes));
+			if (bApplySimpleExternalForce)
+			{
+				Location = Add(Location, SimpleExternalForceStep);
+			}
+
+			// Follow World Movement（ComponentSpace/WorldSpace）
+			if (In.bFollowWorldMove)
+			{
+				const VectorRegister4Double LocationFactor = MakeVectorRegisterDouble(
+					1.0f - WorldDampingLocation[Indices[0]], 1.0f - WorldDampingLocation[Indices[1]],
+					1.0f - WorldDampingLocation[Indices[2]], 1.0f - WorldDampingLocation[Indices[3]]);
+				const VectorRegister4Double RotationFactor = MakeVectorRegisterDouble(
+					1.0f - WorldDampingRotation[Indices[0]], 1.0f - WorldDampingRotation[Indices[1]],
+					1.0f - WorldDampingRotation[Indices[2]], 1.0f - WorldDampingRotation[Indices[3]]);
+				Location = Add(Location, Mul(SkelCompMove, LocationFactor));
+				const FVectorLanes4 Rotated = RotateLanes(PrevLocation, SkelCompRotAxis, SkelCompRotW, Two);
+				Location = Add(Location, Mul(Sub(Rotated, PrevLocation), RotationFactor));
+			}
+
+			StoreLanes(Location, Locations, Indices, NumLanes);
+			StoreLanes(PrevLocation, PrevLocations, Indices, NumLanes);
+		}
+	}
+}
+
+void FAnimNode_KawaiiPhysics::IntegrateSolverStateSimd()
+{
+	FKawaiiPhysicsSolverState& State = SolverState;
+
+	// 積分対象（SimulateOnce のスカラー経路と同じリスト）
+	const TArray<int32>& ActiveBones = BoneCategories.GetIntegrated(IsInterBoneDummyCollisionOnly());
+	const int32 NumActive = ActiveBones.Num();
+	if (NumActive == 0)
+	{
+		return;
+	}
+
+	// ステップ内で不変な値はボーンループの外で1回だけ集める
+	FIntegrationStepInputs Inputs;
+	Inputs.StepDt = GetStepDeltaTime();
+	Inputs.DeltaTimeOld = DeltaTimeOld;
+	Inputs.Gravity = GravityInSimSpace;
+	Inputs.bUseLegacyGravity = bUseLegacyGravity;
+	Inputs.SimpleExternalForce = SimpleExternalForceInSimSpace;
+	Inputs.bFollowWorldMove = SimulationSpace != EKawaiiPhysicsSimulationSpace::WorldSpace
+		&& TeleportType != ETeleportType::TeleportPhysics;
+	Inputs.SkelCompMoveVector = SkelCompMoveVector;
+	Inputs.SkelCompMoveRotation = SkelCompMoveRotation;
+
+	IntegratePositions(State, ActiveBones, Inputs);
+
+	// Pull to Pose Location（剛性）。親の確定位置に依存するため index 順（親→子）のスカラーで適用。
+	// 係数 1-(1-Stiffness)^Exponent は UpdateStepInvariants で求め済み
+	FVector* Locations = State.Location.GetData();
+	const FVector* PoseLocations = State.PoseLocation.GetData();
+	const int32* ParentIndices = State.ParentIndex.GetData();
+	const float* StiffnessFactors = State.StiffnessFactor.GetData();
+	for (const int32 BoneIndex : ActiveBones)
+	{
+		const int32 ParentIndex = ParentIndices[BoneIndex];
+		const FVector BaseLocation = Locations[ParentIndex] + (PoseLocations[BoneIndex] - PoseLocations[ParentIndex]);
+		Locations[BoneIndex] += (BaseLocation - Locations[BoneIndex]) * StiffnessFactors[BoneIndex];
+	}
+}
+
+void FAnimNode_KawaiiPhysics::AdjustByBoneConstraintsColored(TArray<FVector>& Locations)
+{
+	SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_AdjustByBoneConstraint);
+
+	const int32 NumLocations = Locations.Num();
+	if (NumLocations == 0)
+	{
+		return;
+	}
+
+	FVector* LocationData = Locations.GetData();
+	FModifyBoneConstraint* Constraints = MergedBoneConstraints.GetData();
+
+	const FKawaiiPhysicsConstraintColors& Colors = BoneConstraintColors;
+
+	// 同色の4本（色順の slot Begin から）を解く。レーン毎の演算列は AdjustByBoneConstraint と同じ
+	// （長さは FMA なしの X*X+Y*Y+Z*Z、補正は逆数を掛けてから DeltaLambda を掛ける）
+	auto SolveBatch = [this, LocationData, Constraints, NumLocations, &Colors](const int32 Begin)
+	{
+		int32 ConstraintIndices[4];
+		int32 Indices1[4];
+		int32 Indices2[4];
+		bool bLaneValid[4];
+		for (int32 Lane = 0; Lane < 4; ++Lane)
+		{
+			ConstraintIndices[Lane] = Colors.GetConstraintIndex(Begin + Lane);
+			const FModifyBoneConstraint& BoneConstraint = Constraints[ConstraintIndices[Lane]];
+			bLaneValid[Lane] = BoneConstraint.IsValid() &&
+				BoneConstraint.ModifyBoneIndex1 >= 0 && BoneConstraint.ModifyBoneIndex1 < NumLocations &&
+				BoneConstraint.ModifyBoneIndex2 >= 0 && BoneConstraint.ModifyBoneIndex2 < NumLocations;
+			Indices1[Lane] = bLaneValid[Lane] ? BoneConstraint.ModifyBoneIndex1 : 0;
+			Indices2[Lane] = bLaneValid[Lane] ? BoneConstraint.ModifyBoneIndex2 : 0;
+		}
+
+		const FVectorLanes4 Location1 = LoadLanes(LocationData, Indices1);
+		const FVectorLanes4 Location2 = LoadLanes(LocationData, Indices2);
+		const FVectorLanes4 Delta = Sub(Location2, Location1);
+		const VectorRegister4Double LengthSq = VectorAdd(
+			VectorAdd(VectorMultiply(Delta.X, Delta.X), VectorMultiply(Delta.Y, Delta.Y)),
+			VectorMultiply(Delta.Z, Delta.Z));
+		double Lengths[4];
+		VectorStore(VectorSqrt(LengthSq), Lengths);
+
+		// Lambda の計算は float のスカラー（compliance の選択がレーン毎に違うため）
+		double RScales[4] = {0.0, 0.0, 0.0, 0.0};
+		double DeltaLambdas[4] = {0.0, 0.0, 0.0, 0.0};
+		int32 ActiveMask = 0;
+		for (int32 Lane = 0; Lane < 4; ++Lane)
+		{
+			const float DeltaLength = static_cast<float>(Lengths[Lane]);
+			if (!bLaneValid[Lane] || DeltaLength <= 0.0f)
+			{
+				continue;
+			}
+
+			FModifyBoneConstraint& BoneConstraint = Constraints[ConstraintIndices[Lane]];
+			const float DeltaLambda = ComputeBoneConstraintDeltaLambda(BoneConstraint, DeltaLength);
+			RScales[Lane] = 1.0 / static_cast<double>(DeltaLength);
+			DeltaLambdas[Lane] = DeltaLambda;
+			BoneConstraint.Lambda += DeltaLambda;
+			ActiveMask |= 1 << Lane;
+		}
+		if (ActiveMask == 0)
+		{
+			return;
+		}
+
+		const FVectorLanes4 Correction = Mul(
+			Mul(Delta, MakeVectorRegisterDouble(RScales[0], RScales[1], RScales[2], RScales[3])),
+			MakeVectorRegisterDouble(DeltaLambdas[0], DeltaLambdas[1], DeltaLambdas[2], DeltaLambdas[3]));
+		StoreMaskedLanes(Add(Location1, Correction), LocationData, Indices1, ActiveMask);
+		StoreMaskedLanes(Sub(Location2, Correction), LocationData, Indices2, ActiveMask);
+	};
+
+	const int32 ParallelMinColorSize = CVarAnimNodeKawaiiPhysicsBoneConstraintParallelMinColorSize.GetValueOnAnyThread();
+	for (int32 Color = 0; Color < Colors.Num(); ++Color)
+	{
+		const int32 Begin = Colors.GetColorBegin(Color);
+		const int32 End = Colors.GetColorEnd(Color);
+		const int32 NumBatches = (End - Begin) / 4;
+
+		// 色の中は互いに独立なので、大きい色はバッチ単位で並列に解いても結果は変わらない
+		if (ParallelMinColorSize > 0 && End - Begin >= ParallelMinColorSize)
+		{
+			ParallelFor(NumBatches, [&SolveBatch, Begin](const int32 Batch)
+			{
+				SolveBatch(Begin + Batch * 4);
+			});
+		}
+		else
+		{
+			for (int32 Batch = 0; Batch < NumBatches; ++Batch)
+			{
+				SolveBatch(Begin + Batch * 4);
+			}
+		}
+
+		// 4本に満たない端数はスカラー
+		for (int32 Slot = Begin + NumBatches * 4; Slot < End; ++Slot)
+		{
+			AdjustByBoneConstraint(Constraints[Colors.GetConstraintIndex(Slot)], Locations);
+		}
+	}
+}
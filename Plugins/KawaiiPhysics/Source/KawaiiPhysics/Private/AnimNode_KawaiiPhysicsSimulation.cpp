@@ -10,7 +10,9 @@
 #include "ExternalForces/KawaiiPhysicsExternalForce_ProceduralWind.h"
 #include "KawaiiPhysicsLimitsDataAsset.h"
 #include "KawaiiPhysicsSharedCollisionSubsystem.h"
+#include "KawaiiPhysicsSimulationSubsystem.h"
 #include "Animation/AnimInstanceProxy.h"
+#include "Async/ParallelFor.h"
 #include "Curves/CurveFloat.h"
 #include "Runtime/Launch/Resources/Version.h"
 #include "SceneInterface.h"
@@ -158,6 +160,36 @@ namespace
 
 		BuildTransientGustForceFromSource(Node, Request, Source);
 	}
+
+	// スリープ中のノードを起こす Component の回転量（度） / Component rotation (degrees) that wakes a sleeping node
+	constexpr float SleepWakeRotationThresholdDegrees = 0.1f;
+
+	// 細かい LOD 段階へ戻るときに閾値から離れていなければならない割合 / How far past the threshold a finer LOD tier has to be before switching back
+	constexpr float LODTierHysteresis = 0.1f;
+
+	// スリープ判定用のコライダーの外接球半径 / Bounding-sphere radius of a collider for the sleep check
+	float GetSleepBoundingRadius(const FSphericalLimit& Limit) { return Limit.Radius; }
+	float GetSleepBoundingRadius(const FCapsuleLimit& Limit) { return Limit.Radius + Limit.Length * 0.5f; }
+	float GetSleepBoundingRadius(const FTaperedCapsuleLimit& Limit)
+	{
+		return FMath::Max(Limit.Radius0, Limit.Radius1) + Limit.Length * 0.5f;
+	}
+	float GetSleepBoundingRadius(const FBoxLimit& Limit) { return Limit.Extent.Size(); }
+
+	template <typename LimitType>
+	void AccumulateSleepColliders(const TArray<LimitType>& Limits, const FBox& Bounds, int32& OutCount,
+	                              FVector& OutCenterSum)
+	{
+		for (const LimitType& Limit : Limits)
+		{
+			if (Limit.bEnable &&
+				Bounds.ComputeSquaredDistanceToPoint(Limit.Location) <= FMath::Square(GetSleepBoundingRadius(Limit)))
+			{
+				++OutCount;
+				OutCenterSum += Limit.Location;
+			}
+		}
+	}
 }
 
 FKawaiiPhysicsSettingsScale FAnimNode_KawaiiPhysics::ComputeEffectivePhysicsSettingsOverrideScale() const
@@ -450,42 +482,63 @@ void FAnimNode_KawaiiPhysics::SimulateModifyBones(FComponentSpacePoseContext& Ou
 {
 	SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_SimulateModifyBones);
 
-	if (DeltaTime <= 0.0f)
+	if (!PrepareSimulateModifyBones(Output))
 	{
 		return;
 	}
 
-	// このフレームの実dtを保持（サブステップ中は DeltaTime を FixedDt として扱うため別保存）
-	FrameDeltaTime = DeltaTime;
-
 	const USkeletalMeshComponent* SkelComp = Output.AnimInstanceProxy->GetSkelMeshComponent();
+	const UWorld* World = SkelComp ? SkelComp->GetWorld() : nullptr;
+	const FSceneInterface* Scene = World ? World->Scene : nullptr;
 
-	// Prev/Pose 情報を保存し、SkipSimulate を判定
-	for (FKawaiiPhysicsModifyBone& Bone : ModifyBones)
+	// 非同期ワールドコリジョン: 前フレームまでに揃った結果を接触平面にしてからステップし、このフレームの移動でスイープを積む
+	// Broadphase: ステップ前に1回だけ重なり判定して周囲の形状を集める
+	const bool bWorldCollision = IsWorldCollisionActive();
+	const bool bAsyncWorldCollision =
+		bWorldCollision && WorldCollisionMode == EKawaiiPhysicsWorldCollisionMode::AsyncSweep;
+	if (bAsyncWorldCollision)
 	{
-		// bridge dummyは縦親(ParentIndex<0)を持たないが、コリジョン代理として非skipにする
-		// （Simulate()/長さ復元は別途スキップ。下のParentIndex<0分岐に落ちると誤ってskip&Pose固定される）
-		if (Bone.bBridgeDummy)
-		{
-			Bone.bSkipSimulate = false;
-			continue;
-		}
+		UpdateAsyncWorldCollision(Output, SkelComp);
+	}
+	else if (bWorldCollision && WorldCollisionMode == EKawaiiPhysicsWorldCollisionMode::Broadphase)
+	{
+		UpdateWorldCollisionBroadphase(Output, SkelComp);
+	}
+	StepModifyBones(&Output, ComponentTransform, Scene, SkelComp);
+	if (bAsyncWorldCollision)
+	{
+		StageAsyncWorldCollision(Output, SkelComp);
+	}
+	FinishSimulateModifyBones();
+}
 
-		if (Bone.BoneRef.BoneIndex < 0 && !Bone.bDummy)
-		{
-			Bone.bSkipSimulate = true;
-			continue;
-		}
+bool FAnimNode_KawaiiPhysics::PrepareSimulateModifyBones(FComponentSpacePoseContext& Output)
+{
+	if (DeltaTime <= 0.0f)
+	{
+		return false;
+	}
 
-		if (Bone.ParentIndex < 0)
-		{
-			// root: kinematic。実ポーズ追従（PrevLocation/Location更新）は SimulateOnce 内で、
-			// サブステップ補間後のポーズに対して毎ステップ行う。
-			Bone.bSkipSimulate = true;
-			continue;
-		}
+	// このフレームの実dtを保持（サブステップ中は DeltaTime を FixedDt として扱うため別保存）
+	FrameDeltaTime = DeltaTime;
 
-		Bone.bSkipSimulate = false;
+	const USkeletalMeshComponent* SkelComp = Output.AnimInstanceProxy->GetSkelMeshComponent();
+
+	// skip 判定とボーン分類は init / reinit 時に確定済み（未構築なら、ここで作る）。
+	// 毎フレーム変わり得るのは前フレームに LOD で skip された bridge dummy だけなので、それだけを戻して再評価させる。
+	if (!BoneCategories.IsBuiltFor(BoneLayoutGeneration, ModifyBones.Num()))
+	{
+		BuildBoneCategories();
+	}
+	for (const int32 BridgeIndex : BoneCategories.BridgeDummies)
+	{
+		ModifyBones[BridgeIndex].bSkipSimulate = false;
+	}
+	// 分類の作り直し / 最小ボーン数（CVar）の変更があればアイランドも作り直す
+	if (!BoneIslands.IsBuiltFor(ModifyBones.Num(), MergedBoneConstraints.Num(),
+	                            CVarAnimNodeKawaiiPhysicsParallelIslandMinBones.GetValueOnAnyThread()))
+	{
+		BuildBoneIslands();
 	}
 
 	// Gravity
@@ -520,21 +573,24 @@ void FAnimNode_KawaiiPhysics::SimulateModifyBones(FComponentSpacePoseContext& Ou
 		SimpleExternalForceInSimSpace = FVector::ZeroVector;
 	}
 
-	// External Force : PreApply
+	// External Force : PreApply（LOD 段階で止めていれば一時外力だけ）
 	// 注: foreach を使うと問題が起きうる（ranged-for 中に配列が変化する）
-	for (int i = 0; i < CustomExternalForces.Num(); ++i)
+	if (AreExternalForcesActive())
 	{
-		if (CustomExternalForces[i])
+		for (int i = 0; i < CustomExternalForces.Num(); ++i)
 		{
-			CustomExternalForces[i]->PreApply(*this, SkelComp);
+			if (CustomExternalForces[i])
+			{
+				CustomExternalForces[i]->PreApply(*this, SkelComp);
+			}
 		}
-	}
-	for (int i = 0; i < ExternalForces.Num(); ++i)
-	{
-		if (ExternalForces[i].IsValid())
+		for (int i = 0; i < ExternalForces.Num(); ++i)
 		{
-			auto& Force = ExternalForces[i].GetMutable<FKawaiiPhysics_ExternalForce>();
-			Force.PreApply(*this, Output);
+			if (ExternalForces[i].IsValid())
+			{
+				auto& Force = ExternalForces[i].GetMutable<FKawaiiPhysics_ExternalForce>();
+				Force.PreApply(*this, Output);
+			}
 		}
 	}
 	for (int i = 0; i < TransientForceStore.Items.Num(); ++i)
@@ -548,13 +604,14 @@ void FAnimNode_KawaiiPhysics::SimulateModifyBones(FComponentSpacePoseContext& Ou
 		}
 	}
 
-	// ===== サブステップ設定キャッシュ & Scene 取得（毎フレーム1回） =====
+	// ===== サブステップ設定キャッシュ（毎フレーム1回） =====
 	const UKawaiiPhysicsDeveloperSettings* KawaiiSettings = GetDefault<UKawaiiPhysicsDeveloperSettings>();
 	bUseFixedSubsteppingCached = KawaiiSettings->bUseFixedSubstepping;
-	MaxSubstepsCached = FMath::Max(1, KawaiiSettings->MaxSubsteps);
-
-	const UWorld* World = SkelComp ? SkelComp->GetWorld() : nullptr;
-	const FSceneInterface* Scene = World ? World->Scene : nullptr;
+	MaxSubstepsCached = GetEffectiveMaxSubsteps(KawaiiSettings->MaxSubsteps);
+	bSubstepAlwaysInterpolateRotationCached =
+		KawaiiSettings->SubstepRotationInterpolation == EKawaiiPhysicsSubstepRotationInterpolation::Slerp;
+	bSubstepNLerpRotationCached =
+		KawaiiSettings->SubstepRotationInterpolation == EKawaiiPhysicsSubstepRotationInterpolation::NLerpWhenUsed;
 
 	// 現フレームのポーズ目標をスナップショット（サブステップ中 PoseLocation を補間で上書きするため退避）。
 	// 初回/リセット後は前フレーム値を現在値で初期化（補間で飛ばないように）。
@@ -570,68 +627,122 @@ void FAnimNode_KawaiiPhysics::SimulateModifyBones(FComponentSpacePoseContext& Ou
 	}
 	bSubstepPoseInitialized = true;
 
+	// ホット状態をSoAへ集める（以降のステップは SolverState 上で進め、末尾で ModifyBones へ書き戻す）
+	{
+		SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_SolverStateSync);
+		SolverState.Gather(ModifyBones);
+		// サブステップの補間元もここで読む（バッチ / パイプライン実行のステップは ModifyBones に触れない）
+		if (bUseFixedSubsteppingCached)
+		{
+			SolverState.GatherSubstepPoseTargets(ModifyBones);
+		}
+	}
+
+	// ステップ数の決定（未消費時間の繰り越し）はここで行う。評価側が直後に PreSkelCompTransformConsumeFraction を使うため、
+	// ステップの実行がバッチへ回る場合も同じ評価中に確定させておく。
 	if (!bUseFixedSubsteppingCached)
 	{
-		// ===== Legacy: 実フレーム時間で1ステップ（GetStepDeltaTime()==DeltaTime） =====
-		bInSubstep = false;
-		SimulateOnce(Output, ComponentTransform, Scene, SkelComp);
-		DeltaTimeOld = DeltaTime;
 		PreSkelCompTransformConsumeFraction = 1.0f; // legacyは毎フレーム全消費
 	}
 	else
 	{
-		// ===== 固定タイムステップ・サブステップ（§4） =====
 		const float FixedDt = 1.0f / GetEffectiveTargetFramerate();
 		// クランプ前の蓄積実時間
 		const float RawElapsed = FMath::Max(SubstepAccumulator + FrameDeltaTime, KINDA_SMALL_NUMBER);
 		// spiral of death 防止：超過分は破棄
 		SubstepAccumulator = FMath::Min(RawElapsed, MaxSubstepsCached * FixedDt);
 		const float DroppedTime = RawElapsed - SubstepAccumulator; // クランプで破棄された時間
-		const int32 NumSteps = FMath::FloorToInt(SubstepAccumulator / FixedDt);
-		SubstepAccumulator -= NumSteps * FixedDt;
+		PlannedSubstepCount = FMath::FloorToInt(SubstepAccumulator / FixedDt);
+		SubstepAccumulator -= PlannedSubstepCount * FixedDt;
 
 		// world移動を各サブステップへ分配。RawElapsed 基準にし、ステップ未消費(NumSteps==0)でも取りこぼし/二重適用しない。
-		const float MoveFrac = FixedDt / RawElapsed;
+		PlannedSubstepMoveFraction = FixedDt / RawElapsed;
 		// PreSkelCompTransform を「消費(NumSteps*FixedDt)＋破棄(DroppedTime)」割合だけ前進させ残りを繰り越す。破棄分は復活させない（超過分破棄と整合）。
 		PreSkelCompTransformConsumeFraction =
-			FMath::Clamp((NumSteps * FixedDt + DroppedTime) / RawElapsed, 0.0f, 1.0f);
+			FMath::Clamp((PlannedSubstepCount * FixedDt + DroppedTime) / RawElapsed, 0.0f, 1.0f);
+	}
+	return true;
+}
+
+void FAnimNode_KawaiiPhysics::StepModifyBones(FComponentSpacePoseContext* Output,
+                                              const FTransform& ComponentTransform,
+                                              const FSceneInterface* Scene,
+                                              const USkeletalMeshComponent* SkelComp)
+{
+	if (!bUseFixedSubsteppingCached)
+	{
+		// ===== Legacy: 実フレーム時間で1ステップ（GetStepDeltaTime()==DeltaTime） =====
+		bInSubstep = false;
+		SolverState.UpdateRestPose(BoneCategories.Simulated);
+		UpdateStepInvariants();
+		SimulateOnce(Output, ComponentTransform, Scene, SkelComp);
+		DeltaTimeOld = DeltaTime;
+	}
+	else
+	{
+		// ===== 固定タイムステップ・サブステップ（§4）。ステップ数と world 移動の分配率は PrepareSimulateModifyBones で決定済み =====
+		const float FixedDt = 1.0f / GetEffectiveTargetFramerate();
+		const int32 NumSteps = PlannedSubstepCount;
+		const float MoveFrac = PlannedSubstepMoveFraction;
 		const FVector FullSkelCompMove = SkelCompMoveVector;
 		const FQuat FullSkelCompRot = SkelCompMoveRotation;
 
+		// ポーズ回転の補間は読む処理があるときだけ（位置は SolverState 上でまとめて補間）
+		const bool bInterpolateRotation = bSubstepAlwaysInterpolateRotationCached || NeedsSubstepPoseRotation();
+		const bool bUseNLerp = bSubstepNLerpRotationCached;
+
 		bInSubstep = true;
 		StepDeltaTime = FixedDt;
 		DeltaTimeOld = FixedDt;
+
+		// world移動の分配分だけを各ステップに適用させる（Simulateはメンバを参照するため一時設定）。全ステップ同じ値
+		SkelCompMoveVector = FullSkelCompMove * MoveFrac;
+		SkelCompMoveRotation = FQuat::Slerp(FQuat::Identity, FullSkelCompRot, MoveFrac).GetNormalized();
+		UpdateStepInvariants();
+
 		for (int32 SubstepIndex = 0; SubstepIndex < NumSteps; ++SubstepIndex)
 		{
 			// 注: ローカル名は基底クラスのメンバ Alpha（ブレンド係数）を隠さないよう SubstepAlpha とする
 			const float SubstepAlpha = static_cast<float>(SubstepIndex + 1) / static_cast<float>(NumSteps);
 
-			// ポーズ目標をサブステップ補間（§5）
-			for (FKawaiiPhysicsModifyBone& Bone : ModifyBones)
+			// 最後のステップの直前の状態を出力補間の補間元にする
+			if (SubstepIndex == NumSteps - 1)
 			{
-				Bone.PoseLocation = FMath::Lerp(Bone.PrevPoseLocation, Bone.CurrentPoseLocation, SubstepAlpha);
-				Bone.PoseRotation = FQuat::Slerp(Bone.PrevPoseRotation, Bone.CurrentPoseRotation, SubstepAlpha).GetNormalized();
+				CaptureOutputInterpolationFrom(static_cast<float>(SubstepIndex) / static_cast<float>(NumSteps));
 			}
 
-			// world移動の分配分だけを適用させる（Simulateはメンバを参照するため一時設定）
-			SkelCompMoveVector = FullSkelCompMove * MoveFrac;
-			SkelCompMoveRotation = FQuat::Slerp(FQuat::Identity, FullSkelCompRot, MoveFrac).GetNormalized();
+			// ポーズ目標をサブステップ補間（§5）。位置も回転（角度制限/平面拘束の軸）も SolverState 上で補間する
+			InterpolateSubstepPose(SubstepAlpha, bInterpolateRotation, bUseNLerp);
+			SolverState.UpdateRestPose(BoneCategories.Simulated);
 
 			SimulateOnce(Output, ComponentTransform, Scene, SkelComp);
 		}
 		bInSubstep = false;
+		if (NumSteps > 0)
+		{
+			CaptureOutputInterpolationTo();
+		}
 
 		// world移動メンバを元へ（次フレームの UpdateSkelCompMove で再計算されるが安全のため）
 		SkelCompMoveVector = FullSkelCompMove;
 		SkelCompMoveRotation = FullSkelCompRot;
 
-		// PoseLocation を現フレームの真値へ戻す（出力・次フレーム捕捉の整合）
-		for (FKawaiiPhysicsModifyBone& Bone : ModifyBones)
+		// PoseLocation を現フレームの真値へ戻す（出力・次フレーム捕捉の整合）。補間しなかった回転は現フレーム値のまま
+		SolverState.RestoreCurrentPoseLocation();
+		if (bInterpolateRotation)
 		{
-			Bone.PoseLocation = Bone.CurrentPoseLocation;
-			Bone.PoseRotation = Bone.CurrentPoseRotation;
+			SolverState.RestoreCurrentPoseRotation();
 		}
 	}
+}
+
+void FAnimNode_KawaiiPhysics::FinishSimulateModifyBones()
+{
+	// シミュレーション結果を ModifyBones（Blueprint / デバッグ描画 / ApplySimulateResult が参照）へ書き戻す
+	{
+		SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_SolverStateSync);
+		SolverState.Scatter(ModifyBones);
+	}
 
 	// 次フレームのポーズ補間用に現フレーム値を確定
 	for (FKawaiiPhysicsModifyBone& Bone : ModifyBones)
@@ -641,286 +752,1044 @@ void FAnimNode_KawaiiPhysics::SimulateModifyBones(FComponentSpacePoseContext& Ou
 	}
 }
 
-void FAnimNode_KawaiiPhysics::SimulateOnce(FComponentSpacePoseContext& Output,
-                                           const FTransform& ComponentTransform,
-                                           const FSceneInterface* Scene,
-                                           const USkeletalMeshComponent* SkelComp)
+bool FAnimNode_KawaiiPhysics::CanBatchSimulation(const FSceneInterface* Scene) const
 {
-	// root bone（ParentIndex<0）の kinematic follow: （補間済み）ポーズへ追従。
-	// 元の skip ループから移設。サブステップ毎に補間ポーズへ追従させる。
-	for (FKawaiiPhysicsModifyBone& Bone : ModifyBones)
+	// 外力は無効でも PostApply が Output を受け取るため、配列が空（か LOD 段階で止めている）ことを条件にする
+	return !IsWorldCollisionActive() && (ExternalForces.IsEmpty() || !AreExternalForcesActive()) &&
+		TransientForceStore.Items.IsEmpty() && !NeedsPerBoneSimulateHooks(Scene);
+}
+
+bool FAnimNode_KawaiiPhysics::TryEnqueueBatchedSimulation(FComponentSpacePoseContext& Output)
+{
+	if (!CVarAnimNodeKawaiiPhysicsBatchedSimulation.GetValueOnAnyThread())
 	{
-		if (Bone.ParentIndex < 0 && !Bone.bBridgeDummy && !(Bone.BoneRef.BoneIndex < 0 && !Bone.bDummy))
-		{
-			Bone.PrevLocation = Bone.Location;
-			Bone.Location = Bone.PoseLocation;
-		}
+		return false;
+	}
+	UKawaiiPhysicsSimulationSubsystem* Subsystem = CachedSimulationSubsystem.Get();
+	if (!Subsystem)
+	{
+		return false;
 	}
 
-	// Simulate（Exponent は GetStepDeltaTime ベース。サブステップ時は TargetFramerate*FixedDt=1）
-	const int32 EffectiveTargetFramerate = GetEffectiveTargetFramerate();
-	const float Exponent = EffectiveTargetFramerate * GetStepDeltaTime();
-	for (FKawaiiPhysicsModifyBone& Bone : ModifyBones)
+	const USkeletalMeshComponent* SkelComp = Output.AnimInstanceProxy->GetSkelMeshComponent();
+	const UWorld* World = SkelComp ? SkelComp->GetWorld() : nullptr;
+	if (!CanBatchSimulation(World ? World->Scene : nullptr))
 	{
-		if (Bone.bSkipSimulate)
-		{
-			continue;
-		}
+		return false;
+	}
 
-		// コリジョン専用モード: Simulate()をスキップ（コリジョンとbone length restorationは後で実行）
-		if (Bone.bInterBoneDummy && bBoneSubdivisionCollisionOnly)
-		{
-			continue;
-		}
+	SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_SimulateModifyBones);
+	if (PrepareSimulateModifyBones(Output))
+	{
+		bBatchedSimulationPending = true;
+		Subsystem->EnqueueSimulation(this, CachedSimulationOwner);
+	}
+	return true;
+}
 
-		// bridge dummyは常にSimulate()をスキップ（縦親が無くModifyBones[ParentIndex]参照でクラッシュする）
-		if (Bone.bBridgeDummy)
-		{
-			continue;
-		}
+void FAnimNode_KawaiiPhysics::RunBatchedSimulation()
+{
+	if (!bBatchedSimulationPending)
+	{
+		return;
+	}
+	bBatchedSimulationPending = false;
+
+	SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_SimulateModifyBones);
+	// CanBatchSimulation を満たすノードだけが登録されるので Output / Scene / SkelComp / ComponentTransform は使われない
+	StepModifyBones(nullptr, FTransform::Identity, nullptr, nullptr);
+	FinishSimulateModifyBones();
+}
 
-		Simulate(Bone, Scene, ComponentTransform, Exponent, SkelComp, Output);
+bool FAnimNode_KawaiiPhysics::TryPreparePipelinedSimulation(FComponentSpacePoseContext& Output)
+{
+	if (!CVarAnimNodeKawaiiPhysicsPipelinedSimulation.GetValueOnAnyThread())
+	{
+		return false;
 	}
 
-	// コリジョン専用モード: 全実ボーンのシミュレーション完了後、シミュレーション済みのLocation間にダミーを配置
-	if (bBoneSubdivisionCollisionOnly)
+	const USkeletalMeshComponent* SkelComp = Output.AnimInstanceProxy->GetSkelMeshComponent();
+	const UWorld* World = SkelComp ? SkelComp->GetWorld() : nullptr;
+	if (!CanBatchSimulation(World ? World->Scene : nullptr))
 	{
-		for (FKawaiiPhysicsModifyBone& Bone : ModifyBones)
-		{
-			if (Bone.bInterBoneDummy)
-			{
-				if (!ensureMsgf(ModifyBones.IsValidIndex(Bone.InterBoneRealParentIndex) &&
-				                ModifyBones.IsValidIndex(Bone.InterBoneRealChildIndex),
-				                TEXT("KawaiiPhysics: invalid inter-bone dummy endpoint index.")))
-				{
-					continue;
-				}
+		return false;
+	}
 
-				Bone.PrevLocation = Bone.Location;
-				Bone.Location = FMath::Lerp(
-					ModifyBones[Bone.InterBoneRealParentIndex].Location,
-					ModifyBones[Bone.InterBoneRealChildIndex].Location,
-					Bone.InterBoneAlpha);
-			}
-		}
+	SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_SimulateModifyBones);
+	if (PrepareSimulateModifyBones(Output))
+	{
+		bPipelinedSimulationPending = true;
 	}
+	return true;
+}
 
-	// bridge dummy（横方向Constraintのコリジョン代理）を端点間で配置。
-	// bBoneSubdivisionCollisionOnlyに依らず常に実行。縦dummyの後（大きいindex）に走るため端点は配置済み。
+void FAnimNode_KawaiiPhysics::LaunchPipelinedSimulation()
+{
+	if (!bPipelinedSimulationPending)
 	{
-		SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_BridgeDummy);
-		const FBoneContainer& BoneContainer = Output.Pose.GetPose().GetBoneContainer();
-		for (FKawaiiPhysicsModifyBone& Bone : ModifyBones)
-		{
-			if (!Bone.bBridgeDummy)
-			{
-				continue;
-			}
+		return;
+	}
+	bPipelinedSimulationPending = false;
+	bPipelinedSimulationInFlight = true;
 
-			if (!ensureMsgf(ModifyBones.IsValidIndex(Bone.InterBoneRealParentIndex) &&
-			                ModifyBones.IsValidIndex(Bone.InterBoneRealChildIndex),
-			                TEXT("KawaiiPhysics: invalid bridge dummy endpoint index.")))
-			{
-				continue;
-			}
+	// CanBatchSimulation を満たすので Output 等は使わない。タスクが書くのは SolverState（ポーズ回転の補間も含む）と
+	// ステップ用の一時メンバだけで、ModifyBones の冷データとノードの設定は読むだけ。次の PreUpdate / Update / Evaluate /
+	// 破棄と、外部からノードを書き換える setter はそれぞれ先に完了を待つ
+	PipelinedSimulationTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [this]()
+	{
+		SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_SimulateModifyBones);
+		StepModifyBones(nullptr, FTransform::Identity, nullptr, nullptr);
+	});
+}
 
-			const FKawaiiPhysicsModifyBone& EndA = ModifyBones[Bone.InterBoneRealParentIndex];
-			const FKawaiiPhysicsModifyBone& EndB = ModifyBones[Bone.InterBoneRealChildIndex];
+void FAnimNode_KawaiiPhysics::WaitPipelinedSimulation()
+{
+	if (PipelinedSimulationTask.IsValid())
+	{
+		SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_WaitPipelinedSimulation);
+		PipelinedSimulationTask.Wait();
+		PipelinedSimulationTask = UE::Tasks::FTask();
+	}
+}
 
-			// LOD安全: 実ボーン端点がLODでカルされていればproxyを無効化し後続コリジョンループからも除外（stale位置で誤判定しない）。
-			// 次フレーム冒頭のダミー配置ループで bSkipSimulate=false に戻り再評価される。
-			if ((!EndA.bDummy && EndA.BoneRef.BoneIndex >= 0 && EndA.BoneRef.GetCompactPoseIndex(BoneContainer) < 0) ||
-				(!EndB.bDummy && EndB.BoneRef.BoneIndex >= 0 && EndB.BoneRef.GetCompactPoseIndex(BoneContainer) < 0))
-			{
-				Bone.bSkipSimulate = true;
-				continue;
-			}
+void FAnimNode_KawaiiPhysics::CompletePipelinedSimulation()
+{
+	WaitPipelinedSimulation();
+	if (!bPipelinedSimulationInFlight)
+	{
+		return;
+	}
+	bPipelinedSimulationInFlight = false;
+	FinishSimulateModifyBones();
+}
 
-			Bone.PrevLocation = Bone.Location;
-			Bone.Location = FMath::Lerp(EndA.Location, EndB.Location, Bone.InterBoneAlpha);
-			// LERP基準位置をPoseLocationに退避（押し出し量 = Location - PoseLocation を測るため。bridge dummyのPoseLocationは他で未使用）。
-			Bone.PoseLocation = Bone.Location;
-		}
+bool FAnimNode_KawaiiPhysics::ShouldSimulateUnderBudget()
+{
+	const UKawaiiPhysicsDeveloperSettings* KawaiiSettings = GetDefault<UKawaiiPhysicsDeveloperSettings>();
+	if (!KawaiiSettings->bUseSimulationBudget)
+	{
+		SimulationBudgetTier = EKawaiiPhysicsBudgetTier::Full;
 	}
 
-	// External Force : PostApply
-	for (int i = 0; i < ExternalForces.Num(); ++i)
+	// Frozen から戻ったら、止まっていた間の時間は追いかけずに現在のポーズからサブステップを始め直す
+	const EKawaiiPhysicsBudgetTier Tier = SimulationBudgetTier;
+	if (LastSimulationBudgetTier == EKawaiiPhysicsBudgetTier::Frozen && Tier != EKawaiiPhysicsBudgetTier::Frozen)
 	{
-		if (ExternalForces[i].IsValid())
-		{
-			auto& Force = ExternalForces[i].GetMutable<FKawaiiPhysics_ExternalForce>();
-			Force.PostApply(*this, Output);
-		}
+		SubstepAccumulator = GetSubstepPhaseOffset();
+		bSubstepPoseInitialized = false;
 	}
-	for (int i = 0; i < TransientForceStore.Items.Num(); ++i)
+	LastSimulationBudgetTier = Tier;
+
+	if (Tier == EKawaiiPhysicsBudgetTier::Frozen)
 	{
-		if (TransientForceStore.Items[i].Force.IsValid())
-		{
-			if (auto* Force = TransientForceStore.Items[i].Force.GetMutablePtr<FKawaiiPhysics_ExternalForce>())
-			{
-				Force->PostApply(*this, Output);
-			}
-		}
+		BudgetSkippedFrames = 0;
+		BudgetSkippedDeltaTime = 0.0f;
+		return false;
 	}
 
-	// ExternalForce::PostApply が substep 毎にコリジョン limit を書き換え得るため、
-	// 形状派生値キャッシュは毎ステップ再計算する（コストは形状数オーダーで誤差級）
-	PrepareCollisionShapeCaches();
+	// LOD 段階の更新間隔と予算の Reduced のうち長い方で間引く
+	const FKawaiiPhysicsLODTier* LODTier = GetActiveLODTier();
+	int32 UpdateInterval = LODTier ? FMath::Max(LODTier->UpdateInterval, 1) : 1;
+	if (Tier == EKawaiiPhysicsBudgetTier::Reduced)
+	{
+		UpdateInterval = FMath::Max(UpdateInterval, FMath::Max(KawaiiSettings->ReducedUpdateInterval, 2));
+	}
+	if (UpdateInterval > 1 && ++BudgetSkippedFrames < UpdateInterval)
+	{
+		BudgetSkippedDeltaTime += DeltaTime;
+		return false;
+	}
 
-	// Adjust by Bone Constraints Before Collision
-	if (BoneConstraintIterationCountBeforeCollision > 0)
+	// スキップしたフレームの時間もまとめてシミュレーションする（固定サブステップでは MaxSubsteps で頭打ち）
+	DeltaTime += BudgetSkippedDeltaTime;
+	BudgetSkippedDeltaTime = 0.0f;
+	BudgetSkippedFrames = 0;
+	return true;
+}
+
+void FAnimNode_KawaiiPhysics::HoldSimulationForBudget(FComponentSpacePoseContext& Output,
+                                                      const FTransform& ComponentTransform)
+{
+	if (SimulationSpace == EKawaiiPhysicsSimulationSpace::WorldSpace)
 	{
-		for (FModifyBoneConstraint& BoneConstraint : MergedBoneConstraints)
-		{
-			BoneConstraint.Lambda = 0.0f;
-		}
-		for (int i = 0; i < BoneConstraintIterationCountBeforeCollision; ++i)
+		// ワールドに置き去りにしないよう、前フレームからの Component の移動をそのまま乗せる（速度は保つ）
+		for (FKawaiiPhysicsModifyBone& Bone : ModifyBones)
 		{
-			AdjustByBoneConstraints();
+			Bone.Location = ConvertSimulationSpaceLocation(Output, EKawaiiPhysicsSimulationSpace::ComponentSpace,
+			                                               SimulationSpace,
+			                                               PreSkelCompTransform.InverseTransformPosition(Bone.Location));
+			Bone.PrevLocation = ConvertSimulationSpaceLocation(Output, EKawaiiPhysicsSimulationSpace::ComponentSpace,
+			                                                   SimulationSpace,
+			                                                   PreSkelCompTransform.InverseTransformPosition(Bone.PrevLocation));
 		}
+		PreSkelCompTransformConsumeFraction = 1.0f;
 	}
+	else
+	{
+		// Reduced は Component の移動を次にシミュレーションするフレームへ繰り越して慣性を残す。Frozen は捨てる
+		PreSkelCompTransformConsumeFraction = SimulationBudgetTier == EKawaiiPhysicsBudgetTier::Frozen ? 1.0f : 0.0f;
+	}
+}
 
-	// Adjust by collisions
-	// NOTE: 形状ごとにループを分けると ModifyBones を複数回走査してキャッシュ効率が落ちるため
-	// （ボーン数が多いケースで負荷増）、従来どおりボーン外側の1パスで全形状を処理する。
-	// World判定の時間は関数内の既存STAT（STAT_KawaiiPhysics_WorldCollision）で計測する。
-	int32 NumWorldChecks = 0;
-	for (FKawaiiPhysicsModifyBone& Bone : ModifyBones)
+float FAnimNode_KawaiiPhysics::EstimateSimulationCostMs() const
+{
+	const UKawaiiPhysicsDeveloperSettings* KawaiiSettings = GetDefault<UKawaiiPhysicsDeveloperSettings>();
+
+	// 固定サブステップならこのフレームで走るステップ数の目安（端数の繰り越しは無視）
+	float NumSteps = 1.0f;
+	if (KawaiiSettings->bUseFixedSubstepping)
 	{
-		if (Bone.bSkipSimulate)
-		{
-			continue;
-		}
+		NumSteps = FMath::Clamp(DeltaTime * GetEffectiveTargetFramerate(), 1.0f,
+		                        static_cast<float>(GetEffectiveMaxSubsteps(KawaiiSettings->MaxSubsteps)));
+	}
 
-		SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_AdjustByCollision);
+	const float NumBones = static_cast<float>(BoneCategories.Simulated.Num() + BoneCategories.BridgeDummies.Num());
+	const float NumColliders = static_cast<float>(CompiledColliders.Num() + CompiledSharedColliders.Num() +
+		CompiledWorldColliders.Num());
+	const float NumConstraintSolves = static_cast<float>(MergedBoneConstraints.Num() *
+		(GetEffectiveBoneConstraintIterationCount(false) + GetEffectiveBoneConstraintIterationCount(true)));
 
-		AdjustBySphereCollision(Bone, SphericalLimits);
-		AdjustBySphereCollision(Bone, SphericalLimitsData);
-		AdjustByCapsuleCollision(Bone, CapsuleLimits);
-		AdjustByCapsuleCollision(Bone, CapsuleLimitsData);
-		AdjustByTaperedCapsuleCollision(Bone, TaperedCapsuleLimits);
-		AdjustByTaperedCapsuleCollision(Bone, TaperedCapsuleLimitsData);
-		AdjustByBoxCollision(Bone, BoxLimits);
-		AdjustByBoxCollision(Bone, BoxLimitsData);
-		AdjustByPlanerCollision(Bone, PlanarLimits);
-		AdjustByPlanerCollision(Bone, PlanarLimitsData);
+	const float CostPerStepUs =
+		NumBones * (KawaiiSettings->BudgetCostPerBoneStepUs + NumColliders * KawaiiSettings->BudgetCostPerColliderTestUs) +
+		NumConstraintSolves * KawaiiSettings->BudgetCostPerBoneConstraintUs;
 
-		// 共有コリジョン（他の KawaiiPhysics ノードから）
-		if (bUseSharedCollision && !bSharedCollisionSource)
-		{
-			AdjustBySphereCollision(Bone, SharedSphericalLimits);
-			AdjustByCapsuleCollision(Bone, SharedCapsuleLimits);
-			AdjustByTaperedCapsuleCollision(Bone, SharedTaperedCapsuleLimits);
-			AdjustByBoxCollision(Bone, SharedBoxLimits);
-			AdjustByPlanerCollision(Bone, SharedPlanarLimits);
-		}
+	// LOD 段階で間引いているノードは1フレームあたりの平均で申告する
+	const FKawaiiPhysicsLODTier* LODTier = GetActiveLODTier();
+	const float LODUpdateInterval = LODTier ? static_cast<float>(FMath::Max(LODTier->UpdateInterval, 1)) : 1.0f;
+	return NumSteps * CostPerStepUs * 0.001f / LODUpdateInterval;
+}
 
-		if (bAllowWorldCollision)
-		{
-			AdjustByWorldCollision(Output, Bone, SkelComp);
-			++NumWorldChecks; // 発行したワールドスイープ回数
-		}
+bool FAnimNode_KawaiiPhysics::CanSleep() const
+{
+	// 止まっていても力が掛かり続ける / 周囲を見ないと分からない構成は眠らせない
+	return bAllowSleep && !bEnableWind && !IsWorldCollisionActive() &&
+		((ExternalForces.IsEmpty() && CustomExternalForces.IsEmpty()) || !AreExternalForcesActive());
+}
+
+bool FAnimNode_KawaiiPhysics::UpdateSleepState(const bool bHasActiveSettingsOverride)
+{
+	if (!CanSleep() || ModifyBones.IsEmpty())
+	{
+		WakeFromSleep();
+		return false;
 	}
-	SET_DWORD_STAT(STAT_KawaiiPhysics_NumWorldCollisionChecks, NumWorldChecks);
 
-	// bridge dummy のコリジョン変位を端点ボーンへ転送（実ボーンを押し出すフィードバック本体）。コリジョン後・Constraint/length復元前。
-	// Push = Location(押し出し後) - PoseLocation(LERP基準)。端点へ距離比 (1-α):α で配分し Scale で強さ調整。端点が縦dummyでも後段length復元で実子へ伝播。
-	if (BoneConstraintSubdivisionCount > 0 && BoneConstraintSubdivisionFeedbackScale > 0.0f)
+	// 起こす要因: ポーズ / Component の移動、一時外力・突風、物理設定オーバーライド。
+	// スリープ中は PrevPoseLocation が眠ったときのポーズのまま残るので、ゆっくりした変化も積もれば起きる
+	const float PoseThresholdSq = FMath::Square(SleepPoseThreshold);
+	bool bDisturbed = !bSubstepPoseInitialized || bHasActiveSettingsOverride || !TransientForceStore.Items.IsEmpty() ||
+		SkelCompMoveVector.SizeSquared() > PoseThresholdSq ||
+		SkelCompMoveRotation.GetAngle() > FMath::DegreesToRadians(SleepWakeRotationThresholdDegrees);
+	for (int32 i = 0; !bDisturbed && i < ModifyBones.Num(); ++i)
 	{
-		SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_BridgeDummy);
-		// 端点ごとに押し出し量と重みを集計し divisor=max(1,重み合計) で割る。多数のdummyが同じ端点を押す病的ケースのみ加重平均でN倍オーバーシュート/発振を防ぐ。
-		// スクラッチ配列は端点index直アクセス。Reset+SetNumZeroed で再利用し TMap 確保/ハッシュをホットパスから排除。
-		const int32 NumBones = ModifyBones.Num();
-		BridgeFeedbackPushScratch.Reset();
-		BridgeFeedbackPushScratch.SetNumZeroed(NumBones);
-		BridgeFeedbackWeightScratch.Reset();
-		BridgeFeedbackWeightScratch.SetNumZeroed(NumBones);
+		bDisturbed = FVector::DistSquared(ModifyBones[i].PoseLocation, ModifyBones[i].PrevPoseLocation) >
+			PoseThresholdSq;
+	}
 
-		for (const FKawaiiPhysicsModifyBone& Bone : ModifyBones)
+	if (bSleeping)
+	{
+		// コライダーがチェーンの範囲に出入りした / 範囲内で動いたら起きる
+		if (!bDisturbed)
 		{
-			if (!Bone.bBridgeDummy || Bone.bSkipSimulate)
-			{
-				continue;
-			}
-			if (!ModifyBones.IsValidIndex(Bone.InterBoneRealParentIndex) ||
-				!ModifyBones.IsValidIndex(Bone.InterBoneRealChildIndex))
-			{
-				continue;
-			}
-
-			const FVector Push = Bone.Location - Bone.PoseLocation; // コリジョンによる押し出し量
-			if (Push.IsNearlyZero())
-			{
-				continue;
-			}
-
-			const float A = Bone.InterBoneAlpha;
-			const int32 E1 = Bone.InterBoneRealParentIndex;
-			const int32 E2 = Bone.InterBoneRealChildIndex;
-			const float W1 = 1.0f - A; // 端点1に近いほど寄与大
-			const float W2 = A;
-
-			BridgeFeedbackPushScratch[E1] += Push * W1;
-			BridgeFeedbackWeightScratch[E1] += W1;
-			BridgeFeedbackPushScratch[E2] += Push * W2;
-			BridgeFeedbackWeightScratch[E2] += W2;
+			int32 ColliderCount = 0;
+			FVector ColliderCenterSum = FVector::ZeroVector;
+			GatherSleepColliderSignature(ColliderCount, ColliderCenterSum);
+			bDisturbed = ColliderCount != SleepColliderCount ||
+				!ColliderCenterSum.Equals(SleepColliderCenterSum, SleepPoseThreshold);
 		}
-
-		for (int32 EndpointIdx = 0; EndpointIdx < NumBones; ++EndpointIdx)
+		if (!bDisturbed)
 		{
-			const float W = BridgeFeedbackWeightScratch[EndpointIdx];
-			if (W > 0.0f)
-			{
-				ModifyBones[EndpointIdx].Location +=
-					(BridgeFeedbackPushScratch[EndpointIdx] / FMath::Max(1.0f, W)) * BoneConstraintSubdivisionFeedbackScale;
-			}
+			return true;
 		}
+		WakeFromSleep();
+		return false;
+	}
+
+	// 速度は前回のシミュレーション結果から求める（単位質量の運動エネルギー 1/2 v^2 で比べる）
+	const float MaxIslandKineticEnergy = UpdateIslandKineticEnergy();
+	if (bDisturbed || MaxIslandKineticEnergy > 0.5f * FMath::Square(SleepVelocityThreshold))
+	{
+		SleepRestFrames = 0;
+		return false;
+	}
+	if (++SleepRestFrames < FMath::Max(SleepFrames, 1))
+	{
+		return false;
+	}
+
+	// 眠る。チェーンの範囲（ボーン半径込み）と、そこに掛かっているコライダーを覚えておく
+	bSleeping = true;
+	SleepBounds = FBox(ForceInit);
+	for (const FKawaiiPhysicsModifyBone& Bone : ModifyBones)
+	{
+		SleepBounds += FBox::BuildAABB(Bone.Location, FVector(Bone.PhysicsSettings.Radius));
+	}
+	GatherSleepColliderSignature(SleepColliderCount, SleepColliderCenterSum);
+	return true;
+}
+
+void FAnimNode_KawaiiPhysics::WakeFromSleep()
+{
+	bSleeping = false;
+	SleepRestFrames = 0;
+}
+
+float FAnimNode_KawaiiPhysics::UpdateIslandKineticEnergy()
+{
+	// 並列化しない（アイランド未分割の）ときはノード全体を1つのアイランドとして扱う
+	const int32 NumIslands = FMath::Max(BoneIslands.Num(), 1);
+	IslandKineticEnergy.Reset(NumIslands);
+	IslandKineticEnergy.AddZeroed(NumIslands);
+	TArray<int32, TInlineAllocator<16>> IslandBoneCounts;
+	IslandBoneCounts.AddZeroed(NumIslands);
+
+	const float InvDeltaTime = DeltaTimeOld > 0.0f ? 1.0f / DeltaTimeOld : 0.0f;
+	for (int32 i = 0; i < ModifyBones.Num(); ++i)
+	{
+		const FKawaiiPhysicsModifyBone& Bone = ModifyBones[i];
+		const int32 Island = FMath::Max(BoneIslands.GetIsland(i), 0);
+		IslandKineticEnergy[Island] +=
+			0.5f * FVector::DistSquared(Bone.Location, Bone.PrevLocation) * FMath::Square(InvDeltaTime);
+		++IslandBoneCounts[Island];
+	}
+
+	float MaxEnergy = 0.0f;
+	for (int32 Island = 0; Island < NumIslands; ++Island)
+	{
+		if (IslandBoneCounts[Island] > 0)
+		{
+			IslandKineticEnergy[Island] /= static_cast<float>(IslandBoneCounts[Island]);
+		}
+		MaxEnergy = FMath::Max(MaxEnergy, IslandKineticEnergy[Island]);
+	}
+	return MaxEnergy;
+}
+
+void FAnimNode_KawaiiPhysics::GatherSleepColliderSignature(int32& OutCount, FVector& OutCenterSum) const
+{
+	// 平面は無限に広がり常に範囲に掛かるので、位置・向きの変化はポーズ / Component の移動で拾う
+	OutCount = 0;
+	OutCenterSum = FVector::ZeroVector;
+	AccumulateSleepColliders(SphericalLimits, SleepBounds, OutCount, OutCenterSum);
+	AccumulateSleepColliders(SphericalLimitsData, SleepBounds, OutCount, OutCenterSum);
+	AccumulateSleepColliders(SharedSphericalLimits, SleepBounds, OutCount, OutCenterSum);
+	AccumulateSleepColliders(CapsuleLimits, SleepBounds, OutCount, OutCenterSum);
+	AccumulateSleepColliders(CapsuleLimitsData, SleepBounds, OutCount, OutCenterSum);
+	AccumulateSleepColliders(SharedCapsuleLimits, SleepBounds, OutCount, OutCenterSum);
+	AccumulateSleepColliders(TaperedCapsuleLimits, SleepBounds, OutCount, OutCenterSum);
+	AccumulateSleepColliders(TaperedCapsuleLimitsData, SleepBounds, OutCount, OutCenterSum);
+	AccumulateSleepColliders(SharedTaperedCapsuleLimits, SleepBounds, OutCount, OutCenterSum);
+	AccumulateSleepColliders(BoxLimits, SleepBounds, OutCount, OutCenterSum);
+	AccumulateSleepColliders(BoxLimitsData, SleepBounds, OutCount, OutCenterSum);
+	AccumulateSleepColliders(SharedBoxLimits, SleepBounds, OutCount, OutCenterSum);
+}
+
+int32 FAnimNode_KawaiiPhysics::SelectLODTier(const TArray<FKawaiiPhysicsLODTier>& Tiers,
+                                             const EKawaiiPhysicsLODMetric Metric, const float MetricValue,
+                                             const int32 CurrentTier)
+{
+	// Margin の分だけ閾値を手前にずらして判定する
+	auto HasCrossed = [&Tiers, Metric, MetricValue](const int32 TierIndex, const float Margin)
+	{
+		const float Threshold = Tiers[TierIndex].Threshold;
+		return Metric == EKawaiiPhysicsLODMetric::Distance
+			       ? MetricValue >= Threshold * (1.0f - Margin)
+			       : MetricValue <= Threshold * (1.0f + Margin);
+	};
+
+	int32 Selected = INDEX_NONE;
+	for (int32 TierIndex = 0; TierIndex < Tiers.Num(); ++TierIndex)
+	{
+		if (HasCrossed(TierIndex, 0.0f))
+		{
+			Selected = TierIndex;
+		}
+	}
+
+	// 今より細かい段階へは、今の段階の閾値からはっきり離れるまで戻らない
+	if (Tiers.IsValidIndex(CurrentTier) && CurrentTier > Selected && HasCrossed(CurrentTier, LODTierHysteresis))
+	{
+		Selected = CurrentTier;
+	}
+	return Selected;
+}
+
+void FAnimNode_KawaiiPhysics::UpdateLODTier()
+{
+	float MetricValue = LODScreenSize;
+	if (LODTierMetric == EKawaiiPhysicsLODMetric::Distance)
+	{
+		MetricValue = LODViewDistance;
+	}
+	else if (LODTierMetric == EKawaiiPhysicsLODMetric::Significance && Significance >= 0.0f)
+	{
+		MetricValue = UKawaiiPhysicsSimulationSubsystem::NormalizeSignificance(Significance);
+	}
+
+	const int32 NewTier = SelectLODTier(LODTiers, LODTierMetric, MetricValue, ActiveLODTier);
+	if (NewTier == ActiveLODTier)
+	{
+		if (LODTierBlendAlpha < 1.0f)
+		{
+			LODTierBlendAlpha = LODTierBlendTime > 0.0f
+				                    ? FMath::Min(LODTierBlendAlpha + DeltaTime / LODTierBlendTime, 1.0f)
+				                    : 1.0f;
+		}
+		return;
+	}
+	ActiveLODTier = NewTier;
+
+	// 切り替え直前の結果を現在のポーズからの揺れとして覚えておく。ブレンド開始時の出力は前フレームの結果と一致する
+	if (LODTierBlendTime > 0.0f && !ModifyBones.IsEmpty())
+	{
+		LODTierBlendFromOffsets.SetNumUninitialized(ModifyBones.Num());
+		for (int32 i = 0; i < ModifyBones.Num(); ++i)
+		{
+			LODTierBlendFromOffsets[i] = ModifyBones[i].Location - ModifyBones[i].PoseLocation;
+		}
+		LODTierBlendAlpha = 0.0f;
+	}
+}
+
+bool FAnimNode_KawaiiPhysics::BeginLODTierBlend()
+{
+	if (LODTierBlendAlpha >= 1.0f || LODTierBlendFromOffsets.Num() != ModifyBones.Num())
+	{
+		LODTierBlendAlpha = 1.0f;
+		return false;
+	}
+
+	LODTierBlendSavedLocations.SetNumUninitialized(ModifyBones.Num());
+	for (int32 i = 0; i < ModifyBones.Num(); ++i)
+	{
+		FKawaiiPhysicsModifyBone& Bone = ModifyBones[i];
+		LODTierBlendSavedLocations[i] = Bone.Location;
+		Bone.Location = FMath::Lerp(Bone.PoseLocation + LODTierBlendFromOffsets[i], Bone.Location, LODTierBlendAlpha);
+	}
+	return true;
+}
+
+void FAnimNode_KawaiiPhysics::EndLODTierBlend()
+{
+	// 次のステップはブレンドしていないシミュレーション結果から進める
+	for (int32 i = 0; i < ModifyBones.Num(); ++i)
+	{
+		ModifyBones[i].Location = LODTierBlendSavedLocations[i];
+	}
+}
+
+float FAnimNode_KawaiiPhysics::GetSubstepPhaseOffset() const
+{
+	if (OutputInterpolation == EKawaiiPhysicsOutputInterpolation::None)
+	{
+		return 0.0f;
+	}
+
+	// ノードのアドレスから決まる位相。同時に生成されたキャラクターでもステップするフレームが分散する
+	const uint32 Hash = MurmurFinalize32(PointerHash(this));
+	return static_cast<float>(Hash % 1024) / 1024.0f / static_cast<float>(GetEffectiveTargetFramerate());
+}
+
+void FAnimNode_KawaiiPhysics::CaptureOutputInterpolationFrom(const float PoseAlpha)
+{
+	if (OutputInterpolation == EKawaiiPhysicsOutputInterpolation::None)
+	{
+		return;
+	}
+
+	// 補間元のポーズはこのステップ直前のサブステップ補間位置（SolverState.PoseLocation はまだ前のステップの値）
+	const int32 NumBones = SolverState.Num();
+	OutputInterpolationFromOffsets.SetNumUninitialized(NumBones);
+	for (int32 i = 0; i < NumBones; ++i)
+	{
+		OutputInterpolationFromOffsets[i] = SolverState.Location[i] -
+			FMath::Lerp(SolverState.PrevPoseLocation[i], SolverState.CurrentPoseLocation[i], PoseAlpha);
+	}
+}
+
+void FAnimNode_KawaiiPhysics::CaptureOutputInterpolationTo()
+{
+	if (OutputInterpolation == EKawaiiPhysicsOutputInterpolation::None)
+	{
+		bOutputInterpolationValid = false;
+		return;
+	}
+
+	const int32 NumBones = SolverState.Num();
+	OutputInterpolationToOffsets.SetNumUninitialized(NumBones);
+	for (int32 i = 0; i < NumBones; ++i)
+	{
+		OutputInterpolationToOffsets[i] = SolverState.Location[i] - SolverState.CurrentPoseLocation[i];
+	}
+	bOutputInterpolationValid = OutputInterpolationFromOffsets.Num() == NumBones;
+}
+
+float FAnimNode_KawaiiPhysics::GetOutputInterpolationAlpha() const
+{
+	return FMath::Clamp(SubstepAccumulator * static_cast<float>(GetEffectiveTargetFramerate()), 0.0f, 1.0f);
+}
+
+bool FAnimNode_KawaiiPhysics::BeginOutputInterpolation()
+{
+	if (OutputInterpolation == EKawaiiPhysicsOutputInterpolation::None || !bOutputInterpolationValid ||
+		!bUseFixedSubsteppingCached || OutputInterpolationToOffsets.Num() != ModifyBones.Num() ||
+		OutputInterpolationFromOffsets.Num() != ModifyBones.Num())
+	{
+		return false;
+	}
+
+	// 揺れを現在のポーズに乗せるので、ステップの無いフレームでも root はポーズに追従する
+	const float InterpolationAlpha = GetOutputInterpolationAlpha();
+	const bool bExtrapolate = OutputInterpolation == EKawaiiPhysicsOutputInterpolation::Extrapolate;
+	OutputInterpolationSavedLocations.SetNumUninitialized(ModifyBones.Num());
+	for (int32 i = 0; i < ModifyBones.Num(); ++i)
+	{
+		FKawaiiPhysicsModifyBone& Bone = ModifyBones[i];
+		const FVector& FromOffset = OutputInterpolationFromOffsets[i];
+		const FVector& ToOffset = OutputInterpolationToOffsets[i];
+		OutputInterpolationSavedLocations[i] = Bone.Location;
+		Bone.Location = Bone.PoseLocation + (bExtrapolate
+			                                     ? ToOffset + (ToOffset - FromOffset) * InterpolationAlpha
+			                                     : FMath::Lerp(FromOffset, ToOffset, InterpolationAlpha));
+	}
+	return true;
+}
+
+void FAnimNode_KawaiiPhysics::EndOutputInterpolation()
+{
+	for (int32 i = 0; i < ModifyBones.Num(); ++i)
+	{
+		ModifyBones[i].Location = OutputInterpolationSavedLocations[i];
+	}
+}
+
+void FAnimNode_KawaiiPhysics::SimulateOnce(FComponentSpacePoseContext* Output,
+                                           const FTransform& ComponentTransform,
+                                           const FSceneInterface* Scene,
+                                           const USkeletalMeshComponent* SkelComp)
+{
+	using EFlags = FKawaiiPhysicsSolverState::EFlags;
+	FKawaiiPhysicsSolverState& State = SolverState;
+	const int32 NumBones = State.Num();
+
+	// root bone（ParentIndex<0）の kinematic follow: （補間済み）ポーズへ追従。
+	// 元の skip ループから移設。サブステップ毎に補間ポーズへ追従させる。
+	for (const int32 i : BoneCategories.KinematicRoots)
+	{
+		State.PrevLocation[i] = State.Location[i];
+		State.Location[i] = State.PoseLocation[i];
+	}
+
+	// bridge dummy feedback の集計バッファは使った端点だけを0へ戻すので、ボーン数が変わったときだけ確保し直す。
+	// 辺コリジョン時は bridge dummy が無いので確保しない
+	const bool bSimulateBridgeDummies = ShouldSimulateDummyBones();
+	const bool bApplyBridgeFeedback = bSimulateBridgeDummies && BoneConstraintSubdivisionCount > 0 &&
+		!bBoneConstraintEdgeCollision && BoneConstraintSubdivisionFeedbackScale > 0.0f;
+	if (bApplyBridgeFeedback && BridgeFeedbackPushScratch.Num() != NumBones)
+	{
+		BridgeFeedbackPushScratch.Reset();
+		BridgeFeedbackPushScratch.SetNumZeroed(NumBones);
+		BridgeFeedbackWeightScratch.Reset();
+		BridgeFeedbackWeightScratch.SetNumZeroed(NumBones);
+	}
+
+	// BoneConstraint で繋がっていない root チェーンはアイランドごとに並列でソルブする
+	if (CanSimulateIslandsInParallel(Scene))
+	{
+		// SIMD カーネルは SolverState 全体を4ボーン単位で回すため、積分だけは全体で先に済ませる
+		const bool bUseSimdIntegration = SimulationSpace != EKawaiiPhysicsSimulationSpace::BaseBoneSpace &&
+			CVarAnimNodeKawaiiPhysicsSimdIntegration.GetValueOnAnyThread();
+		if (bUseSimdIntegration)
+		{
+			SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_Simulate);
+			IntegrateSolverStateSimd();
+		}
+
+		// アイランドから共有して読むコライダーはタスクを起こす前にコンパイルする
+		PrepareCollisionShapeCaches();
+
+		SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_ParallelIslands);
+		ParallelFor(BoneIslands.Num(), [this, bUseSimdIntegration](const int32 IslandIndex)
+		{
+			SimulateIslandOnce(BoneIslands.Islands[IslandIndex], !bUseSimdIntegration);
+		}, EParallelForFlags::Unbalanced);
+		SET_DWORD_STAT(STAT_KawaiiPhysics_NumWorldCollisionChecks, 0);
+		return;
+	}
+
+	// 積分対象: skip / bridge dummy（縦親無し） / コリジョン専用モードの inter-bone dummy を除いたボーン
+	const TArray<int32>& IntegratedBones = BoneCategories.GetIntegrated(IsInterBoneDummyCollisionOnly());
+
+	// Simulate（剛性係数と BaseBoneSpace の world 移動量は UpdateStepInvariants で求め済み）
+	if (NeedsPerBoneSimulateHooks(Scene))
+	{
+		// wind / 外力フックは FKawaiiPhysicsModifyBone を受け取り他ボーンも参照し得るため、
+		// ModifyBones へ同期して従来どおり Simulate() を回し、結果を SolverState へ戻す。
+		{
+			SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_SolverStateSync);
+			State.Scatter(ModifyBones);
+			// フックは BoneTransform 等で補間済みのポーズ回転を読み得る（同期実行のみなので ModifyBones へ書いてよい）
+			if (bInSubstep)
+			{
+				State.ScatterPoseRotation(ModifyBones);
+			}
+		}
+
+		// コリジョン専用モードの inter-bone dummy はコリジョンとbone length restorationのみ（後で実行）。
+		// bridge dummy は縦親が無く ModifyBones[ParentIndex] 参照でクラッシュするため常に対象外。
+		// フックは Output を要するため、バッチ実行（Output 無し）の対象にはならない（CanBatchSimulation）
+		check(Output);
+		for (const int32 i : IntegratedBones)
+		{
+			Simulate(ModifyBones[i], Scene, ComponentTransform, SkelComp, *Output);
+		}
+
+		{
+			SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_SolverStateSync);
+			State.Gather(ModifyBones);
+			// 出力済みの ModifyBones は現フレームのポーズ回転に戻す
+			if (bInSubstep)
+			{
+				for (FKawaiiPhysicsModifyBone& Bone : ModifyBones)
+				{
+					Bone.PoseRotation = Bone.CurrentPoseRotation;
+				}
+			}
+		}
+	}
+	else
+	{
+		// フック無し: Simulate() と同じ順序の物理計算を SolverState 上で直接実行
+		SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_Simulate);
+
+		const bool bBaseBoneSpace = SimulationSpace == EKawaiiPhysicsSimulationSpace::BaseBoneSpace;
+		// BaseBoneSpace の world 追従は Output 依存の空間変換を伴うためスカラー経路のみ
+		const bool bUseSimdIntegration =
+			!bBaseBoneSpace && CVarAnimNodeKawaiiPhysicsSimdIntegration.GetValueOnAnyThread();
+		if (bUseSimdIntegration)
+		{
+			IntegrateSolverStateSimd();
+		}
+		else
+		{
+			IntegrateBones(IntegratedBones);
+		}
+	}
+
+	// コリジョン専用モードの inter-bone dummy / bridge dummy の配置
+	PlaceDummyBones(BoneCategories);
+
+	// External Force : PostApply
+	// 注: ModifyBones 側の位置は積分フェーズ時点のもの（フック経路で同期済み）
+	if (AreExternalForcesActive())
+	{
+		for (int i = 0; i < ExternalForces.Num(); ++i)
+		{
+			if (ExternalForces[i].IsValid())
+			{
+				auto& Force = ExternalForces[i].GetMutable<FKawaiiPhysics_ExternalForce>();
+				Force.PostApply(*this, *Output);
+			}
+		}
+	}
+	for (int i = 0; i < TransientForceStore.Items.Num(); ++i)
+	{
+		if (TransientForceStore.Items[i].Force.IsValid())
+		{
+			if (auto* Force = TransientForceStore.Items[i].Force.GetMutablePtr<FKawaiiPhysics_ExternalForce>())
+			{
+				Force->PostApply(*this, *Output);
+			}
+		}
+	}
+
+	// ExternalForce::PostApply が substep 毎にコリジョン limit を書き換え得るため、
+	// 形状派生値キャッシュは毎ステップ再計算する（コストは形状数オーダーで誤差級）
+	PrepareCollisionShapeCaches();
+
+	// Adjust by Bone Constraints Before Collision
+	SolveBoneConstraints(GetEffectiveBoneConstraintIterationCount(false), nullptr);
+
+	// Adjust by collisions
+	// NOTE: 形状ごとにループを分けると位置ストリームを複数回走査してキャッシュ効率が落ちるため
+	// （ボーン数が多いケースで負荷増）、従来どおりボーン外側の1パスで全形状を処理する。
+	// World判定の時間は関数内の既存STAT（STAT_KawaiiPhysics_WorldCollision）で計測する。
+	// 対象は simulate 対象ボーン + bridge dummy。各ボーンの押し出しは互いに独立なので、2リストに分けても結果は同じ。
+	int32 NumWorldChecks = 0;
+	const bool bWorldCollision = IsWorldCollisionActive();
+	auto AdjustBoneByCollision = [&](const int32 i)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_AdjustByCollision);
+
+		FVector& Location = State.Location[i];
+		const FVector& PrevLocation = State.PrevLocation[i];
+		const float Radius = State.Radius[i];
+
+		// AnimNode / DataAsset 由来（PrepareCollisionShapeCaches でコンパイル済み。関連マスクでボーンごとに絞る）
+		AdjustByColliderBuffer(Location, PrevLocation, Radius, CompiledColliders, i);
+
+		// 共有コリジョン（他の KawaiiPhysics ノードから。受信側でない場合は空）
+		AdjustByColliderBuffer(Location, PrevLocation, Radius, CompiledSharedColliders);
+
+		if (bWorldCollision && WorldCollisionMode == EKawaiiPhysicsWorldCollisionMode::AsyncSweep)
+		{
+			// 非同期スイープの結果（UpdateAsyncWorldCollision で作った接触平面）で押し出す
+			AdjustByAsyncWorldContact(Location, i);
+		}
+		else if (bWorldCollision && WorldCollisionMode == EKawaiiPhysicsWorldCollisionMode::Broadphase)
+		{
+			// 重なり判定で集めた形状（UpdateWorldCollisionBroadphase でコンパイル済み）をコリジョン limit と同じカーネルで判定
+			AdjustByColliderBuffer(Location, PrevLocation, Radius, CompiledWorldColliders);
+		}
+		else if (bWorldCollision)
+		{
+			// ワールドスイープは BoneRef 等の冷データも使うため ModifyBones 経由で呼ぶ
+			FKawaiiPhysicsModifyBone& Bone = ModifyBones[i];
+			Bone.Location = Location;
+			Bone.PrevLocation = PrevLocation;
+			AdjustByWorldCollision(*Output, Bone, SkelComp);
+			Location = Bone.Location;
+			++NumWorldChecks; // 発行したワールドスイープ回数
+		}
+	};
+	for (const int32 i : BoneCategories.Simulated)
+	{
+		AdjustBoneByCollision(i);
+	}
+	for (const int32 i : BoneCategories.BridgeDummies)
+	{
+		// 端点が LOD でカルされた bridge dummy はこのステップで skip 済み
+		if (bSimulateBridgeDummies && !State.HasFlag(i, EFlags::Flag_SkipSimulate))
+		{
+			AdjustBoneByCollision(i);
+		}
+	}
+	SET_DWORD_STAT(STAT_KawaiiPhysics_NumWorldCollisionChecks, NumWorldChecks);
+
+	// ボーン区間をカプセルとして判定し、関節の間をすり抜けたコライダーの分を両端のボーンへ戻す
+	if (bBoneSegmentCollision)
+	{
+		AdjustBoneSegmentsByCollision(BoneCategories.Simulated);
+	}
+
+	// 横方向 Constraint の辺をカプセルとして判定し、列の間をすり抜けたコライダーの分を両端点へ戻す（bridge dummy の代わり）
+	if (bBoneConstraintEdgeCollision)
+	{
+		AdjustBoneConstraintEdgesByCollision(nullptr);
+	}
+
+	// bridge dummy のコリジョン変位を端点ボーンへ転送（実ボーンを押し出すフィードバック本体）。コリジョン後・Constraint/length復元前。
+	if (bApplyBridgeFeedback)
+	{
+		ApplyBridgeDummyFeedback(BoneCategories.BridgeDummies);
 	}
 
 	// Adjust by Bone Constraints After Collision
-	if (BoneConstraintIterationCountAfterCollision > 0)
+	SolveBoneConstraints(GetEffectiveBoneConstraintIterationCount(true), nullptr);
+
+	// Adjust by Limits and Bone Length
+	AdjustByLimitsAndLength(BoneCategories.Simulated);
+	// 注: DeltaTimeOld は呼び出し元 SimulateModifyBones（legacy=DeltaTime / substep=FixedDt）で設定
+}
+
+bool FAnimNode_KawaiiPhysics::CanSimulateIslandsInParallel(const FSceneInterface* Scene) const
+{
+	// ノード全体を触る処理が無い条件はバッチ実行（Output 無しで回せる）と同じ
+	return BoneIslands.Num() > 1 && CVarAnimNodeKawaiiPhysicsParallelIslands.GetValueOnAnyThread() &&
+		CanBatchSimulation(Scene);
+}
+
+void FAnimNode_KawaiiPhysics::SimulateIslandOnce(const FKawaiiPhysicsBoneIsland& Island, const bool bIntegrate)
+{
+	using EFlags = FKawaiiPhysicsSolverState::EFlags;
+	FKawaiiPhysicsSolverState& State = SolverState;
+	const FKawaiiPhysicsBoneCategories& Categories = Island.Categories;
+
+	// SimulateOnce の逐次経路と同じ順序を、このアイランドのボーンと Constraint だけで行う
+	if (bIntegrate)
 	{
-		for (FModifyBoneConstraint& BoneConstraint : MergedBoneConstraints)
+		SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_Simulate);
+		IntegrateBones(Categories.GetIntegrated(IsInterBoneDummyCollisionOnly()));
+	}
+
+	PlaceDummyBones(Categories);
+
+	SolveBoneConstraints(GetEffectiveBoneConstraintIterationCount(false), &Island.Constraints);
+
+	const bool bSimulateBridgeDummies = ShouldSimulateDummyBones();
+	{
+		SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_AdjustByCollision);
+		auto AdjustBoneByCollision = [&](const int32 i)
 		{
-			BoneConstraint.Lambda = 0.0f;
+			FVector& Location = State.Location[i];
+			const FVector& PrevLocation = State.PrevLocation[i];
+			const float Radius = State.Radius[i];
+			AdjustByColliderBuffer(Location, PrevLocation, Radius, CompiledColliders, i);
+			AdjustByColliderBuffer(Location, PrevLocation, Radius, CompiledSharedColliders);
+		};
+		for (const int32 i : Categories.Simulated)
+		{
+			AdjustBoneByCollision(i);
 		}
-		for (int i = 0; i < BoneConstraintIterationCountAfterCollision; ++i)
+		for (const int32 i : Categories.BridgeDummies)
 		{
-			AdjustByBoneConstraints();
+			if (bSimulateBridgeDummies && !State.HasFlag(i, EFlags::Flag_SkipSimulate))
+			{
+				AdjustBoneByCollision(i);
+			}
 		}
 	}
 
-	// Adjust by Limits and Bone Length（角度制限 + 平面制約 + ボーン長復元のO(N)ループをまとめて計測）
+	// 区間の親は同じチェーン（= 同じアイランド）にあるので、書き込み先は他のアイランドと重ならない
+	if (bBoneSegmentCollision)
 	{
-		SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_AdjustByLimitsAndLength);
-		for (FKawaiiPhysicsModifyBone& Bone : ModifyBones)
+		AdjustBoneSegmentsByCollision(Categories.Simulated);
+	}
+
+	// アイランドは Constraint で繋がったボーンをまとめているので、辺の両端点もこのアイランドにある
+	if (bBoneConstraintEdgeCollision)
+	{
+		AdjustBoneConstraintEdgesByCollision(&Island.Constraints);
+	}
+
+	// bridge dummy の端点は同じアイランドにあるので、集計バッファの書き込み先は他のアイランドと重ならない
+	if (bSimulateBridgeDummies && BoneConstraintSubdivisionCount > 0 && !bBoneConstraintEdgeCollision &&
+		BoneConstraintSubdivisionFeedbackScale > 0.0f)
+	{
+		ApplyBridgeDummyFeedback(Categories.BridgeDummies);
+	}
+
+	SolveBoneConstraints(GetEffectiveBoneConstraintIterationCount(true), &Island.Constraints);
+
+	AdjustByLimitsAndLength(Categories.Simulated);
+}
+
+void FAnimNode_KawaiiPhysics::IntegrateBones(const TArray<int32>& Bones)
+{
+	FKawaiiPhysicsSolverState& State = SolverState;
+	const bool bBaseBoneSpace = SimulationSpace == EKawaiiPhysicsSimulationSpace::BaseBoneSpace;
+	for (const int32 i : Bones)
+	{
+		FVector& Location = State.Location[i];
+		FVector& PrevLocation = State.PrevLocation[i];
+		const int32 ParentIndex = State.ParentIndex[i];
+
+		const FVector Velocity =
+			ComputeVerletStepVelocity(Location, PrevLocation, State.Damping[i], FVector::ZeroVector);
+		IntegrateVerletStepPosition(Location, Velocity);
+		ApplySimpleExternalForce(Location);
+
+		// Follow World Movement
+		if (bBaseBoneSpace)
 		{
-			if (Bone.bSkipSimulate)
+			if (TeleportType != ETeleportType::TeleportPhysics)
 			{
-				continue;
+				ApplyWorldMoveFollowBaseBone(Location, PrevLocation, State.WorldDampingLocation[i],
+				                             State.WorldDampingRotation[i]);
 			}
+		}
+		else
+		{
+			ApplyWorldMoveFollowNonBaseBone(Location, PrevLocation, State.WorldDampingLocation[i],
+			                                State.WorldDampingRotation[i]);
+		}
+
+		// Pull to Pose Location（剛性）
+		ApplyStiffnessPull(Location, State.PoseLocation[i], State.Location[ParentIndex],
+		                   State.PoseLocation[ParentIndex], State.StiffnessFactor[i]);
+	}
+}
+
+void FAnimNode_KawaiiPhysics::PlaceDummyBones(const FKawaiiPhysicsBoneCategories& Categories)
+{
+	using EFlags = FKawaiiPhysicsSolverState::EFlags;
+	FKawaiiPhysicsSolverState& State = SolverState;
 
-			// bridge dummyは縦親を持たないため長さ/角度復元をスキップ（ParentIndex=-1参照でクラッシュ）。
-			// 位置は直前のconstraint solveで確定済みで、次フレーム冒頭で端点間に再LERPされる。
-			if (Bone.bBridgeDummy)
+	// コリジョン専用モード（LOD 段階で dummy を止めている場合も）: 全実ボーンのシミュレーション完了後、
+	// シミュレーション済みのLocation間にダミーを配置
+	if (IsInterBoneDummyCollisionOnly())
+	{
+		for (const int32 i : Categories.InterBoneDummies)
+		{
+			const int32 RealParentIndex = State.InterBoneRealParentIndex[i];
+			const int32 RealChildIndex = State.InterBoneRealChildIndex[i];
+			if (!ensureMsgf(State.Location.IsValidIndex(RealParentIndex) &&
+			                State.Location.IsValidIndex(RealChildIndex),
+			                TEXT("KawaiiPhysics: invalid inter-bone dummy endpoint index.")))
 			{
 				continue;
 			}
 
-			auto& ParentBone = ModifyBones[Bone.ParentIndex];
+			State.PrevLocation[i] = State.Location[i];
+			State.Location[i] = FMath::Lerp(State.Location[RealParentIndex], State.Location[RealChildIndex],
+			                                State.InterBoneAlpha[i]);
+		}
+	}
+
+	// bridge dummy（横方向Constraintのコリジョン代理）を端点間で配置。
+	// bBoneSubdivisionCollisionOnlyに依らず常に実行。縦dummyの後（大きいindex）に走るため端点は配置済み。
+	SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_BridgeDummy);
+	for (const int32 i : Categories.BridgeDummies)
+	{
+		const int32 EndAIndex = State.InterBoneRealParentIndex[i];
+		const int32 EndBIndex = State.InterBoneRealChildIndex[i];
+		if (!ensureMsgf(ModifyBones.IsValidIndex(EndAIndex) && ModifyBones.IsValidIndex(EndBIndex),
+		                TEXT("KawaiiPhysics: invalid bridge dummy endpoint index.")))
+		{
+			continue;
+		}
+
+		// LOD判定は BoneRef（冷データ）を ModifyBones 側から読む
+		const FKawaiiPhysicsModifyBone& EndA = ModifyBones[EndAIndex];
+		const FKawaiiPhysicsModifyBone& EndB = ModifyBones[EndBIndex];
+
+		// LOD安全: 実ボーン端点がLODでカルされていればproxyを無効化し後続コリジョンループからも除外（stale位置で誤判定しない）。
+		// 次フレーム冒頭のダミー配置ループで bSkipSimulate=false に戻り再評価される。
+		// compact pose index は InitializeBoneReferences でキャッシュ済みの値を読む（GetCompactPoseIndex と同値。Output 不要）
+		if ((!EndA.bDummy && EndA.BoneRef.BoneIndex >= 0 && EndA.BoneRef.CachedCompactPoseIndex < 0) ||
+			(!EndB.bDummy && EndB.BoneRef.BoneIndex >= 0 && EndB.BoneRef.CachedCompactPoseIndex < 0))
+		{
+			State.SetFlag(i, EFlags::Flag_SkipSimulate, true);
+			continue;
+		}
+
+		State.PrevLocation[i] = State.Location[i];
+		State.Location[i] = FMath::Lerp(State.Location[EndAIndex], State.Location[EndBIndex], State.InterBoneAlpha[i]);
+		// LERP基準位置をPoseLocationに退避（押し出し量 = Location - PoseLocation を測るため。bridge dummyのPoseLocationは他で未使用）。
+		State.PoseLocation[i] = State.Location[i];
+	}
+}
+
+void FAnimNode_KawaiiPhysics::SolveBoneConstraints(const int32 IterationCount, const TArray<int32>* ConstraintIndices)
+{
+	if (IterationCount <= 0)
+	{
+		return;
+	}
+
+	if (ConstraintIndices)
+	{
+		for (const int32 ConstraintIndex : *ConstraintIndices)
+		{
+			MergedBoneConstraints[ConstraintIndex].Lambda = 0.0f;
+		}
+		for (int32 i = 0; i < IterationCount; ++i)
+		{
+			AdjustByBoneConstraints(SolverState.Location, *ConstraintIndices);
+		}
+	}
+	else
+	{
+		for (FModifyBoneConstraint& BoneConstraint : MergedBoneConstraints)
+		{
+			BoneConstraint.Lambda = 0.0f;
+		}
+		// 今の Constraint 配列に対して色分け済みなら色ごとのバッチで解く（解く順序は色順になる）
+		const bool bUseColoredSolve = CVarAnimNodeKawaiiPhysicsColoredBoneConstraints.GetValueOnAnyThread() &&
+			BoneConstraintColors.IsBuiltFor(BoneConstraintGeneration, MergedBoneConstraints.Num());
+		for (int32 i = 0; i < IterationCount; ++i)
+		{
+			if (bUseColoredSolve)
+			{
+				AdjustByBoneConstraintsColored(SolverState.Location);
+			}
+			else
+			{
+				AdjustByBoneConstraints(SolverState.Location);
+			}
+		}
+	}
+}
+
+void FAnimNode_KawaiiPhysics::ApplyBridgeDummyFeedback(const TArray<int32>& BridgeDummies)
+{
+	using EFlags = FKawaiiPhysicsSolverState::EFlags;
+	FKawaiiPhysicsSolverState& State = SolverState;
+
+	// Push = Location(押し出し後) - PoseLocation(LERP基準)。端点へ距離比 (1-α):α で配分し Scale で強さ調整。端点が縦dummyでも後段length復元で実子へ伝播。
+	SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_BridgeDummy);
+	// 端点ごとに押し出し量と重みを集計し divisor=max(1,重み合計) で割る。多数のdummyが同じ端点を押す病的ケースのみ加重平均でN倍オーバーシュート/発振を防ぐ。
+	// スクラッチ配列は端点index直アクセス（呼び出し側でボーン数分を0で確保済み）。TMap 確保/ハッシュをホットパスから排除。
+	for (const int32 i : BridgeDummies)
+	{
+		if (State.HasFlag(i, EFlags::Flag_SkipSimulate))
+		{
+			continue;
+		}
+		const int32 E1 = State.InterBoneRealParentIndex[i];
+		const int32 E2 = State.InterBoneRealChildIndex[i];
+		if (!State.Location.IsValidIndex(E1) || !State.Location.IsValidIndex(E2))
+		{
+			continue;
+		}
+
+		const FVector Push = State.Location[i] - State.PoseLocation[i]; // コリジョンによる押し出し量
+		if (Push.IsNearlyZero())
+		{
+			continue;
+		}
 
-			// Adjust by angle limit
-			AdjustByAngleLimit(Bone, ParentBone);
+		const float A = State.InterBoneAlpha[i];
+		const float W1 = 1.0f - A; // 端点1に近いほど寄与大
+		const float W2 = A;
 
-			// Adjust by Planar Constraint
-			AdjustByPlanarConstraint(Bone, ParentBone);
+		BridgeFeedbackPushScratch[E1] += Push * W1;
+		BridgeFeedbackWeightScratch[E1] += W1;
+		BridgeFeedbackPushScratch[E2] += Push * W2;
+		BridgeFeedbackWeightScratch[E2] += W2;
+	}
 
-			// Restore Bone Length
-			const float BoneLength = (Bone.PoseLocation - ParentBone.PoseLocation).Size();
-			Bone.Location = (Bone.Location - ParentBone.Location).GetSafeNormal() * BoneLength + ParentBone.Location;
+	// 端点ごとに1回だけ反映し、その場で0へ戻す（全ボーン分の走査・クリアをしない）
+	auto ApplyEndpoint = [this, &State](const int32 EndpointIdx)
+	{
+		const float W = BridgeFeedbackWeightScratch[EndpointIdx];
+		if (W > 0.0f)
+		{
+			State.Location[EndpointIdx] +=
+				(BridgeFeedbackPushScratch[EndpointIdx] / FMath::Max(1.0f, W)) * BoneConstraintSubdivisionFeedbackScale;
+		}
+		BridgeFeedbackPushScratch[EndpointIdx] = FVector::ZeroVector;
+		BridgeFeedbackWeightScratch[EndpointIdx] = 0.0f;
+	};
+	for (const int32 i : BridgeDummies)
+	{
+		const int32 E1 = State.InterBoneRealParentIndex[i];
+		const int32 E2 = State.InterBoneRealChildIndex[i];
+		if (State.Location.IsValidIndex(E1) && State.Location.IsValidIndex(E2))
+		{
+			ApplyEndpoint(E1);
+			ApplyEndpoint(E2);
 		}
 	}
-	// 注: DeltaTimeOld は呼び出し元 SimulateModifyBones（legacy=DeltaTime / substep=FixedDt）で設定
+}
+
+void FAnimNode_KawaiiPhysics::AdjustByLimitsAndLength(const TArray<int32>& Bones)
+{
+	// 角度制限 + 平面制約 + ボーン長復元のO(N)ループをまとめて計測
+	// ポーズ側の長さ・向きは UpdateRestPose で求め済みなので、ここではポーズ差分の sqrt / 正規化をしない
+	SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_AdjustByLimitsAndLength);
+	FKawaiiPhysicsSolverState& State = SolverState;
+
+	// bridge dummyは縦親を持たないため長さ/角度復元の対象外（ParentIndex=-1参照でクラッシュ）。
+	// 位置は直前のconstraint solveで確定済みで、次フレーム冒頭で端点間に再LERPされる。
+	for (const int32 i : Bones)
+	{
+		const int32 ParentIndex = State.ParentIndex[i];
+		FVector& Location = State.Location[i];
+		const FVector& ParentLocation = State.Location[ParentIndex];
+		// 親の PoseRotation（サブステップ中は補間済み）は角度制限の代替軸/平面拘束の法線にのみ使う
+		const FQuat& ParentPoseRotation = State.PoseRotation[ParentIndex];
+
+		// Adjust by angle limit
+		AdjustByAngleLimit(Location, ParentLocation, State.PoseDirection[i], ParentPoseRotation,
+		                   State.LimitAngle[i]);
+
+		// Adjust by Planar Constraint
+		AdjustByPlanarConstraint(Location, ParentLocation, ParentPoseRotation);
+
+		// Restore Bone Length
+		Location = (Location - ParentLocation).GetSafeNormal() * State.RestLength[i] + ParentLocation;
+	}
 }
 
 FTransform FAnimNode_KawaiiPhysics::ResolveExternalForceBoneTransform(
@@ -947,8 +1816,7 @@ FTransform FAnimNode_KawaiiPhysics::ResolveExternalForceBoneTransform(
 
 void FAnimNode_KawaiiPhysics::Simulate(FKawaiiPhysicsModifyBone& Bone, const FSceneInterface* Scene,
                                        const FTransform& ComponentTransform,
-                                       const float& Exponent, const USkeletalMeshComponent* SkelComp,
-                                       FComponentSpacePoseContext& Output)
+                                       const USkeletalMeshComponent* SkelComp, FComponentSpacePoseContext& Output)
 {
 	SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_Simulate);
 
@@ -965,7 +1833,8 @@ void FAnimNode_KawaiiPhysics::Simulate(FKawaiiPhysicsModifyBone& Bone, const FSc
 	FVector Velocity = ComputeVerletStepVelocity(Bone, WindVelocity);
 
 	// ユーザー外力に実速度を渡す（gravity の後・位置更新の前）。ApplyToVelocity が InOutVelocity を読む実装もあり得るため実速度に対して呼ぶ。
-	for (int i = 0; i < ExternalForces.Num(); ++i)
+	const bool bExternalForcesActive = AreExternalForcesActive();
+	for (int i = 0; bExternalForcesActive && i < ExternalForces.Num(); ++i)
 	{
 		if (ExternalForces[i].IsValid())
 		{
@@ -1001,19 +1870,9 @@ void FAnimNode_KawaiiPhysics::Simulate(FKawaiiPhysicsModifyBone& Bone, const FSc
 	if (SimulationSpace == EKawaiiPhysicsSimulationSpace::BaseBoneSpace
 		&& TeleportType != ETeleportType::TeleportPhysics)
 	{
-		// BaseBoneSpace は Output 依存の空間変換が必要なため、別関数に切り出さずここで実行。
-		// Follow Translation
-		const FVector SkelCompMoveVectorBBS =
-			ConvertSimulationSpaceVector(Output, EKawaiiPhysicsSimulationSpace::ComponentSpace,
-			                             EKawaiiPhysicsSimulationSpace::BaseBoneSpace, SkelCompMoveVector);
-		Bone.Location += SkelCompMoveVectorBBS * (1.0f - Bone.PhysicsSettings.WorldDampingLocation);
-
-		// Follow Rotation
-		const FVector PrevLocationCS = PrevBaseBoneSpace2ComponentSpace.TransformPosition(Bone.PrevLocation);
-		const FVector RotatedLocationCS = SkelCompMoveRotation.RotateVector(PrevLocationCS);
-		const FVector RotatedLocationBase = ConvertSimulationSpaceLocationCached(
-			FSimulationSpaceCache(), CurrentEvalSimSpaceCache, RotatedLocationCS);
-		Bone.Location += (RotatedLocationBase - Bone.PrevLocation) * (1.0f - Bone.PhysicsSettings.WorldDampingRotation);
+		ApplyWorldMoveFollowBaseBone(Bone.Location, Bone.PrevLocation,
+		                             Bone.PhysicsSettings.WorldDampingLocation,
+		                             Bone.PhysicsSettings.WorldDampingRotation);
 	}
 	else
 	{
@@ -1023,7 +1882,7 @@ void FAnimNode_KawaiiPhysics::Simulate(FKawaiiPhysicsModifyBone& Bone, const FSc
 
 	// External Force
 	// 注: foreach を使うと問題が起きうる（ranged-for 中に配列が変化する）
-	for (int i = 0; i < CustomExternalForces.Num(); ++i)
+	for (int i = 0; bExternalForcesActive && i < CustomExternalForces.Num(); ++i)
 	{
 		if (CustomExternalForces[i] && CustomExternalForces[i]->bIsEnabled)
 		{
@@ -1032,7 +1891,7 @@ void FAnimNode_KawaiiPhysics::Simulate(FKawaiiPhysicsModifyBone& Bone, const FSc
 		}
 	}
 
-	for (int i = 0; i < ExternalForces.Num(); ++i)
+	for (int i = 0; bExternalForcesActive && i < ExternalForces.Num(); ++i)
 	{
 		if (ExternalForces[i].IsValid())
 		{
@@ -1075,7 +1934,8 @@ void FAnimNode_KawaiiPhysics::Simulate(FKawaiiPhysicsModifyBone& Bone, const FSc
 	}
 
 	// Pull to Pose Location（剛性）
-	ApplyStiffnessPull(Bone, ParentBone, Exponent);
+	ApplyStiffnessPull(Bone.Location, Bone.PoseLocation, ParentBone.Location, ParentBone.PoseLocation,
+	                   SolverState.StiffnessFactor[Bone.Index]);
 }
 
 // ============================================================================
@@ -1085,14 +1945,20 @@ void FAnimNode_KawaiiPhysics::Simulate(FKawaiiPhysicsModifyBone& Bone, const FSc
 
 FVector FAnimNode_KawaiiPhysics::ComputeVerletStepVelocity(FKawaiiPhysicsModifyBone& Bone,
                                                      const FVector& WindVelocity)
+{
+	return ComputeVerletStepVelocity(Bone.Location, Bone.PrevLocation, Bone.PhysicsSettings.Damping, WindVelocity);
+}
+
+FVector FAnimNode_KawaiiPhysics::ComputeVerletStepVelocity(FVector& Location, FVector& PrevLocation,
+                                                           const float Damping, const FVector& WindVelocity) const
 {
 	// 速度は前ステップ変位を DeltaTimeOld で割って再構成。固定サブステップ時 DeltaTimeOld=FixedDt。
-	FVector Velocity = (Bone.Location - Bone.PrevLocation) / FMath::Max(DeltaTimeOld, KINDA_SMALL_NUMBER);
-	Bone.PrevLocation = Bone.Location;
+	FVector Velocity = (Location - PrevLocation) / FMath::Max(DeltaTimeOld, KINDA_SMALL_NUMBER);
+	PrevLocation = Location;
 
 	// 毎ステップ生の damping 係数。固定サブステップ経路ではStepDeltaTime一定によりフレームレート依存が解消される。
 	// legacy(非サブステップ)経路は後方互換目的で意図的に dt 非正規化のまま（フレームレート依存が残る）。
-	Velocity *= (1.0f - Bone.PhysicsSettings.Damping);
+	Velocity *= (1.0f - Damping);
 
 	// wind（呼び出し元で計算済み）
 	Velocity += WindVelocity;
@@ -1107,50 +1973,146 @@ FVector FAnimNode_KawaiiPhysics::ComputeVerletStepVelocity(FKawaiiPhysicsModifyB
 	else
 	{
 		// Legacy gravity: 0.5 * g * dt^2 を位置へ加算
-		Bone.Location += 0.5 * GravityInSimSpace * StepDt * StepDt;
+		Location += 0.5 * GravityInSimSpace * StepDt * StepDt;
 	}
 
 	return Velocity;
 }
 
 void FAnimNode_KawaiiPhysics::IntegrateVerletStepPosition(FKawaiiPhysicsModifyBone& Bone, const FVector& Velocity)
+{
+	IntegrateVerletStepPosition(Bone.Location, Velocity);
+}
+
+void FAnimNode_KawaiiPhysics::IntegrateVerletStepPosition(FVector& Location, const FVector& Velocity) const
 {
 	// 速度から位置を積分
-	Bone.Location += Velocity * GetStepDeltaTime();
+	Location += Velocity * GetStepDeltaTime();
 }
 
 void FAnimNode_KawaiiPhysics::ApplySimpleExternalForce(FKawaiiPhysicsModifyBone& Bone)
+{
+	ApplySimpleExternalForce(Bone.Location);
+}
+
+void FAnimNode_KawaiiPhysics::ApplySimpleExternalForce(FVector& Location) const
 {
 	// Simple External Force（速度を経由しない位置オフセット。SimulateModifyBones でキャッシュ済み）。
 	// world-move / stiffness と同じ「位置空間の後処理」なので Verlet ステップから分離している。
 	if (!SimpleExternalForceInSimSpace.IsNearlyZero())
 	{
-		Bone.Location += SimpleExternalForceInSimSpace * GetStepDeltaTime();
+		Location += SimpleExternalForceInSimSpace * GetStepDeltaTime();
 	}
 }
 
 void FAnimNode_KawaiiPhysics::ApplyWorldMoveFollowNonBaseBone(FKawaiiPhysicsModifyBone& Bone)
 {
-	// Follow World Movement（ComponentSpace/WorldSpace のみ。BaseBoneSpaceは Simulate() で別処理）
+	ApplyWorldMoveFollowNonBaseBone(Bone.Location, Bone.PrevLocation, Bone.PhysicsSettings.WorldDampingLocation,
+	                                Bone.PhysicsSettings.WorldDampingRotation);
+}
+
+void FAnimNode_KawaiiPhysics::ApplyWorldMoveFollowNonBaseBone(FVector& Location, const FVector& PrevLocation,
+                                                              const float WorldDampingLocation,
+                                                              const float WorldDampingRotation) const
+{
+	// Follow World Movement（ComponentSpace/WorldSpace のみ。BaseBoneSpaceは ApplyWorldMoveFollowBaseBone で別処理）
 	if (SimulationSpace != EKawaiiPhysicsSimulationSpace::WorldSpace
 		&& TeleportType != ETeleportType::TeleportPhysics)
 	{
 		// Follow Translation
-		Bone.Location += SkelCompMoveVector * (1.0f - Bone.PhysicsSettings.WorldDampingLocation);
+		Location += SkelCompMoveVector * (1.0f - WorldDampingLocation);
 
 		// Follow Rotation
-		Bone.Location += (SkelCompMoveRotation.RotateVector(Bone.PrevLocation) - Bone.PrevLocation)
-			* (1.0f - Bone.PhysicsSettings.WorldDampingRotation);
+		Location += (SkelCompMoveRotation.RotateVector(PrevLocation) - PrevLocation)
+			* (1.0f - WorldDampingRotation);
 	}
 }
 
+void FAnimNode_KawaiiPhysics::ApplyWorldMoveFollowBaseBone(FVector& Location, const FVector& PrevLocation,
+                                                           const float WorldDampingLocation,
+                                                           const float WorldDampingRotation) const
+{
+	// Follow Translation（BaseBoneSpace への変換は Output 依存なので UpdateStepInvariants で評価毎に1回）
+	Location += SkelCompMoveVectorBaseBoneSpace * (1.0f - WorldDampingLocation);
+
+	// Follow Rotation
+	const FVector PrevLocationCS = PrevBaseBoneSpace2ComponentSpace.TransformPosition(PrevLocation);
+	const FVector RotatedLocationCS = SkelCompMoveRotation.RotateVector(PrevLocationCS);
+	const FVector RotatedLocationBase = ConvertSimulationSpaceLocationCached(
+		FSimulationSpaceCache(), CurrentEvalSimSpaceCache, RotatedLocationCS);
+	Location += (RotatedLocationBase - PrevLocation) * (1.0f - WorldDampingRotation);
+}
+
 void FAnimNode_KawaiiPhysics::ApplyStiffnessPull(FKawaiiPhysicsModifyBone& Bone,
                                                  const FKawaiiPhysicsModifyBone& ParentBone, float Exponent)
+{
+	ApplyStiffnessPull(Bone.Location, Bone.PoseLocation, ParentBone.Location, ParentBone.PoseLocation,
+	                   Bone.PhysicsSettings.Stiffness, Exponent);
+}
+
+void FAnimNode_KawaiiPhysics::ApplyStiffnessPull(FVector& Location, const FVector& PoseLocation,
+                                                 const FVector& ParentLocation, const FVector& ParentPoseLocation,
+                                                 const float Stiffness, const float Exponent) const
+{
+	ApplyStiffnessPull(Location, PoseLocation, ParentLocation, ParentPoseLocation,
+	                   1.0f - FMath::Pow(1.0f - Stiffness, Exponent));
+}
+
+void FAnimNode_KawaiiPhysics::ApplyStiffnessPull(FVector& Location, const FVector& PoseLocation,
+                                                 const FVector& ParentLocation, const FVector& ParentPoseLocation,
+                                                 const float StiffnessFactor) const
 {
 	// Pull to Pose Location
-	const FVector BaseLocation = ParentBone.Location + (Bone.PoseLocation - ParentBone.PoseLocation);
-	Bone.Location += (BaseLocation - Bone.Location) *
-		(1.0f - FMath::Pow(1.0f - Bone.PhysicsSettings.Stiffness, Exponent));
+	const FVector BaseLocation = ParentLocation + (PoseLocation - ParentPoseLocation);
+	Location += (BaseLocation - Location) * StiffnessFactor;
+}
+
+void FAnimNode_KawaiiPhysics::UpdateStepInvariants()
+{
+	// Exponent は GetStepDeltaTime ベース（サブステップ時は TargetFramerate*FixedDt=1）。評価中のステップでは不変
+	const float Exponent = GetEffectiveTargetFramerate() * GetStepDeltaTime();
+	SolverState.UpdateStiffnessFactors(BoneCategories.Simulated, Exponent);
+
+	if (SimulationSpace == EKawaiiPhysicsSimulationSpace::BaseBoneSpace)
+	{
+		// 評価冒頭で作った SimulationSpace のキャッシュ（= ConvertSimulationSpaceVector が引く値）を直接使う。
+		// バッチ実行でも同じフレームの評価で作った値なので Output を要しない
+		SkelCompMoveVectorBaseBoneSpace =
+			ConvertSimulationSpaceVectorCached(FSimulationSpaceCache(), CurrentEvalSimSpaceCache, SkelCompMoveVector);
+	}
+}
+
+bool FAnimNode_KawaiiPhysics::NeedsPerBoneSimulateHooks(const FSceneInterface* Scene) const
+{
+	if (bEnableWind && Scene)
+	{
+		return true;
+	}
+	const bool bExternalForcesActive = AreExternalForcesActive();
+	for (const TObjectPtr<UKawaiiPhysics_CustomExternalForce>& CustomForce : CustomExternalForces)
+	{
+		if (bExternalForcesActive && CustomForce && CustomForce->bIsEnabled)
+		{
+			return true;
+		}
+	}
+	for (const FInstancedStruct& ExternalForce : ExternalForces)
+	{
+		if (const FKawaiiPhysics_ExternalForce* Force = ExternalForce.GetPtr<FKawaiiPhysics_ExternalForce>();
+			bExternalForcesActive && Force && Force->bIsEnabled)
+		{
+			return true;
+		}
+	}
+	for (const auto& Item : TransientForceStore.Items)
+	{
+		if (const FKawaiiPhysics_ExternalForce* Force = Item.Force.GetPtr<FKawaiiPhysics_ExternalForce>();
+			Force && Force->bIsEnabled)
+		{
+			return true;
+		}
+	}
+	return false;
 }
 
 FVector FAnimNode_KawaiiPhysics::GetWindVelocity(FComponentSpacePoseContext& Output, const FSceneInterface* Scene,
@@ -1200,6 +2162,61 @@ FVector FAnimNode_KawaiiPhysics::GetWindVelocity(FComponentSpacePoseContext& Out
 	return WindVelocity;
 }
 
+bool FAnimNode_KawaiiPhysics::NeedsSubstepPoseRotation() const
+{
+	// 平面拘束の法線
+	if (PlanarConstraint != EPlanarConstraint::None)
+	{
+		return true;
+	}
+	// 外力は BoneTransform やボーン自体を受け取るため、回転を読み得るものは補間しておく
+	const bool bExternalForcesActive = AreExternalForcesActive();
+	for (const TObjectPtr<UKawaiiPhysics_CustomExternalForce>& CustomForce : CustomExternalForces)
+	{
+		if (bExternalForcesActive && CustomForce && CustomForce->bIsEnabled)
+		{
+			return true;
+		}
+	}
+	auto IsBoneSpaceForce = [](const FKawaiiPhysics_ExternalForce* Force)
+	{
+		return Force && Force->bIsEnabled && Force->ExternalForceSpace == EExternalForceSpace::BoneSpace;
+	};
+	for (const FInstancedStruct& ExternalForce : ExternalForces)
+	{
+		if (bExternalForcesActive && IsBoneSpaceForce(ExternalForce.GetPtr<FKawaiiPhysics_ExternalForce>()))
+		{
+			return true;
+		}
+	}
+	for (const auto& Item : TransientForceStore.Items)
+	{
+		if (IsBoneSpaceForce(Item.Force.GetPtr<FKawaiiPhysics_ExternalForce>()))
+		{
+			return true;
+		}
+	}
+	// 角度制限（PoseDir と BoneDir が反平行のときの代替軸に親の回転を使う）
+	for (const int32 i : BoneCategories.Simulated)
+	{
+		if (SolverState.LimitAngle[i] != 0.0f)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void FAnimNode_KawaiiPhysics::InterpolateSubstepPose(const float SubstepAlpha, const bool bInterpolateRotation,
+                                                     const bool bUseNLerp)
+{
+	SolverState.LerpPoseLocation(SubstepAlpha);
+	if (bInterpolateRotation)
+	{
+		SolverState.InterpolatePoseRotation(SubstepAlpha, bUseNLerp);
+	}
+}
+
 void FAnimNode_KawaiiPhysics::WarmUp(FComponentSpacePoseContext& Output, const FBoneContainer& BoneContainer,
                                      FTransform& ComponentTransform)
 {
@@ -1228,22 +2245,78 @@ void FAnimNode_KawaiiPhysics::WarmUp(FComponentSpacePoseContext& Output, const F
 	}
 }
 
+void FKawaiiPhysicsOutputSlots::Build(const TArray<FKawaiiPhysicsModifyBone>& Bones, const uint32 LayoutGeneration)
+{
+	Reset();
+
+	const int32 NumBones = Bones.Num();
+	BoneSlots.Init(INDEX_NONE, NumBones);
+	for (int32 Index = 0; Index < NumBones; ++Index)
+	{
+		// dummy は BoneRef を持たず、LOD で外れた実ボーンは INDEX_NONE になる
+		if (Bones[Index].BoneRef.CachedCompactPoseIndex >= 0)
+		{
+			SlotBones.Add(Index);
+		}
+	}
+
+	// FCSPose<PoseType>::LocalBlendCSBoneTransforms が compact pose index 昇順を要求する
+	SlotBones.Sort([&Bones](const int32 A, const int32 B)
+	{
+		return Bones[A].BoneRef.CachedCompactPoseIndex < Bones[B].BoneRef.CachedCompactPoseIndex;
+	});
+
+	SlotCompactIndices.Reserve(SlotBones.Num());
+	for (int32 Slot = 0; Slot < SlotBones.Num(); ++Slot)
+	{
+		BoneSlots[SlotBones[Slot]] = Slot;
+		SlotCompactIndices.Add(Bones[SlotBones[Slot]].BoneRef.CachedCompactPoseIndex);
+	}
+	BuiltLayoutGeneration = LayoutGeneration;
+	bBuilt = true;
+}
+
+void FKawaiiPhysicsOutputSlots::Reset()
+{
+	SlotBones.Reset();
+	SlotCompactIndices.Reset();
+	BoneSlots.Reset();
+	bBuilt = false;
+}
+
 void FAnimNode_KawaiiPhysics::ApplySimulateResult(FComponentSpacePoseContext& Output,
                                                   const FBoneContainer& BoneContainer,
                                                   TArray<FBoneTransform>& OutBoneTransforms)
 {
 	SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_ApplySimulateResult);
 
-	for (int32 i = 0; i < ModifyBones.Num(); ++i)
+	// 出力順（compact pose index 昇順）は init 時に確定済み。dummy / LOD で外れたボーンはスロットを持たない
+	if (!OutputSlots.IsBuiltFor(BoneLayoutGeneration, ModifyBones.Num()))
 	{
-		FTransform PoseTransform = FTransform(ModifyBones[i].PoseRotation, ModifyBones[i].PoseLocation,
-		                                      ModifyBones[i].PoseScale);
-		PoseTransform =
-			ConvertSimulationSpaceTransform(Output, SimulationSpace, EKawaiiPhysicsSimulationSpace::ComponentSpace,
-			                                PoseTransform);
-		OutBoneTransforms.Add(FBoneTransform(ModifyBones[i].BoneRef.GetCompactPoseIndex(BoneContainer), PoseTransform));
+		OutputSlots.Build(ModifyBones, BoneLayoutGeneration);
 	}
 
+	// 空間変換は Evaluate 中のキャッシュを1回だけ引いて全ボーンに使う（ComponentSpace なら変換しない）
+	const bool bConvertSpace = SimulationSpace != EKawaiiPhysicsSimulationSpace::ComponentSpace;
+	const FSimulationSpaceCache CacheFrom = bConvertSpace
+		                                        ? GetSimulationSpaceCacheFor(Output, SimulationSpace)
+		                                        : FSimulationSpaceCache();
+	const FSimulationSpaceCache CacheTo;
+
+	const int32 FirstSlot = OutBoneTransforms.Num();
+	OutBoneTransforms.AddUninitialized(OutputSlots.Num());
+	FBoneTransform* SlotTransforms = OutBoneTransforms.GetData() + FirstSlot;
+
+	for (int32 Slot = 0; Slot < OutputSlots.Num(); ++Slot)
+	{
+		const FKawaiiPhysicsModifyBone& Bone = ModifyBones[OutputSlots.GetSlotBone(Slot)];
+		FTransform PoseTransform = FTransform(Bone.PoseRotation, Bone.PoseLocation, Bone.PoseScale);
+		if (bConvertSpace)
+		{
+			PoseTransform = ConvertSimulationSpaceTransformCached(CacheFrom, CacheTo, PoseTransform);
+		}
+		SlotTransforms[Slot] = FBoneTransform(OutputSlots.GetSlotCompactIndex(Slot), PoseTransform);
+	}
 
 	for (int32 i = 0; i < ModifyBones.Num(); ++i)
 	{
@@ -1255,13 +2328,14 @@ void FAnimNode_KawaiiPhysics::ApplySimulateResult(FComponentSpacePoseContext& Ou
 
 		FKawaiiPhysicsModifyBone& ParentBone = ModifyBones[Bone.ParentIndex];
 
-		if (ParentBone.ChildIndices.Num() <= 1)
+		if (BoneTopology.NumChildren(Bone.ParentIndex) <= 1)
 		{
 			if (ParentBone.BoneRef.BoneIndex >= 0)
 			{
 				FVector PoseVector = Bone.PoseLocation - ParentBone.PoseLocation;
 				FVector SimulateVector = Bone.Location - ParentBone.Location;
 
+				// 向きが変わっていなければポーズの回転のまま
 				if (PoseVector.GetSafeNormal() == SimulateVector.GetSafeNormal())
 				{
 					continue;
@@ -1278,28 +2352,27 @@ void FAnimNode_KawaiiPhysics::ApplySimulateResult(FComponentSpacePoseContext& Ou
 					FQuat::FindBetweenVectors(PoseVector, SimulateVector) * ParentBone.PoseRotation;
 				ParentBone.PrevRotation = SimulateRotation;
 
-				SimulateRotation =
-					ConvertSimulationSpaceRotation(Output, SimulationSpace,
-					                               EKawaiiPhysicsSimulationSpace::ComponentSpace, SimulateRotation);
-				OutBoneTransforms[Bone.ParentIndex].Transform.SetRotation(SimulateRotation);
+				const int32 ParentSlot = OutputSlots.GetSlot(Bone.ParentIndex);
+				if (ParentSlot != INDEX_NONE)
+				{
+					if (bConvertSpace)
+					{
+						SimulateRotation = ConvertSimulationSpaceRotationCached(CacheFrom, CacheTo, SimulateRotation);
+					}
+					SlotTransforms[ParentSlot].Transform.SetRotation(SimulateRotation);
+				}
 			}
 		}
 
-		if (Bone.BoneRef.BoneIndex >= 0 && !Bone.bDummy)
+		const int32 Slot = OutputSlots.GetSlot(i);
+		if (Slot != INDEX_NONE && Bone.BoneRef.BoneIndex >= 0 && !Bone.bDummy)
 		{
-			OutBoneTransforms[i].Transform.SetLocation(
-				ConvertSimulationSpaceLocation(Output, SimulationSpace, EKawaiiPhysicsSimulationSpace::ComponentSpace,
-				                               Bone.Location));
+			SlotTransforms[Slot].Transform.SetLocation(
+				bConvertSpace
+					? ConvertSimulationSpaceLocationCached(CacheFrom, CacheTo, Bone.Location)
+					: Bone.Location);
 		}
 	}
-
-	OutBoneTransforms.RemoveAll([](const FBoneTransform& BoneTransform)
-	{
-		return BoneTransform.BoneIndex < 0;
-	});
-
-	// FCSPose<PoseType>::LocalBlendCSBoneTransforms 内のチェック用
-	OutBoneTransforms.Sort(FCompareBoneTransformIndex());
 }
 
 FTransform FAnimNode_KawaiiPhysics::GetBoneTransformInSimSpace(FComponentSpacePoseContext& Output,
@@ -99,7 +99,7 @@ void FAnimNode_KawaiiPhysics::CollectSyncBoneChildTargets(FKawaiiPhysicsSyncTarg
 
 	// 子ボーンを収集する。BoneSubdivision のダミーは内部計算用の点なので、走査はするが
 	// SyncBone のターゲットやエディタプレビュー項目としては公開しない。
-	TArray<int32> IndicesToProcess = ModifyBones[TargetRoot.ModifyBoneIndex].ChildIndices;
+	TArray<int32> IndicesToProcess(BoneTopology.GetChildren(TargetRoot.ModifyBoneIndex));
 	while (!IndicesToProcess.IsEmpty())
 	{
 		const int32 CurrentIndex = IndicesToProcess.Pop();
@@ -120,7 +120,7 @@ void FAnimNode_KawaiiPhysics::CollectSyncBoneChildTargets(FKawaiiPhysicsSyncTarg
 			MaxLength = FMath::Max(MaxLength, ModifyBone.LengthFromRoot);
 		}
 
-		IndicesToProcess.Append(ModifyBone.ChildIndices);
+		IndicesToProcess.Append(BoneTopology.GetChildren(CurrentIndex));
 	}
 
 	// LengthRateFromSyncTargetRoot を計算
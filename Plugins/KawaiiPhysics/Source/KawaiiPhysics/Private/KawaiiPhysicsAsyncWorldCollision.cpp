@@ -0,0 +1,105 @@
+// Copyright 2019-2026 pafuhana1213. All Rights Reserved.
+
+#include "KawaiiPhysicsAsyncWorldCollision.h"
+
+#include "Engine/World.h"
+
+void FKawaiiPhysicsAsyncWorldCollision::StageSweeps(TArray<FSweep>& InOutSweeps,
+                                                    const ECollisionChannel InTraceChannel,
+                                                    const FCollisionQueryParams& InQueryParams,
+                                                    const FCollisionResponseParams& InResponseParams,
+                                                    const bool bInMultiHit)
+{
+	FScopeLock ScopeLock(&Lock);
+	Swap(StagedSweeps, InOutSweeps);
+	TraceChannel = InTraceChannel;
+	QueryParams = InQueryParams;
+	ResponseParams = InResponseParams;
+	bMultiHit = bInMultiHit;
+}
+
+int32 FKawaiiPhysicsAsyncWorldCollision::IssueStagedSweeps(UWorld& World)
+{
+	check(IsInGameThread());
+
+	FScopeLock ScopeLock(&Lock);
+	if (!BeginIssuedBatch())
+	{
+		return 0;
+	}
+
+	// ノードが先に破棄されたら結果は届かなくてよいので弱参照でバインドする
+	const FTraceDelegate Delegate = FTraceDelegate::CreateSP(
+		AsShared(), &FKawaiiPhysicsAsyncWorldCollision::OnSweepCompleted, BatchSerial);
+	const EAsyncTraceType TraceType = bMultiHit ? EAsyncTraceType::Multi : EAsyncTraceType::Single;
+	for (int32 SweepIndex = 0; SweepIndex < IssuedSweeps.Num(); ++SweepIndex)
+	{
+		const FSweep& Sweep = IssuedSweeps[SweepIndex];
+		World.AsyncSweepByChannel(TraceType, Sweep.Start, Sweep.End, FQuat::Identity, TraceChannel,
+		                          FCollisionShape::MakeSphere(Sweep.Radius), QueryParams, ResponseParams, &Delegate,
+		                          static_cast<uint32>(SweepIndex));
+	}
+	return IssuedSweeps.Num();
+}
+
+bool FKawaiiPhysicsAsyncWorldCollision::BeginIssuedBatch()
+{
+	if (StagedSweeps.IsEmpty())
+	{
+		return false;
+	}
+
+	// 前のバッチが揃う前に次を発行した場合、前のバッチの結果は捨てる（新しい方が現在の姿勢に近い）
+	++BatchSerial;
+	Swap(IssuedSweeps, StagedSweeps);
+	StagedSweeps.Reset();
+	PendingResults.Reset();
+	NumInFlight = IssuedSweeps.Num();
+	return true;
+}
+
+void FKawaiiPhysicsAsyncWorldCollision::OnSweepCompleted(const FTraceHandle& Handle, FTraceDatum& Datum,
+                                                         const uint32 InBatchSerial)
+{
+	FScopeLock ScopeLock(&Lock);
+	if (InBatchSerial != BatchSerial)
+	{
+		return;
+	}
+
+	const int32 SweepIndex = static_cast<int32>(Datum.UserData);
+	if (IssuedSweeps.IsValidIndex(SweepIndex) && !Datum.OutHits.IsEmpty())
+	{
+		FSweepResult& Result = PendingResults.AddDefaulted_GetRef();
+		Result.BoneIndex = IssuedSweeps[SweepIndex].BoneIndex;
+		Result.Hits = MoveTemp(Datum.OutHits);
+	}
+
+	// バッチ内の全スイープが揃ったら公開する（ヒット無しのバッチも「接触なし」として公開）
+	if (--NumInFlight == 0)
+	{
+		Swap(CompletedResults, PendingResults);
+		PendingResults.Reset();
+		bHasCompletedResults = true;
+	}
+}
+
+bool FKawaiiPhysicsAsyncWorldCollision::ConsumeResults(TArray<FSweepResult>& OutResults)
+{
+	FScopeLock ScopeLock(&Lock);
+	if (!bHasCompletedResults)
+	{
+		return false;
+	}
+
+	Swap(OutResults, CompletedResults);
+	CompletedResults.Reset();
+	bHasCompletedResults = false;
+	return true;
+}
+
+int32 FKawaiiPhysicsAsyncWorldCollision::GetNumInFlight() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return NumInFlight;
+}
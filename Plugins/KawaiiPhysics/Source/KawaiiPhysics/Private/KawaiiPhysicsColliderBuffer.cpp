@@ -0,0 +1,490 @@
+// Copyright 2019-2026 pafuhana1213. All Rights Reserved.
+
+#include "KawaiiPhysicsColliderBuffer.h"
+
+namespace
+{
+	// CullBounds が有効で、コライダーの AABB と重ならなければ間引く
+	bool IsOutsideCullBounds(const FBox& CullBounds, const FBox& ColliderBounds)
+	{
+		return CullBounds.IsValid && !CullBounds.Intersect(ColliderBounds);
+	}
+
+	// 線分を半径で太らせた AABB（カプセル / テーパーカプセル用）
+	FBox GetSweptSegmentBounds(const FVector& Start, const FVector& End, const double Radius)
+	{
+		return FBox(Start.ComponentMin(End) - FVector(Radius), Start.ComponentMax(End) + FVector(Radius));
+	}
+
+	FBox GetBoxBounds(const FTransform& Transform, const FVector& Extent)
+	{
+		return FBox(-Extent, Extent).TransformBy(Transform);
+	}
+
+	// グリッドの1軸あたりの最大セル数（セル数 = 最大 16^3）
+	constexpr int32 MaxGridCellsPerAxis = 16;
+}
+
+void FKawaiiPhysicsColliderBuffer::Reset()
+{
+	CullBounds = FBox(ForceInit);
+	NumCulled = 0;
+	RelevanceMasks = TConstArrayView<uint32>();
+	RelevanceMaskWords = 0;
+	Grid.CellOffsets.Reset();
+	Grid.CellEntries.Reset();
+
+	Spheres.Center.Reset();
+	Spheres.Radius.Reset();
+	Spheres.bInner.Reset();
+	Spheres.Blocks.Reset();
+	Spheres.RelevanceMask.Reset();
+
+	Capsules.Start.Reset();
+	Capsules.End.Reset();
+	Capsules.FallbackPushDir.Reset();
+	Capsules.Radius.Reset();
+	Capsules.Blocks.Reset();
+	Capsules.RelevanceMask.Reset();
+
+	TaperedCapsules.Start.Reset();
+	TaperedCapsules.Segment.Reset();
+	TaperedCapsules.FallbackPushDir.Reset();
+	TaperedCapsules.SegmentSizeSq.Reset();
+	TaperedCapsules.Radius0.Reset();
+	TaperedCapsules.Radius1.Reset();
+	TaperedCapsules.Blocks.Reset();
+	TaperedCapsules.RelevanceMask.Reset();
+
+	Boxes.Transform.Reset();
+	Boxes.Extent.Reset();
+	Boxes.Blocks.Reset();
+	Boxes.RelevanceMask.Reset();
+
+	Planes.Plane.Reset();
+	Planes.Normal.Reset();
+	Planes.RelevanceMask.Reset();
+}
+
+FKawaiiPhysicsColliderBuffer::FRelevanceFilter FKawaiiPhysicsColliderBuffer::MakeRelevanceFilter(
+	const int32 BoneIndex) const
+{
+	FRelevanceFilter Filter;
+	if (RelevanceMasks.IsEmpty() || BoneIndex < 0 || BoneIndex / 32 >= RelevanceMaskWords)
+	{
+		return Filter;
+	}
+	Filter.Masks = RelevanceMasks.GetData();
+	Filter.Word = BoneIndex / 32;
+	Filter.Bit = 1u << (BoneIndex % 32);
+	return Filter;
+}
+
+void FKawaiiPhysicsColliderBuffer::AddRelevanceMask(TArray<int32>& ShapeMasks, const FCollisionLimitBase& Limit)
+{
+	if (RelevanceMasks.IsEmpty())
+	{
+		return;
+	}
+	// マスク配列を作り直した後に増えた limit 等、範囲外を指すものは全ボーン扱い
+	const int32 Offset = Limit.CachedRelevanceMask;
+	const bool bValid = Offset >= 0 && RelevanceMaskWords > 0 && Offset + RelevanceMaskWords <= RelevanceMasks.Num();
+	ShapeMasks.Add(bValid ? Offset : INDEX_NONE);
+}
+
+void FKawaiiPhysicsColliderBuffer::Append(TArray<FSphericalLimit>& Limits)
+{
+	for (const FSphericalLimit& Sphere : Limits)
+	{
+		if (!Sphere.bEnable || Sphere.Radius <= 0.0f)
+		{
+			continue;
+		}
+		const bool bInner = Sphere.LimitType == ESphericalLimitType::Inner;
+		if (!bInner && IsOutsideCullBounds(CullBounds, FBox::BuildAABB(Sphere.Location, FVector(Sphere.Radius))))
+		{
+			++NumCulled;
+			continue;
+		}
+		Spheres.Center.Add(Sphere.Location);
+		Spheres.Radius.Add(Sphere.Radius);
+		Spheres.bInner.Add(bInner ? 1 : 0);
+		AddRelevanceMask(Spheres.RelevanceMask, Sphere);
+	}
+}
+
+void FKawaiiPhysicsColliderBuffer::Append(TArray<FCapsuleLimit>& Limits)
+{
+	for (FCapsuleLimit& Capsule : Limits)
+	{
+		if (!Capsule.bEnable)
+		{
+			continue;
+		}
+		// キャッシュは縮退形状でも更新する（単体の AdjustByCapsuleCollision 等が参照するため）
+		Capsule.UpdateRuntimeCache();
+		if (Capsule.Radius <= 0 || Capsule.Length <= 0)
+		{
+			continue;
+		}
+		if (IsOutsideCullBounds(CullBounds, GetSweptSegmentBounds(Capsule.CachedStartPoint, Capsule.CachedEndPoint,
+		                                                          Capsule.Radius)))
+		{
+			++NumCulled;
+			continue;
+		}
+		Capsules.Start.Add(Capsule.CachedStartPoint);
+		Capsules.End.Add(Capsule.CachedEndPoint);
+		Capsules.FallbackPushDir.Add(Capsule.CachedFallbackPushDir);
+		Capsules.Radius.Add(Capsule.Radius);
+		AddRelevanceMask(Capsules.RelevanceMask, Capsule);
+	}
+}
+
+void FKawaiiPhysicsColliderBuffer::Append(TArray<FTaperedCapsuleLimit>& Limits)
+{
+	for (FTaperedCapsuleLimit& TaperedCapsule : Limits)
+	{
+		if (!TaperedCapsule.bEnable)
+		{
+			continue;
+		}
+		TaperedCapsule.UpdateRuntimeCache();
+		if (TaperedCapsule.Radius0 <= 0.0f && TaperedCapsule.Radius1 <= 0.0f)
+		{
+			continue;
+		}
+
+		const bool bHasLength = TaperedCapsule.Length > KINDA_SMALL_NUMBER;
+		const FVector SegmentStart = bHasLength ? TaperedCapsule.CachedStartPoint : TaperedCapsule.Location;
+		const FVector SegmentEnd = bHasLength ? SegmentStart + TaperedCapsule.CachedSegment : SegmentStart;
+		const float MaxRadius = FMath::Max(FMath::Max(TaperedCapsule.Radius0, TaperedCapsule.Radius1), 0.0f);
+		if (IsOutsideCullBounds(CullBounds, GetSweptSegmentBounds(SegmentStart, SegmentEnd, MaxRadius)))
+		{
+			++NumCulled;
+			continue;
+		}
+
+		TaperedCapsules.FallbackPushDir.Add(TaperedCapsule.CachedFallbackPushDir);
+		AddRelevanceMask(TaperedCapsules.RelevanceMask, TaperedCapsule);
+		if (bHasLength)
+		{
+			TaperedCapsules.Start.Add(TaperedCapsule.CachedStartPoint);
+			TaperedCapsules.Segment.Add(TaperedCapsule.CachedSegment);
+			TaperedCapsules.SegmentSizeSq.Add(TaperedCapsule.CachedSegmentSizeSq);
+			TaperedCapsules.Radius0.Add(TaperedCapsule.Radius0);
+			TaperedCapsules.Radius1.Add(TaperedCapsule.Radius1);
+		}
+		else
+		{
+			// 長さ0: 最近接点は中心固定（T=0）、半径は大きい方
+			TaperedCapsules.Start.Add(TaperedCapsule.Location);
+			TaperedCapsules.Segment.Add(FVector::ZeroVector);
+			TaperedCapsules.SegmentSizeSq.Add(1.0);
+			TaperedCapsules.Radius0.Add(MaxRadius);
+			TaperedCapsules.Radius1.Add(MaxRadius);
+		}
+	}
+}
+
+void FKawaiiPhysicsColliderBuffer::Append(TArray<FBoxLimit>& Limits)
+{
+	for (FBoxLimit& Box : Limits)
+	{
+		if (!Box.bEnable)
+		{
+			continue;
+		}
+		Box.UpdateRuntimeCache();
+		if (Box.Extent.GetMin() >= 0.0 &&
+			IsOutsideCullBounds(CullBounds, GetBoxBounds(Box.CachedBoxTransform, Box.Extent)))
+		{
+			++NumCulled;
+			continue;
+		}
+		Boxes.Transform.Add(Box.CachedBoxTransform);
+		Boxes.Extent.Add(Box.Extent);
+		AddRelevanceMask(Boxes.RelevanceMask, Box);
+	}
+}
+
+void FKawaiiPhysicsColliderBuffer::Append(TArray<FPlanarLimit>& Limits)
+{
+	for (FPlanarLimit& Planar : Limits)
+	{
+		if (!Planar.bEnable)
+		{
+			continue;
+		}
+		Planar.UpdateRuntimeCache();
+		Planes.Plane.Add(Planar.Plane);
+		Planes.Normal.Add(Planar.CachedNormal);
+		AddRelevanceMask(Planes.RelevanceMask, Planar);
+	}
+}
+
+namespace
+{
+	// 端数レーン用。距離の2乗が何と比べても必ず外れる位置（1e30^2 でも double の範囲内）
+	constexpr double PaddingCoordinate = 1.0e30;
+	// Inner スフィア / 負の Extent の Box を常に候補にするための大きさ
+	constexpr double AlwaysCandidateSize = 1.0e30;
+
+	template <typename TBlock>
+	TBlock& AddBlockForLane(TArray<TBlock>& Blocks, const int32 ColliderIndex, int32& OutLane)
+	{
+		OutLane = ColliderIndex % FKawaiiPhysicsColliderBuffer::SimdBlockSize;
+		if (OutLane == 0)
+		{
+			Blocks.AddUninitialized();
+		}
+		return Blocks.Last();
+	}
+
+	void FillCapsuleLane(FKawaiiPhysicsColliderBuffer::FCapsuleBlock& Block, const int32 Lane, const FVector& Start,
+	                     const FVector& Segment, const double SegmentSizeSq, const double Radius)
+	{
+		Block.StartX[Lane] = Start.X;
+		Block.StartY[Lane] = Start.Y;
+		Block.StartZ[Lane] = Start.Z;
+		Block.SegmentX[Lane] = Segment.X;
+		Block.SegmentY[Lane] = Segment.Y;
+		Block.SegmentZ[Lane] = Segment.Z;
+		// 長さ0の線分は T=0 に潰す（0 * Inf で NaN を作らない）
+		Block.RcpSegmentSizeSq[Lane] = SegmentSizeSq > 0.0 ? 1.0 / SegmentSizeSq : 0.0;
+		Block.Radius[Lane] = Radius;
+	}
+}
+
+void FKawaiiPhysicsColliderBuffer::BuildSimdBlocks()
+{
+	constexpr int32 BlockSize = SimdBlockSize;
+	const FVector PaddingLocation(PaddingCoordinate);
+
+	Spheres.Blocks.Reset();
+	for (int32 i = 0; i < Spheres.Num() || (i % BlockSize) != 0; ++i)
+	{
+		int32 Lane;
+		FSphereBlock& Block = AddBlockForLane(Spheres.Blocks, i, Lane);
+		const bool bValid = i < Spheres.Num();
+		const FVector Center = bValid ? Spheres.Center[i] : PaddingLocation;
+		Block.CenterX[Lane] = Center.X;
+		Block.CenterY[Lane] = Center.Y;
+		Block.CenterZ[Lane] = Center.Z;
+		Block.Radius[Lane] = !bValid ? 0.0 : (Spheres.bInner[i] != 0 ? AlwaysCandidateSize : Spheres.Radius[i]);
+	}
+
+	Capsules.Blocks.Reset();
+	for (int32 i = 0; i < Capsules.Num() || (i % BlockSize) != 0; ++i)
+	{
+		int32 Lane;
+		FCapsuleBlock& Block = AddBlockForLane(Capsules.Blocks, i, Lane);
+		if (i < Capsules.Num())
+		{
+			const FVector Segment = Capsules.End[i] - Capsules.Start[i];
+			FillCapsuleLane(Block, Lane, Capsules.Start[i], Segment, Segment.SizeSquared(), Capsules.Radius[i]);
+		}
+		else
+		{
+			FillCapsuleLane(Block, Lane, PaddingLocation, FVector::ZeroVector, 0.0, 0.0);
+		}
+	}
+
+	TaperedCapsules.Blocks.Reset();
+	for (int32 i = 0; i < TaperedCapsules.Num() || (i % BlockSize) != 0; ++i)
+	{
+		int32 Lane;
+		FCapsuleBlock& Block = AddBlockForLane(TaperedCapsules.Blocks, i, Lane);
+		if (i < TaperedCapsules.Num())
+		{
+			// 押し出し半径は T に依存するため、判定には線分全体での最大半径を使う
+			const double MaxRadius = FMath::Max3(TaperedCapsules.Radius0[i], TaperedCapsules.Radius1[i], 0.0f);
+			FillCapsuleLane(Block, Lane, TaperedCapsules.Start[i], TaperedCapsules.Segment[i],
+			                TaperedCapsules.SegmentSizeSq[i], MaxRadius);
+		}
+		else
+		{
+			FillCapsuleLane(Block, Lane, PaddingLocation, FVector::ZeroVector, 0.0, 0.0);
+		}
+	}
+
+	Boxes.Blocks.Reset();
+	for (int32 i = 0; i < Boxes.Num() || (i % BlockSize) != 0; ++i)
+	{
+		int32 Lane;
+		FBoxBlock& Block = AddBlockForLane(Boxes.Blocks, i, Lane);
+		const bool bValid = i < Boxes.Num();
+		const FVector Center = bValid ? Boxes.Transform[i].GetLocation() : PaddingLocation;
+		const FQuat Rotation = bValid ? Boxes.Transform[i].GetRotation() : FQuat::Identity;
+		FVector Extent = bValid ? Boxes.Extent[i] : FVector::ZeroVector;
+		if (Extent.GetMin() < 0.0)
+		{
+			Extent = FVector(AlwaysCandidateSize);
+		}
+		Block.CenterX[Lane] = Center.X;
+		Block.CenterY[Lane] = Center.Y;
+		Block.CenterZ[Lane] = Center.Z;
+		Block.RotationX[Lane] = Rotation.X;
+		Block.RotationY[Lane] = Rotation.Y;
+		Block.RotationZ[Lane] = Rotation.Z;
+		Block.RotationW[Lane] = Rotation.W;
+		Block.ExtentX[Lane] = Extent.X;
+		Block.ExtentY[Lane] = Extent.Y;
+		Block.ExtentZ[Lane] = Extent.Z;
+	}
+}
+
+FIntVector FKawaiiPhysicsColliderBuffer::FGrid::GetCellCoord(const FVector& Location) const
+{
+	// 範囲外（パディング座標等の巨大値を含む）は int へ変換する前に端のセルへ丸める
+	const FVector Local = (Location - Origin) * InvCellSize;
+	return FIntVector(
+		FMath::FloorToInt32(FMath::Clamp(Local.X, 0.0, Dims.X - 1.0)),
+		FMath::FloorToInt32(FMath::Clamp(Local.Y, 0.0, Dims.Y - 1.0)),
+		FMath::FloorToInt32(FMath::Clamp(Local.Z, 0.0, Dims.Z - 1.0)));
+}
+
+bool FKawaiiPhysicsColliderBuffer::FGrid::FindCell(const FVector& Center, const double Extent, int32& OutCell) const
+{
+	const FIntVector Min = GetCellCoord(Center - FVector(Extent));
+	const FIntVector Max = GetCellCoord(Center + FVector(Extent));
+	if (Min != Max)
+	{
+		return false;
+	}
+	OutCell = GetCellIndex(Min);
+	return true;
+}
+
+void FKawaiiPhysicsColliderBuffer::BuildGrid(const int32 MinColliders)
+{
+	Grid.CellOffsets.Reset();
+	Grid.CellEntries.Reset();
+
+	const int32 NumGridColliders = Spheres.Num() + Capsules.Num() + TaperedCapsules.Num() + Boxes.Num();
+	if (MinColliders <= 0 || NumGridColliders < MinColliders)
+	{
+		return;
+	}
+
+	// キー昇順（形状順 → index 順）に、各コライダーの AABB を渡す。常に候補のものは無効な箱
+	auto ForEachCollider = [this](auto&& Visit)
+	{
+		for (int32 i = 0; i < Spheres.Num(); ++i)
+		{
+			Visit(MakeGridKey(EGridShape::Sphere, i), Spheres.bInner[i] != 0
+				                                          ? FBox(ForceInit)
+				                                          : FBox::BuildAABB(Spheres.Center[i],
+				                                                            FVector(Spheres.Radius[i])));
+		}
+		for (int32 i = 0; i < Capsules.Num(); ++i)
+		{
+			Visit(MakeGridKey(EGridShape::Capsule, i),
+			      GetSweptSegmentBounds(Capsules.Start[i], Capsules.End[i], Capsules.Radius[i]));
+		}
+		for (int32 i = 0; i < TaperedCapsules.Num(); ++i)
+		{
+			const float MaxRadius = FMath::Max3(TaperedCapsules.Radius0[i], TaperedCapsules.Radius1[i], 0.0f);
+			Visit(MakeGridKey(EGridShape::TaperedCapsule, i),
+			      GetSweptSegmentBounds(TaperedCapsules.Start[i], TaperedCapsules.Start[i] + TaperedCapsules.Segment[i],
+			                            MaxRadius));
+		}
+		for (int32 i = 0; i < Boxes.Num(); ++i)
+		{
+			Visit(MakeGridKey(EGridShape::Box, i), Boxes.Extent[i].GetMin() < 0.0
+				                                       ? FBox(ForceInit)
+				                                       : GetBoxBounds(Boxes.Transform[i], Boxes.Extent[i]));
+		}
+	};
+
+	FBox Bounds(ForceInit);
+	ForEachCollider([&Bounds](uint32, const FBox& ColliderBounds)
+	{
+		if (ColliderBounds.IsValid)
+		{
+			Bounds += ColliderBounds;
+		}
+	});
+	if (!Bounds.IsValid)
+	{
+		// 全て常に候補なら絞り込めない
+		return;
+	}
+
+	// セル体積 ≒ 範囲の体積 / コライダー数。平たい範囲でも体積が0にならないよう各辺に1cm足す
+	const FVector Size = Bounds.GetSize();
+	const double CellSize = FMath::Max(
+		FMath::Pow((Size.X + 1.0) * (Size.Y + 1.0) * (Size.Z + 1.0) / NumGridColliders, 1.0 / 3.0), 1.0);
+	for (int32 Axis = 0; Axis < 3; ++Axis)
+	{
+		Grid.Dims[Axis] = FMath::Clamp(FMath::CeilToInt32(Size[Axis] / CellSize), 1, MaxGridCellsPerAxis);
+		Grid.InvCellSize[Axis] = Size[Axis] > UE_KINDA_SMALL_NUMBER ? Grid.Dims[Axis] / Size[Axis] : 0.0;
+	}
+	Grid.Origin = Bounds.Min;
+
+	const int32 NumCells = Grid.Dims.X * Grid.Dims.Y * Grid.Dims.Z;
+	auto ForEachCell = [this, NumCells](const FBox& ColliderBounds, auto&& Visit)
+	{
+		if (!ColliderBounds.IsValid)
+		{
+			for (int32 Cell = 0; Cell < NumCells; ++Cell)
+			{
+				Visit(Cell);
+			}
+			return;
+		}
+		const FIntVector Min = Grid.GetCellCoord(ColliderBounds.Min);
+		const FIntVector Max = Grid.GetCellCoord(ColliderBounds.Max);
+		for (int32 Z = Min.Z; Z <= Max.Z; ++Z)
+		{
+			for (int32 Y = Min.Y; Y <= Max.Y; ++Y)
+			{
+				for (int32 X = Min.X; X <= Max.X; ++X)
+				{
+					Visit(Grid.GetCellIndex(FIntVector(X, Y, Z)));
+				}
+			}
+		}
+	};
+
+	// 1パス目でセルごとの個数、2パス目でキーを詰める（キー昇順に走査するので各セルの列も昇順）。
+	// 2パス目は CellOffsets[c] を書き込み位置として進めるので、終わると1つずれた終端になる。最後に1つ戻す
+	TArray<int32>& Offsets = Grid.CellOffsets;
+	Offsets.SetNumZeroed(NumCells + 1);
+	ForEachCollider([&](uint32, const FBox& ColliderBounds)
+	{
+		ForEachCell(ColliderBounds, [&Offsets](const int32 Cell) { ++Offsets[Cell + 1]; });
+	});
+	for (int32 Cell = 0; Cell < NumCells; ++Cell)
+	{
+		Offsets[Cell + 1] += Offsets[Cell];
+	}
+	Grid.CellEntries.SetNumUninitialized(Offsets[NumCells]);
+	ForEachCollider([&](const uint32 Key, const FBox& ColliderBounds)
+	{
+		ForEachCell(ColliderBounds, [&](const int32 Cell) { Grid.CellEntries[Offsets[Cell]++] = Key; });
+	});
+	for (int32 Cell = NumCells; Cell > 0; --Cell)
+	{
+		Offsets[Cell] = Offsets[Cell - 1];
+	}
+	Offsets[0] = 0;
+}
+
+SIZE_T FKawaiiPhysicsColliderBuffer::GetAllocatedSize() const
+{
+	return Spheres.Center.GetAllocatedSize() + Spheres.Radius.GetAllocatedSize() + Spheres.bInner.GetAllocatedSize() +
+		Capsules.Start.GetAllocatedSize() + Capsules.End.GetAllocatedSize() +
+		Capsules.FallbackPushDir.GetAllocatedSize() + Capsules.Radius.GetAllocatedSize() +
+		TaperedCapsules.Start.GetAllocatedSize() + TaperedCapsules.Segment.GetAllocatedSize() +
+		TaperedCapsules.FallbackPushDir.GetAllocatedSize() + TaperedCapsules.SegmentSizeSq.GetAllocatedSize() +
+		TaperedCapsules.Radius0.GetAllocatedSize() + TaperedCapsules.Radius1.GetAllocatedSize() +
+		Boxes.Transform.GetAllocatedSize() + Boxes.Extent.GetAllocatedSize() +
+		Planes.Plane.GetAllocatedSize() + Planes.Normal.GetAllocatedSize() +
+		Spheres.Blocks.GetAllocatedSize() + Capsules.Blocks.GetAllocatedSize() +
+		TaperedCapsules.Blocks.GetAllocatedSize() + Boxes.Blocks.GetAllocatedSize() +
+		Grid.CellOffsets.GetAllocatedSize() + Grid.CellEntries.GetAllocatedSize() +
+		Spheres.RelevanceMask.GetAllocatedSize() + Capsules.RelevanceMask.GetAllocatedSize() +
+		TaperedCapsules.RelevanceMask.GetAllocatedSize() + Boxes.RelevanceMask.GetAllocatedSize() +
+		Planes.RelevanceMask.GetAllocatedSize();
+}
@@ -0,0 +1,269 @@
+﻿// Copyright 2019-2026 pafuhana1213. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "KawaiiPhysicsColliderBuffer.h"
+
+// 1ボーン×1コライダーの押し出し。limit 配列版（AdjustBy*Collision）、コンパイル済みバッファ版（AdjustByColliderBuffer）、
+// SIMD ナローフェーズの確定処理で共有し、全経路の結果をビット一致させる。
+namespace KawaiiPhysicsCollision
+{
+	FORCEINLINE void PushOutSphere(FVector& Location, const float Radius, const FVector& Center,
+	                               const float SphereRadius, const bool bInner)
+	{
+		if (!bInner)
+		{
+			const float LimitDistanceOuter = SphereRadius + Radius;
+			const FVector Delta = Location - Center;
+			const float DistSq = Delta.SizeSquared();
+			if (DistSq > LimitDistanceOuter * LimitDistanceOuter)
+			{
+				return;
+			}
+
+			const float Dist = FMath::Sqrt(DistSq);
+			if (Dist > KINDA_SMALL_NUMBER)
+			{
+				Location += (LimitDistanceOuter - Dist) * (Delta / Dist);
+			}
+		}
+		else
+		{
+			// ボーン半径≥スフィア半径だと内半径(=スフィア半径−ボーン半径)が負になり反対側へ飛ぶ。Max(...,0)で中心にピン留めして回避。
+			const float LimitDistanceInner = FMath::Max(SphereRadius - Radius, 0.0f);
+			const FVector Delta = Location - Center;
+			const float DistSq = Delta.SizeSquared();
+			if (DistSq < LimitDistanceInner * LimitDistanceInner)
+			{
+				return;
+			}
+
+			const float Dist = FMath::Sqrt(DistSq);
+			Location = Dist > KINDA_SMALL_NUMBER
+				           ? Center + LimitDistanceInner * (Delta / Dist)
+				           : Center;
+		}
+	}
+
+	FORCEINLINE void PushOutCapsule(FVector& Location, const float Radius, const FVector& StartPoint,
+	                                const FVector& EndPoint, const float CapsuleRadius,
+	                                const FVector& FallbackPushDir)
+	{
+		const float DistSquared = FMath::PointDistToSegmentSquared(Location, StartPoint, EndPoint);
+
+		const float LimitDistance = Radius + CapsuleRadius;
+		if (DistSquared < LimitDistance * LimitDistance)
+		{
+			const FVector ClosestPoint = FMath::ClosestPointOnSegment(Location, StartPoint, EndPoint);
+			FVector PushDir = (Location - ClosestPoint).GetSafeNormal();
+			if (PushDir.IsNearlyZero())
+			{
+				// ボーンがカプセル軸上に乗ると押し出し方向が消えるため軸直交方向を代替に使う
+				PushDir = FallbackPushDir;
+			}
+			Location = ClosestPoint + PushDir * LimitDistance;
+		}
+	}
+
+	// 長さ0のカプセルは Segment=0 / SegmentSizeSq=1 / Radius0=Radius1=最大半径 で渡す（T=0 で中心・最大半径になる）
+	FORCEINLINE void PushOutTaperedCapsule(FVector& Location, const float Radius, const FVector& StartPoint,
+	                                       const FVector& Segment, const FVector::FReal SegmentSizeSq,
+	                                       const float Radius0, const float Radius1,
+	                                       const FVector& FallbackPushDir)
+	{
+		const float T = FMath::Clamp(FVector::DotProduct(Location - StartPoint, Segment) / SegmentSizeSq, 0.0f, 1.0f);
+		const FVector ClosestPoint = StartPoint + Segment * T;
+		// Chaos PhiWithNormal 準拠の近似（厳密な2球凸包SDFではない）
+		// 負の半径が入り得るため、使用する半径は0以上に丸める。
+		const float TaperedRadius = FMath::Max(FMath::Lerp(Radius0, Radius1, T), 0.0f);
+
+		const float LimitDistance = Radius + TaperedRadius;
+		const float DistSquared = (Location - ClosestPoint).SizeSquared();
+		if (DistSquared < LimitDistance * LimitDistance)
+		{
+			FVector PushDir = (Location - ClosestPoint).GetSafeNormal();
+			if (PushDir.IsNearlyZero())
+			{
+				// ボーンがカプセル軸上に乗ると押し出し方向が消えるため軸直交方向を代替に使う
+				PushDir = FallbackPushDir;
+			}
+			Location = ClosestPoint + PushDir * LimitDistance;
+		}
+	}
+
+	FORCEINLINE void PushOutBox(FVector& Location, const float Radius, const FTransform& BoxTransform,
+	                            const FVector& Extent)
+	{
+		const float SphereRadius = Radius;
+
+		const FVector LocalSphereCenter = BoxTransform.InverseTransformPosition(Location);
+		const FBox LocalBox(-Extent, Extent);
+		if (!FMath::SphereAABBIntersection(FSphere(LocalSphereCenter, SphereRadius), LocalBox))
+		{
+			return;
+		}
+
+		// Sphere の中心に最も近い Box 上の点を計算
+		FVector ClosestPoint = LocalSphereCenter;
+		ClosestPoint.X = FMath::Clamp(ClosestPoint.X, LocalBox.Min.X, LocalBox.Max.X);
+		ClosestPoint.Y = FMath::Clamp(ClosestPoint.Y, LocalBox.Min.Y, LocalBox.Max.Y);
+		ClosestPoint.Z = FMath::Clamp(ClosestPoint.Z, LocalBox.Min.Z, LocalBox.Max.Z);
+
+		FVector PushOutVector = LocalSphereCenter - ClosestPoint;
+		float Distance = PushOutVector.Size();
+
+		// ボーンスフィアが Box 内部に完全に埋没している場合は強制的に押し出す。
+		if (PushOutVector.IsNearlyZero())
+		{
+			PushOutVector = LocalSphereCenter;
+			Distance = SphereRadius;
+
+			// 中心一致時は半径方向が定まらず GetSafeNormal()==0 で動かなくなるため、最近面（最小貫通軸）を選ぶ。
+			if (PushOutVector.IsNearlyZero())
+			{
+				const FVector Penetration = Extent - LocalSphereCenter.GetAbs();
+				if (Penetration.X <= Penetration.Y && Penetration.X <= Penetration.Z)
+				{
+					PushOutVector = FVector(LocalSphereCenter.X >= 0.0 ? 1.0 : -1.0, 0.0, 0.0);
+				}
+				else if (Penetration.Y <= Penetration.Z)
+				{
+					PushOutVector = FVector(0.0, LocalSphereCenter.Y >= 0.0 ? 1.0 : -1.0, 0.0);
+				}
+				else
+				{
+					PushOutVector = FVector(0.0, 0.0, LocalSphereCenter.Z >= 0.0 ? 1.0 : -1.0);
+				}
+			}
+		}
+
+		// 押し出し
+		if (Distance <= SphereRadius)
+		{
+			const FVector PushOutDirection = PushOutVector.GetSafeNormal();
+			const FVector NewLocalSphereCenter = ClosestPoint + PushOutDirection * SphereRadius;
+			Location = BoxTransform.TransformPosition(NewLocalSphereCenter);
+		}
+	}
+
+	FORCEINLINE void PushOutPlane(FVector& Location, const FVector& PrevLocation, const float Radius,
+	                              const FPlane& Plane, const FVector& Normal)
+	{
+		const FVector PointOnPlane = FVector::PointPlaneProject(Location, Plane);
+		const float DistSquared = (Location - PointOnPlane).SizeSquared();
+
+		FVector IntersectionPoint;
+		if (DistSquared < Radius * Radius ||
+			FMath::SegmentPlaneIntersection(Location, PrevLocation, Plane, IntersectionPoint))
+		{
+			Location = PointOnPlane + Normal * Radius;
+		}
+	}
+
+	// ===== ボーン区間コリジョン（bBoneSegmentCollision / bBoneConstraintEdgeCollision） =====
+	// 親→子のボーン区間（または BoneConstraint の辺）A-B を半径 RadiusA→RadiusB のカプセルとみなし、コライダーと最も近い区間上の点を表面まで戻す変位を求める。
+	// OutT は接触点の区間上の位置（0=A, 1=B）。当たっていなければ false。
+
+	// 中心が区間上に乗ると押し出し方向が決まらないため、そのときは端点の判定に任せる
+	FORCEINLINE bool ComputeSegmentSphereContact(const FVector& A, const FVector& B, const float RadiusA,
+	                                             const float RadiusB, const FVector& Center, const float SphereRadius,
+	                                             float& OutT, FVector& OutPush)
+	{
+		const FVector Segment = B - A;
+		const FVector::FReal SegmentSizeSq = Segment.SizeSquared();
+		const float T = SegmentSizeSq > UE_SMALL_NUMBER
+			                ? FMath::Clamp(static_cast<float>(FVector::DotProduct(Center - A, Segment) / SegmentSizeSq),
+			                               0.0f, 1.0f)
+			                : 0.0f;
+		const FVector Delta = A + Segment * T - Center;
+		const float LimitDistance = FMath::Lerp(RadiusA, RadiusB, T) + SphereRadius;
+		const float DistSq = Delta.SizeSquared();
+		if (DistSq >= LimitDistance * LimitDistance)
+		{
+			return false;
+		}
+
+		const float Dist = FMath::Sqrt(DistSq);
+		if (Dist <= KINDA_SMALL_NUMBER)
+		{
+			return false;
+		}
+		OutT = T;
+		OutPush = (LimitDistance - Dist) * (Delta / Dist);
+		return true;
+	}
+
+	// Capsule は Radius0=Radius1。テーパーの半径はコライダー軸上の最近点で補間する（PushOutTaperedCapsule と同じ近似）
+	FORCEINLINE bool ComputeSegmentCapsuleContact(const FVector& A, const FVector& B, const float RadiusA,
+	                                              const float RadiusB, const FVector& StartPoint,
+	                                              const FVector& EndPoint, const float Radius0, const float Radius1,
+	                                              const FVector& FallbackPushDir, float& OutT, FVector& OutPush)
+	{
+		FVector PointOnBone;
+		FVector PointOnCapsule;
+		FMath::SegmentDistToSegmentSafe(A, B, StartPoint, EndPoint, PointOnBone, PointOnCapsule);
+
+		const FVector Segment = B - A;
+		const FVector::FReal SegmentSizeSq = Segment.SizeSquared();
+		const float T = SegmentSizeSq > UE_SMALL_NUMBER
+			                ? FMath::Clamp(static_cast<float>(FVector::DotProduct(PointOnBone - A, Segment) /
+			                                                  SegmentSizeSq), 0.0f, 1.0f)
+			                : 0.0f;
+		const FVector Axis = EndPoint - StartPoint;
+		const FVector::FReal AxisSizeSq = Axis.SizeSquared();
+		const float S = AxisSizeSq > UE_SMALL_NUMBER
+			                ? FMath::Clamp(static_cast<float>(FVector::DotProduct(PointOnCapsule - StartPoint, Axis) /
+			                                                  AxisSizeSq), 0.0f, 1.0f)
+			                : 0.0f;
+
+		const float LimitDistance = FMath::Lerp(RadiusA, RadiusB, T) + FMath::Max(FMath::Lerp(Radius0, Radius1, S), 0.0f);
+		const FVector Delta = PointOnBone - PointOnCapsule;
+		const float DistSq = Delta.SizeSquared();
+		if (DistSq >= LimitDistance * LimitDistance)
+		{
+			return false;
+		}
+
+		// 区間がカプセル軸と交差すると押し出し方向が消えるため軸直交方向を代替に使う
+		const float Dist = FMath::Sqrt(DistSq);
+		const FVector PushDir = Dist > KINDA_SMALL_NUMBER ? Delta / Dist : FallbackPushDir;
+		OutT = T;
+		OutPush = PointOnCapsule + PushDir * LimitDistance - PointOnBone;
+		return true;
+	}
+
+	// 固定端のすぐそばの接触で動かせる端点を大きく振らないための、重みの二乗和の下限（増幅は最大2倍）
+	constexpr float GMinSegmentPushWeightSq = 0.25f;
+
+	// 区間上 T の点が Push だけ動くよう、動かせる端点へ重心座標の重み（1-T : T）で配分する
+	FORCEINLINE void ApplySegmentPush(FVector& A, FVector& B, const bool bMovableA, const bool bMovableB, const float T,
+	                                  const FVector& Push)
+	{
+		const float WeightA = bMovableA ? 1.0f - T : 0.0f;
+		const float WeightB = bMovableB ? T : 0.0f;
+		const float WeightSq = WeightA * WeightA + WeightB * WeightB;
+		if (WeightSq <= UE_SMALL_NUMBER)
+		{
+			return;
+		}
+		const FVector ScaledPush = Push / FMath::Max(WeightSq, GMinSegmentPushWeightSq);
+		A += ScaledPush * WeightA;
+		B += ScaledPush * WeightB;
+	}
+
+	// ===== SIMD ナローフェーズ（AnimNode_KawaiiPhysicsSimd.cpp） =====
+	// 1ボーンを4コライダー単位のブロックで判定し、当たり候補のあるブロックだけを上のスカラー関数で順に確定する。
+	// 判定は保守的（わずかに広い）なので、押し出し結果はスカラー経路とビット一致する。
+	// Relevance でこのボーンと無関係なコライダーは確定処理で飛ばす。
+	using FRelevanceFilter = FKawaiiPhysicsColliderBuffer::FRelevanceFilter;
+	void PushOutSpheresSimd(FVector& Location, float Radius, const FKawaiiPhysicsColliderBuffer::FSpheres& Spheres,
+	                        const FRelevanceFilter& Relevance);
+	void PushOutCapsulesSimd(FVector& Location, float Radius, const FKawaiiPhysicsColliderBuffer::FCapsules& Capsules,
+	                         const FRelevanceFilter& Relevance);
+	void PushOutTaperedCapsulesSimd(FVector& Location, float Radius,
+	                                const FKawaiiPhysicsColliderBuffer::FTaperedCapsules& TaperedCapsules,
+	                                const FRelevanceFilter& Relevance);
+	void PushOutBoxesSimd(FVector& Location, float Radius, const FKawaiiPhysicsColliderBuffer::FBoxes& Boxes,
+	                      const FRelevanceFilter& Relevance);
+}
@@ -42,7 +42,10 @@ namespace
 			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, PhysicsAssetForLimits),
 			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, MirrorDataTableForLimits),
 			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, bSkipMirroredBoneWithExistingCollision),
+			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, bAutoColliderRelevance),
+			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, ColliderRelevanceMargin),
 			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, BoneConstraintSubdivisionCount),
+			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, bBoneConstraintEdgeCollision),
 			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, BoneConstraints),
 			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, BoneConstraintsDataAsset),
 		};
@@ -475,6 +478,8 @@ bool UKawaiiPhysicsLibrary::SetNodeWildcardPropertyValue(FAnimNode_KawaiiPhysics
 		return false;
 	}
 
+	// パイプライン実行中のタスクがノードを読んでいる間に書き換えないよう、先に合流させる
+	Node.JoinPipelinedSimulation();
 	if (void* NodeValuePtr = Property->ContainerPtrToValuePtr<void>(&Node))
 	{
 		Property->CopyCompleteValue(NodeValuePtr, ValuePtr);
@@ -519,6 +524,7 @@ bool UKawaiiPhysicsLibrary::SetNodePropertyValueFromString(FAnimNode_KawaiiPhysi
 		return false;
 	}
 
+	Node.JoinPipelinedSimulation();
 	if (void* NodeValuePtr = Property->ContainerPtrToValuePtr<void>(&Node))
 	{
 #if UE_VERSION_OLDER_THAN(5, 1, 0)
@@ -581,6 +587,7 @@ FKawaiiPhysicsReference UKawaiiPhysicsLibrary::ApplyPresetDataAsset(EKawaiiPhysi
 		TEXT("ApplyPresetDataAsset"),
 		[&ExecResult, Preset, Options](FAnimNode_KawaiiPhysics& InKawaiiPhysics)
 		{
+			InKawaiiPhysics.JoinPipelinedSimulation();
 			Preset->ApplyToNode(InKawaiiPhysics, Options, nullptr);
 			InKawaiiPhysics.RequestModifyBonesReinit();
 			InKawaiiPhysics.RequestSharedCollisionReinit();
@@ -610,6 +617,7 @@ FKawaiiPhysicsReference UKawaiiPhysicsLibrary::SetRootBoneName(const FKawaiiPhys
 		TEXT("SetRootBoneName"),
 		[RootBoneName](FAnimNode_KawaiiPhysics& InKawaiiPhysics)
 		{
+			InKawaiiPhysics.JoinPipelinedSimulation();
 			InKawaiiPhysics.RootBone = FBoneReference(RootBoneName);
 			InKawaiiPhysics.RequestModifyBonesReinit();
 		});
@@ -638,6 +646,7 @@ FKawaiiPhysicsReference UKawaiiPhysicsLibrary::SetExcludeBoneNames(const FKawaii
 		TEXT("SetExcludeBoneNames"),
 		[&ExcludeBoneNames](FAnimNode_KawaiiPhysics& InKawaiiPhysics)
 		{
+			InKawaiiPhysics.JoinPipelinedSimulation();
 			InKawaiiPhysics.ExcludeBones.Empty();
 			for (auto& ExcludeBoneName : ExcludeBoneNames)
 			{
@@ -666,6 +675,21 @@ TArray<FName> UKawaiiPhysicsLibrary::GetExcludeBoneNames(const FKawaiiPhysicsRef
 	return ExcludeBoneNames;
 }
 
+TArray<int32> UKawaiiPhysicsLibrary::GetModifyBoneChildIndices(const FKawaiiPhysicsReference& KawaiiPhysics,
+                                                              int32 ModifyBoneIndex)
+{
+	TArray<int32> ChildIndices;
+
+	KawaiiPhysics.CallAnimNodeFunction<FAnimNode_KawaiiPhysics>(
+		TEXT("GetModifyBoneChildIndices"),
+		[&ChildIndices, ModifyBoneIndex](FAnimNode_KawaiiPhysics& InKawaiiPhysics)
+		{
+			ChildIndices = InKawaiiPhysics.GetModifyBoneChildIndices(ModifyBoneIndex);
+		});
+
+	return ChildIndices;
+}
+
 FKawaiiPhysicsReference UKawaiiPhysicsLibrary::AddExternalForceWithExecResult(
 	EKawaiiPhysicsAccessExternalForceResult& ExecResult,
 	const FKawaiiPhysicsReference& KawaiiPhysics,
@@ -697,6 +721,7 @@ bool UKawaiiPhysicsLibrary::AddExternalForce(const FKawaiiPhysicsReference& Kawa
 				TEXT("AddExternalForce"),
 				[&](FAnimNode_KawaiiPhysics& InKawaiiPhysics)
 				{
+					InKawaiiPhysics.JoinPipelinedSimulation();
 					InKawaiiPhysics.ExternalForces.Add(ExternalForce);
 				});
 
@@ -747,6 +772,7 @@ bool UKawaiiPhysicsLibrary::RemoveExternalForcesFromComponent(USkeletalMeshCompo
 			TEXT("RemoveExternalForce"),
 			[&](FAnimNode_KawaiiPhysics& InKawaiiPhysics)
 			{
+				InKawaiiPhysics.JoinPipelinedSimulation();
 				const int32 NumRemoved = InKawaiiPhysics.ExternalForces.RemoveAll([&](FInstancedStruct& InstancedStruct)
 				{
 					const auto* ExternalForcePtr = InstancedStruct.GetMutablePtr<FKawaiiPhysics_ExternalForce>();
@@ -1377,6 +1403,7 @@ bool UKawaiiPhysicsLibrary::SetAlphaToComponent(USkeletalMeshComponent* MeshComp
 			TEXT("SetAlpha"),
 			[&](FAnimNode_KawaiiPhysics& InKawaiiPhysics)
 			{
+				InKawaiiPhysics.JoinPipelinedSimulation();
 				InKawaiiPhysics.Alpha = Alpha;
 				bResult = true;
 			});
@@ -1490,6 +1517,7 @@ DEFINE_FUNCTION(UKawaiiPhysicsLibrary::execSetExternalForceWildcardProperty)
 		TEXT("SetExternalForceWildcardProperty"),
 		[&ExecResult, &ExternalForceIndex, &PropertyName, &ValuePtr, &ValueProp](FAnimNode_KawaiiPhysics& InKawaiiPhysics)
 		{
+			InKawaiiPhysics.JoinPipelinedSimulation();
 			if (InKawaiiPhysics.ExternalForces.IsValidIndex(ExternalForceIndex) &&
 				InKawaiiPhysics.ExternalForces[ExternalForceIndex].IsValid())
 			{
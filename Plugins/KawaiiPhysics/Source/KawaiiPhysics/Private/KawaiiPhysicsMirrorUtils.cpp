@@ -44,4 +44,21 @@ namespace KawaiiPhysicsMirror
 			OutCSRotations[BoneIndex].Normalize();
 		}
 	}
+
+	void MirrorBoneFilter(FKawaiiPhysicsLimitBoneFilter& Filter, TFunctionRef<FName(FName)> ResolveMirrorBoneName)
+	{
+		auto MirrorBones = [&ResolveMirrorBoneName](TArray<FBoneReference>& Bones)
+		{
+			for (FBoneReference& Bone : Bones)
+			{
+				const FName MirroredBoneName = ResolveMirrorBoneName(Bone.BoneName);
+				if (!MirroredBoneName.IsNone())
+				{
+					Bone = FBoneReference(MirroredBoneName);
+				}
+			}
+		};
+		MirrorBones(Filter.Bones);
+		MirrorBones(Filter.RootBones);
+	}
 }
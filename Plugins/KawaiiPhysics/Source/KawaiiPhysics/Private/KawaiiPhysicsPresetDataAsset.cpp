@@ -52,6 +52,8 @@ namespace
 	{
 		static const TSet<FName> Names = {
 			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, DeltaTime),
+			// ゲーム側がインスタンス毎に与える優先度なのでプリセットには含めない / Per-instance priority given by the game
+			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, Significance),
 		};
 		return Names;
 	}
@@ -63,18 +65,28 @@ namespace
 			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, BoneSubdivisionCount),
 			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, bBoneSubdivisionCollisionOnly),
 			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, bBoneSubdivisionDensifyByRadius),
+			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, bBoneSegmentCollision),
 			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, BoneConstraintSubdivisionCount),
 			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, BoneConstraintSubdivisionFeedbackScale),
+			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, bBoneConstraintEdgeCollision),
 			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, BoneForwardAxis),
 			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, PhysicsSettings),
 			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, SimulationSpace),
 			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, SimulationBaseBone),
 			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, TargetFramerate),
+			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, OutputInterpolation),
 			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, WarmUpFrames),
 			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, bUseWarmUpWhenResetDynamics),
 			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, bNeedWarmUp),
 			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, TeleportDistanceThreshold),
 			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, TeleportRotationThreshold),
+			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, bAllowSleep),
+			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, SleepVelocityThreshold),
+			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, SleepPoseThreshold),
+			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, SleepFrames),
+			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, LODTiers),
+			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, LODTierMetric),
+			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, LODTierBlendTime),
 			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, PlanarConstraint),
 			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, SkelCompMoveScale),
 			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, bUpdatePhysicsSettingsInGame),
@@ -94,6 +106,8 @@ namespace
 			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, PhysicsAssetForLimits),
 			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, MirrorDataTableForLimits),
 			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, bSkipMirroredBoneWithExistingCollision),
+			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, bAutoColliderRelevance),
+			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, ColliderRelevanceMargin),
 			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, bSharedCollisionSource),
 			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, bUseSharedCollision),
 			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, SharedCollisionGroupTag),
@@ -116,6 +130,8 @@ namespace
 			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, ExternalForces),
 			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, CustomExternalForces),
 			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, bAllowWorldCollision),
+			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, WorldCollisionMode),
+			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, WorldCollisionQueryRadius),
 			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, bOverrideCollisionParams),
 			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, CollisionChannelSettings),
 			GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, bIgnoreSelfComponent),
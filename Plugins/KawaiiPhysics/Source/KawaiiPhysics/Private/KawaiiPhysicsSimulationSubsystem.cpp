@@ -0,0 +1,436 @@
+// Copyright 2019-2026 pafuhana1213. All Rights Reserved.
+
+#include "KawaiiPhysicsSimulationSubsystem.h"
+#include "AnimNode_KawaiiPhysics.h"
+#include "KawaiiPhysicsAsyncWorldCollision.h"
+#include "KawaiiPhysicsDeveloperSettings.h"
+
+#include "Animation/AnimInstance.h"
+#include "Async/ParallelFor.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+
+DECLARE_CYCLE_STAT(TEXT("KawaiiPhysics_BatchedSimulation"), STAT_KawaiiPhysics_BatchedSimulation, STATGROUP_Anim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("KawaiiPhysics_NumBatchedSimulations"), STAT_KawaiiPhysics_NumBatchedSimulations, STATGROUP_Anim);
+DECLARE_CYCLE_STAT(TEXT("KawaiiPhysics_IssueAsyncWorldCollision"), STAT_KawaiiPhysics_IssueAsyncWorldCollision, STATGROUP_Anim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("KawaiiPhysics_NumAsyncWorldCollisionTraces"), STAT_KawaiiPhysics_NumAsyncWorldCollisionTraces, STATGROUP_Anim);
+DECLARE_CYCLE_STAT(TEXT("KawaiiPhysics_AllocateBudget"), STAT_KawaiiPhysics_AllocateBudget, STATGROUP_Anim);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("KawaiiPhysics_BudgetMs"), STAT_KawaiiPhysics_BudgetMs, STATGROUP_Anim);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("KawaiiPhysics_BudgetRequestedMs"), STAT_KawaiiPhysics_BudgetRequestedMs, STATGROUP_Anim);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("KawaiiPhysics_BudgetUsedMs"), STAT_KawaiiPhysics_BudgetUsedMs, STATGROUP_Anim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("KawaiiPhysics_NumBudgetFull"), STAT_KawaiiPhysics_NumBudgetFull, STATGROUP_Anim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("KawaiiPhysics_NumBudgetReduced"), STAT_KawaiiPhysics_NumBudgetReduced, STATGROUP_Anim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("KawaiiPhysics_NumBudgetFrozen"), STAT_KawaiiPhysics_NumBudgetFrozen, STATGROUP_Anim);
+
+namespace
+{
+	struct FBudgetView
+	{
+		FVector Location = FVector::ZeroVector;
+		// 1 / tan(FOV/2)。球の半径/距離に掛けると画面に対する大きさになる / Multiplied by radius/distance gives the screen size
+		float ScreenMultiple = 1.0f;
+	};
+
+	/** ローカルプレイヤーのカメラ（無ければ空） / Cameras of the local players (empty if none) */
+	void GatherBudgetViews(const UWorld& World, TArray<FBudgetView, TInlineAllocator<4>>& OutViews)
+	{
+		for (FConstPlayerControllerIterator It = World.GetPlayerControllerIterator(); It; ++It)
+		{
+			const APlayerController* PlayerController = It->Get();
+			if (!PlayerController || !PlayerController->IsLocalController() || !PlayerController->PlayerCameraManager)
+			{
+				continue;
+			}
+
+			const APlayerCameraManager* CameraManager = PlayerController->PlayerCameraManager;
+			const float HalfFOVRadians = FMath::DegreesToRadians(FMath::Clamp(CameraManager->GetFOVAngle(), 1.0f, 179.0f) * 0.5f);
+			OutViews.Add({CameraManager->GetCameraLocation(), 1.0f / FMath::Tan(HalfFOVRadians)});
+		}
+	}
+
+	/**
+	 * バウンディング球の画面サイズ（画面の高さに対する直径の比の目安、0〜1 に丸める）。カメラが無いワールドでは全員1、
+	 * 最近描画されていなければ0。
+	 * Approximate screen size of the bounding sphere (diameter relative to the screen, clamped to 0-1). 1 for everyone in
+	 * worlds without a camera, 0 when not rendered recently.
+	 */
+	float ComputeScreenSizeSignificance(const UObject* Owner, const TArrayView<const FBudgetView> Views)
+	{
+		const UAnimInstance* AnimInstance = Cast<UAnimInstance>(Owner);
+		const USkeletalMeshComponent* SkelComp = AnimInstance ? AnimInstance->GetSkelMeshComponent() : nullptr;
+		if (!SkelComp || Views.IsEmpty())
+		{
+			return 1.0f;
+		}
+		if (!SkelComp->WasRecentlyRendered(0.2f))
+		{
+			return 0.0f;
+		}
+
+		const FBoxSphereBounds& Bounds = SkelComp->Bounds;
+		float ScreenSize = 0.0f;
+		for (const FBudgetView& View : Views)
+		{
+			const float Distance = FMath::Max(static_cast<float>(FVector::Dist(Bounds.Origin, View.Location)), 1.0f);
+			ScreenSize = FMath::Max(ScreenSize, View.ScreenMultiple * static_cast<float>(Bounds.SphereRadius) / Distance);
+		}
+		return UKawaiiPhysicsSimulationSubsystem::NormalizeSignificance(ScreenSize);
+	}
+
+	/** バウンディング球の中心から最も近いカメラまでの距離（カメラが無ければ0） / Distance to the nearest camera (0 if none) */
+	float ComputeViewDistance(const UObject* Owner, const TArrayView<const FBudgetView> Views)
+	{
+		const UAnimInstance* AnimInstance = Cast<UAnimInstance>(Owner);
+		const USkeletalMeshComponent* SkelComp = AnimInstance ? AnimInstance->GetSkelMeshComponent() : nullptr;
+		if (!SkelComp || Views.IsEmpty())
+		{
+			return 0.0f;
+		}
+
+		float DistanceSquared = TNumericLimits<float>::Max();
+		for (const FBudgetView& View : Views)
+		{
+			DistanceSquared = FMath::Min(DistanceSquared,
+			                             static_cast<float>(FVector::DistSquared(SkelComp->Bounds.Origin, View.Location)));
+		}
+		return FMath::Sqrt(DistanceSquared);
+	}
+}
+
+void UKawaiiPhysicsSimulationSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(
+		this, &UKawaiiPhysicsSimulationSubsystem::OnWorldPostActorTick);
+}
+
+void UKawaiiPhysicsSimulationSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+	PostActorTickHandle.Reset();
+
+	// 未実行のソルバはノードごと破棄されるので捨てる（ノード側の保留フラグは次の Evaluate で同期実行に回る）
+	{
+		FScopeLock Lock(&PendingLock);
+		PendingSimulations.Empty();
+	}
+	RunningSimulations.Empty();
+	{
+		FScopeLock Lock(&AsyncWorldCollisionLock);
+		PendingAsyncWorldCollisions.Empty();
+	}
+	IssuingAsyncWorldCollisions.Empty();
+	InFlightAsyncWorldCollisions.Empty();
+	{
+		FScopeLock Lock(&BudgetLock);
+		PendingBudgetRequests.Empty();
+	}
+	AllocatingBudgetRequests.Empty();
+	{
+		FScopeLock Lock(&LODViewMetricsLock);
+		PendingLODViewMetrics.Empty();
+	}
+	UpdatingLODViewMetrics.Empty();
+	Super::Deinitialize();
+}
+
+void UKawaiiPhysicsSimulationSubsystem::EnqueueSimulation(FAnimNode_KawaiiPhysics* Node,
+                                                          const TWeakObjectPtr<const UObject>& Owner)
+{
+	if (!Node)
+	{
+		return;
+	}
+
+	FScopeLock Lock(&PendingLock);
+	PendingSimulations.Add({Node, Owner});
+}
+
+int32 UKawaiiPhysicsSimulationSubsystem::GetNumPendingSimulations() const
+{
+	FScopeLock Lock(&PendingLock);
+	return PendingSimulations.Num();
+}
+
+void UKawaiiPhysicsSimulationSubsystem::OnWorldPostActorTick(UWorld* InWorld, ELevelTick InTickType,
+                                                            float InDeltaSeconds)
+{
+	if (InWorld == GetWorld())
+	{
+		RunPendingSimulations();
+		AllocateSimulationBudget();
+		UpdateLODViewMetrics();
+		IssueAsyncWorldCollisions();
+	}
+}
+
+void UKawaiiPhysicsSimulationSubsystem::RunPendingSimulations()
+{
+	check(IsInGameThread());
+
+	// ロック区間は Swap のみ。実行中に登録されたもの（通常は無い）は次のバッチへ回る
+	RunningSimulations.Reset();
+	{
+		FScopeLock Lock(&PendingLock);
+		Swap(PendingSimulations, RunningSimulations);
+	}
+	if (RunningSimulations.IsEmpty())
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_BatchedSimulation);
+	SET_DWORD_STAT(STAT_KawaiiPhysics_NumBatchedSimulations, RunningSimulations.Num());
+
+	// Owner の生存確認は UObject を触るので GameThread で済ませ、ワーカーにはノードだけを渡す
+	for (FPendingSimulation& Pending : RunningSimulations)
+	{
+		if (!Pending.Owner.IsValid())
+		{
+			Pending.Node = nullptr;
+		}
+	}
+
+	// ノードごとのボーン数・ステップ数はばらつくので Unbalanced で細かく配る
+	ParallelFor(RunningSimulations.Num(), [this](const int32 Index)
+	{
+		if (FAnimNode_KawaiiPhysics* Node = RunningSimulations[Index].Node)
+		{
+			Node->RunBatchedSimulation();
+		}
+	}, EParallelForFlags::Unbalanced);
+
+	RunningSimulations.Reset();
+}
+
+void UKawaiiPhysicsSimulationSubsystem::EnqueueAsyncWorldCollision(
+	const TSharedRef<FKawaiiPhysicsAsyncWorldCollision, ESPMode::ThreadSafe>& AsyncWorldCollision)
+{
+	FScopeLock Lock(&AsyncWorldCollisionLock);
+	PendingAsyncWorldCollisions.Add(AsyncWorldCollision);
+}
+
+void UKawaiiPhysicsSimulationSubsystem::IssueAsyncWorldCollisions()
+{
+	check(IsInGameThread());
+
+	IssuingAsyncWorldCollisions.Reset();
+	{
+		FScopeLock Lock(&AsyncWorldCollisionLock);
+		Swap(PendingAsyncWorldCollisions, IssuingAsyncWorldCollisions);
+	}
+
+	UWorld* World = GetWorld();
+	if (World && !IssuingAsyncWorldCollisions.IsEmpty())
+	{
+		SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_IssueAsyncWorldCollision);
+		for (const TWeakPtr<FKawaiiPhysicsAsyncWorldCollision, ESPMode::ThreadSafe>& Weak : IssuingAsyncWorldCollisions)
+		{
+			if (const TSharedPtr<FKawaiiPhysicsAsyncWorldCollision, ESPMode::ThreadSafe> AsyncWorldCollision = Weak.Pin())
+			{
+				if (AsyncWorldCollision->IssueStagedSweeps(*World) > 0)
+				{
+					InFlightAsyncWorldCollisions.AddUnique(Weak);
+				}
+			}
+		}
+	}
+
+	// 発行数ではなく、まだ結果の揃っていないスイープ数（前フレーム以前に発行して未完了のものを含む）を数える。
+	// 全て揃ったノードと破棄されたノードはここで外す
+	int32 NumInFlight = 0;
+	for (int32 Index = InFlightAsyncWorldCollisions.Num() - 1; Index >= 0; --Index)
+	{
+		const TSharedPtr<FKawaiiPhysicsAsyncWorldCollision, ESPMode::ThreadSafe> AsyncWorldCollision =
+			InFlightAsyncWorldCollisions[Index].Pin();
+		const int32 NodeInFlight = AsyncWorldCollision.IsValid() ? AsyncWorldCollision->GetNumInFlight() : 0;
+		if (NodeInFlight > 0)
+		{
+			NumInFlight += NodeInFlight;
+		}
+		else
+		{
+			InFlightAsyncWorldCollisions.RemoveAtSwap(Index);
+		}
+	}
+	SET_DWORD_STAT(STAT_KawaiiPhysics_NumAsyncWorldCollisionTraces, NumInFlight);
+
+	IssuingAsyncWorldCollisions.Reset();
+}
+
+void UKawaiiPhysicsSimulationSubsystem::ReportSimulationCost(FAnimNode_KawaiiPhysics* Node,
+                                                             const TWeakObjectPtr<const UObject>& Owner,
+                                                             const float CostMs, const float Significance,
+                                                             const uint32 ComponentId, const int32 NodeId)
+{
+	if (!Node)
+	{
+		return;
+	}
+
+	FScopeLock Lock(&BudgetLock);
+	FBudgetRequest& Request = PendingBudgetRequests.AddDefaulted_GetRef();
+	Request.Node = Node;
+	Request.Owner = Owner;
+	Request.CostMs = CostMs;
+	Request.Significance = NormalizeSignificance(Significance);
+	Request.ComponentId = ComponentId;
+	Request.NodeId = NodeId;
+}
+
+void UKawaiiPhysicsSimulationSubsystem::AllocateSimulationBudget()
+{
+	check(IsInGameThread());
+
+	AllocatingBudgetRequests.Reset();
+	{
+		FScopeLock Lock(&BudgetLock);
+		Swap(PendingBudgetRequests, AllocatingBudgetRequests);
+	}
+	if (AllocatingBudgetRequests.IsEmpty())
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_AllocateBudget);
+
+	const UWorld* World = GetWorld();
+	TArray<FBudgetView, TInlineAllocator<4>> Views;
+	if (World)
+	{
+		GatherBudgetViews(*World, Views);
+	}
+
+	// 破棄済みのノードは割り当てから外し、Significance 未指定のノードは画面サイズで埋める
+	AllocatingBudgetRequests.RemoveAll([](const FBudgetRequest& Request)
+	{
+		return !Request.Owner.IsValid();
+	});
+	float RequestedMs = 0.0f;
+	for (FBudgetRequest& Request : AllocatingBudgetRequests)
+	{
+		if (Request.Significance < 0.0f)
+		{
+			Request.Significance = ComputeScreenSizeSignificance(Request.Owner.Get(), Views);
+		}
+		RequestedMs += Request.CostMs;
+	}
+
+	const UKawaiiPhysicsDeveloperSettings* KawaiiSettings = GetDefault<UKawaiiPhysicsDeveloperSettings>();
+	const float BudgetMs = KawaiiSettings->SimulationBudgetMs;
+	const float UsedMs = AssignBudgetTiers(AllocatingBudgetRequests, BudgetMs, KawaiiSettings->ReducedUpdateInterval);
+
+	int32 NumTier[3] = {0, 0, 0};
+	for (const FBudgetRequest& Request : AllocatingBudgetRequests)
+	{
+		Request.Node->SimulationBudgetTier = Request.Tier;
+		++NumTier[static_cast<int32>(Request.Tier)];
+	}
+
+	SET_FLOAT_STAT(STAT_KawaiiPhysics_BudgetMs, BudgetMs);
+	SET_FLOAT_STAT(STAT_KawaiiPhysics_BudgetRequestedMs, RequestedMs);
+	SET_FLOAT_STAT(STAT_KawaiiPhysics_BudgetUsedMs, UsedMs);
+	SET_DWORD_STAT(STAT_KawaiiPhysics_NumBudgetFull, NumTier[static_cast<int32>(EKawaiiPhysicsBudgetTier::Full)]);
+	SET_DWORD_STAT(STAT_KawaiiPhysics_NumBudgetReduced, NumTier[static_cast<int32>(EKawaiiPhysicsBudgetTier::Reduced)]);
+	SET_DWORD_STAT(STAT_KawaiiPhysics_NumBudgetFrozen, NumTier[static_cast<int32>(EKawaiiPhysicsBudgetTier::Frozen)]);
+
+	AllocatingBudgetRequests.Reset();
+}
+
+float UKawaiiPhysicsSimulationSubsystem::NormalizeSignificance(const float Significance)
+{
+	return Significance < 0.0f ? Significance : FMath::Min(Significance, 1.0f);
+}
+
+void UKawaiiPhysicsSimulationSubsystem::RequestLODViewMetrics(FAnimNode_KawaiiPhysics* Node,
+                                                              const TWeakObjectPtr<const UObject>& Owner)
+{
+	if (!Node)
+	{
+		return;
+	}
+
+	FScopeLock Lock(&LODViewMetricsLock);
+	PendingLODViewMetrics.Add({Node, Owner});
+}
+
+void UKawaiiPhysicsSimulationSubsystem::UpdateLODViewMetrics()
+{
+	check(IsInGameThread());
+
+	UpdatingLODViewMetrics.Reset();
+	{
+		FScopeLock Lock(&LODViewMetricsLock);
+		Swap(PendingLODViewMetrics, UpdatingLODViewMetrics);
+	}
+	if (UpdatingLODViewMetrics.IsEmpty())
+	{
+		return;
+	}
+
+	const UWorld* World = GetWorld();
+	TArray<FBudgetView, TInlineAllocator<4>> Views;
+	if (World)
+	{
+		GatherBudgetViews(*World, Views);
+	}
+
+	// 書き込んだ値は次の Evaluate で LOD 段階の選択に使われる（1フレーム遅れ）
+	for (const FPendingSimulation& Entry : UpdatingLODViewMetrics)
+	{
+		const UObject* Owner = Entry.Owner.Get();
+		if (!Owner)
+		{
+			continue;
+		}
+		Entry.Node->LODScreenSize = ComputeScreenSizeSignificance(Owner, Views);
+		Entry.Node->LODViewDistance = ComputeViewDistance(Owner, Views);
+	}
+
+	UpdatingLODViewMetrics.Reset();
+}
+
+float UKawaiiPhysicsSimulationSubsystem::AssignBudgetTiers(TArray<FBudgetRequest>& Requests, const float BudgetMs,
+                                                           const int32 ReducedUpdateInterval)
+{
+	// 同じ Significance 同士はコンポーネントとノードの ID で決める。登録順はワーカースレッドの実行順で毎フレーム変わるので、
+	// それに頼るとフレーム毎に段階が入れ替わってちらつく
+	Requests.Sort([](const FBudgetRequest& A, const FBudgetRequest& B)
+	{
+		if (A.Significance != B.Significance)
+		{
+			return A.Significance > B.Significance;
+		}
+		if (A.ComponentId != B.ComponentId)
+		{
+			return A.ComponentId < B.ComponentId;
+		}
+		return A.NodeId < B.NodeId;
+	});
+
+	const float ReducedScale = 1.0f / static_cast<float>(FMath::Max(ReducedUpdateInterval, 2));
+	float UsedMs = 0.0f;
+	EKawaiiPhysicsBudgetTier WorstTier = EKawaiiPhysicsBudgetTier::Full;
+	for (int32 Index = 0; Index < Requests.Num(); ++Index)
+	{
+		FBudgetRequest& Request = Requests[Index];
+		if (WorstTier == EKawaiiPhysicsBudgetTier::Full && (Index == 0 || UsedMs + Request.CostMs <= BudgetMs))
+		{
+			Request.Tier = EKawaiiPhysicsBudgetTier::Full;
+			UsedMs += Request.CostMs;
+		}
+		else if (WorstTier != EKawaiiPhysicsBudgetTier::Frozen && UsedMs + Request.CostMs * ReducedScale <= BudgetMs)
+		{
+			Request.Tier = EKawaiiPhysicsBudgetTier::Reduced;
+			UsedMs += Request.CostMs * ReducedScale;
+		}
+		else
+		{
+			Request.Tier = EKawaiiPhysicsBudgetTier::Frozen;
+		}
+		WorstTier = Request.Tier;
+	}
+	return UsedMs;
+}
@@ -0,0 +1,533 @@
+// Copyright 2019-2026 pafuhana1213. All Rights Reserved.
+
+#include "KawaiiPhysicsSolverState.h"
+
+#include "Math/VectorRegister.h"
+
+void FKawaiiPhysicsSolverState::Reset()
+{
+	Location.Reset();
+	PrevLocation.Reset();
+	PoseLocation.Reset();
+	PoseRotation.Reset();
+	Damping.Reset();
+	Stiffness.Reset();
+	WorldDampingLocation.Reset();
+	WorldDampingRotation.Reset();
+	Radius.Reset();
+	LimitAngle.Reset();
+	ParentIndex.Reset();
+	InterBoneRealParentIndex.Reset();
+	InterBoneRealChildIndex.Reset();
+	InterBoneAlpha.Reset();
+	Flags.Reset();
+	RestLength.Reset();
+	PoseDirection.Reset();
+	StiffnessFactor.Reset();
+	PrevPoseLocation.Reset();
+	CurrentPoseLocation.Reset();
+	PrevPoseRotation.Reset();
+	CurrentPoseRotation.Reset();
+}
+
+void FKawaiiPhysicsSolverState::Gather(const TArray<FKawaiiPhysicsModifyBone>& Bones)
+{
+	const int32 NumBones = Bones.Num();
+	if (Num() != NumBones)
+	{
+		// ボーン数はinit/reinit時にしか変わらないため、SetNumUninitialized は実質初回のみ確保する
+		Location.SetNumUninitialized(NumBones);
+		PrevLocation.SetNumUninitialized(NumBones);
+		PoseLocation.SetNumUninitialized(NumBones);
+		PoseRotation.SetNumUninitialized(NumBones);
+		Damping.SetNumUninitialized(NumBones);
+		Stiffness.SetNumUninitialized(NumBones);
+		WorldDampingLocation.SetNumUninitialized(NumBones);
+		WorldDampingRotation.SetNumUninitialized(NumBones);
+		Radius.SetNumUninitialized(NumBones);
+		LimitAngle.SetNumUninitialized(NumBones);
+		ParentIndex.SetNumUninitialized(NumBones);
+		InterBoneRealParentIndex.SetNumUninitialized(NumBones);
+		InterBoneRealChildIndex.SetNumUninitialized(NumBones);
+		InterBoneAlpha.SetNumUninitialized(NumBones);
+		Flags.SetNumUninitialized(NumBones);
+		// 派生値は Gather では読まない（UpdateRestPose / UpdateStiffnessFactors が埋める）
+		RestLength.SetNumZeroed(NumBones);
+		PoseDirection.SetNumZeroed(NumBones);
+		StiffnessFactor.SetNumZeroed(NumBones);
+	}
+
+	for (int32 Index = 0; Index < NumBones; ++Index)
+	{
+		GatherBone(Bones[Index], Index);
+	}
+}
+
+void FKawaiiPhysicsSolverState::GatherBone(const FKawaiiPhysicsModifyBone& Bone, const int32 Index)
+{
+	Location[Index] = Bone.Location;
+	PrevLocation[Index] = Bone.PrevLocation;
+	PoseLocation[Index] = Bone.PoseLocation;
+	PoseRotation[Index] = Bone.PoseRotation;
+
+	Damping[Index] = Bone.PhysicsSettings.Damping;
+	Stiffness[Index] = Bone.PhysicsSettings.Stiffness;
+	WorldDampingLocation[Index] = Bone.PhysicsSettings.WorldDampingLocation;
+	WorldDampingRotation[Index] = Bone.PhysicsSettings.WorldDampingRotation;
+	Radius[Index] = Bone.PhysicsSettings.Radius;
+	LimitAngle[Index] = Bone.PhysicsSettings.LimitAngle;
+
+	ParentIndex[Index] = Bone.ParentIndex;
+	InterBoneRealParentIndex[Index] = Bone.InterBoneRealParentIndex;
+	InterBoneRealChildIndex[Index] = Bone.InterBoneRealChildIndex;
+	InterBoneAlpha[Index] = Bone.InterBoneAlpha;
+
+	uint8 BoneFlags = Flag_None;
+	BoneFlags |= Bone.bSkipSimulate ? Flag_SkipSimulate : Flag_None;
+	BoneFlags |= Bone.bDummy ? Flag_Dummy : Flag_None;
+	BoneFlags |= Bone.bInterBoneDummy ? Flag_InterBoneDummy : Flag_None;
+	BoneFlags |= Bone.bBridgeDummy ? Flag_BridgeDummy : Flag_None;
+	// SimulateOnce の root 追従条件（bridge dummy と LOD で無効な実ボーンを除く）
+	if (IsKinematicRoot(Bone))
+	{
+		BoneFlags |= Flag_KinematicRoot;
+	}
+	Flags[Index] = BoneFlags;
+}
+
+void FKawaiiPhysicsSolverState::Scatter(TArray<FKawaiiPhysicsModifyBone>& Bones) const
+{
+	const int32 NumBones = FMath::Min(Bones.Num(), Num());
+	for (int32 Index = 0; Index < NumBones; ++Index)
+	{
+		ScatterBone(Bones[Index], Index);
+	}
+}
+
+void FKawaiiPhysicsSolverState::ScatterBone(FKawaiiPhysicsModifyBone& Bone, const int32 Index) const
+{
+	Bone.Location = Location[Index];
+	Bone.PrevLocation = PrevLocation[Index];
+	Bone.PoseLocation = PoseLocation[Index];
+	Bone.bSkipSimulate = HasFlag(Index, Flag_SkipSimulate);
+}
+
+void FKawaiiPhysicsSolverState::ScatterPoseRotation(TArray<FKawaiiPhysicsModifyBone>& Bones) const
+{
+	const int32 NumBones = FMath::Min(Bones.Num(), Num());
+	for (int32 Index = 0; Index < NumBones; ++Index)
+	{
+		Bones[Index].PoseRotation = PoseRotation[Index];
+	}
+}
+
+void FKawaiiPhysicsSolverState::UpdateRestPose(const TArray<int32>& Bones)
+{
+	for (const int32 Index : Bones)
+	{
+		const FVector PoseVector = PoseLocation[Index] - PoseLocation[ParentIndex[Index]];
+		RestLength[Index] = PoseVector.Size();
+		PoseDirection[Index] = PoseVector.GetSafeNormal();
+	}
+}
+
+void FKawaiiPhysicsSolverState::UpdateStiffnessFactors(const TArray<int32>& Bones, const float Exponent)
+{
+	for (const int32 Index : Bones)
+	{
+		StiffnessFactor[Index] = 1.0f - FMath::Pow(1.0f - Stiffness[Index], Exponent);
+	}
+}
+
+void FKawaiiPhysicsSolverState::GatherSubstepPoseTargets(const TArray<FKawaiiPhysicsModifyBone>& Bones)
+{
+	const int32 NumBones = Bones.Num();
+	PrevPoseLocation.SetNumUninitialized(NumBones);
+	CurrentPoseLocation.SetNumUninitialized(NumBones);
+	PrevPoseRotation.SetNumUninitialized(NumBones);
+	CurrentPoseRotation.SetNumUninitialized(NumBones);
+	for (int32 Index = 0; Index < NumBones; ++Index)
+	{
+		PrevPoseLocation[Index] = Bones[Index].PrevPoseLocation;
+		CurrentPoseLocation[Index] = Bones[Index].CurrentPoseLocation;
+		PrevPoseRotation[Index] = Bones[Index].PrevPoseRotation;
+		CurrentPoseRotation[Index] = Bones[Index].CurrentPoseRotation;
+	}
+}
+
+void FKawaiiPhysicsSolverState::LerpPoseLocation(const float Alpha)
+{
+	check(PrevPoseLocation.Num() == Num() && CurrentPoseLocation.Num() == Num());
+	static_assert(sizeof(FVector) == 3 * sizeof(FVector::FReal), "FVector must be tightly packed");
+
+	// 成分ごとに独立な演算なので、ストリームを成分の連続配列とみなして4成分ずつ処理する。
+	// 演算列は FMath::Lerp と同じ A + Alpha * (B - A)（FMA にまとめない）
+	const double* Prev = &PrevPoseLocation.GetData()->X;
+	const double* Current = &CurrentPoseLocation.GetData()->X;
+	double* Pose = &PoseLocation.GetData()->X;
+	const int32 NumComponents = Num() * 3;
+	const double AlphaDouble = Alpha;
+	const VectorRegister4Double AlphaLanes = MakeVectorRegisterDouble(AlphaDouble, AlphaDouble, AlphaDouble,
+	                                                                  AlphaDouble);
+
+	int32 Component = 0;
+	for (; Component + 4 <= NumComponents; Component += 4)
+	{
+		const VectorRegister4Double A = VectorLoad(Prev + Component);
+		const VectorRegister4Double B = VectorLoad(Current + Component);
+		VectorStore(VectorAdd(A, VectorMultiply(AlphaLanes, VectorSubtract(B, A))), Pose + Component);
+	}
+	for (; Component < NumComponents; ++Component)
+	{
+		Pose[Component] = Prev[Component] + AlphaDouble * (Current[Component] - Prev[Component]);
+	}
+}
+
+void FKawaiiPhysicsSolverState::RestoreCurrentPoseLocation()
+{
+	check(CurrentPoseLocation.Num() == Num());
+	FMemory::Memcpy(PoseLocation.GetData(), CurrentPoseLocation.GetData(), Num() * sizeof(FVector));
+}
+
+void FKawaiiPhysicsSolverState::InterpolatePoseRotation(const float Alpha, const bool bUseNLerp)
+{
+	check(PrevPoseRotation.Num() == Num() && CurrentPoseRotation.Num() == Num());
+	if (bUseNLerp)
+	{
+		// FastLerp は最短経路側へ符号を揃えた線形補間（未正規化）
+		for (int32 Index = 0; Index < Num(); ++Index)
+		{
+			PoseRotation[Index] =
+				FQuat::FastLerp(PrevPoseRotation[Index], CurrentPoseRotation[Index], Alpha).GetNormalized();
+		}
+	}
+	else
+	{
+		for (int32 Index = 0; Index < Num(); ++Index)
+		{
+			PoseRotation[Index] =
+				FQuat::Slerp(PrevPoseRotation[Index], CurrentPoseRotation[Index], Alpha).GetNormalized();
+		}
+	}
+}
+
+void FKawaiiPhysicsSolverState::RestoreCurrentPoseRotation()
+{
+	check(CurrentPoseRotation.Num() == Num());
+	FMemory::Memcpy(PoseRotation.GetData(), CurrentPoseRotation.GetData(), Num() * sizeof(FQuat));
+}
+
+SIZE_T FKawaiiPhysicsSolverState::GetAllocatedSize() const
+{
+	return Location.GetAllocatedSize() + PrevLocation.GetAllocatedSize() + PoseLocation.GetAllocatedSize() +
+		PoseRotation.GetAllocatedSize() +
+		Damping.GetAllocatedSize() + Stiffness.GetAllocatedSize() + WorldDampingLocation.GetAllocatedSize() +
+		WorldDampingRotation.GetAllocatedSize() + Radius.GetAllocatedSize() + LimitAngle.GetAllocatedSize() +
+		ParentIndex.GetAllocatedSize() + InterBoneRealParentIndex.GetAllocatedSize() +
+		InterBoneRealChildIndex.GetAllocatedSize() + InterBoneAlpha.GetAllocatedSize() + Flags.GetAllocatedSize() +
+		RestLength.GetAllocatedSize() + PoseDirection.GetAllocatedSize() + StiffnessFactor.GetAllocatedSize() +
+		PrevPoseLocation.GetAllocatedSize() + CurrentPoseLocation.GetAllocatedSize() +
+		PrevPoseRotation.GetAllocatedSize() + CurrentPoseRotation.GetAllocatedSize();
+}
+
+void FKawaiiPhysicsBoneCategories::Build(const TArray<FKawaiiPhysicsModifyBone>& Bones, const uint32 LayoutGeneration)
+{
+	Reset();
+
+	const int32 NumBones = Bones.Num();
+	for (int32 Index = 0; Index < NumBones; ++Index)
+	{
+		const FKawaiiPhysicsModifyBone& Bone = Bones[Index];
+		if (Bone.bBridgeDummy)
+		{
+			BridgeDummies.Add(Index);
+			continue;
+		}
+		if (Bone.bInterBoneDummy)
+		{
+			InterBoneDummies.Add(Index);
+		}
+		if (Bone.bSkipSimulate)
+		{
+			if (FKawaiiPhysicsSolverState::IsKinematicRoot(Bone))
+			{
+				KinematicRoots.Add(Index);
+			}
+			continue;
+		}
+
+		Simulated.Add(Index);
+		if (!Bone.bInterBoneDummy)
+		{
+			SimulatedWithoutInterBoneDummies.Add(Index);
+		}
+	}
+	BuiltNumBones = NumBones;
+	BuiltLayoutGeneration = LayoutGeneration;
+}
+
+void FKawaiiPhysicsBoneCategories::Reset()
+{
+	KinematicRoots.Reset();
+	Simulated.Reset();
+	SimulatedWithoutInterBoneDummies.Reset();
+	InterBoneDummies.Reset();
+	BridgeDummies.Reset();
+	BuiltNumBones = INDEX_NONE;
+}
+
+void FKawaiiPhysicsBoneTopology::Build(const TArray<FKawaiiPhysicsModifyBone>& Bones)
+{
+	const int32 NumBones = Bones.Num();
+
+	// 親ごとの子の数を数えてオフセットにし、index 昇順に詰める（counting sort）
+	ChildOffsets.Reset(NumBones + 1);
+	ChildOffsets.AddZeroed(NumBones + 1);
+	for (const FKawaiiPhysicsModifyBone& Bone : Bones)
+	{
+		if (Bones.IsValidIndex(Bone.ParentIndex))
+		{
+			++ChildOffsets[Bone.ParentIndex + 1];
+		}
+	}
+	for (int32 Index = 0; Index < NumBones; ++Index)
+	{
+		ChildOffsets[Index + 1] += ChildOffsets[Index];
+	}
+
+	Children.SetNumUninitialized(ChildOffsets[NumBones]);
+	TArray<int32, TInlineAllocator<64>> Cursor;
+	Cursor.Append(ChildOffsets.GetData(), NumBones);
+	for (int32 Index = 0; Index < NumBones; ++Index)
+	{
+		const int32 ParentIndex = Bones[Index].ParentIndex;
+		if (Bones.IsValidIndex(ParentIndex))
+		{
+			Children[Cursor[ParentIndex]++] = Index;
+		}
+	}
+}
+
+void FKawaiiPhysicsBoneTopology::Reset()
+{
+	ChildOffsets.Reset();
+	Children.Reset();
+}
+
+SIZE_T FKawaiiPhysicsBoneCategories::GetAllocatedSize() const
+{
+	return KinematicRoots.GetAllocatedSize() + Simulated.GetAllocatedSize() + SimulatedWithoutInterBoneDummies.GetAllocatedSize() +
+		InterBoneDummies.GetAllocatedSize() + BridgeDummies.GetAllocatedSize();
+}
+
+void FKawaiiPhysicsBoneIslands::Build(const TArray<FKawaiiPhysicsModifyBone>& Bones,
+                                      const TArray<FModifyBoneConstraint>& Constraints,
+                                      const FKawaiiPhysicsBoneCategories& Categories, const int32 MinBonesPerIsland)
+{
+	Reset();
+
+	const int32 NumBones = Bones.Num();
+	BuiltNumBones = NumBones;
+	BuiltNumConstraints = Constraints.Num();
+	BuiltMinBonesPerIsland = MinBonesPerIsland;
+
+	// union-find（代表は成分内の最小 index。経路半減で平坦化）
+	TArray<int32> Representative;
+	Representative.SetNumUninitialized(NumBones);
+	for (int32 Index = 0; Index < NumBones; ++Index)
+	{
+		Representative[Index] = Index;
+	}
+	auto Find = [&Representative](int32 Index)
+	{
+		while (Representative[Index] != Index)
+		{
+			Representative[Index] = Representative[Representative[Index]];
+			Index = Representative[Index];
+		}
+		return Index;
+	};
+	auto Union = [&Representative, &Find](const int32 A, const int32 B)
+	{
+		if (!Representative.IsValidIndex(A) || !Representative.IsValidIndex(B))
+		{
+			return;
+		}
+		const int32 RootA = Find(A);
+		const int32 RootB = Find(B);
+		if (RootA != RootB)
+		{
+			Representative[FMath::Max(RootA, RootB)] = FMath::Min(RootA, RootB);
+		}
+	};
+
+	// 親子 / dummy の端点（inter-bone dummy は同じチェーン内、bridge dummy は Constraint 両端） / Constraint の両端
+	for (int32 Index = 0; Index < NumBones; ++Index)
+	{
+		const FKawaiiPhysicsModifyBone& Bone = Bones[Index];
+		Union(Index, Bone.ParentIndex);
+		Union(Index, Bone.InterBoneRealParentIndex);
+		Union(Index, Bone.InterBoneRealChildIndex);
+	}
+	for (const FModifyBoneConstraint& Constraint : Constraints)
+	{
+		Union(Constraint.ModifyBoneIndex1, Constraint.ModifyBoneIndex2);
+	}
+
+	// 連結成分に先頭ボーン順の番号を振る（代表は自分以下の index なので既に番号が付いている）
+	TArray<int32> ComponentOfBone;
+	ComponentOfBone.SetNumUninitialized(NumBones);
+	TArray<int32> ComponentSizes;
+	for (int32 Index = 0; Index < NumBones; ++Index)
+	{
+		const int32 Root = Find(Index);
+		ComponentOfBone[Index] = (Root == Index) ? ComponentSizes.Add(0) : ComponentOfBone[Root];
+		++ComponentSizes[ComponentOfBone[Index]];
+	}
+
+	// 最小ボーン数に届くまで隣り合う成分を1つのアイランドへ詰める。届かなかった末尾は1つ前へ合流
+	TArray<int32> IslandOfComponent;
+	IslandOfComponent.SetNumUninitialized(ComponentSizes.Num());
+	int32 NumIslands = 0;
+	int32 OpenIslandBones = 0;
+	for (int32 Component = 0; Component < ComponentSizes.Num(); ++Component)
+	{
+		if (NumIslands == 0 || OpenIslandBones >= MinBonesPerIsland)
+		{
+			++NumIslands;
+			OpenIslandBones = 0;
+		}
+		IslandOfComponent[Component] = NumIslands - 1;
+		OpenIslandBones += ComponentSizes[Component];
+	}
+	if (NumIslands > 1 && OpenIslandBones < MinBonesPerIsland)
+	{
+		for (int32& Island : IslandOfComponent)
+		{
+			Island = FMath::Min(Island, NumIslands - 2);
+		}
+		--NumIslands;
+	}
+	if (NumIslands <= 1)
+	{
+		return;
+	}
+
+	BoneIslands.SetNumUninitialized(NumBones);
+	Islands.SetNum(NumIslands);
+	for (int32 Index = 0; Index < NumBones; ++Index)
+	{
+		BoneIslands[Index] = IslandOfComponent[ComponentOfBone[Index]];
+		++Islands[BoneIslands[Index]].NumBones;
+	}
+
+	// 全体リストを先頭から振り分けるので、各アイランド内の並びは全体と同じ
+	auto Distribute = [this](const TArray<int32>& From, TArray<int32> FKawaiiPhysicsBoneCategories::* To)
+	{
+		for (const int32 Index : From)
+		{
+			(Islands[BoneIslands[Index]].Categories.*To).Add(Index);
+		}
+	};
+	Distribute(Categories.KinematicRoots, &FKawaiiPhysicsBoneCategories::KinematicRoots);
+	Distribute(Categories.Simulated, &FKawaiiPhysicsBoneCategories::Simulated);
+	Distribute(Categories.SimulatedWithoutInterBoneDummies,
+	           &FKawaiiPhysicsBoneCategories::SimulatedWithoutInterBoneDummies);
+	Distribute(Categories.InterBoneDummies, &FKawaiiPhysicsBoneCategories::InterBoneDummies);
+	Distribute(Categories.BridgeDummies, &FKawaiiPhysicsBoneCategories::BridgeDummies);
+
+	// 端点が無効な Constraint はソルバでも読み飛ばされるのでどこにも入れない
+	for (int32 ConstraintIndex = 0; ConstraintIndex < Constraints.Num(); ++ConstraintIndex)
+	{
+		const FModifyBoneConstraint& Constraint = Constraints[ConstraintIndex];
+		if (Bones.IsValidIndex(Constraint.ModifyBoneIndex1) && Bones.IsValidIndex(Constraint.ModifyBoneIndex2))
+		{
+			Islands[BoneIslands[Constraint.ModifyBoneIndex1]].Constraints.Add(ConstraintIndex);
+		}
+	}
+}
+
+void FKawaiiPhysicsBoneIslands::Reset()
+{
+	Islands.Reset();
+	BoneIslands.Reset();
+	BuiltNumBones = INDEX_NONE;
+	BuiltNumConstraints = INDEX_NONE;
+	BuiltMinBonesPerIsland = INDEX_NONE;
+}
+
+SIZE_T FKawaiiPhysicsBoneIslands::GetAllocatedSize() const
+{
+	SIZE_T Size = Islands.GetAllocatedSize() + BoneIslands.GetAllocatedSize();
+	for (const FKawaiiPhysicsBoneIsland& Island : Islands)
+	{
+		Size += Island.Categories.GetAllocatedSize() + Island.Constraints.GetAllocatedSize();
+	}
+	return Size;
+}
+
+void FKawaiiPhysicsConstraintColors::Build(const TArray<FModifyBoneConstraint>& Constraints, const int32 NumBones,
+                                          const uint32 Generation)
+{
+	Reset();
+
+	// 元の順に、両端のボーンがまだ使っていない最小の色を割り当てる（色ごとに使用済みボーンのビット列を持つ）。
+	// 端点が無効な Constraint はソルバで読み飛ばされ、どのボーンも使わないので色0に入れる
+	const int32 NumConstraints = Constraints.Num();
+	TArray<int32> ConstraintColors;
+	ConstraintColors.SetNumUninitialized(NumConstraints);
+	TArray<TBitArray<>> ColorBones;
+	TArray<int32> ColorSizes;
+	for (int32 ConstraintIndex = 0; ConstraintIndex < NumConstraints; ++ConstraintIndex)
+	{
+		const int32 Bone1 = Constraints[ConstraintIndex].ModifyBoneIndex1;
+		const int32 Bone2 = Constraints[ConstraintIndex].ModifyBoneIndex2;
+		const bool bUsesBones = Bone1 >= 0 && Bone1 < NumBones && Bone2 >= 0 && Bone2 < NumBones;
+
+		int32 Color = 0;
+		if (bUsesBones)
+		{
+			while (ColorBones.IsValidIndex(Color) && (ColorBones[Color][Bone1] || ColorBones[Color][Bone2]))
+			{
+				++Color;
+			}
+		}
+		if (!ColorBones.IsValidIndex(Color))
+		{
+			ColorBones.Emplace(false, NumBones);
+			ColorSizes.Add(0);
+		}
+		if (bUsesBones)
+		{
+			ColorBones[Color][Bone1] = true;
+			ColorBones[Color][Bone2] = true;
+		}
+		ConstraintColors[ConstraintIndex] = Color;
+		++ColorSizes[Color];
+	}
+
+	ColorOffsets.SetNumUninitialized(ColorSizes.Num() + 1);
+	ColorOffsets[0] = 0;
+	for (int32 Color = 0; Color < ColorSizes.Num(); ++Color)
+	{
+		ColorOffsets[Color + 1] = ColorOffsets[Color] + ColorSizes[Color];
+	}
+
+	// 色順の index 列（色の中は元の順）
+	TArray<int32> WriteIndices(ColorOffsets.GetData(), ColorSizes.Num());
+	ColorOrder.SetNumUninitialized(NumConstraints);
+	for (int32 ConstraintIndex = 0; ConstraintIndex < NumConstraints; ++ConstraintIndex)
+	{
+		ColorOrder[WriteIndices[ConstraintColors[ConstraintIndex]]++] = ConstraintIndex;
+	}
+	BuiltGeneration = Generation;
+	bBuilt = true;
+}
+
+void FKawaiiPhysicsConstraintColors::Reset()
+{
+	ColorOffsets.Reset();
+	ColorOrder.Reset();
+	BuiltGeneration = 0;
+	bBuilt = false;
+}
@@ -4,6 +4,10 @@
 
 #include "Misc/AutomationTest.h"
 #include "KawaiiPhysicsTestHarness.h"
+#include "KawaiiPhysicsLimitsDataAsset.h"
+#include "Animation/AnimInstanceProxy.h"
+#include "PhysicsEngine/AggregateGeom.h"
+#include "ReferenceSkeleton.h"
 
 // コリジョン押し出しの正しさ（解析的基準値）。
 // 各形状: ボーン(半径r)が形状に食い込んだとき、表面+r へ正しく押し出されることを検証。
@@ -314,4 +318,1381 @@ bool FKawaiiPhysicsAngleLimitTest::RunTest(const FString& Parameters)
 	return true;
 }
 
+// ---------------------------------------------------------------------------
+//  Compiled collider buffer
+// ---------------------------------------------------------------------------
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKawaiiPhysicsCompiledColliderBufferTest,
+                                 "KawaiiPhysics.Collision.CompiledColliderBuffer",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FKawaiiPhysicsCompiledColliderBufferTest::RunTest(const FString& Parameters)
+{
+	FKawaiiPhysicsTestAccessor A;
+
+	FSphericalLimit Sphere;
+	Sphere.Location = FVector(0, 0, 0);
+	Sphere.Radius = 10.0f;
+	Sphere.bEnable = true;
+	A.Node.SphericalLimits.Add(Sphere);
+
+	FSphericalLimit DisabledSphere = Sphere;
+	DisabledSphere.bEnable = false;
+	A.Node.SphericalLimits.Add(DisabledSphere);
+
+	FSphericalLimit ZeroRadiusSphere = Sphere;
+	ZeroRadiusSphere.Radius = 0.0f;
+	A.Node.SphericalLimits.Add(ZeroRadiusSphere);
+
+	FSphericalLimit InnerSphere;
+	InnerSphere.Location = FVector(4, 0, 0);
+	InnerSphere.Radius = 30.0f;
+	InnerSphere.LimitType = ESphericalLimitType::Inner;
+	InnerSphere.bEnable = true;
+	A.Node.SphericalLimitsData.Add(InnerSphere);
+
+	FCapsuleLimit Capsule;
+	Capsule.Location = FVector(0, 8, 0);
+	Capsule.Rotation = FQuat(FVector::ForwardVector, 0.4f);
+	Capsule.Radius = 3.0f;
+	Capsule.Length = 12.0f;
+	Capsule.bEnable = true;
+	A.Node.CapsuleLimits.Add(Capsule);
+
+	FCapsuleLimit ZeroLengthCapsule = Capsule;
+	ZeroLengthCapsule.Length = 0.0f;
+	A.Node.CapsuleLimitsData.Add(ZeroLengthCapsule);
+
+	FTaperedCapsuleLimit TaperedCapsule;
+	TaperedCapsule.Location = FVector(-6, 0, 2);
+	TaperedCapsule.Rotation = FQuat(FVector::RightVector, 0.3f);
+	TaperedCapsule.Radius0 = 4.0f;
+	TaperedCapsule.Radius1 = 2.0f;
+	TaperedCapsule.Length = 10.0f;
+	TaperedCapsule.bEnable = true;
+	A.Node.TaperedCapsuleLimits.Add(TaperedCapsule);
+
+	// 長さ0のテーパードカプセルは最大半径の球として詰められる
+	FTaperedCapsuleLimit ZeroLengthTapered = TaperedCapsule;
+	ZeroLengthTapered.Location = FVector(6, -6, 0);
+	ZeroLengthTapered.Length = 0.0f;
+	A.Node.TaperedCapsuleLimitsData.Add(ZeroLengthTapered);
+
+	FBoxLimit Box;
+	Box.Location = FVector(0, -8, -4);
+	Box.Rotation = FQuat(FVector::UpVector, 0.5f);
+	Box.Extent = FVector(3, 4, 5);
+	Box.bEnable = true;
+	A.Node.BoxLimits.Add(Box);
+
+	FPlanarLimit DisabledPlanar;
+	DisabledPlanar.Location = FVector(0, 0, -100);
+	DisabledPlanar.Plane = FPlane(DisabledPlanar.Location, FVector::UpVector);
+	DisabledPlanar.bEnable = false;
+	A.Node.PlanarLimits.Add(DisabledPlanar);
+
+	FPlanarLimit Planar;
+	Planar.Location = FVector(0, 0, -12);
+	Planar.Plane = FPlane(Planar.Location, FVector::UpVector);
+	Planar.bEnable = true;
+	A.Node.PlanarLimitsData.Add(Planar);
+
+	FKawaiiPhysicsModifyBone Probe = MakeBone(FVector::ZeroVector, 1.0f, FVector::ZeroVector);
+	A.CallCompiledCollision(Probe);
+
+	// 無効 / 縮退 limit は詰められず、配列順（AnimNode → DataAsset）は保たれる
+	const FKawaiiPhysicsColliderBuffer& Buffer = A.CompiledColliders();
+	TestEqual(TEXT("Compiled spheres skip disabled and zero-radius limits"), Buffer.Spheres.Num(), 2);
+	TestEqual(TEXT("Compiled spheres keep AnimNode -> DataAsset order"), Buffer.Spheres.Center[1], FVector(4, 0, 0));
+	TestEqual(TEXT("Compiled sphere keeps the inner flag"), Buffer.Spheres.bInner[1], static_cast<uint8>(1));
+	TestEqual(TEXT("Compiled capsules skip zero-length limits"), Buffer.Capsules.Num(), 1);
+	TestEqual(TEXT("Compiled tapered capsules keep zero-length limits"), Buffer.TaperedCapsules.Num(), 2);
+	TestEqual(TEXT("Zero-length tapered capsule is folded to its max radius"), Buffer.TaperedCapsules.Radius1[1], 4.0f);
+	TestEqual(TEXT("Compiled boxes"), Buffer.Boxes.Num(), 1);
+	TestEqual(TEXT("Compiled planes skip disabled limits"), Buffer.Planes.Num(), 1);
+
+	// バッファ経由の押し出しは limit 配列を従来順で直接処理した結果とビット一致する
+	for (int32 X = -3; X <= 3; ++X)
+	{
+		for (int32 Y = -3; Y <= 3; ++Y)
+		{
+			for (int32 Z = -3; Z <= 3; ++Z)
+			{
+				const FVector Start(X * 4.1, Y * 3.7, Z * 4.3);
+				const FVector Prev = Start + FVector(0.5, -0.25, 1.5);
+
+				FKawaiiPhysicsModifyBone Compiled = MakeBone(Start, 1.5f, Prev);
+				A.CallCompiledCollision(Compiled);
+
+				FKawaiiPhysicsModifyBone Direct = MakeBone(Start, 1.5f, Prev);
+				A.CallSphereCollision(Direct, A.Node.SphericalLimits);
+				A.CallSphereCollision(Direct, A.Node.SphericalLimitsData);
+				A.CallCapsuleCollision(Direct, A.Node.CapsuleLimits);
+				A.CallCapsuleCollision(Direct, A.Node.CapsuleLimitsData);
+				A.CallTaperedCapsuleCollision(Direct, A.Node.TaperedCapsuleLimits);
+				A.CallTaperedCapsuleCollision(Direct, A.Node.TaperedCapsuleLimitsData);
+				A.CallBoxCollision(Direct, A.Node.BoxLimits);
+				A.CallBoxCollision(Direct, A.Node.BoxLimitsData);
+				A.CallPlanarCollision(Direct, A.Node.PlanarLimits);
+				A.CallPlanarCollision(Direct, A.Node.PlanarLimitsData);
+
+				if (Compiled.Location != Direct.Location)
+				{
+					AddError(FString::Printf(TEXT("Compiled buffer mismatch at %s: compiled %s direct %s"),
+					                         *Start.ToString(), *Compiled.Location.ToString(),
+					                         *Direct.Location.ToString()));
+					return false;
+				}
+			}
+		}
+	}
+
+	// 共有コリジョンを使っていない間もキャッシュは更新され、有効にした直後に古い値を使わない
+	FCapsuleLimit SharedCapsule = Capsule;
+	SharedCapsule.Location = FVector(0, 0, 50);
+	A.SharedCapsuleLimits().Add(SharedCapsule);
+	A.Node.bUseSharedCollision = false;
+	A.CompileColliders();
+	TestTrue(TEXT("Unused shared limits still refresh their cache"),
+	         A.SharedCapsuleLimits()[0].CachedStartPoint.Equals(
+		         SharedCapsule.Location + SharedCapsule.Rotation.GetAxisZ() * SharedCapsule.Length * 0.5f));
+	TestEqual(TEXT("Unused shared limits are not compiled"), A.CompiledSharedColliders().Capsules.Num(), 0);
+
+	return true;
+}
+
+// ---------------------------------------------------------------------------
+//  SIMD narrowphase
+// ---------------------------------------------------------------------------
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKawaiiPhysicsSimdNarrowphaseTest,
+                                 "KawaiiPhysics.Collision.SimdNarrowphase",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FKawaiiPhysicsSimdNarrowphaseTest::RunTest(const FString& Parameters)
+{
+	FKawaiiPhysicsTestAccessor A;
+	FRandomStream Random(1213);
+
+	// 各形状とも4の倍数にならない個数にして、端数ブロックのパディングも通す
+	for (int32 i = 0; i < 11; ++i)
+	{
+		FSphericalLimit Sphere;
+		Sphere.Location = Random.GetUnitVector() * Random.FRandRange(0.0f, 20.0f);
+		Sphere.Radius = Random.FRandRange(2.0f, 8.0f);
+		Sphere.LimitType = i == 5 ? ESphericalLimitType::Inner : ESphericalLimitType::Outer;
+		Sphere.bEnable = true;
+		A.Node.SphericalLimits.Add(Sphere);
+	}
+	for (int32 i = 0; i < 9; ++i)
+	{
+		FCapsuleLimit Capsule;
+		Capsule.Location = Random.GetUnitVector() * Random.FRandRange(0.0f, 20.0f);
+		Capsule.Rotation = FQuat(Random.GetUnitVector(), Random.FRandRange(0.0f, PI));
+		Capsule.Radius = Random.FRandRange(1.0f, 5.0f);
+		Capsule.Length = Random.FRandRange(2.0f, 15.0f);
+		Capsule.bEnable = true;
+		A.Node.CapsuleLimits.Add(Capsule);
+	}
+	for (int32 i = 0; i < 7; ++i)
+	{
+		FTaperedCapsuleLimit TaperedCapsule;
+		TaperedCapsule.Location = Random.GetUnitVector() * Random.FRandRange(0.0f, 20.0f);
+		TaperedCapsule.Rotation = FQuat(Random.GetUnitVector(), Random.FRandRange(0.0f, PI));
+		TaperedCapsule.Radius0 = Random.FRandRange(1.0f, 6.0f);
+		// 片側が負の半径（Max(...,0) で丸められる側）と長さ0（球に畳み込み）も混ぜる
+		TaperedCapsule.Radius1 = i == 2 ? -1.0f : Random.FRandRange(0.5f, 4.0f);
+		TaperedCapsule.Length = i == 4 ? 0.0f : Random.FRandRange(2.0f, 15.0f);
+		TaperedCapsule.bEnable = true;
+		A.Node.TaperedCapsuleLimits.Add(TaperedCapsule);
+	}
+	for (int32 i = 0; i < 6; ++i)
+	{
+		FBoxLimit Box;
+		// 先頭の Box は原点中心（ボーンが中心に一致する最小貫通軸の分岐を通す）
+		Box.Location = i == 0 ? FVector::ZeroVector : Random.GetUnitVector() * Random.FRandRange(0.0f, 20.0f);
+		Box.Rotation = FQuat(Random.GetUnitVector(), Random.FRandRange(0.0f, PI));
+		Box.Extent = FVector(Random.FRandRange(1.0f, 6.0f), Random.FRandRange(1.0f, 6.0f),
+		                     Random.FRandRange(1.0f, 6.0f));
+		Box.bEnable = true;
+		A.Node.BoxLimits.Add(Box);
+	}
+
+	// SIMD 判定用ブロックは4コライダー単位（端数は切り上げ）
+	{
+		const FKawaiiPhysicsScopedSimdNarrowphase ScopedSimd(true);
+		FKawaiiPhysicsModifyBone Probe = MakeBone(FVector::ZeroVector, 1.0f, FVector::ZeroVector);
+		A.CallCompiledCollision(Probe);
+		const FKawaiiPhysicsColliderBuffer& Buffer = A.CompiledColliders();
+		TestEqual(TEXT("Sphere blocks"), Buffer.Spheres.Blocks.Num(), 3);
+		TestEqual(TEXT("Capsule blocks"), Buffer.Capsules.Blocks.Num(), 3);
+		TestEqual(TEXT("Tapered capsule blocks"), Buffer.TaperedCapsules.Blocks.Num(), 2);
+		TestEqual(TEXT("Box blocks"), Buffer.Boxes.Blocks.Num(), 2);
+	}
+
+	// 乱択点に加えて、形状の中心・軸上（押し出し方向が縮退する点）もプローブする
+	TArray<FVector> Probes;
+	for (int32 i = 0; i < 2000; ++i)
+	{
+		Probes.Add(Random.GetUnitVector() * Random.FRandRange(0.0f, 30.0f));
+	}
+	for (const FSphericalLimit& Sphere : A.Node.SphericalLimits)
+	{
+		Probes.Add(Sphere.Location);
+	}
+	for (const FCapsuleLimit& Capsule : A.Node.CapsuleLimits)
+	{
+		Probes.Add(Capsule.Location);
+	}
+	for (const FTaperedCapsuleLimit& TaperedCapsule : A.Node.TaperedCapsuleLimits)
+	{
+		Probes.Add(TaperedCapsule.Location);
+	}
+	for (const FBoxLimit& Box : A.Node.BoxLimits)
+	{
+		Probes.Add(Box.Location);
+	}
+
+	// ボーン半径 0（判定の絶対マージンだけが頼り）も含め、SIMD 経路はスカラー経路とビット一致する
+	for (const float Radius : {0.0f, 1.5f, 4.0f})
+	{
+		for (const FVector& Start : Probes)
+		{
+			FKawaiiPhysicsModifyBone Scalar = MakeBone(Start, Radius, Start);
+			{
+				const FKawaiiPhysicsScopedSimdNarrowphase ScopedSimd(false);
+				A.CallCompiledCollision(Scalar);
+			}
+
+			FKawaiiPhysicsModifyBone Simd = MakeBone(Start, Radius, Start);
+			{
+				const FKawaiiPhysicsScopedSimdNarrowphase ScopedSimd(true);
+				A.CallCompiledCollision(Simd);
+			}
+
+			if (Simd.Location != Scalar.Location)
+			{
+				AddError(FString::Printf(TEXT("SIMD narrowphase mismatch at %s (r=%.1f): simd %s scalar %s"),
+				                         *Start.ToString(), Radius, *Simd.Location.ToString(),
+				                         *Scalar.Location.ToString()));
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+// ---------------------------------------------------------------------------
+//  チェーン AABB によるコライダーカリング
+//  チェーンの掃引 AABB から遠いコライダーだけがコンパイル時に間引かれ（Inner スフィアと Plane は常に残す）、
+//  カリングの有無でシミュレーション結果がビット一致すること。
+// ---------------------------------------------------------------------------
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKawaiiPhysicsColliderCullingTest,
+                                 "KawaiiPhysics.Collision.ColliderCulling",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FKawaiiPhysicsColliderCullingTest::RunTest(const FString& Parameters)
+{
+	constexpr float Dt = 1.0f / 60.0f;
+	auto SetupScenario = [](FKawaiiPhysicsTestAccessor& A)
+	{
+		A.BuildVerticalChain(6, 10.0f);
+		FKawaiiPhysicsSettings Settings;
+		Settings.Damping = 0.1f;
+		Settings.Stiffness = 0.05f;
+		Settings.Radius = 2.0f;
+		A.SetAllPhysicsSettings(Settings);
+		A.SetSimulationSpace(EKawaiiPhysicsSimulationSpace::ComponentSpace);
+		// 横向きの重力でチェーンを近くのスフィアへ振り込ませる
+		A.SetGravityInSimSpace(FVector(980.0, 0.0, -490.0));
+		A.SetFixedSubstepping(true, 60, 4);
+
+		// チェーンに掛かるスフィア / 全体を包む Inner スフィア / 遠くの Plane は残る
+		FSphericalLimit NearSphere;
+		NearSphere.bEnable = true;
+		NearSphere.Location = FVector(8.0, 0.0, -40.0);
+		NearSphere.Radius = 5.0f;
+		A.Node.SphericalLimits.Add(NearSphere);
+
+		FSphericalLimit InnerSphere;
+		InnerSphere.bEnable = true;
+		InnerSphere.Location = FVector(-500.0, 0.0, 0.0);
+		InnerSphere.Radius = 1000.0f;
+		InnerSphere.LimitType = ESphericalLimitType::Inner;
+		A.Node.SphericalLimits.Add(InnerSphere);
+
+		FPlanarLimit Planar;
+		Planar.bEnable = true;
+		Planar.Location = FVector(0.0, 0.0, -500.0);
+		Planar.Plane = FPlane(Planar.Location, FVector::UpVector);
+		A.Node.PlanarLimits.Add(Planar);
+
+		// 反対側の脚・肩に相当する遠いコライダーは間引かれる
+		FSphericalLimit FarSphere;
+		FarSphere.bEnable = true;
+		FarSphere.Location = FVector(-200.0, 0.0, 0.0);
+		FarSphere.Radius = 5.0f;
+		A.Node.SphericalLimits.Add(FarSphere);
+
+		FCapsuleLimit FarCapsule;
+		FarCapsule.bEnable = true;
+		FarCapsule.Location = FVector(0.0, 300.0, -20.0);
+		FarCapsule.Radius = 5.0f;
+		FarCapsule.Length = 40.0f;
+		A.Node.CapsuleLimits.Add(FarCapsule);
+
+		FTaperedCapsuleLimit FarTaperedCapsule;
+		FarTaperedCapsule.bEnable = true;
+		FarTaperedCapsule.Location = FVector(0.0, -300.0, -20.0);
+		FarTaperedCapsule.Radius0 = 6.0f;
+		FarTaperedCapsule.Radius1 = 3.0f;
+		FarTaperedCapsule.Length = 40.0f;
+		A.Node.TaperedCapsuleLimits.Add(FarTaperedCapsule);
+
+		FBoxLimit FarBox;
+		FarBox.bEnable = true;
+		FarBox.Location = FVector(-150.0, 0.0, -30.0);
+		FarBox.Extent = FVector(10.0, 10.0, 10.0);
+		A.Node.BoxLimits.Add(FarBox);
+	};
+
+	// 間引かれるのは遠い4つだけ。カリング無効なら全て残る
+	{
+		const FKawaiiPhysicsScopedColliderCulling ScopedCulling(true);
+		FKawaiiPhysicsTestAccessor A;
+		SetupScenario(A);
+		A.StepFrame(Dt);
+
+		const FBox Bounds = A.CallComputeCollisionCullBounds();
+		TestTrue(TEXT("Cull bounds are valid with a chain"), Bounds.IsValid != 0);
+		// root（kinematic）はコリジョン対象外なので含めなくてよい
+		for (int32 i = 1; i < A.Num(); ++i)
+		{
+			TestTrue(TEXT("Cull bounds contain the simulated bones"), Bounds.IsInside(A.Bone(i).Location));
+		}
+
+		A.CompileColliders();
+		const FKawaiiPhysicsColliderBuffer& Buffer = A.CompiledColliders();
+		TestEqual(TEXT("Near and inner spheres kept"), Buffer.Spheres.Num(), 2);
+		TestEqual(TEXT("Far capsule culled"), Buffer.Capsules.Num(), 0);
+		TestEqual(TEXT("Far tapered capsule culled"), Buffer.TaperedCapsules.Num(), 0);
+		TestEqual(TEXT("Far box culled"), Buffer.Boxes.Num(), 0);
+		TestEqual(TEXT("Planes are never culled"), Buffer.Planes.Num(), 1);
+		TestEqual(TEXT("Culled count"), Buffer.NumCulled, 4);
+
+		const FKawaiiPhysicsScopedColliderCulling ScopedNoCulling(false);
+		TestFalse(TEXT("Disabled culling has no bounds"), A.CallComputeCollisionCullBounds().IsValid != 0);
+		A.CompileColliders();
+		TestEqual(TEXT("Nothing culled when disabled"), A.CompiledColliders().NumCulled, 0);
+		TestEqual(TEXT("All colliders kept when disabled"), A.CompiledColliders().Num(), 7);
+	}
+
+	// カリングの有無で結果はビット一致し、近くのスフィアは実際にチェーンを押し出している
+	auto Simulate = [&](const bool bCulling, const bool bWithNearSphere)
+	{
+		const FKawaiiPhysicsScopedColliderCulling ScopedCulling(bCulling);
+		FKawaiiPhysicsTestAccessor A;
+		SetupScenario(A);
+		if (!bWithNearSphere)
+		{
+			A.Node.SphericalLimits.RemoveAt(0);
+		}
+		A.StepFrames(60, Dt);
+		TArray<FVector> Locations;
+		for (int32 i = 0; i < A.Num(); ++i)
+		{
+			Locations.Add(A.Bone(i).Location);
+		}
+		return Locations;
+	};
+	const TArray<FVector> Culled = Simulate(true, true);
+	const TArray<FVector> Unculled = Simulate(false, true);
+	const TArray<FVector> WithoutNearSphere = Simulate(true, false);
+	bool bPushed = false;
+	for (int32 i = 0; i < Culled.Num(); ++i)
+	{
+		TestTrue(FString::Printf(TEXT("Bone %d bit-identical with culling"), i), Culled[i] == Unculled[i]);
+		bPushed |= !Culled[i].Equals(WithoutNearSphere[i], 0.01);
+	}
+	TestTrue(TEXT("Near sphere pushes the chain"), bPushed);
+	return true;
+}
+
+// ---------------------------------------------------------------------------
+//  コライダーグリッド
+//  しきい値以上のコライダー数でだけグリッドを作り、各セルのキー列は昇順（=適用順）で Inner スフィアは全セルに入ること。
+//  押し出し結果は総当たりとビット一致すること（セル境界をまたぐ位置・押し出しでセルが変わる位置を含む）。
+// ---------------------------------------------------------------------------
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKawaiiPhysicsColliderGridTest,
+                                 "KawaiiPhysics.Collision.ColliderGrid",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FKawaiiPhysicsColliderGridTest::RunTest(const FString& Parameters)
+{
+	using FColliderBuffer = FKawaiiPhysicsColliderBuffer;
+
+	FKawaiiPhysicsTestAccessor A;
+	FRandomStream Random(4649);
+	for (int32 i = 0; i < 30; ++i)
+	{
+		FSphericalLimit Sphere;
+		Sphere.Location = Random.GetUnitVector() * Random.FRandRange(0.0f, 60.0f);
+		Sphere.Radius = i == 7 ? 80.0f : Random.FRandRange(2.0f, 8.0f);
+		Sphere.LimitType = i == 7 ? ESphericalLimitType::Inner : ESphericalLimitType::Outer;
+		Sphere.bEnable = true;
+		A.Node.SphericalLimits.Add(Sphere);
+	}
+	for (int32 i = 0; i < 14; ++i)
+	{
+		FCapsuleLimit Capsule;
+		Capsule.Location = Random.GetUnitVector() * Random.FRandRange(0.0f, 60.0f);
+		Capsule.Rotation = FQuat(Random.GetUnitVector(), Random.FRandRange(0.0f, PI));
+		Capsule.Radius = Random.FRandRange(1.0f, 5.0f);
+		Capsule.Length = Random.FRandRange(2.0f, 30.0f);
+		Capsule.bEnable = true;
+		A.Node.CapsuleLimits.Add(Capsule);
+	}
+	for (int32 i = 0; i < 12; ++i)
+	{
+		FTaperedCapsuleLimit TaperedCapsule;
+		TaperedCapsule.Location = Random.GetUnitVector() * Random.FRandRange(0.0f, 60.0f);
+		TaperedCapsule.Rotation = FQuat(Random.GetUnitVector(), Random.FRandRange(0.0f, PI));
+		TaperedCapsule.Radius0 = Random.FRandRange(1.0f, 6.0f);
+		TaperedCapsule.Radius1 = i == 2 ? -1.0f : Random.FRandRange(0.5f, 4.0f);
+		TaperedCapsule.Length = i == 4 ? 0.0f : Random.FRandRange(2.0f, 30.0f);
+		TaperedCapsule.bEnable = true;
+		A.Node.TaperedCapsuleLimits.Add(TaperedCapsule);
+	}
+	for (int32 i = 0; i < 12; ++i)
+	{
+		FBoxLimit Box;
+		Box.Location = Random.GetUnitVector() * Random.FRandRange(0.0f, 60.0f);
+		Box.Rotation = FQuat(Random.GetUnitVector(), Random.FRandRange(0.0f, PI));
+		Box.Extent = FVector(Random.FRandRange(1.0f, 10.0f), Random.FRandRange(1.0f, 10.0f),
+		                     Random.FRandRange(1.0f, 10.0f));
+		Box.bEnable = true;
+		A.Node.BoxLimits.Add(Box);
+	}
+	constexpr int32 NumColliders = 30 + 14 + 12 + 12;
+
+	// しきい値未満では作らない
+	{
+		const FKawaiiPhysicsScopedColliderGridMinColliders ScopedGrid(NumColliders + 1);
+		A.CompileColliders();
+		TestFalse(TEXT("No grid below the threshold"), A.CompiledColliders().Grid.IsValid());
+	}
+	{
+		const FKawaiiPhysicsScopedColliderGridMinColliders ScopedGrid(0);
+		A.CompileColliders();
+		TestFalse(TEXT("No grid when disabled"), A.CompiledColliders().Grid.IsValid());
+	}
+
+	// しきい値以上で作り、各セルの列は昇順、Inner スフィアは全セルに入る
+	{
+		const FKawaiiPhysicsScopedColliderGridMinColliders ScopedGrid(NumColliders);
+		A.CompileColliders();
+		const FColliderBuffer::FGrid& Grid = A.CompiledColliders().Grid;
+		TestTrue(TEXT("Grid at the threshold"), Grid.IsValid());
+		const int32 NumCells = Grid.Dims.X * Grid.Dims.Y * Grid.Dims.Z;
+		TestTrue(TEXT("Grid has several cells"), NumCells > 1);
+		const uint32 InnerKey = FColliderBuffer::MakeGridKey(FColliderBuffer::EGridShape::Sphere, 7);
+		int32 NumEntries = 0;
+		for (int32 Cell = 0; Cell < NumCells; ++Cell)
+		{
+			const TConstArrayView<uint32> Entries = Grid.GetCellEntries(Cell);
+			NumEntries += Entries.Num();
+			for (int32 i = 1; i < Entries.Num(); ++i)
+			{
+				TestTrue(TEXT("Cell keys ascending"), Entries[i - 1] < Entries[i]);
+			}
+			TestTrue(TEXT("Inner sphere in every cell"), Entries.Contains(InnerKey));
+		}
+		TestTrue(TEXT("Cells hold fewer entries than brute force would test"), NumEntries < NumCells * NumColliders);
+	}
+
+	// 乱択点と形状の中心をプローブし、グリッド経路が総当たり（スカラー）とビット一致すること
+	TArray<FVector> Probes;
+	for (int32 i = 0; i < 2000; ++i)
+	{
+		Probes.Add(Random.GetUnitVector() * Random.FRandRange(0.0f, 90.0f));
+	}
+	for (const FSphericalLimit& Sphere : A.Node.SphericalLimits)
+	{
+		Probes.Add(Sphere.Location);
+	}
+	for (const FBoxLimit& Box : A.Node.BoxLimits)
+	{
+		Probes.Add(Box.Location);
+	}
+	for (const float Radius : {0.0f, 1.5f, 4.0f})
+	{
+		for (const FVector& Start : Probes)
+		{
+			FKawaiiPhysicsModifyBone BruteForce = MakeBone(Start, Radius, Start);
+			{
+				const FKawaiiPhysicsScopedSimdNarrowphase ScopedSimd(false);
+				const FKawaiiPhysicsScopedColliderGridMinColliders ScopedGrid(0);
+				A.CallCompiledCollision(BruteForce);
+			}
+
+			FKawaiiPhysicsModifyBone Grid = MakeBone(Start, Radius, Start);
+			{
+				const FKawaiiPhysicsScopedColliderGridMinColliders ScopedGrid(1);
+				A.CallCompiledCollision(Grid);
+			}
+
+			if (Grid.Location != BruteForce.Location)
+			{
+				AddError(FString::Printf(TEXT("Collider grid mismatch at %s (r=%.1f): grid %s brute force %s"),
+				                         *Start.ToString(), Radius, *Grid.Location.ToString(),
+				                         *BruteForce.Location.ToString()));
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+// ---------------------------------------------------------------------------
+//  コライダー関連マスク（BoneFilter / 自動判定）
+//  BoneFilter と参照ポーズの到達距離からボーンごとの関連ビットを作り、どの経路でもマスク外のボーンは押し出さないこと。
+//  到達距離は共通祖先から DrivingBone / チェーン root までのチェーン長と OffsetLocation を含み、どの関節がどう回っても
+//  届くコライダーは外さないこと。DataAsset 由来の limit も BoneFilter を持ち込めること。
+// ---------------------------------------------------------------------------
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKawaiiPhysicsColliderRelevanceMaskTest,
+                                 "KawaiiPhysics.Collision.ColliderRelevanceMasks",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FKawaiiPhysicsColliderRelevanceMaskTest::RunTest(const FString& Parameters)
+{
+	// root - pelvis(z=100) - head(z=170) - hair_01(z=160) - hair_02(z=150)
+	//                                   - ear_l(x=60, z=170)
+	//                      - thigh_l(x=10, z=90)
+	FReferenceSkeleton RefSkeleton;
+	{
+		FReferenceSkeletonModifier Modifier(RefSkeleton, nullptr);
+		Modifier.Add(FMeshBoneInfo(FName(TEXT("root")), TEXT("root"), INDEX_NONE), FTransform::Identity);
+		Modifier.Add(FMeshBoneInfo(FName(TEXT("pelvis")), TEXT("pelvis"), 0), FTransform(FVector(0, 0, 100)));
+		Modifier.Add(FMeshBoneInfo(FName(TEXT("head")), TEXT("head"), 1), FTransform(FVector(0, 0, 70)));
+		Modifier.Add(FMeshBoneInfo(FName(TEXT("hair_01")), TEXT("hair_01"), 2), FTransform(FVector(0, 0, -10)));
+		Modifier.Add(FMeshBoneInfo(FName(TEXT("hair_02")), TEXT("hair_02"), 3), FTransform(FVector(0, 0, -10)));
+		Modifier.Add(FMeshBoneInfo(FName(TEXT("ear_l")), TEXT("ear_l"), 2), FTransform(FVector(60, 0, 0)));
+		Modifier.Add(FMeshBoneInfo(FName(TEXT("thigh_l")), TEXT("thigh_l"), 1), FTransform(FVector(10, 0, -10)));
+	}
+
+	// hair_01 - hair_02 - 末端 dummy
+	const auto SetupChain = [](FKawaiiPhysicsTestAccessor& A)
+	{
+		A.BuildVerticalChain(3, 10.0f, FVector(0, 0, 160));
+		A.Node.PhysicsSettings.Radius = 3.0f;
+		for (int32 i = 0; i < A.Num(); ++i)
+		{
+			A.Bone(i).LengthFromRoot = 10.0f * i;
+			A.Bone(i).PhysicsSettings.Radius = 3.0f;
+		}
+		A.Bone(0).BoneRef.BoneName = FName(TEXT("hair_01"));
+		A.Bone(1).BoneRef.BoneName = FName(TEXT("hair_02"));
+		A.Bone(2).bDummy = true;
+	};
+
+	FKawaiiPhysicsTestAccessor A;
+	SetupChain(A);
+	A.Node.bAutoColliderRelevance = true;
+
+	// 参照ポーズでは thigh_l は hair_01 から 70cm 離れているが、hair_01 は共通祖先 pelvis まわりに 80cm、
+	// thigh_l は 14cm 動けるので判定に残る。ear_l も共通祖先 head まわりに 60cm 動けるので残る。
+	// OffsetLocation で 40cm 先に置いた球も DrivingBone まわりに回れば届く
+	A.Node.ColliderRelevanceMargin = 0.0f;
+	FSphericalLimit ThighSphere;
+	ThighSphere.DrivingBone.BoneName = FName(TEXT("thigh_l"));
+	ThighSphere.Radius = 5.0f;
+	FSphericalLimit HeadSphere;
+	HeadSphere.DrivingBone.BoneName = FName(TEXT("head"));
+	HeadSphere.Radius = 12.0f;
+	FSphericalLimit InnerSphere = ThighSphere;
+	InnerSphere.LimitType = ESphericalLimitType::Inner;
+	FSphericalLimit EarSphere;
+	EarSphere.DrivingBone.BoneName = FName(TEXT("ear_l"));
+	EarSphere.Radius = 5.0f;
+	FSphericalLimit OffsetSphere = HeadSphere;
+	OffsetSphere.OffsetLocation = FVector(0, 0, 40);
+	OffsetSphere.Radius = 1.0f;
+	A.Node.SphericalLimits = {ThighSphere, HeadSphere, InnerSphere, EarSphere, OffsetSphere};
+
+	FCapsuleLimit Capsule;
+	Capsule.DrivingBone.BoneName = FName(TEXT("head"));
+	Capsule.BoneFilter.Bones.Add(FBoneReference(FName(TEXT("hair_02"))));
+	A.Node.CapsuleLimits.Add(Capsule);
+
+	FBoxLimit Box;
+	Box.DrivingBone.BoneName = FName(TEXT("head"));
+	Box.BoneFilter.RootBones.Add(FBoneReference(FName(TEXT("pelvis"))));
+	A.Node.BoxLimits.Add(Box);
+
+	FPlanarLimit Plane;
+	Plane.DrivingBone.BoneName = FName(TEXT("pelvis"));
+	Plane.BoneFilter.RootBones.Add(FBoneReference(FName(TEXT("thigh_l"))));
+	A.Node.PlanarLimits.Add(Plane);
+
+	// 旧形式の DataAsset の BoneFilter も変換後の limit へ引き継ぐ。
+	// ApplyLimitsDataAsset はボーン参照の解決に実メッシュのボーンコンテナが要るので、追加だけ同じ手順で行う
+	FSphericalLimitData SphereData;
+	SphereData.DrivingBoneReference.BoneName = FName(TEXT("head"));
+	SphereData.BoneFilter.Bones.Add(FBoneReference(FName(TEXT("hair_01"))));
+	UKawaiiPhysicsLimitsDataAsset* LimitsDataAsset = NewObject<UKawaiiPhysicsLimitsDataAsset>();
+	LimitsDataAsset->SphericalLimits.Add(SphereData.Convert());
+	A.Node.SphericalLimitsData.Append(LimitsDataAsset->SphericalLimits);
+
+	A.CallBuildColliderRelevanceMasks(RefSkeleton);
+
+	const auto TestBits = [&](const TCHAR* What, const FCollisionLimitBase& Limit, const TArray<bool>& Expected)
+	{
+		for (int32 i = 0; i < Expected.Num(); ++i)
+		{
+			TestEqual(FString::Printf(TEXT("%s: bone %d"), What, i), A.IsLimitRelevantToBone(Limit, i), Expected[i]);
+		}
+	};
+	TestEqual(TEXT("Thigh sphere is reachable through both chains from pelvis"),
+	          A.Node.SphericalLimits[0].CachedRelevanceMask, static_cast<int32>(INDEX_NONE));
+	TestEqual(TEXT("Head sphere within reach keeps no mask"), A.Node.SphericalLimits[1].CachedRelevanceMask,
+	          static_cast<int32>(INDEX_NONE));
+	TestEqual(TEXT("Inner sphere is never auto-masked"), A.Node.SphericalLimits[2].CachedRelevanceMask,
+	          static_cast<int32>(INDEX_NONE));
+	TestEqual(TEXT("Ear sphere is reachable through the driving bone's chain"),
+	          A.Node.SphericalLimits[3].CachedRelevanceMask, static_cast<int32>(INDEX_NONE));
+	TestEqual(TEXT("Offset sphere is reachable by rotating about its driving bone"),
+	          A.Node.SphericalLimits[4].CachedRelevanceMask, static_cast<int32>(INDEX_NONE));
+	TestBits(TEXT("Capsule filtered to hair_02 (tip dummy follows its parent)"), A.Node.CapsuleLimits[0],
+	         {false, true, true});
+	TestEqual(TEXT("Box rooted at pelvis covers the whole chain"), A.Node.BoxLimits[0].CachedRelevanceMask,
+	          static_cast<int32>(INDEX_NONE));
+	TestBits(TEXT("Plane rooted at thigh_l excludes the chain"), A.Node.PlanarLimits[0], {false, false, false});
+	TestBits(TEXT("DataAsset limit filtered to hair_01"), A.Node.SphericalLimitsData[0], {true, false, false});
+
+	// 自動判定を切れば BoneFilter だけが残る
+	A.Node.bAutoColliderRelevance = false;
+	A.CallBuildColliderRelevanceMasks(RefSkeleton);
+	TestEqual(TEXT("Thigh sphere is unmasked without auto relevance"), A.Node.SphericalLimits[0].CachedRelevanceMask,
+	          static_cast<int32>(INDEX_NONE));
+	TestBits(TEXT("BoneFilter still applies without auto relevance"), A.Node.CapsuleLimits[0], {false, true, true});
+	TestBits(TEXT("DataAsset BoneFilter still applies without auto relevance"), A.Node.SphericalLimitsData[0],
+	         {true, false, false});
+
+	// 代入はキャッシュを運ばない
+	FCapsuleLimit Assigned;
+	Assigned = A.Node.CapsuleLimits[0];
+	TestEqual(TEXT("operator= resets the cached mask"), Assigned.CachedRelevanceMask, static_cast<int32>(INDEX_NONE));
+	TestEqual(TEXT("operator= copies the BoneFilter"), Assigned.BoneFilter.Bones.Num(), 1);
+
+	// スカラー / SIMD / グリッドのどの経路でも、マスク外のボーンだけ押し出しを省く
+	FKawaiiPhysicsTestAccessor B;
+	SetupChain(B);
+	for (int32 i = 0; i < 5; ++i)
+	{
+		FSphericalLimit Sphere;
+		Sphere.Location = FVector(0, 100.0f * i, 0);
+		Sphere.Radius = 5.0f;
+		Sphere.BoneFilter.Bones.Add(FBoneReference(FName(TEXT("hair_02"))));
+		B.Node.SphericalLimits.Add(Sphere);
+	}
+	B.CallBuildColliderRelevanceMasks(RefSkeleton);
+
+	const auto PushOut = [&B](const int32 BoneIndex)
+	{
+		FVector Location(1, 0, 0);
+		B.CallCompiledCollisionForBone(Location, 1.0f, BoneIndex);
+		return Location;
+	};
+	for (const int32 Path : {0, 1, 2})
+	{
+		const FKawaiiPhysicsScopedSimdNarrowphase ScopedSimd(Path == 1);
+		const FKawaiiPhysicsScopedColliderGridMinColliders ScopedGrid(Path == 2 ? 1 : 0);
+		B.CompileColliders();
+		TestEqual(TEXT("Grid only on the grid path"), B.CompiledColliders().Grid.IsValid(), Path == 2);
+
+		TestEqual(FString::Printf(TEXT("Path %d: masked bone is not pushed"), Path), PushOut(0), FVector(1, 0, 0));
+		TestTrue(FString::Printf(TEXT("Path %d: relevant bone is pushed"), Path),
+		         PushOut(1).Equals(FVector(6, 0, 0), GCollisionTol));
+		TestTrue(FString::Printf(TEXT("Path %d: unknown bone is pushed"), Path),
+		         PushOut(INDEX_NONE).Equals(FVector(6, 0, 0), GCollisionTol));
+	}
+
+	// ボーン数が変わって古くなったマスクは使わない
+	B.BuildVerticalChain(40, 10.0f, FVector(0, 0, 90));
+	B.CompileColliders();
+	TestTrue(TEXT("Stale masks are ignored"), PushOut(0).Equals(FVector(6, 0, 0), GCollisionTol));
+
+	return true;
+}
+
+// ---------------------------------------------------------------------------
+//  ボーン区間のコリジョン（bBoneSegmentCollision）
+//  区間の最近接点で求めた押し出しを T で両端へ配分し、親が kinematic なら子だけで補うこと（増幅は2倍まで）。
+//  inter-bone dummy は飛ばして実ボーン同士の区間で判定し、端点だけでは素通りする細い形状を捉えること。
+//  Grid がある時は区間の AABB が掛かるセルだけを引き、総当たりと完全に同じ結果になること。
+// ---------------------------------------------------------------------------
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKawaiiPhysicsBoneSegmentCollisionTest,
+                                 "KawaiiPhysics.Collision.BoneSegment",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FKawaiiPhysicsBoneSegmentCollisionTest::RunTest(const FString& Parameters)
+{
+	FKawaiiPhysicsSettings Settings;
+	Settings.Radius = 1.0f;
+
+	// root(0,0,0) → (0,0,-20) → (0,0,-40)。root は kinematic
+	const auto SolveAgainstSphere = [&](FKawaiiPhysicsTestAccessor& A, const FVector& Center, const float Radius)
+	{
+		A.BuildVerticalChain(3, 20.0f);
+		A.SetAllPhysicsSettings(Settings);
+		FSphericalLimit Sphere;
+		Sphere.Location = Center;
+		Sphere.Radius = Radius;
+		A.Node.SphericalLimits = {Sphere};
+		A.CallBoneSegmentCollision();
+	};
+
+	// 区間 1-2 の中点に半径3の球。両端とも動けるので半分ずつではなく押し出し量そのものを両端へ
+	{
+		FKawaiiPhysicsTestAccessor A;
+		SolveAgainstSphere(A, FVector(2, 0, -30), 3.0f);
+		TestTrue(TEXT("Movable parent takes its share"), A.Bone(1).Location.Equals(FVector(-2, 0, -20), GCollisionTol));
+		TestTrue(TEXT("Child takes its share"), A.Bone(2).Location.Equals(FVector(-2, 0, -40), GCollisionTol));
+	}
+
+	// 区間 0-1 の中点。root は動かないので子が2倍動いて区間の中点を押し出す
+	{
+		FKawaiiPhysicsTestAccessor A;
+		SolveAgainstSphere(A, FVector(2, 0, -10), 3.0f);
+		TestTrue(TEXT("Kinematic root stays put"), A.Bone(0).Location.Equals(FVector::ZeroVector, GCollisionTol));
+		TestTrue(TEXT("Child compensates for the pinned parent"),
+		         A.Bone(1).Location.Equals(FVector(-4, 0, -20), GCollisionTol));
+	}
+
+	// 区間 0-1 の 1/4 点。単独では4倍になるところを2倍で打ち切る
+	{
+		FKawaiiPhysicsTestAccessor A;
+		SolveAgainstSphere(A, FVector(2, 0, -5), 3.0f);
+		TestTrue(TEXT("Amplification near the pinned end is capped"),
+		         A.Bone(1).Location.Equals(FVector(-2, 0, -20), GCollisionTol));
+	}
+
+	// 区間を横切る細いカプセル（Y 方向）。どちらの端点にも届かない
+	{
+		FKawaiiPhysicsTestAccessor A;
+		A.BuildVerticalChain(3, 20.0f);
+		A.SetAllPhysicsSettings(Settings);
+		FCapsuleLimit Capsule;
+		Capsule.Location = FVector(1.5f, 0, -30);
+		Capsule.Rotation = FQuat(FVector::ForwardVector, UE_HALF_PI);
+		Capsule.Radius = 1.0f;
+		Capsule.Length = 20.0f;
+		A.Node.CapsuleLimits = {Capsule};
+
+		FVector Tip = A.Bone(2).Location;
+		A.CompileColliders();
+		A.CallCompiledCollisionForBone(Tip, Settings.Radius, 2);
+		TestEqual(TEXT("Endpoint test alone misses the thin capsule"), Tip, FVector(0, 0, -40));
+
+		A.CallBoneSegmentCollision();
+		TestTrue(TEXT("Capsule pushes the parent end"), A.Bone(1).Location.Equals(FVector(-0.5f, 0, -20), GCollisionTol));
+		TestTrue(TEXT("Capsule pushes the child end"), A.Bone(2).Location.Equals(FVector(-0.5f, 0, -40), GCollisionTol));
+	}
+
+	// inter-bone dummy を挟んだチェーンでも実ボーン同士の区間で解き、dummy は触らない
+	{
+		FKawaiiPhysicsTestAccessor A;
+		A.BuildSubdividedVerticalChain(3, 20.0f, 1);
+		A.SetAllPhysicsSettings(Settings);
+		FSphericalLimit Sphere;
+		Sphere.Location = FVector(2, 0, -30);
+		Sphere.Radius = 3.0f;
+		A.Node.SphericalLimits = {Sphere};
+		A.CallBoneSegmentCollision();
+		TestTrue(TEXT("Real parent across the dummy is pushed"),
+		         A.Bone(2).Location.Equals(FVector(-2, 0, -20), GCollisionTol));
+		TestTrue(TEXT("Real child is pushed"), A.Bone(4).Location.Equals(FVector(-2, 0, -40), GCollisionTol));
+		TestTrue(TEXT("Dummy is left to PlaceDummyBones"), A.Bone(3).Location.Equals(FVector(0, 0, -30), GCollisionTol));
+	}
+
+	// 多数のコライダーの中を通る区間。Grid のセル経由でも総当たりと同じ位置へ押し出す（押し出し連鎖でセルをはみ出す場合も）
+	{
+		const auto SolveAmongColliders = [&](const bool bGrid, const FVector& Offset)
+		{
+			FKawaiiPhysicsTestAccessor A;
+			A.BuildVerticalChain(4, 20.0f, Offset);
+			A.SetAllPhysicsSettings(Settings);
+			for (int32 X = -3; X <= 3; ++X)
+			{
+				for (int32 Z = 0; Z < 7; ++Z)
+				{
+					FSphericalLimit Sphere;
+					Sphere.Location = FVector(X * 9.0f + 1.5f, (Z % 3) - 1.0f, Z * -9.0f - 5.0f);
+					Sphere.Radius = 2.0f + (Z % 2);
+					A.Node.SphericalLimits.Add(Sphere);
+				}
+			}
+			for (int32 i = 0; i < 4; ++i)
+			{
+				FCapsuleLimit Capsule;
+				Capsule.Location = FVector(-1.0f + i, 0, -15.0f * i - 8.0f);
+				Capsule.Rotation = FQuat(FVector::ForwardVector, UE_HALF_PI);
+				Capsule.Radius = 1.0f;
+				Capsule.Length = 30.0f;
+				A.Node.CapsuleLimits.Add(Capsule);
+			}
+
+			const FKawaiiPhysicsScopedColliderGridMinColliders ScopedGrid(bGrid ? 1 : 0);
+			A.CallBoneSegmentCollision();
+			TestEqual(TEXT("Grid only on the grid path"), A.CompiledColliders().Grid.IsValid(), bGrid);
+			TArray<FVector> Locations;
+			for (int32 i = 0; i < A.Num(); ++i)
+			{
+				Locations.Add(A.Bone(i).Location);
+			}
+			return Locations;
+		};
+
+		for (const FVector& Offset : {FVector::ZeroVector, FVector(4, 0, 3), FVector(-7, 1, -2)})
+		{
+			const TArray<FVector> BruteForce = SolveAmongColliders(false, Offset);
+			const TArray<FVector> Grid = SolveAmongColliders(true, Offset);
+			bool bMoved = false;
+			for (int32 i = 0; i < BruteForce.Num(); ++i)
+			{
+				bMoved |= BruteForce[i] != Offset + FVector(0, 0, -20.0f * i);
+				if (Grid[i] != BruteForce[i])
+				{
+					AddError(FString::Printf(TEXT("Segment grid mismatch at bone %d (offset %s): grid %s brute force %s"),
+					                         i, *Offset.ToString(), *Grid[i].ToString(), *BruteForce[i].ToString()));
+				}
+			}
+			TestTrue(FString::Printf(TEXT("Segments hit the colliders (offset %s)"), *Offset.ToString()), bMoved);
+		}
+	}
+
+	// 本番の SimulateOnce 経路: 無効時は区間が球に食い込んだまま、有効時は押し出される
+	const auto SegmentPenetration = [](FKawaiiPhysicsTestAccessor& A, const FVector& Center, const float Limit)
+	{
+		return Limit - FMath::PointDistToSegment(Center, A.Bone(1).Location, A.Bone(2).Location);
+	};
+	for (const bool bSegment : {false, true})
+	{
+		FKawaiiPhysicsTestAccessor A;
+		A.BuildVerticalChain(3, 20.0f);
+		FKawaiiPhysicsSettings ThinSettings;
+		ThinSettings.Radius = 0.5f;
+		A.SetAllPhysicsSettings(ThinSettings);
+		A.SetGravityInSimSpace(FVector::ZeroVector);
+		A.SetFixedSubstepping(false, 60);
+		FSphericalLimit Sphere;
+		Sphere.Location = FVector(1.5f, 0, -30);
+		Sphere.Radius = 2.0f;
+		A.Node.SphericalLimits = {Sphere};
+		A.Node.bBoneSegmentCollision = bSegment;
+		for (int32 Frame = 0; Frame < 30; ++Frame)
+		{
+			A.StepFrameWithSimulateOnce(1.0f / 60.0f);
+		}
+
+		const float Penetration = SegmentPenetration(A, Sphere.Location, Sphere.Radius + ThinSettings.Radius);
+		if (bSegment)
+		{
+			TestTrue(FString::Printf(TEXT("Segment mode resolves the mid-segment contact (%.3f)"), Penetration),
+			         Penetration < 0.25f);
+		}
+		else
+		{
+			TestTrue(FString::Printf(TEXT("Endpoint-only collision tunnels (%.3f)"), Penetration),
+			         Penetration > 0.9f);
+		}
+	}
+
+	return true;
+}
+
+// ---------------------------------------------------------------------------
+//  BoneConstraint の辺コリジョン（bBoneConstraintEdgeCollision）
+//  列の間の辺で受けた押し出しを両端点へ直接配分し、固定端点・分割除外の Constraint は動かさないこと。
+//  有効時は bridge dummy を生成しないこと。
+// ---------------------------------------------------------------------------
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKawaiiPhysicsBoneConstraintEdgeCollisionTest,
+                                 "KawaiiPhysics.Collision.BoneConstraintEdge",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FKawaiiPhysicsBoneConstraintEdgeCollisionTest::RunTest(const FString& Parameters)
+{
+	FKawaiiPhysicsSettings Settings;
+	Settings.Radius = 1.0f;
+
+	// 左 0..2 は x=0、右 3..5 は x=20。先端同士 (2-5) と root 同士 (0-3) を横に繋ぐ
+	const auto SetupColumns = [&](FKawaiiPhysicsTestAccessor& A)
+	{
+		A.BuildTwoVerticalChains(3, 20.0f, 20.0f);
+		A.SetAllPhysicsSettings(Settings);
+		A.ClearRuntimeBoneConstraints();
+		A.AddRuntimeBoneConstraint(2, 5, 20.0f);
+		A.AddRuntimeBoneConstraint(0, 3, 20.0f);
+	};
+
+	// 辺 2-5 の中点のそばに球。端点には届かないが辺には食い込む → 両端点が押し出し量そのものだけ動く
+	{
+		FKawaiiPhysicsTestAccessor A;
+		SetupColumns(A);
+		FSphericalLimit Sphere;
+		Sphere.Location = FVector(10, 2, -40);
+		Sphere.Radius = 2.0f;
+		A.Node.SphericalLimits = {Sphere};
+		A.CallBoneConstraintEdgeCollision();
+		TestTrue(TEXT("Left endpoint is pushed"), A.Bone(2).Location.Equals(FVector(0, -1, -40), GCollisionTol));
+		TestTrue(TEXT("Right endpoint is pushed"), A.Bone(5).Location.Equals(FVector(20, -1, -40), GCollisionTol));
+	}
+
+	// 両端点とも kinematic な root 同士の辺は動かさない
+	{
+		FKawaiiPhysicsTestAccessor A;
+		SetupColumns(A);
+		FSphericalLimit Sphere;
+		Sphere.Location = FVector(10, 2, 0);
+		Sphere.Radius = 2.0f;
+		A.Node.SphericalLimits = {Sphere};
+		A.CallBoneConstraintEdgeCollision();
+		TestEqual(TEXT("Pinned left root stays put"), A.Bone(0).Location, FVector::ZeroVector);
+		TestEqual(TEXT("Pinned right root stays put"), A.Bone(3).Location, FVector(20, 0, 0));
+	}
+
+	// bExcludeFromSubdivision の Constraint は辺としても判定しない
+	{
+		FKawaiiPhysicsTestAccessor A;
+		SetupColumns(A);
+		A.Node.MergedBoneConstraints[0].bExcludeFromSubdivision = true;
+		FSphericalLimit Sphere;
+		Sphere.Location = FVector(10, 2, -40);
+		Sphere.Radius = 2.0f;
+		A.Node.SphericalLimits = {Sphere};
+		A.CallBoneConstraintEdgeCollision();
+		TestEqual(TEXT("Excluded edge is not collided"), A.Bone(2).Location, FVector(0, 0, -40));
+	}
+
+	// 辺コリジョン有効時は bridge dummy を挿入しない
+	for (const bool bEdge : {false, true})
+	{
+		FKawaiiPhysicsTestAccessor A;
+		SetupColumns(A);
+		A.Node.BoneConstraintSubdivisionCount = 2;
+		A.Node.bBoneConstraintEdgeCollision = bEdge;
+		A.CallInsertBridgeDummiesForConstraints();
+		TestEqual(FString::Printf(TEXT("Bridge dummies with edge collision %s"), bEdge ? TEXT("on") : TEXT("off")),
+		          A.Num(), bEdge ? 6 : 10);
+	}
+
+	// 本番の SimulateOnce 経路: 列の間を縦に通る細いカプセルを、無効時はすり抜け、有効時は押し出す
+	for (const bool bEdge : {false, true})
+	{
+		FKawaiiPhysicsTestAccessor A;
+		SetupColumns(A);
+		A.SetGravityInSimSpace(FVector::ZeroVector);
+		A.SetFixedSubstepping(false, 60);
+		FCapsuleLimit Capsule;
+		Capsule.Location = FVector(10, 1.5f, -40);
+		Capsule.Radius = 1.0f;
+		Capsule.Length = 40.0f;
+		A.Node.CapsuleLimits = {Capsule};
+		A.Node.bBoneConstraintEdgeCollision = bEdge;
+		for (int32 Frame = 0; Frame < 30; ++Frame)
+		{
+			A.StepFrameWithSimulateOnce(1.0f / 60.0f);
+		}
+
+		FVector OnEdge;
+		FVector OnCapsule;
+		FMath::SegmentDistToSegmentSafe(A.Bone(2).Location, A.Bone(5).Location, Capsule.Location + FVector(0, 0, 20),
+		                                Capsule.Location - FVector(0, 0, 20), OnEdge, OnCapsule);
+		const float Penetration = Settings.Radius + Capsule.Radius - FVector::Dist(OnEdge, OnCapsule);
+		if (bEdge)
+		{
+			TestTrue(FString::Printf(TEXT("Edge collision keeps the capsule out (%.3f)"), Penetration),
+			         Penetration < 0.1f);
+		}
+		else
+		{
+			TestTrue(FString::Printf(TEXT("Endpoint-only collision lets the capsule through (%.3f)"), Penetration),
+			         Penetration > 0.4f);
+		}
+	}
+
+	return true;
+}
+
+// ---------------------------------------------------------------------------
+//  非同期ワールドコリジョンの接触平面
+//  平面の裏へ入った球の中心だけを平面上へ戻し、接触なし（法線0）や範囲外のボーンは動かさないこと。
+// ---------------------------------------------------------------------------
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKawaiiPhysicsAsyncWorldContactTest,
+                                 "KawaiiPhysics.Collision.AsyncWorldContactPlane",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FKawaiiPhysicsAsyncWorldContactTest::RunTest(const FString& Parameters)
+{
+	FKawaiiPhysicsTestAccessor A;
+
+	// ボーン0: z=10 を通る上向きの平面（ヒット時の球の中心）、ボーン1: 接触なし
+	A.SetAsyncWorldContactPlanes({FPlane(FVector(0, 0, 10), FVector::UpVector), FPlane(0.0, 0.0, 0.0, 0.0)});
+
+	FVector Behind(3, 4, 6);
+	A.CallAsyncWorldContact(Behind, 0);
+	TestTrue(FString::Printf(TEXT("Centre behind the plane is pushed onto it: %s"), *Behind.ToString()),
+	         Behind.Equals(FVector(3, 4, 10), GCollisionTol));
+
+	FVector InFront(3, 4, 12);
+	A.CallAsyncWorldContact(InFront, 0);
+	TestEqual(TEXT("Centre in front of the plane is untouched"), InFront, FVector(3, 4, 12));
+
+	FVector NoContact(3, 4, -50);
+	A.CallAsyncWorldContact(NoContact, 1);
+	TestEqual(TEXT("Zero-normal plane means no contact"), NoContact, FVector(3, 4, -50));
+
+	FVector OutOfRange(3, 4, -50);
+	A.CallAsyncWorldContact(OutOfRange, 2);
+	TestEqual(TEXT("Bones without a plane are untouched"), OutOfRange, FVector(3, 4, -50));
+
+	// 斜めの平面でも法線方向の食い込み分だけ戻す
+	const FVector SlopeNormal = FVector(1, 0, 1).GetSafeNormal();
+	A.SetAsyncWorldContactPlanes({FPlane(FVector::ZeroVector, SlopeNormal)});
+	FVector OnSlope = -SlopeNormal * 2.0 + FVector(0, 5, 0);
+	A.CallAsyncWorldContact(OnSlope, 0);
+	TestTrue(FString::Printf(TEXT("Slope contact pushes along the normal: %s"), *OnSlope.ToString()),
+	         OnSlope.Equals(FVector(0, 5, 0), GCollisionTol));
+
+	return true;
+}
+
+// ---------------------------------------------------------------------------
+//  非同期ワールドコリジョンのバッチ（FKawaiiPhysicsAsyncWorldCollision）
+//  積んだスイープは発行前なら置き換わり、発行したバッチは全スイープが揃ってから1回だけ渡され、
+//  後から発行したバッチがあれば古いバッチの完了は捨てられること。World 無しで発行と完了コールバックを再現する。
+// ---------------------------------------------------------------------------
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKawaiiPhysicsAsyncWorldCollisionBatchTest,
+                                 "KawaiiPhysics.Collision.AsyncWorldCollisionBatch",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FKawaiiPhysicsAsyncWorldCollisionBatchTest::RunTest(const FString& Parameters)
+{
+	using FAsync = FKawaiiPhysicsAsyncWorldCollision;
+
+	auto MakeSweeps = [](const TArray<int32>& BoneIndices)
+	{
+		TArray<FAsync::FSweep> Sweeps;
+		for (const int32 BoneIndex : BoneIndices)
+		{
+			FAsync::FSweep& Sweep = Sweeps.AddDefaulted_GetRef();
+			Sweep.BoneIndex = BoneIndex;
+			Sweep.Start = FVector(0, 0, BoneIndex * 10.0);
+			Sweep.End = Sweep.Start + FVector(5, 0, 0);
+			Sweep.Radius = 2.0f;
+		}
+		return Sweeps;
+	};
+	auto MakeHit = [](const FVector& Location)
+	{
+		FHitResult Hit;
+		Hit.bBlockingHit = true;
+		Hit.Location = Location;
+		Hit.Normal = FVector::UpVector;
+		return TArray<FHitResult>{Hit};
+	};
+	auto Stage = [](FAsync& Async, TArray<FAsync::FSweep>& Sweeps)
+	{
+		Async.StageSweeps(Sweeps, ECC_WorldDynamic, FCollisionQueryParams(), FCollisionResponseParams(), false);
+	};
+
+	const TSharedRef<FAsync, ESPMode::ThreadSafe> Async = MakeShared<FAsync, ESPMode::ThreadSafe>();
+	TArray<FAsync::FSweepResult> Results;
+
+	// 何も積んでいなければ発行しない
+	TestFalse(TEXT("Nothing staged, nothing issued"), FKawaiiPhysicsTestAccessor::BeginAsyncSweepBatch(*Async));
+	TestTrue(TEXT("No batch serial consumed"), FKawaiiPhysicsTestAccessor::AsyncSweepBatchSerial(*Async) == 0);
+	TestFalse(TEXT("No results before any batch"), Async->ConsumeResults(Results));
+
+	// 発行前に積み直すと前の分は置き換わり、呼び出し側には前の分がスクラッチとして返る
+	{
+		TArray<FAsync::FSweep> First = MakeSweeps({0, 1, 2});
+		Stage(*Async, First);
+		TestEqual(TEXT("Stage swaps in the (empty) previous batch"), First.Num(), 0);
+
+		TArray<FAsync::FSweep> Second = MakeSweeps({3, 4});
+		Stage(*Async, Second);
+		TestEqual(TEXT("Restaging hands back the replaced batch"), Second.Num(), 3);
+	}
+
+	// 発行したバッチは全スイープが揃うまで渡されない。ヒットの無いスイープは結果に入らない
+	{
+		TestTrue(TEXT("Staged batch issued"), FKawaiiPhysicsTestAccessor::BeginAsyncSweepBatch(*Async));
+		const uint32 Serial = FKawaiiPhysicsTestAccessor::AsyncSweepBatchSerial(*Async);
+		TestEqual(TEXT("Only the restaged sweeps are in flight"), Async->GetNumInFlight(), 2);
+		TestFalse(TEXT("Issuing consumes the staged sweeps"), FKawaiiPhysicsTestAccessor::BeginAsyncSweepBatch(*Async));
+
+		FKawaiiPhysicsTestAccessor::CompleteAsyncSweep(*Async, Serial, 1, MakeHit(FVector(1, 2, 3)));
+		TestEqual(TEXT("One sweep still in flight"), Async->GetNumInFlight(), 1);
+		TestFalse(TEXT("Partial batch is not handed out"), Async->ConsumeResults(Results));
+
+		FKawaiiPhysicsTestAccessor::CompleteAsyncSweep(*Async, Serial, 0, {});
+		TestEqual(TEXT("Batch complete"), Async->GetNumInFlight(), 0);
+		TestTrue(TEXT("Completed batch is handed out"), Async->ConsumeResults(Results));
+		if (TestEqual(TEXT("Only the sweep with a hit has a result"), Results.Num(), 1))
+		{
+			TestEqual(TEXT("Result maps back to the sweep's bone"), Results[0].BoneIndex, 4);
+			TestEqual(TEXT("Hits are handed over"), Results[0].Hits.Num(), 1);
+		}
+		TestFalse(TEXT("A batch is handed out only once"), Async->ConsumeResults(Results));
+	}
+
+	// 古いバッチの完了は捨て、新しいバッチだけを渡す
+	{
+		TArray<FAsync::FSweep> Old = MakeSweeps({0});
+		Stage(*Async, Old);
+		FKawaiiPhysicsTestAccessor::BeginAsyncSweepBatch(*Async);
+		const uint32 OldSerial = FKawaiiPhysicsTestAccessor::AsyncSweepBatchSerial(*Async);
+
+		TArray<FAsync::FSweep> New = MakeSweeps({1, 2});
+		Stage(*Async, New);
+		FKawaiiPhysicsTestAccessor::BeginAsyncSweepBatch(*Async);
+		const uint32 NewSerial = FKawaiiPhysicsTestAccessor::AsyncSweepBatchSerial(*Async);
+		TestTrue(TEXT("New batch gets a new serial"), NewSerial != OldSerial);
+
+		FKawaiiPhysicsTestAccessor::CompleteAsyncSweep(*Async, OldSerial, 0, MakeHit(FVector::ZeroVector));
+		TestEqual(TEXT("Stale completion does not count against the new batch"), Async->GetNumInFlight(), 2);
+		TestFalse(TEXT("Stale completion publishes nothing"), Async->ConsumeResults(Results));
+
+		FKawaiiPhysicsTestAccessor::CompleteAsyncSweep(*Async, NewSerial, 0, {});
+		FKawaiiPhysicsTestAccessor::CompleteAsyncSweep(*Async, NewSerial, 1, {});
+		TestTrue(TEXT("New batch is handed out"), Async->ConsumeResults(Results));
+		TestEqual(TEXT("A batch without hits is handed out as \"no contact\""), Results.Num(), 0);
+	}
+
+	return true;
+}
+
+// ---------------------------------------------------------------------------
+//  非同期ワールドコリジョンのヒット → 接触平面（UpdateAsyncWorldCollision）
+//  揃ったバッチのヒットを、ボーンごとに押し出し先を通る平面へ変換し、次のバッチで置き換えること。
+// ---------------------------------------------------------------------------
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKawaiiPhysicsAsyncWorldHitToPlaneTest,
+                                 "KawaiiPhysics.Collision.AsyncWorldHitToPlane",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FKawaiiPhysicsAsyncWorldHitToPlaneTest::RunTest(const FString& Parameters)
+{
+	using FAsync = FKawaiiPhysicsAsyncWorldCollision;
+
+	FKawaiiPhysicsTestAccessor A;
+	A.BuildVerticalChain(4, 10.0f);
+	// ワールド空間でシミュレーションしてヒット（ワールド空間）をそのまま比べる
+	A.SetSimulationSpace(EKawaiiPhysicsSimulationSpace::WorldSpace);
+	FAnimInstanceProxy AnimInstanceProxy;
+	FComponentSpacePoseContext Output(&AnimInstanceProxy);
+
+	const TSharedRef<FAsync, ESPMode::ThreadSafe> Async = MakeShared<FAsync, ESPMode::ThreadSafe>();
+	A.AsyncWorldCollision() = Async;
+
+	// 1回目はボーン数に合わせて平面を確保するだけ（接触なし）
+	A.CallUpdateAsyncWorldCollision(Output);
+	if (!TestEqual(TEXT("One plane per bone"), A.AsyncWorldContactPlanes().Num(), A.Num()))
+	{
+		return false;
+	}
+
+	auto IssueAndComplete = [&Async](const TArray<TArray<FHitResult>>& HitsPerBone)
+	{
+		TArray<FAsync::FSweep> Sweeps;
+		for (int32 BoneIndex = 0; BoneIndex < HitsPerBone.Num(); ++BoneIndex)
+		{
+			Sweeps.AddDefaulted_GetRef().BoneIndex = BoneIndex;
+		}
+		Async->StageSweeps(Sweeps, ECC_WorldDynamic, FCollisionQueryParams(), FCollisionResponseParams(), false);
+		FKawaiiPhysicsTestAccessor::BeginAsyncSweepBatch(*Async);
+		const uint32 Serial = FKawaiiPhysicsTestAccessor::AsyncSweepBatchSerial(*Async);
+		for (int32 BoneIndex = 0; BoneIndex < HitsPerBone.Num(); ++BoneIndex)
+		{
+			FKawaiiPhysicsTestAccessor::CompleteAsyncSweep(*Async, Serial, BoneIndex, HitsPerBone[BoneIndex]);
+		}
+	};
+	auto PlaneContains = [](const FPlane& Plane, const FVector& Normal, const FVector& Point)
+	{
+		return Plane.GetNormal().Equals(Normal, GCollisionTol) &&
+			FMath::IsNearlyZero(Plane.PlaneDot(Point), GCollisionTol);
+	};
+
+	const FVector SlopeNormal = FVector(0, 1, 1).GetSafeNormal();
+	FHitResult Swept;
+	Swept.bBlockingHit = true;
+	Swept.Location = FVector(1, 2, 3);
+	Swept.Normal = FVector::UpVector;
+
+	FHitResult Penetrating;
+	Penetrating.bBlockingHit = true;
+	Penetrating.bStartPenetrating = true;
+	Penetrating.TraceStart = FVector(10, 0, 0);
+	Penetrating.Normal = SlopeNormal;
+	Penetrating.PenetrationDepth = 4.0f;
+	Penetrating.Location = FVector(-100, -100, -100);
+
+	FHitResult Overlap = Swept;
+	Overlap.bBlockingHit = false;
+	Overlap.Location = FVector(0, 0, 50);
+	FHitResult Blocking = Swept;
+	Blocking.Location = FVector(0, 0, 7);
+
+	// ボーン0: 通常のヒット、1: 開始時点で食い込み、2: 非ブロックを飛ばして次のヒット、3: ヒットなし
+	IssueAndComplete({{Swept}, {Penetrating}, {Overlap, Blocking}, {}});
+	A.CallUpdateAsyncWorldCollision(Output);
+	const TArray<FPlane>& Planes = A.AsyncWorldContactPlanes();
+	TestTrue(TEXT("Swept hit: plane through the hit centre"), PlaneContains(Planes[0], FVector::UpVector, Swept.Location));
+	TestTrue(TEXT("Start-penetrating hit: plane through the depenetrated start"),
+	         PlaneContains(Planes[1], SlopeNormal, Penetrating.TraceStart + SlopeNormal * 4.0));
+	TestTrue(TEXT("Non-blocking hit is skipped"), PlaneContains(Planes[2], FVector::UpVector, Blocking.Location));
+	TestTrue(TEXT("No hit means no plane"), Planes[3].GetNormal().IsZero());
+
+	// 揃うまでは前のバッチの平面を使い続ける
+	A.CallUpdateAsyncWorldCollision(Output);
+	TestTrue(TEXT("Planes kept until the next batch"), PlaneContains(Planes[0], FVector::UpVector, Swept.Location));
+
+	// 次のバッチで全て置き換わる（ヒットの無くなったボーンは接触なしへ）
+	IssueAndComplete({{}, {}, {}, {Swept}});
+	A.CallUpdateAsyncWorldCollision(Output);
+	TestTrue(TEXT("Cleared when the next batch has no hit"), Planes[0].GetNormal().IsZero());
+	TestTrue(TEXT("New hit replaces no contact"), PlaneContains(Planes[3], FVector::UpVector, Swept.Location));
+
+	// 範囲外のボーンのヒットは無視する
+	{
+		TArray<FAsync::FSweep> Sweeps;
+		Sweeps.AddDefaulted_GetRef().BoneIndex = 100;
+		Async->StageSweeps(Sweeps, ECC_WorldDynamic, FCollisionQueryParams(), FCollisionResponseParams(), false);
+		FKawaiiPhysicsTestAccessor::BeginAsyncSweepBatch(*Async);
+		FKawaiiPhysicsTestAccessor::CompleteAsyncSweep(*Async, FKawaiiPhysicsTestAccessor::AsyncSweepBatchSerial(*Async),
+		                                               0, {Swept});
+		A.CallUpdateAsyncWorldCollision(Output);
+		for (int32 i = 0; i < Planes.Num(); ++i)
+		{
+			TestTrue(FString::Printf(TEXT("Out-of-range hit leaves bone %d without contact"), i),
+			         Planes[i].GetNormal().IsZero());
+		}
+	}
+
+	return true;
+}
+
+// ---------------------------------------------------------------------------
+//  ワールドコリジョンのボディ → Limit 変換（AddWorldCollisionAggGeomShapes）
+//  回転と非一様スケールを持つボディで、スフィア・カプセル・ボックスは要素の GetFinalScaled とボディの回転・位置を合成し、
+//  凸包の要素は近似せずに無視すること。
+// ---------------------------------------------------------------------------
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKawaiiPhysicsWorldCollisionBodyShapesTest,
+                                 "KawaiiPhysics.Collision.WorldCollisionBodyShapes",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FKawaiiPhysicsWorldCollisionBodyShapesTest::RunTest(const FString& Parameters)
+{
+	FKawaiiPhysicsTestAccessor A;
+	// ワールド空間でシミュレーションして Limit をワールド座標のまま比べる
+	A.SetSimulationSpace(EKawaiiPhysicsSimulationSpace::WorldSpace);
+	FAnimInstanceProxy AnimInstanceProxy;
+	FComponentSpacePoseContext Output(&AnimInstanceProxy);
+
+	// Z 軸まわりに90度回したボディ（非一様スケール）
+	const FQuat BodyRotation(FVector::UpVector, UE_HALF_PI);
+	const FVector BodyLocation(100, 0, 0);
+	const FVector Scale3D(2, 1, 3);
+	const FTransform BodyTransform(BodyRotation, BodyLocation, Scale3D);
+	const FTransform BodyTransformNoScale(BodyRotation, BodyLocation);
+
+	FKAggregateGeom AggGeom;
+
+	FKSphereElem& Sphere = AggGeom.SphereElems.Add_GetRef(FKSphereElem(5.0f));
+	Sphere.Center = FVector(1, 2, 3);
+
+	FKSphylElem& Capsule = AggGeom.SphylElems.Add_GetRef(FKSphylElem(2.0f, 10.0f));
+	Capsule.Center = FVector(0, 0, 1);
+	Capsule.Rotation = FRotator(90, 0, 0);
+
+	FKBoxElem& Box = AggGeom.BoxElems.Add_GetRef(FKBoxElem(8.0f, 6.0f, 4.0f));
+	Box.Center = FVector(0, 1, 0);
+	Box.Rotation = FRotator(0, 30, 0);
+
+	// 辺20の立方体を Z 軸まわりに45度回し、X へ5ずらした凸包（Limit にはならない）
+	FKConvexElem& Convex = AggGeom.ConvexElems.AddDefaulted_GetRef();
+	for (int32 Corner = 0; Corner < 8; ++Corner)
+	{
+		Convex.VertexData.Add(FVector(Corner & 1 ? 10 : -10, Corner & 2 ? 10 : -10, Corner & 4 ? 10 : -10));
+	}
+	Convex.UpdateElemBox();
+	Convex.SetTransform(FTransform(FQuat(FVector::UpVector, UE_PI / 4.0), FVector(5, 0, 0)));
+
+	A.CallAddWorldCollisionAggGeomShapes(Output, AggGeom, BodyTransform);
+
+	// スフィア: 中心はスケール後にボディで変換、半径は要素のスケール規則どおり
+	if (TestEqual(TEXT("One sphere"), A.WorldSphericalLimits().Num(), 1))
+	{
+		const FKSphereElem Scaled = Sphere.GetFinalScaled(Scale3D, FTransform::Identity);
+		const FSphericalLimit& Limit = A.WorldSphericalLimits()[0];
+		TestTrue(FString::Printf(TEXT("Sphere centre: %s"), *Limit.Location.ToString()),
+		         Limit.Location.Equals(FVector(98, 2, 9), GCollisionTol));
+		TestEqual(TEXT("Sphere radius"), Limit.Radius, Scaled.Radius);
+		TestTrue(TEXT("Sphere enabled"), Limit.bEnable);
+	}
+
+	// カプセル: 要素の回転にボディの回転を合成する
+	if (TestEqual(TEXT("One capsule"), A.WorldCapsuleLimits().Num(), 1))
+	{
+		const FKSphylElem Scaled = Capsule.GetFinalScaled(Scale3D, FTransform::Identity);
+		const FCapsuleLimit& Limit = A.WorldCapsuleLimits()[0];
+		TestTrue(FString::Printf(TEXT("Capsule centre: %s"), *Limit.Location.ToString()),
+		         Limit.Location.Equals(BodyTransformNoScale.TransformPosition(FVector(0, 0, 3)), GCollisionTol));
+		TestTrue(TEXT("Capsule rotation"),
+		         Limit.Rotation.Equals(BodyRotation * Scaled.Rotation.Quaternion(), GCollisionTol));
+		TestEqual(TEXT("Capsule radius"), Limit.Radius, Scaled.Radius);
+		TestEqual(TEXT("Capsule length"), Limit.Length, Scaled.Length);
+	}
+
+	// ボックスだけが Limit になり、凸包はボックスで近似しない
+	if (TestEqual(TEXT("Only the box becomes a box limit"), A.WorldBoxLimits().Num(), 1))
+	{
+		const FBoxLimit& BoxLimit = A.WorldBoxLimits()[0];
+		TestTrue(FString::Printf(TEXT("Box centre: %s"), *BoxLimit.Location.ToString()),
+		         BoxLimit.Location.Equals(BodyTransformNoScale.TransformPosition(FVector(0, 1, 0)), GCollisionTol));
+		TestTrue(TEXT("Box rotation"),
+		         BoxLimit.Rotation.Equals(BodyRotation * FRotator(0, 30, 0).Quaternion(), GCollisionTol));
+		TestTrue(FString::Printf(TEXT("Box extent: %s"), *BoxLimit.Extent.ToString()),
+		         BoxLimit.Extent.Equals(FVector(8, 3, 6), GCollisionTol));
+	}
+
+	return true;
+}
+
+// ---------------------------------------------------------------------------
+//  ワールドコリジョンの自コンポーネント除外（スイープ / Broadphase 共通）
+//  IgnoreBones と IgnoreBoneNamePrefix に該当する骨だけを除外し、プレフィックスの変更にも追従すること。
+// ---------------------------------------------------------------------------
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKawaiiPhysicsWorldCollisionIgnoreBoneTest,
+                                 "KawaiiPhysics.Collision.WorldCollisionIgnoreBone",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FKawaiiPhysicsWorldCollisionIgnoreBoneTest::RunTest(const FString& Parameters)
+{
+	FKawaiiPhysicsTestAccessor A;
+	A.Node.IgnoreBones.Add(FBoneReference(TEXT("pelvis")));
+	A.Node.IgnoreBoneNamePrefix.Add(TEXT("ik_"));
+
+	TestTrue(TEXT("IgnoreBones"), A.CallIsIgnoredWorldCollisionBone(TEXT("pelvis")));
+	TestTrue(TEXT("IgnoreBoneNamePrefix"), A.CallIsIgnoredWorldCollisionBone(TEXT("ik_hand_l")));
+	TestFalse(TEXT("Other bones collide"), A.CallIsIgnoredWorldCollisionBone(TEXT("spine_01")));
+
+	// プレフィックスの文字列キャッシュは配列の変更で作り直される
+	A.Node.IgnoreBoneNamePrefix = {TEXT("spine_")};
+	TestTrue(TEXT("Updated prefix is used"), A.CallIsIgnoredWorldCollisionBone(TEXT("spine_01")));
+	TestFalse(TEXT("Old prefix is dropped"), A.CallIsIgnoredWorldCollisionBone(TEXT("ik_hand_l")));
+
+	return true;
+}
+
 #endif // WITH_DEV_AUTOMATION_TESTS
@@ -67,6 +67,8 @@ bool FKawaiiPhysicsCollisionCategoryMetadataTest::RunTest(const FString& Paramet
 		{GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, BoneConstraintsDataAsset), TEXT("Collision|Bone Constraint")},
 		{GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, BoneConstraintsData), TEXT("Collision|Bone Constraint")},
 		{GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, bAllowWorldCollision), TEXT("Collision|World Collision")},
+		{GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, WorldCollisionMode), TEXT("Collision|World Collision")},
+		{GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, WorldCollisionQueryRadius), TEXT("Collision|World Collision")},
 		{GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, bOverrideCollisionParams), TEXT("Collision|World Collision")},
 		{GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, CollisionChannelSettings), TEXT("Collision|World Collision")},
 		{GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, bIgnoreSelfComponent), TEXT("Collision|World Collision")},
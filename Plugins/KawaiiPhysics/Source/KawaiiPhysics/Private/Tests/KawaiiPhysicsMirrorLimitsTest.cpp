@@ -234,6 +234,8 @@ bool FKawaiiPhysicsAppendMirroredLimitsTest::RunTest(const FString& Parameters)
 
 	TArray<FSphericalLimit> SourceLimits;
 	SourceLimits.Add(MakeSphere(SourceBoneName, ECollisionSourceType::DataAsset));
+	SourceLimits[0].BoneFilter.Bones.Add(FBoneReference(SourceBoneName));
+	SourceLimits[0].BoneFilter.RootBones.Add(FBoneReference(CenterBoneName));
 #if WITH_EDITORONLY_DATA
 	const FGuid SourceGuid = SourceLimits[0].Guid;
 #endif
@@ -278,6 +280,11 @@ bool FKawaiiPhysicsAppendMirroredLimitsTest::RunTest(const FString& Parameters)
 		TestTrue(TEXT("Generated limit preserves limit type"), Generated.LimitType == SourceLimits[0].LimitType);
 		TestTrue(TEXT("Generated limit mirrors offset location"),
 		         Generated.OffsetLocation.Equals(FVector(-1.0f, 2.0f, 3.0f), GMirrorVectorTol));
+		TestTrue(TEXT("Generated limit mirrors filtered bones"),
+		         Generated.BoneFilter.Bones.Num() == 1 && Generated.BoneFilter.Bones[0].BoneName == TargetBoneName);
+		TestTrue(TEXT("Generated limit keeps unmirrored filter roots"),
+		         Generated.BoneFilter.RootBones.Num() == 1 &&
+		         Generated.BoneFilter.RootBones[0].BoneName == CenterBoneName);
 		TestTrue(TEXT("Generated limit mirrors offset rotation"),
 		         IsSameRotation(Generated.OffsetRotation.Quaternion(),
 		                        FQuat(FVector::ZAxisVector, FMath::DegreesToRadians(-30.0f))));
@@ -3,6 +3,7 @@
 #if WITH_DEV_AUTOMATION_TESTS
 
 #include "Misc/AutomationTest.h"
+#include "HAL/PlatformMisc.h"
 #include "HAL/PlatformTime.h"
 #include "Templates/Function.h"
 #include "Curves/CurveFloat.h"
@@ -418,6 +419,225 @@ namespace
 
 		return bCountOk;
 	}
+
+	// ---------------------------------------------------------------
+	// Collision Narrowphase Perf
+	// ---------------------------------------------------------------
+	// コンパイル済みバッファに対するナローフェーズ単体（コンパイル・ソルバー無し）を SIMD / スカラーで計測する。
+	// Sphere/Capsule/TaperedCapsule/Box 各8個（計32）をチェーン沿いに散らし、大半のペアが非接触になる配置にする。
+	// コライダーグリッドは切り、総当たりのペア単価を測る（グリッドとの比較は ColliderGridCrossover）。
+
+	constexpr int32 GNarrowphaseCollidersPerShape = 8;
+	constexpr int32 GNarrowphaseBones = 200;
+	constexpr int32 GNarrowphasePasses = 200;
+
+	// 形状ごとの個数を変えてもチェーン（Z=0..-995）沿いの同じ区間へ等間隔に散らす
+	void AddNarrowphaseColliders(FKawaiiPhysicsTestAccessor& A,
+	                             const int32 CollidersPerShape = GNarrowphaseCollidersPerShape)
+	{
+		const double Spacing = 960.0 / CollidersPerShape;
+		for (int32 Index = 0; Index < CollidersPerShape; ++Index)
+		{
+			const double Z = -40.0 - Spacing * Index;
+
+			FSphericalLimit Sphere;
+			Sphere.bEnable = true;
+			Sphere.Location = FVector(4.0, 0.0, Z);
+			Sphere.Radius = 8.0f;
+			A.Node.SphericalLimits.Add(Sphere);
+
+			FCapsuleLimit Capsule;
+			Capsule.bEnable = true;
+			Capsule.Location = FVector(0.0, 5.0, Z - 30.0);
+			Capsule.Rotation = FQuat(FVector::ForwardVector, 0.3f);
+			Capsule.Radius = 4.0f;
+			Capsule.Length = 20.0f;
+			A.Node.CapsuleLimits.Add(Capsule);
+
+			FTaperedCapsuleLimit TaperedCapsule;
+			TaperedCapsule.bEnable = true;
+			TaperedCapsule.Location = FVector(-5.0, 0.0, Z - 60.0);
+			TaperedCapsule.Rotation = FQuat(FVector::RightVector, 0.3f);
+			TaperedCapsule.Radius0 = 5.0f;
+			TaperedCapsule.Radius1 = 2.0f;
+			TaperedCapsule.Length = 20.0f;
+			A.Node.TaperedCapsuleLimits.Add(TaperedCapsule);
+
+			FBoxLimit Box;
+			Box.bEnable = true;
+			Box.Location = FVector(0.0, -5.0, Z - 90.0);
+			Box.Rotation = FQuat(FVector::UpVector, 0.4f);
+			Box.Extent = FVector(6.0, 6.0, 10.0);
+			A.Node.BoxLimits.Add(Box);
+		}
+	}
+
+	bool RunNarrowphasePerf(FAutomationTestBase& Test, const TCHAR* TestName, const bool bSimd, double& OutChecksum,
+	                        const int32 CollidersPerShape = GNarrowphaseCollidersPerShape, const bool bGrid = false,
+	                        double* OutMedianMsPerPass = nullptr)
+	{
+		const FKawaiiPhysicsScopedSimdNarrowphase ScopedSimd(bSimd);
+		const FKawaiiPhysicsScopedColliderGridMinColliders ScopedGrid(bGrid ? 1 : 0);
+		FKawaiiPhysicsTestAccessor A;
+		AddNarrowphaseColliders(A, CollidersPerShape);
+		A.CompileColliders();
+		const int32 NumColliders = CollidersPerShape * 4;
+
+		TArray<FVector> BoneLocations;
+		BoneLocations.Reserve(GNarrowphaseBones);
+		for (int32 Bone = 0; Bone < GNarrowphaseBones; ++Bone)
+		{
+			BoneLocations.Add(FVector(0.0, 0.0, -5.0 * Bone));
+		}
+
+		TArray<double> MsPerPassValues;
+		MsPerPassValues.Reserve(GTrials);
+		double Checksum = 0.0;
+		for (int32 Trial = 0; Trial < GTrials; ++Trial)
+		{
+			double TrialChecksum = 0.0;
+			const double StartSeconds = FPlatformTime::Seconds();
+			for (int32 Pass = 0; Pass < GNarrowphasePasses; ++Pass)
+			{
+				for (const FVector& BoneLocation : BoneLocations)
+				{
+					FVector Location = BoneLocation;
+					A.CallCompiledCollisionNoCompile(Location, BoneLocation, 3.0f);
+					TrialChecksum += Location.X + Location.Y + Location.Z;
+				}
+			}
+			const double ElapsedSeconds = FPlatformTime::Seconds() - StartSeconds;
+			const double MsPerPass = ElapsedSeconds * 1000.0 / static_cast<double>(GNarrowphasePasses);
+
+			Test.AddInfo(FString::Printf(TEXT("PERF_RAW %s trial=%d ms=%.6f"), TestName, Trial, MsPerPass));
+			MsPerPassValues.Add(MsPerPass);
+			Checksum = TrialChecksum;
+		}
+
+		MsPerPassValues.Sort();
+		const double MedianMsPerPass = MsPerPassValues[GTrials / 2];
+		const double NsPerPair = MedianMsPerPass * 1000000.0 /
+			static_cast<double>(GNarrowphaseBones * NumColliders);
+		Test.AddInfo(FString::Printf(
+			TEXT("PERF %s median_ms_per_pass=%.6f ns_per_pair=%.3f colliders=%d checksum=%.6f"),
+			TestName, MedianMsPerPass, NsPerPair, NumColliders, Checksum));
+		OutChecksum = Checksum;
+		if (OutMedianMsPerPass)
+		{
+			*OutMedianMsPerPass = MedianMsPerPass;
+		}
+		return FMath::IsFinite(Checksum);
+	}
+
+	constexpr int32 GBoneSegmentRealBones = 20;
+	constexpr float GBoneSegmentSpacing = 10.0f;
+	constexpr float GBoneSegmentBoneRadius = 1.5f;
+	constexpr int32 GBoneSegmentCapsules = 9;
+	constexpr float GBoneSegmentCapsuleRadius = 1.0f;
+
+	// 実ボーン同士の区間（inter-bone dummy を飛ばす）と細いカプセルとの最大・平均めり込み量を加算する
+	void AccumulateBoneSegmentPenetration(const FKawaiiPhysicsTestAccessor& A, double& InOutMax, double& InOutSum,
+	                                      int32& InOutCount)
+	{
+		for (int32 i = 0; i < A.Num(); ++i)
+		{
+			const FKawaiiPhysicsModifyBone& Bone = A.Node.ModifyBones[i];
+			if (Bone.bInterBoneDummy || Bone.ParentIndex < 0)
+			{
+				continue;
+			}
+			int32 ParentIndex = Bone.ParentIndex;
+			while (A.Node.ModifyBones[ParentIndex].bInterBoneDummy)
+			{
+				ParentIndex = A.Node.ModifyBones[ParentIndex].ParentIndex;
+			}
+			const FVector& ParentLocation = A.Node.ModifyBones[ParentIndex].Location;
+			double EdgePenetration = 0.0;
+			for (const FCapsuleLimit& Capsule : A.Node.CapsuleLimits)
+			{
+				const FVector Axis = Capsule.Rotation.GetAxisZ() * Capsule.Length * 0.5f;
+				FVector OnBone;
+				FVector OnCapsule;
+				FMath::SegmentDistToSegmentSafe(ParentLocation, Bone.Location, Capsule.Location + Axis,
+				                                Capsule.Location - Axis, OnBone, OnCapsule);
+				EdgePenetration = FMath::Max(EdgePenetration, GBoneSegmentBoneRadius + Capsule.Radius -
+				                             FVector::Dist(OnBone, OnCapsule));
+			}
+			InOutMax = FMath::Max(InOutMax, EdgePenetration);
+			InOutSum += EdgePenetration;
+			++InOutCount;
+		}
+	}
+
+	bool RunBoneSegmentPerf(FAutomationTestBase& Test, const TCHAR* TestName, const int32 SubdivisionCount,
+	                        const bool bSegmentCollision)
+	{
+		TArray<double> MsPerFrameValues;
+		MsPerFrameValues.Reserve(GTrials);
+		double MaxPenetration = 0.0;
+		double PenetrationSum = 0.0;
+		int32 PenetrationCount = 0;
+		int32 BoneCount = 0;
+		bool bFinite = true;
+
+		for (int32 Trial = 0; Trial < GTrials; ++Trial)
+		{
+			FKawaiiPhysicsTestAccessor A;
+			A.BuildSubdividedVerticalChain(GBoneSegmentRealBones, GBoneSegmentSpacing, SubdivisionCount);
+			ConfigureBaseSimulation(A, GBoneSegmentBoneRadius);
+			// 本番の SimulateOnce（PlaceDummyBones を含む）で回すので legacy ステップにする
+			A.SetFixedSubstepping(false, 60);
+			A.Node.bBoneSegmentCollision = bSegmentCollision;
+			// 実ボーン区間の中点を横切る Y 方向の細いカプセル。端点だけの判定ではすり抜けやすい
+			for (int32 Index = 0; Index < GBoneSegmentCapsules; ++Index)
+			{
+				FCapsuleLimit Capsule;
+				Capsule.bEnable = true;
+				Capsule.Location = FVector(0.0, 0.0, -GBoneSegmentSpacing * (2 * Index + 1.5f));
+				Capsule.Rotation = FQuat(FVector::ForwardVector, UE_HALF_PI);
+				Capsule.Radius = GBoneSegmentCapsuleRadius;
+				Capsule.Length = 30.0f;
+				A.Node.CapsuleLimits.Add(Capsule);
+			}
+			BoneCount = A.Num();
+
+			double ElapsedSeconds = 0.0;
+			for (int32 Frame = 0; Frame < GWarmupFrames + GMeasureFrames; ++Frame)
+			{
+				// カプセルを X 方向に往復させ、チェーンを常に横切らせる
+				const double Phase = static_cast<double>(Frame) * GFrameDt * 4.0;
+				for (int32 Index = 0; Index < A.Node.CapsuleLimits.Num(); ++Index)
+				{
+					A.Node.CapsuleLimits[Index].Location.X = 8.0 * FMath::Sin(Phase + Index * 0.7);
+				}
+
+				const double StartSeconds = FPlatformTime::Seconds();
+				A.StepFrameWithSimulateOnce(GFrameDt);
+				if (Frame >= GWarmupFrames)
+				{
+					ElapsedSeconds += FPlatformTime::Seconds() - StartSeconds;
+					AccumulateBoneSegmentPenetration(A, MaxPenetration, PenetrationSum, PenetrationCount);
+				}
+			}
+			const double MsPerFrame = ElapsedSeconds * 1000.0 / static_cast<double>(GMeasureFrames);
+
+			Test.AddInfo(FString::Printf(TEXT("PERF_RAW %s trial=%d ms=%.6f"), TestName, Trial, MsPerFrame));
+			MsPerFrameValues.Add(MsPerFrame);
+
+			if (!A.AllFinite())
+			{
+				Test.AddError(FString::Printf(TEXT("PERF %s produced NaN or Inf"), TestName));
+				bFinite = false;
+			}
+		}
+
+		MsPerFrameValues.Sort();
+		Test.AddInfo(FString::Printf(
+			TEXT("PERF %s median_ms_per_frame=%.6f bones=%d max_penetration=%.4f mean_penetration=%.4f"),
+			TestName, MsPerFrameValues[GTrials / 2], BoneCount, MaxPenetration,
+			PenetrationSum / FMath::Max(1, PenetrationCount)));
+		return bFinite;
+	}
 }
 
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKawaiiPhysicsPerfChainTest,
@@ -542,6 +762,88 @@ bool FKawaiiPhysicsPerfSharedCollisionCopyTest::RunTest(const FString& Parameter
 	return RunSharedCollisionCopyPerf(*this);
 }
 
+// ナローフェーズ（ボーン×コライダーのペア）単価を SIMD / スカラーで比較する。結果はビット一致が前提。
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKawaiiPhysicsPerfCollisionNarrowphaseTest,
+                                 "KawaiiPhysics.Perf.CollisionNarrowphase",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FKawaiiPhysicsPerfCollisionNarrowphaseTest::RunTest(const FString& Parameters)
+{
+	double ScalarChecksum = 0.0;
+	double SimdChecksum = 0.0;
+	bool bOk = RunNarrowphasePerf(*this, TEXT("KawaiiPhysics.Perf.CollisionNarrowphase.Scalar"), false,
+	                              ScalarChecksum);
+	bOk &= RunNarrowphasePerf(*this, TEXT("KawaiiPhysics.Perf.CollisionNarrowphase.Simd"), true, SimdChecksum);
+	if (ScalarChecksum != SimdChecksum)
+	{
+		AddError(FString::Printf(TEXT("PERF KawaiiPhysics.Perf.CollisionNarrowphase checksum mismatch: "
+		                              "scalar %.6f simd %.6f"), ScalarChecksum, SimdChecksum));
+		bOk = false;
+	}
+	return bOk;
+}
+
+// コライダー数を変えて SIMD 総当たりとグリッドを比較し、ColliderGridMinColliders の損益分岐点を探す。結果はビット一致が前提。
+// 以降のすべての数でグリッドの方が速くなる最小のコライダー数を break_even_colliders として出す（無ければ 0 = 無効のまま）。
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKawaiiPhysicsPerfColliderGridCrossoverTest,
+                                 "KawaiiPhysics.Perf.ColliderGridCrossover",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FKawaiiPhysicsPerfColliderGridCrossoverTest::RunTest(const FString& Parameters)
+{
+	bool bOk = true;
+	int32 BreakEvenColliders = 0;
+	for (const int32 CollidersPerShape : {2, 4, 6, 8, 12, 16, 20, 24})
+	{
+		const int32 NumColliders = CollidersPerShape * 4;
+		double BruteForceChecksum = 0.0;
+		double GridChecksum = 0.0;
+		double BruteForceMs = 0.0;
+		double GridMs = 0.0;
+		bOk &= RunNarrowphasePerf(*this, *FString::Printf(TEXT("KawaiiPhysics.Perf.ColliderGrid.BruteForce.%d"),
+		                                                  NumColliders), true, BruteForceChecksum, CollidersPerShape,
+		                          false, &BruteForceMs);
+		bOk &= RunNarrowphasePerf(*this, *FString::Printf(TEXT("KawaiiPhysics.Perf.ColliderGrid.Grid.%d"),
+		                                                  NumColliders), true, GridChecksum, CollidersPerShape, true,
+		                          &GridMs);
+		if (GridMs >= BruteForceMs)
+		{
+			BreakEvenColliders = 0;
+		}
+		else if (BreakEvenColliders == 0)
+		{
+			BreakEvenColliders = NumColliders;
+		}
+		if (BruteForceChecksum != GridChecksum)
+		{
+			AddError(FString::Printf(TEXT("PERF KawaiiPhysics.Perf.ColliderGridCrossover checksum mismatch at %d "
+			                              "colliders: brute force %.6f grid %.6f"), NumColliders, BruteForceChecksum,
+			                         GridChecksum));
+			bOk = false;
+		}
+	}
+	AddInfo(FString::Printf(TEXT("PERF KawaiiPhysics.Perf.ColliderGridCrossover break_even_colliders=%d cpu=%s"),
+	                        BreakEvenColliders, *FPlatformMisc::GetCPUBrand()));
+	return bOk;
+}
+
+// 細いカプセルを横切らせ、BoneSubdivisionCount による dummy 挿入と bBoneSegmentCollision のコストとめり込み量を比べる。
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKawaiiPhysicsPerfBoneSegmentCollisionTest,
+                                 "KawaiiPhysics.Perf.BoneSegmentCollision",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FKawaiiPhysicsPerfBoneSegmentCollisionTest::RunTest(const FString& Parameters)
+{
+	bool bOk = true;
+	for (const int32 SubdivisionCount : {0, 1, 2, 3, 4})
+	{
+		bOk &= RunBoneSegmentPerf(*this, *FString::Printf(TEXT("KawaiiPhysics.Perf.BoneSegment.Subdivision%d"),
+		                                                  SubdivisionCount), SubdivisionCount, false);
+	}
+	bOk &= RunBoneSegmentPerf(*this, TEXT("KawaiiPhysics.Perf.BoneSegment.SegmentCollision"), 0, true);
+	return bOk;
+}
+
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKawaiiPhysicsPerfSizeofTest,
                                  "KawaiiPhysics.Perf.Sizeof",
                                  EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
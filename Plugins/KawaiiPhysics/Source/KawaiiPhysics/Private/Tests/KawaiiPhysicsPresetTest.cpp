@@ -45,18 +45,34 @@ namespace
 		Node.DummyBoneLength = 7.5f;
 		Node.BoneSubdivisionCount = 2;
 		Node.bBoneSubdivisionCollisionOnly = false;
+		Node.bBoneSegmentCollision = true;
 		Node.BoneConstraintSubdivisionCount = 3;
 		Node.BoneConstraintSubdivisionFeedbackScale = 0.5f;
+		Node.bBoneConstraintEdgeCollision = true;
 		Node.TargetFramerate = 90;
+		Node.OutputInterpolation = EKawaiiPhysicsOutputInterpolation::Interpolate;
 		Node.bNeedWarmUp = true;
 		Node.WarmUpFrames = 8;
 		Node.TeleportDistanceThreshold = 123.0f;
 		Node.TeleportRotationThreshold = 17.0f;
+		Node.bAllowSleep = true;
+		Node.SleepVelocityThreshold = 2.5f;
+		Node.SleepPoseThreshold = 0.02f;
+		Node.SleepFrames = 12;
+		FKawaiiPhysicsLODTier& LODTier = Node.LODTiers.AddDefaulted_GetRef();
+		LODTier.Threshold = 1500.0f;
+		LODTier.UpdateInterval = 2;
+		LODTier.TargetFramerate = 30;
+		LODTier.bEnableWorldCollision = false;
+		Node.LODTierMetric = EKawaiiPhysicsLODMetric::Distance;
+		Node.LODTierBlendTime = 0.5f;
 		Node.PlanarConstraint = EPlanarConstraint::X;
 		Node.SkelCompMoveScale = FVector(0.5f, 0.75f, 1.25f);
 		Node.PhysicsSettings.Damping = 0.42f;
 		Node.PhysicsSettings.Stiffness = 0.73f;
 		Node.SphericalLimits.Add(MakeSphereLimit());
+		Node.bAutoColliderRelevance = true;
+		Node.ColliderRelevanceMargin = 35.0f;
 		Node.bSharedCollisionSource = true;
 		Node.BoneConstraintIterationCountBeforeCollision = 2;
 		Node.BoneConstraintIterationCountAfterCollision = 4;
@@ -66,6 +82,8 @@ namespace
 		Node.WindScale = 2.5f;
 		Node.SimpleExternalForce = FVector(11.0f, 12.0f, 13.0f);
 		Node.bAllowWorldCollision = true;
+		Node.WorldCollisionMode = EKawaiiPhysicsWorldCollisionMode::Broadphase;
+		Node.WorldCollisionQueryRadius = 35.0f;
 		Node.bOverrideCollisionParams = true;
 		Node.bIgnoreSelfComponent = false;
 		Node.IgnoreBones.Add(FBoneReference(TEXT("pelvis")));
@@ -142,7 +142,10 @@ bool FKawaiiPhysicsPropertyAccessReinitTest::RunTest(const FString& Parameters)
 		GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, PhysicsAssetForLimits),
 		GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, MirrorDataTableForLimits),
 		GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, bSkipMirroredBoneWithExistingCollision),
+		GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, bAutoColliderRelevance),
+		GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, ColliderRelevanceMargin),
 		GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, BoneConstraintSubdivisionCount),
+		GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, bBoneConstraintEdgeCollision),
 		GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, BoneConstraints),
 		GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, BoneConstraintsDataAsset),
 	};
@@ -4,6 +4,13 @@
 
 #include "Misc/AutomationTest.h"
 #include "KawaiiPhysicsTestHarness.h"
+#include "KawaiiPhysicsSimulationSubsystem.h"
+#include "KawaiiPhysicsDeveloperSettings.h"
+#include "ExternalForces/KawaiiPhysicsExternalForce_Basic.h"
+#include "KawaiiPhysicsLibrary.h"
+
+#include "Animation/AnimInstanceProxy.h"
+#include "Algo/Reverse.h"
 
 // 物理計算の回帰テスト（Output 非依存の物理関数を直接呼ぶ）：決定性／パラメータ応答（重力方向・剛性単調性・減衰オーバーシュート）／フレームレート非依存性／数値安定性。
 
@@ -91,6 +98,1149 @@ bool FKawaiiPhysicsDeterminismTest::RunTest(const FString& Parameters)
 	return true;
 }
 
+// ---------------------------------------------------------------------------
+//  SoA ソルバ状態（SolverState）と ModifyBones の同期
+//  Gather でホット値/分類フラグが写り、Scatter はソルバが書き換える値だけを戻すこと。
+// ---------------------------------------------------------------------------
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKawaiiPhysicsSolverStateSyncTest,
+                                 "KawaiiPhysics.Simulation.SolverStateSync",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FKawaiiPhysicsSolverStateSyncTest::RunTest(const FString& Parameters)
+{
+	using EFlags = FKawaiiPhysicsSolverState::EFlags;
+
+	FKawaiiPhysicsTestAccessor A;
+	A.BuildSyncBoneSubdivisionFixture();
+	A.Bone(0).BoneRef.BoneIndex = 0; // 実root（LOD有効） → kinematic root
+	A.Bone(2).BoneRef.BoneIndex = 2;
+	A.Bone(2).PhysicsSettings.Damping = 0.25f;
+	A.Bone(2).PhysicsSettings.Radius = 1.5f;
+
+	FKawaiiPhysicsSolverState& State = A.SolverState();
+	State.Gather(A.Node.ModifyBones);
+
+	TestEqual(TEXT("Num matches ModifyBones"), State.Num(), A.Num());
+	TestTrue(TEXT("Real root is kinematic"), State.HasFlag(0, EFlags::Flag_KinematicRoot));
+	TestFalse(TEXT("Real child is not kinematic"), State.HasFlag(2, EFlags::Flag_KinematicRoot));
+	TestTrue(TEXT("Inter-bone dummy flags"),
+	         State.HasFlag(1, EFlags::Flag_Dummy) && State.HasFlag(1, EFlags::Flag_InterBoneDummy));
+	TestTrue(TEXT("Tip dummy is not inter-bone"),
+	         State.HasFlag(4, EFlags::Flag_Dummy) && !State.HasFlag(4, EFlags::Flag_InterBoneDummy));
+	TestEqual(TEXT("Inter-bone endpoints"), State.InterBoneRealChildIndex[1], 2);
+	TestTrue(TEXT("Settings streams"), State.Damping[2] == 0.25f && State.Radius[2] == 1.5f);
+	TestTrue(TEXT("Location stream"), State.Location[2] == A.Bone(2).Location);
+
+	// ソルバ側で書き換え → Scatter で位置/skipのみ戻り、冷データ（ParentIndex/設定）は不変
+	const FVector Moved(1.0f, 2.0f, 3.0f);
+	State.Location[2] = Moved;
+	State.PrevLocation[2] = Moved * 0.5f;
+	State.Damping[2] = 0.75f;
+	State.SetFlag(2, EFlags::Flag_SkipSimulate, true);
+	State.Scatter(A.Node.ModifyBones);
+
+	TestTrue(TEXT("Scatter writes Location/PrevLocation"),
+	         A.Bone(2).Location == Moved && A.Bone(2).PrevLocation == Moved * 0.5f);
+	TestTrue(TEXT("Scatter writes skip flag"), A.Bone(2).bSkipSimulate);
+	TestEqual(TEXT("Scatter leaves settings untouched"), A.Bone(2).PhysicsSettings.Damping, 0.25f);
+	TestEqual(TEXT("Scatter leaves ParentIndex untouched"), A.Bone(2).ParentIndex, 1);
+	return true;
+}
+
+// ---------------------------------------------------------------------------
+//  ボーン分類リスト（BuildBoneCategories）
+//  skip 判定と各パスの対象 index が、従来のフラグ判定による全走査と同じ集合・同じ順序になること。
+// ---------------------------------------------------------------------------
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKawaiiPhysicsBoneCategoriesTest,
+                                 "KawaiiPhysics.Simulation.BoneCategories",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FKawaiiPhysicsBoneCategoriesTest::RunTest(const FString& Parameters)
+{
+	FKawaiiPhysicsTestAccessor A;
+	A.BuildSyncBoneSubdivisionFixture();
+	A.Bone(0).BoneRef.BoneIndex = 0;
+	A.Bone(2).BoneRef.BoneIndex = 2;
+
+	// 実ボーン 0-2 間の bridge dummy を末尾に追加（前フレームに LOD で skip された状態から始める）
+	FKawaiiPhysicsModifyBone Bridge;
+	Bridge.bDummy = true;
+	Bridge.bBridgeDummy = true;
+	Bridge.ParentIndex = -1;
+	Bridge.InterBoneRealParentIndex = 0;
+	Bridge.InterBoneRealChildIndex = 2;
+	Bridge.bSkipSimulate = true;
+	Bridge.Index = A.Node.ModifyBones.Add(Bridge);
+
+	A.CallBuildBoneCategories();
+	const FKawaiiPhysicsBoneCategories& Categories = A.BoneCategories();
+
+	TestTrue(TEXT("Built for the current layout"), Categories.IsBuiltFor(A.BoneLayoutGeneration(), A.Num()));
+	TestTrue(TEXT("Root is skipped"), A.Bone(0).bSkipSimulate);
+	TestFalse(TEXT("Bridge dummy skip is cleared"), A.Bone(6).bSkipSimulate);
+	TestTrue(TEXT("Kinematic roots"), Categories.KinematicRoots == TArray<int32>{0});
+	TestTrue(TEXT("Simulated (parent-first, includes inter-bone dummies)"), Categories.Simulated ==
+	          TArray<int32>{1, 2, 3, 4, 5});
+	TestTrue(TEXT("Simulated without inter-bone dummies"),
+	         Categories.SimulatedWithoutInterBoneDummies == TArray<int32>{2, 4, 5});
+	TestTrue(TEXT("Inter-bone dummies"), Categories.InterBoneDummies == TArray<int32>{1, 3});
+	TestTrue(TEXT("Bridge dummies"), Categories.BridgeDummies == TArray<int32>{6});
+	TestTrue(TEXT("Collision-only integration skips inter-bone dummies"),
+	         &Categories.GetIntegrated(true) == &Categories.SimulatedWithoutInterBoneDummies);
+
+	// BoneRef が解決できない実ボーン（LOD 等）は skip され、kinematic root にもならない
+	A.Bone(2).BoneRef.BoneIndex = INDEX_NONE;
+	A.CallBuildBoneCategories();
+	TestTrue(TEXT("Unresolved real bone is skipped"), A.Bone(2).bSkipSimulate);
+	TestTrue(TEXT("Unresolved real bone leaves Simulated"), Categories.Simulated == TArray<int32>{1, 3, 4, 5});
+	TestTrue(TEXT("Unresolved real bone is not a kinematic root"),
+	         Categories.KinematicRoots == TArray<int32>{0});
+
+	// 同じボーン数で init し直した（世代が進んだ）場合も作り直しが必要
+	++A.BoneLayoutGeneration();
+	TestFalse(TEXT("Stale after a same-count reinit"), Categories.IsBuiltFor(A.BoneLayoutGeneration(), A.Num()));
+	A.CallBuildBoneCategories();
+	TestTrue(TEXT("Rebuilt for the new generation"), Categories.IsBuiltFor(A.BoneLayoutGeneration(), A.Num()));
+
+	// ボーン構成が変われば作り直しが必要
+	A.Node.ModifyBones.Pop();
+	TestFalse(TEXT("Stale after a layout change"), Categories.IsBuiltFor(A.BoneLayoutGeneration(), A.Num()));
+	return true;
+}
+
+// ---------------------------------------------------------------------------
+//  子ボーンの隣接リスト（FKawaiiPhysicsBoneTopology）
+//  ParentIndex から作った CSR が、子を index 昇順で返し、親を持たない bridge dummy を含まないこと。
+// ---------------------------------------------------------------------------
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKawaiiPhysicsBoneTopologyTest,
+                                 "KawaiiPhysics.Simulation.BoneTopology",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FKawaiiPhysicsBoneTopologyTest::RunTest(const FString& Parameters)
+{
+	FKawaiiPhysicsTestAccessor A;
+	A.BuildSyncBoneSubdivisionFixture();
+
+	FKawaiiPhysicsModifyBone Bridge;
+	Bridge.bDummy = true;
+	Bridge.bBridgeDummy = true;
+	Bridge.ParentIndex = -1;
+	Bridge.Index = A.Node.ModifyBones.Add(Bridge);
+	A.CallBuildBoneTopology();
+
+	const FKawaiiPhysicsBoneTopology& Topology = A.BoneTopology();
+	auto ChildrenOf = [&Topology](const int32 BoneIndex)
+	{
+		return TArray<int32>(Topology.GetChildren(BoneIndex));
+	};
+
+	TestEqual(TEXT("Bone count"), Topology.Num(), A.Num());
+	TestTrue(TEXT("Root has the inter-bone dummy and the tip dummy"), ChildrenOf(0) == TArray<int32>{1, 5});
+	TestTrue(TEXT("Inter-bone dummy -> real child"), ChildrenOf(1) == TArray<int32>{2});
+	TestTrue(TEXT("Real child -> inter-bone dummy"), ChildrenOf(2) == TArray<int32>{3});
+	TestTrue(TEXT("Inter-bone dummy -> tip dummy"), ChildrenOf(3) == TArray<int32>{4});
+	TestEqual(TEXT("Tip has no children"), Topology.NumChildren(4), 0);
+	TestEqual(TEXT("Bridge dummy has no children"), Topology.NumChildren(6), 0);
+	TestEqual(TEXT("Node accessor matches"), A.Node.GetModifyBoneChildIndices(0).Num(), 2);
+
+	// 範囲外は空
+	TestEqual(TEXT("Negative index is empty"), Topology.GetChildren(INDEX_NONE).Num(), 0);
+	TestEqual(TEXT("Out-of-range index is empty"), Topology.GetChildren(A.Num()).Num(), 0);
+
+	A.BoneTopology().Reset();
+	TestEqual(TEXT("Reset empties the topology"), Topology.Num(), 0);
+	return true;
+}
+
+// ---------------------------------------------------------------------------
+//  出力スロット表（FKawaiiPhysicsOutputSlots）
+//  従来の Add → RemoveAll(BoneIndex<0) → Sort(compact pose index) と同じ集合・同じ順序になること。
+// ---------------------------------------------------------------------------
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKawaiiPhysicsOutputSlotsTest,
+                                 "KawaiiPhysics.Simulation.OutputSlots",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FKawaiiPhysicsOutputSlotsTest::RunTest(const FString& Parameters)
+{
+	// compact pose index がボーン順と一致しない実ボーン + dummy + LOD で外れた実ボーン
+	FKawaiiPhysicsTestAccessor A;
+	A.BuildVerticalChain(6, 10.0f);
+	const int32 CompactIndices[] = {7, 3, INDEX_NONE, 12, INDEX_NONE, 5};
+	for (int32 i = 0; i < A.Num(); ++i)
+	{
+		A.Bone(i).BoneRef.CachedCompactPoseIndex = FCompactPoseBoneIndex(CompactIndices[i]);
+	}
+	A.Bone(2).bDummy = true;
+
+	FKawaiiPhysicsOutputSlots Slots;
+	Slots.Build(A.Node.ModifyBones, 1);
+
+	TestTrue(TEXT("Built for the current layout"), Slots.IsBuiltFor(1, A.Num()));
+	TestFalse(TEXT("Stale for a later generation with the same bone count"), Slots.IsBuiltFor(2, A.Num()));
+	TestEqual(TEXT("Only bones with a compact pose index are written"), Slots.Num(), 4);
+	const int32 ExpectedSlotBones[] = {1, 5, 0, 3};
+	for (int32 Slot = 0; Slot < FMath::Min(Slots.Num(), 4); ++Slot)
+	{
+		TestEqual(FString::Printf(TEXT("Slot %d follows ascending compact pose index"), Slot), Slots.GetSlotBone(Slot),
+		          ExpectedSlotBones[Slot]);
+	}
+	for (int32 Slot = 1; Slot < Slots.Num(); ++Slot)
+	{
+		TestTrue(FString::Printf(TEXT("Slot %d is sorted"), Slot),
+		         Slots.GetSlotCompactIndex(Slot - 1) < Slots.GetSlotCompactIndex(Slot));
+	}
+	TestEqual(TEXT("Bone 0 slot"), Slots.GetSlot(0), 2);
+	TestEqual(TEXT("Bone 5 slot"), Slots.GetSlot(5), 1);
+	TestEqual(TEXT("Dummy has no slot"), Slots.GetSlot(2), static_cast<int32>(INDEX_NONE));
+	TestEqual(TEXT("LOD-culled bone has no slot"), Slots.GetSlot(4), static_cast<int32>(INDEX_NONE));
+	TestEqual(TEXT("Out-of-range bone has no slot"), Slots.GetSlot(99), static_cast<int32>(INDEX_NONE));
+
+	Slots.Reset();
+	TestFalse(TEXT("Reset drops the table"), Slots.IsBuiltFor(1, A.Num()));
+	return true;
+}
+
+// ---------------------------------------------------------------------------
+//  バッチ実行（UKawaiiPhysicsSimulationSubsystem）
+//  Output / Scene に依存するノードはバッチ対象外になり、所有者が無効なエントリは実行されないこと。
+// ---------------------------------------------------------------------------
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKawaiiPhysicsBatchedSimulationTest,
+                                 "KawaiiPhysics.Simulation.BatchedSimulation",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FKawaiiPhysicsBatchedSimulationTest::RunTest(const FString& Parameters)
+{
+	{
+		FKawaiiPhysicsTestAccessor A;
+		A.BuildVerticalChain(4, 10.0f);
+		TestTrue(TEXT("Plain node can be batched"), A.CallCanBatchSimulation());
+
+		A.Node.bAllowWorldCollision = true;
+		TestFalse(TEXT("World collision needs the scene"), A.CallCanBatchSimulation());
+		A.Node.bAllowWorldCollision = false;
+
+		A.Node.ExternalForces.Add(FInstancedStruct::Make<FKawaiiPhysics_ExternalForce_Basic>());
+		TestFalse(TEXT("External forces need the pose context"), A.CallCanBatchSimulation());
+	}
+
+	{
+		FKawaiiPhysicsTestAccessor A;
+		A.BuildVerticalChain(4, 10.0f);
+		A.StepFrame(1.0f / 60.0f);
+		const FVector TipBefore = A.Bone(3).Location;
+
+		// 保留が無ければ何もしない
+		A.CallRunBatchedSimulation();
+		TestEqual(TEXT("No pending solve is a no-op"), A.Bone(3).Location, TipBefore);
+
+		// 所有者が無効なエントリは捨てられ、保留フラグは次の評価での同期実行に残る
+		UKawaiiPhysicsSimulationSubsystem* Subsystem = NewObject<UKawaiiPhysicsSimulationSubsystem>();
+		A.BatchedSimulationPending() = true;
+		Subsystem->EnqueueSimulation(&A.Node, nullptr);
+		TestEqual(TEXT("Enqueued"), Subsystem->GetNumPendingSimulations(), 1);
+		Subsystem->RunPendingSimulations();
+		TestEqual(TEXT("Queue drained"), Subsystem->GetNumPendingSimulations(), 0);
+		TestTrue(TEXT("Stale entry was not solved"), A.BatchedSimulationPending());
+		TestEqual(TEXT("Stale entry left the bones alone"), A.Bone(3).Location, TipBefore);
+		A.BatchedSimulationPending() = false;
+	}
+
+	// 登録したノードを本番の評価 → RunPendingSimulations の順で回すと、各評価で見える結果は
+	// 同期実行の1フレーム前の結果とビット一致する（バッチのソルバは評価の後で走るため）
+	{
+		FKawaiiPhysicsScopedBoolCVar ScopedBatched(CVarAnimNodeKawaiiPhysicsBatchedSimulation, true);
+		FAnimInstanceProxy AnimInstanceProxy;
+		FComponentSpacePoseContext Output(&AnimInstanceProxy);
+		UKawaiiPhysicsSimulationSubsystem* Subsystem = NewObject<UKawaiiPhysicsSimulationSubsystem>();
+
+		FKawaiiPhysicsTestAccessor Inline;
+		FKawaiiPhysicsTestAccessor Batched;
+		for (FKawaiiPhysicsTestAccessor* A : {&Inline, &Batched})
+		{
+			A->BuildVerticalChain(5, 10.0f);
+			for (int32 i = 0; i < A->Num(); ++i)
+			{
+				A->Bone(i).BoneRef.BoneIndex = i;
+			}
+			A->Bone(0).PoseLocation += FVector(5.0f, 0.0f, 0.0f);
+		}
+
+		TArray<FVector> InlinePrevFrame;
+		for (int32 i = 0; i < Inline.Num(); ++i)
+		{
+			InlinePrevFrame.Add(Inline.Bone(i).Location);
+		}
+
+		for (int32 Frame = 0; Frame < 20; ++Frame)
+		{
+			TestTrue(FString::Printf(TEXT("Frame %d is enqueued"), Frame),
+			         Batched.StepFrameBatched(Output, 1.0f / 60.0f, Subsystem));
+			TestEqual(FString::Printf(TEXT("Frame %d waits in the queue"), Frame),
+			          Subsystem->GetNumPendingSimulations(), 1);
+
+			// 評価時点で見えるのは前フレームまでの結果 / Evaluation sees the previous frame's result
+			for (int32 i = 0; i < Batched.Num(); ++i)
+			{
+				TestTrue(FString::Printf(TEXT("Frame %d bone %d lags the inline solve by one frame"), Frame, i),
+				         Batched.Bone(i).Location == InlinePrevFrame[i]);
+			}
+
+			Inline.StepFrameInline(Output, 1.0f / 60.0f);
+			Subsystem->RunPendingSimulations();
+			TestFalse(FString::Printf(TEXT("Frame %d was solved by the batch"), Frame),
+			          Batched.BatchedSimulationPending());
+
+			for (int32 i = 0; i < Inline.Num(); ++i)
+			{
+				InlinePrevFrame[i] = Inline.Bone(i).Location;
+			}
+		}
+
+		// 最後のバッチの後は同フレームの同期実行と一致する / After the last batch it matches the same frame inline
+		for (int32 i = 0; i < Inline.Num(); ++i)
+		{
+			TestTrue(FString::Printf(TEXT("Bone %d matches after the last batch"), i),
+			         Batched.Bone(i).Location == Inline.Bone(i).Location);
+		}
+		TestTrue(TEXT("The chain actually moved"), !Inline.Bone(4).Location.Equals(FVector(0.0f, 0.0f, -40.0f)));
+	}
+	return true;
+}
+
+// ---------------------------------------------------------------------------
+//  パイプライン実行（a.AnimNode.KawaiiPhysics.PipelinedSimulation）
+//  本番の順（PreUpdate → Update → 評価で Prepare → Launch）で回し、タスクは次の PreUpdate で取り込まれ、
+//  各評価で見える結果は同期実行の1フレーム前の結果とビット一致すること。
+// ---------------------------------------------------------------------------
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKawaiiPhysicsPipelinedSimulationTest,
+                                 "KawaiiPhysics.Simulation.PipelinedSimulation",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FKawaiiPhysicsPipelinedSimulationTest::RunTest(const FString& Parameters)
+{
+	FKawaiiPhysicsScopedBoolCVar ScopedPipelined(CVarAnimNodeKawaiiPhysicsPipelinedSimulation, true);
+	FAnimInstanceProxy AnimInstanceProxy;
+	FComponentSpacePoseContext Output(&AnimInstanceProxy);
+
+	FKawaiiPhysicsTestAccessor Inline;
+	FKawaiiPhysicsTestAccessor Pipelined;
+	for (FKawaiiPhysicsTestAccessor* A : {&Inline, &Pipelined})
+	{
+		A->BuildVerticalChain(5, 10.0f);
+		for (int32 i = 0; i < A->Num(); ++i)
+		{
+			A->Bone(i).BoneRef.BoneIndex = i;
+		}
+		A->Bone(0).PoseLocation += FVector(5.0f, 0.0f, 0.0f);
+	}
+
+	TArray<FVector> InlinePrevFrame;
+	for (int32 i = 0; i < Inline.Num(); ++i)
+	{
+		InlinePrevFrame.Add(Inline.Bone(i).Location);
+	}
+
+	for (int32 Frame = 0; Frame < 20; ++Frame)
+	{
+		TestTrue(FString::Printf(TEXT("Frame %d is scheduled as a task"), Frame),
+		         Pipelined.StepFramePipelined(Output, 1.0f / 60.0f));
+
+		// 評価時点で見えるのは前フレームまでの結果（このフレームのタスクは起動しただけ）
+		// Evaluation sees the previous frame's result; this frame's task has only been launched
+		for (int32 i = 0; i < Pipelined.Num(); ++i)
+		{
+			TestTrue(FString::Printf(TEXT("Frame %d bone %d lags the inline solve by one frame"), Frame, i),
+			         Pipelined.Bone(i).Location == InlinePrevFrame[i]);
+		}
+
+		Inline.StepFrameInline(Output, 1.0f / 60.0f);
+		for (int32 i = 0; i < Inline.Num(); ++i)
+		{
+			InlinePrevFrame[i] = Inline.Bone(i).Location;
+		}
+	}
+
+	// 次フレームの PreUpdate（ピン / setter より前）でタスクは終わって取り込まれ、同フレームの同期実行と一致する
+	TestTrue(TEXT("A task is in flight after the evaluation"), Pipelined.PipelinedSimulationInFlight());
+	Pipelined.CallPreUpdate();
+	TestFalse(TEXT("PreUpdate joins the task"), Pipelined.PipelinedSimulationTaskValid());
+	TestFalse(TEXT("PreUpdate picks up the result"), Pipelined.PipelinedSimulationInFlight());
+	for (int32 i = 0; i < Inline.Num(); ++i)
+	{
+		TestTrue(FString::Printf(TEXT("Bone %d matches the inline solve bit for bit after PreUpdate"), i),
+		         Pipelined.Bone(i).Location == Inline.Bone(i).Location &&
+		         Pipelined.Bone(i).PoseRotation == Inline.Bone(i).PoseRotation);
+	}
+	TestTrue(TEXT("The chain actually moved"), !Inline.Bone(4).Location.Equals(FVector(0.0f, 0.0f, -40.0f)));
+	return true;
+}
+
+// ---------------------------------------------------------------------------
+//  パイプライン実行中の setter
+//  タスクが走っている間に Blueprint の setter でノードを書き換えると、先にタスクと合流して結果を取り込み、
+//  その後で値が書かれること（タスクが読んでいるノードを書き換えない）。
+// ---------------------------------------------------------------------------
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKawaiiPhysicsPipelinedSetterJoinTest,
+                                 "KawaiiPhysics.Simulation.PipelinedSetterJoin",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FKawaiiPhysicsPipelinedSetterJoinTest::RunTest(const FString& Parameters)
+{
+	FKawaiiPhysicsScopedBoolCVar ScopedPipelined(CVarAnimNodeKawaiiPhysicsPipelinedSimulation, true);
+	FAnimInstanceProxy AnimInstanceProxy;
+	FComponentSpacePoseContext Output(&AnimInstanceProxy);
+
+	FKawaiiPhysicsTestAccessor Inline;
+	FKawaiiPhysicsTestAccessor Pipelined;
+	for (FKawaiiPhysicsTestAccessor* A : {&Inline, &Pipelined})
+	{
+		A->BuildVerticalChain(5, 10.0f);
+		for (int32 i = 0; i < A->Num(); ++i)
+		{
+			A->Bone(i).BoneRef.BoneIndex = i;
+		}
+		A->Bone(0).PoseLocation += FVector(5.0f, 0.0f, 0.0f);
+	}
+
+	for (int32 Frame = 0; Frame < 5; ++Frame)
+	{
+		Pipelined.StepFramePipelined(Output, 1.0f / 60.0f);
+		Inline.StepFrameInline(Output, 1.0f / 60.0f);
+	}
+	TestTrue(TEXT("A task is in flight before the setter"), Pipelined.PipelinedSimulationInFlight());
+
+	TestTrue(TEXT("Set string property"),
+	         UKawaiiPhysicsLibrary::SetNodePropertyValueFromString(
+		         Pipelined.Node, GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, WindScale), TEXT("2.5")));
+	TestFalse(TEXT("The string setter joins the task"), Pipelined.PipelinedSimulationTaskValid());
+	TestFalse(TEXT("The string setter picks up the result"), Pipelined.PipelinedSimulationInFlight());
+	TestTrue(TEXT("The string setter writes the value"), FMath::IsNearlyEqual(Pipelined.Node.WindScale, 2.5f));
+	for (int32 i = 0; i < Inline.Num(); ++i)
+	{
+		TestTrue(FString::Printf(TEXT("Bone %d holds the joined result after the string setter"), i),
+		         Pipelined.Bone(i).Location == Inline.Bone(i).Location);
+	}
+
+	Pipelined.StepFramePipelined(Output, 1.0f / 60.0f);
+	TestTrue(TEXT("A task is in flight before the wildcard setter"), Pipelined.PipelinedSimulationInFlight());
+	TestTrue(TEXT("Set float property"),
+	         UKawaiiPhysicsLibrary::SetNodePropertyValue<float, FFloatProperty>(
+		         Pipelined.Node, GET_MEMBER_NAME_CHECKED(FAnimNode_KawaiiPhysics, WindScale), 1.0f));
+	TestFalse(TEXT("The wildcard setter joins the task"), Pipelined.PipelinedSimulationTaskValid());
+	TestFalse(TEXT("The wildcard setter picks up the result"), Pipelined.PipelinedSimulationInFlight());
+
+	// ResetDynamics もタスクが書く補間フラグに触れるので合流する
+	Pipelined.StepFramePipelined(Output, 1.0f / 60.0f);
+	Pipelined.Node.ResetDynamics(ETeleportType::ResetPhysics);
+	TestFalse(TEXT("ResetDynamics joins the task"), Pipelined.PipelinedSimulationTaskValid());
+	TestFalse(TEXT("ResetDynamics picks up the result"), Pipelined.PipelinedSimulationInFlight());
+	return true;
+}
+
+// ---------------------------------------------------------------------------
+//  フレーム予算の割り当て（UKawaiiPhysicsSimulationSubsystem::AssignBudgetTiers）とノード側の間引き
+//  Significance の高い順に Full → Reduced → Frozen と単調に割り当て、最上位は予算超過でも Full であること。
+//  同じ Significance は登録順に依らずコンポーネント ID → ノード ID の順で、Significance は 0〜1 に揃えること。
+//  Reduced のノードは ReducedUpdateInterval フレームに1回、スキップした時間をまとめてシミュレーションすること。
+// ---------------------------------------------------------------------------
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKawaiiPhysicsSimulationBudgetTest,
+                                 "KawaiiPhysics.Simulation.SimulationBudget",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FKawaiiPhysicsSimulationBudgetTest::RunTest(const FString& Parameters)
+{
+	using FBudgetRequest = UKawaiiPhysicsSimulationSubsystem::FBudgetRequest;
+	auto MakeRequest = [](const float CostMs, const float Significance)
+	{
+		FBudgetRequest Request;
+		Request.CostMs = CostMs;
+		Request.Significance = Significance;
+		return Request;
+	};
+
+	{
+		// 予算 1.05ms・間隔 2: 0.6(Full) → 0.4(Full, 計1.0) → 0.4(Reduced でも 0.2 必要で超過 → Frozen)
+		TArray<FBudgetRequest> Requests = {MakeRequest(0.4f, 0.2f), MakeRequest(0.6f, 0.9f), MakeRequest(0.4f, 0.1f)};
+		const float UsedMs = UKawaiiPhysicsSimulationSubsystem::AssignBudgetTiers(Requests, 1.05f, 2);
+		TestEqual(TEXT("Sorted by significance"), Requests[0].Significance, 0.9f);
+		TestEqual(TEXT("Top is Full"), Requests[0].Tier, EKawaiiPhysicsBudgetTier::Full);
+		TestEqual(TEXT("Second fits"), Requests[1].Tier, EKawaiiPhysicsBudgetTier::Full);
+		TestEqual(TEXT("Third is frozen"), Requests[2].Tier, EKawaiiPhysicsBudgetTier::Frozen);
+		TestTrue(TEXT("Used budget"), FMath::IsNearlyEqual(UsedMs, 1.0f));
+	}
+
+	{
+		// 上位が Reduced になったら、下位は予算が残っていても Full にはならない
+		TArray<FBudgetRequest> Requests = {MakeRequest(0.5f, 3.0f), MakeRequest(1.0f, 2.0f), MakeRequest(0.1f, 1.0f)};
+		UKawaiiPhysicsSimulationSubsystem::AssignBudgetTiers(Requests, 1.0f, 4);
+		TestEqual(TEXT("Top is Full"), Requests[0].Tier, EKawaiiPhysicsBudgetTier::Full);
+		TestEqual(TEXT("Over budget drops to Reduced"), Requests[1].Tier, EKawaiiPhysicsBudgetTier::Reduced);
+		TestEqual(TEXT("Tiers stay monotonic"), Requests[2].Tier, EKawaiiPhysicsBudgetTier::Reduced);
+	}
+
+	{
+		// 1ノードだけで予算を超えても最上位は止めない
+		TArray<FBudgetRequest> Requests = {MakeRequest(5.0f, 1.0f)};
+		UKawaiiPhysicsSimulationSubsystem::AssignBudgetTiers(Requests, 1.0f, 2);
+		TestEqual(TEXT("Highest priority is never throttled"), Requests[0].Tier, EKawaiiPhysicsBudgetTier::Full);
+	}
+
+	{
+		// 同じ Significance なら、どの順で登録されても ComponentId → NodeId の順に割り当てる
+		auto MakeTied = [&MakeRequest](const uint32 ComponentId, const int32 NodeId)
+		{
+			FBudgetRequest Request = MakeRequest(0.4f, 0.5f);
+			Request.ComponentId = ComponentId;
+			Request.NodeId = NodeId;
+			return Request;
+		};
+		const TArray<FBudgetRequest> Forward = {MakeTied(3, 0), MakeTied(7, 2), MakeTied(7, 1)};
+		TArray<FBudgetRequest> Reversed = Forward;
+		Algo::Reverse(Reversed);
+		for (TArray<FBudgetRequest> Requests : {Forward, Reversed})
+		{
+			UKawaiiPhysicsSimulationSubsystem::AssignBudgetTiers(Requests, 1.05f, 2);
+			TestTrue(TEXT("Lowest component id first"), Requests[0].ComponentId == 3);
+			TestTrue(TEXT("Then by node id"), Requests[1].ComponentId == 7 && Requests[1].NodeId == 1);
+			TestEqual(TEXT("Tie-broken order decides the tiers"), Requests[1].Tier, EKawaiiPhysicsBudgetTier::Full);
+			TestEqual(TEXT("Last of the ties is reduced"), Requests[2].Tier, EKawaiiPhysicsBudgetTier::Reduced);
+		}
+	}
+
+	{
+		// ゲームの Significance と画面サイズは同じ 0〜1 で比べる（負は画面サイズで代用する印として残す）
+		TestEqual(TEXT("Above 1 counts as 1"), UKawaiiPhysicsSimulationSubsystem::NormalizeSignificance(25.0f), 1.0f);
+		TestEqual(TEXT("In range is unchanged"), UKawaiiPhysicsSimulationSubsystem::NormalizeSignificance(0.25f), 0.25f);
+		TestEqual(TEXT("Negative passes through"), UKawaiiPhysicsSimulationSubsystem::NormalizeSignificance(-1.0f), -1.0f);
+	}
+
+	{
+		UKawaiiPhysicsDeveloperSettings* KawaiiSettings = GetMutableDefault<UKawaiiPhysicsDeveloperSettings>();
+		const bool bSavedUseBudget = KawaiiSettings->bUseSimulationBudget;
+		const int32 SavedInterval = KawaiiSettings->ReducedUpdateInterval;
+		KawaiiSettings->bUseSimulationBudget = true;
+		KawaiiSettings->ReducedUpdateInterval = 3;
+
+		FKawaiiPhysicsTestAccessor A;
+		A.BuildVerticalChain(4, 10.0f);
+		A.SimulationBudgetTier() = EKawaiiPhysicsBudgetTier::Reduced;
+
+		int32 NumSimulated = 0;
+		float SimulatedDeltaTime = 0.0f;
+		for (int32 Frame = 0; Frame < 6; ++Frame)
+		{
+			A.Node.DeltaTime = 1.0f / 60.0f;
+			if (A.CallShouldSimulateUnderBudget())
+			{
+				++NumSimulated;
+				SimulatedDeltaTime = A.Node.DeltaTime;
+			}
+		}
+		TestEqual(TEXT("Reduced simulates every third frame"), NumSimulated, 2);
+		TestTrue(TEXT("Skipped time is simulated at once"), FMath::IsNearlyEqual(SimulatedDeltaTime, 3.0f / 60.0f));
+
+		A.SimulationBudgetTier() = EKawaiiPhysicsBudgetTier::Frozen;
+		TestFalse(TEXT("Frozen never simulates"), A.CallShouldSimulateUnderBudget());
+
+		KawaiiSettings->bUseSimulationBudget = false;
+		TestTrue(TEXT("Budget off always simulates"), A.CallShouldSimulateUnderBudget());
+		TestEqual(TEXT("Budget off resets the tier"), A.SimulationBudgetTier(), EKawaiiPhysicsBudgetTier::Full);
+
+		KawaiiSettings->bUseSimulationBudget = bSavedUseBudget;
+		KawaiiSettings->ReducedUpdateInterval = SavedInterval;
+	}
+	return true;
+}
+
+// ---------------------------------------------------------------------------
+//  静止したチェーンのスリープ（UpdateSleepState）
+//  速度とポーズ変化が閾値未満で SleepFrames 続いたら眠り、ポーズの変化・コライダーの出入り・物理設定オーバーライドで起きること。
+//  動いているチェーンや wind を使うノードは眠らないこと。
+// ---------------------------------------------------------------------------
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKawaiiPhysicsSleepTest,
+                                 "KawaiiPhysics.Simulation.Sleep",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FKawaiiPhysicsSleepTest::RunTest(const FString& Parameters)
+{
+	constexpr float Dt = 1.0f / 60.0f;
+	FKawaiiPhysicsTestAccessor A;
+	A.BuildVerticalChain(4, 10.0f);
+	A.Node.bAllowSleep = true;
+	A.Node.SleepFrames = 3;
+
+	// 重力無しの静止チェーンは SleepFrames 後に眠る
+	auto SettleUntilSleep = [&A]()
+	{
+		int32 NumFrames = 0;
+		while (NumFrames < 10)
+		{
+			A.StepFrame(Dt);
+			++NumFrames;
+			if (A.CallUpdateSleepState())
+			{
+				break;
+			}
+		}
+		return NumFrames;
+	};
+	TestEqual(TEXT("Falls asleep after SleepFrames"), SettleUntilSleep(), 3);
+	TestTrue(TEXT("Sleeping"), A.IsSleeping());
+	TestTrue(TEXT("Stays asleep"), A.CallUpdateSleepState());
+	TestEqual(TEXT("One island when not split"), A.IslandKineticEnergy().Num(), 1);
+
+	// 入力ポーズが動いたら起きる
+	A.Node.ModifyBones[0].PoseLocation.Z += 1.0f;
+	TestFalse(TEXT("Pose change wakes"), A.CallUpdateSleepState());
+	TestFalse(TEXT("Awake after pose change"), A.IsSleeping());
+	A.Node.ModifyBones[0].PoseLocation.Z -= 1.0f;
+
+	// チェーンの範囲にコライダーが入ったら起きる（遠くのコライダーでは起きない）
+	TestEqual(TEXT("Sleeps again"), SettleUntilSleep(), 3);
+	FSphericalLimit FarLimit;
+	FarLimit.Location = FVector(500.0f, 0.0f, 0.0f);
+	FarLimit.Radius = 5.0f;
+	A.Node.SphericalLimits.Add(FarLimit);
+	TestTrue(TEXT("Far collider keeps sleeping"), A.CallUpdateSleepState());
+	FSphericalLimit NearLimit;
+	NearLimit.Location = FVector(6.0f, 0.0f, -20.0f);
+	NearLimit.Radius = 5.0f;
+	A.Node.SphericalLimits.Add(NearLimit);
+	TestFalse(TEXT("Collider entering the bounds wakes"), A.CallUpdateSleepState());
+	A.Node.SphericalLimits.Pop();
+
+	// 物理設定オーバーライドで起きる
+	TestEqual(TEXT("Sleeps again without the collider"), SettleUntilSleep(), 3);
+	TestFalse(TEXT("Settings override wakes"), A.CallUpdateSleepState(true));
+
+	// 動いているチェーンは眠らない
+	for (int32 Frame = 0; Frame < 5; ++Frame)
+	{
+		A.StepFrame(Dt);
+		A.Node.ModifyBones[3].PrevLocation = A.Node.ModifyBones[3].Location - FVector(1.0f, 0.0f, 0.0f);
+		TestFalse(TEXT("Moving chain stays awake"), A.CallUpdateSleepState());
+	}
+	TestTrue(TEXT("Kinetic energy tracked"), A.IslandKineticEnergy()[0] > 0.0f);
+
+	// wind を使うノードは眠らない
+	A.Node.bEnableWind = true;
+	for (int32 Frame = 0; Frame < 5; ++Frame)
+	{
+		A.StepFrame(Dt);
+		TestFalse(TEXT("Wind never sleeps"), A.CallUpdateSleepState());
+	}
+	return true;
+}
+
+// ---------------------------------------------------------------------------
+//  距離・画面サイズによる LOD 段階（SelectLODTier / UpdateLODTier）
+//  指標ごとに最も粗い段階を選び、閾値付近ではヒステリシスで行き来しないこと。段階の設定が更新間隔・反復回数・
+//  サブステップ数に反映され、切り替え直後の出力は前フレームの結果から始まること。
+// ---------------------------------------------------------------------------
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKawaiiPhysicsLODTiersTest,
+                                 "KawaiiPhysics.Simulation.LODTiers",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FKawaiiPhysicsLODTiersTest::RunTest(const FString& Parameters)
+{
+	// 段階の選択とヒステリシス
+	{
+		const auto Select = &FKawaiiPhysicsTestAccessor::CallSelectLODTier;
+		TArray<FKawaiiPhysicsLODTier> Tiers;
+		Tiers.AddDefaulted(2);
+		Tiers[0].Threshold = 1000.0f;
+		Tiers[1].Threshold = 3000.0f;
+		constexpr EKawaiiPhysicsLODMetric Distance = EKawaiiPhysicsLODMetric::Distance;
+		TestEqual(TEXT("Near uses full quality"), Select(Tiers, Distance, 500.0f, INDEX_NONE), INDEX_NONE);
+		TestEqual(TEXT("Middle distance"), Select(Tiers, Distance, 1500.0f, INDEX_NONE), 0);
+		TestEqual(TEXT("Far distance"), Select(Tiers, Distance, 5000.0f, 0), 1);
+		TestEqual(TEXT("Stays coarse just inside the threshold"), Select(Tiers, Distance, 2900.0f, 1), 1);
+		TestEqual(TEXT("Returns once clearly inside"), Select(Tiers, Distance, 2500.0f, 1), 0);
+
+		Tiers[0].Threshold = 0.3f;
+		Tiers[1].Threshold = 0.1f;
+		constexpr EKawaiiPhysicsLODMetric ScreenSize = EKawaiiPhysicsLODMetric::ScreenSize;
+		TestEqual(TEXT("Large on screen"), Select(Tiers, ScreenSize, 0.8f, INDEX_NONE), INDEX_NONE);
+		TestEqual(TEXT("Small on screen"), Select(Tiers, ScreenSize, 0.05f, INDEX_NONE), 1);
+		TestEqual(TEXT("Screen size hysteresis"), Select(Tiers, ScreenSize, 0.105f, 1), 1);
+		TestEqual(TEXT("Not rendered is the coarsest tier"), Select(Tiers, ScreenSize, 0.0f, INDEX_NONE), 1);
+	}
+
+	constexpr float Dt = 1.0f / 60.0f;
+	FKawaiiPhysicsTestAccessor A;
+	A.BuildVerticalChain(4, 10.0f);
+	A.Node.BoneConstraintIterationCountBeforeCollision = 2;
+	A.Node.BoneConstraintIterationCountAfterCollision = 3;
+	A.Node.bAllowWorldCollision = true;
+	A.Node.LODTierMetric = EKawaiiPhysicsLODMetric::Distance;
+	A.Node.LODTierBlendTime = 0.1f;
+	FKawaiiPhysicsLODTier& Tier = A.Node.LODTiers.AddDefaulted_GetRef();
+	Tier.Threshold = 1000.0f;
+	Tier.UpdateInterval = 3;
+	Tier.MaxSubsteps = 2;
+	Tier.bEnableWorldCollision = false;
+	Tier.BoneConstraintIterationCountAfterCollision = 1;
+
+	A.Node.DeltaTime = Dt;
+	A.SetLODViewMetrics(1.0f, 200.0f);
+	A.CallUpdateLODTier();
+	TestEqual(TEXT("Near node has no tier"), A.ActiveLODTier(), INDEX_NONE);
+	TestEqual(TEXT("Node iterations without a tier"), A.GetEffectiveBoneConstraintIterationCount(true), 3);
+	TestEqual(TEXT("Project substeps without a tier"), A.GetEffectiveMaxSubsteps(8), 8);
+	TestTrue(TEXT("World collision without a tier"), A.IsWorldCollisionActive());
+
+	// 前フレームの結果をずらしておき、切り替え直後の出力がそれと一致することを確かめる
+	A.StepFrame(Dt);
+	A.Node.ModifyBones[3].Location.X += 2.0f;
+	const FVector LocationBeforeSwitch = A.Node.ModifyBones[3].Location;
+	A.SetLODViewMetrics(0.1f, 2000.0f);
+	A.CallUpdateLODTier();
+	TestEqual(TEXT("Far node uses the tier"), A.ActiveLODTier(), 0);
+	TestEqual(TEXT("Tier iterations override"), A.GetEffectiveBoneConstraintIterationCount(true), 1);
+	TestEqual(TEXT("Negative tier iterations keep the node value"), A.GetEffectiveBoneConstraintIterationCount(false), 2);
+	TestEqual(TEXT("Tier caps substeps"), A.GetEffectiveMaxSubsteps(8), 2);
+	TestFalse(TEXT("Tier disables world collision"), A.IsWorldCollisionActive());
+	TestEqual(TEXT("Blend starts"), A.LODTierBlendAlpha(), 0.0f);
+
+	A.Node.ModifyBones[3].Location.X -= 2.0f;
+	const FVector SimulatedLocation = A.Node.ModifyBones[3].Location;
+	TestTrue(TEXT("Blend applied"), A.CallBeginLODTierBlend());
+	TestTrue(TEXT("Output starts from the previous result"),
+	         A.Node.ModifyBones[3].Location.Equals(LocationBeforeSwitch, KINDA_SMALL_NUMBER));
+	A.CallEndLODTierBlend();
+	TestTrue(TEXT("Simulation state restored"), A.Node.ModifyBones[3].Location.Equals(SimulatedLocation));
+
+	// ブレンドは LODTierBlendTime で終わる
+	A.Node.DeltaTime = Dt;
+	for (int32 Frame = 0; Frame < 8; ++Frame)
+	{
+		A.CallUpdateLODTier();
+	}
+	TestEqual(TEXT("Blend finished"), A.LODTierBlendAlpha(), 1.0f);
+	TestFalse(TEXT("No blend once finished"), A.CallBeginLODTierBlend());
+
+	// 段階の UpdateInterval で間引かれ、スキップした時間はまとめて進める
+	int32 NumSimulated = 0;
+	for (int32 Frame = 0; Frame < 6; ++Frame)
+	{
+		A.Node.DeltaTime = Dt;
+		if (A.CallShouldSimulateUnderBudget())
+		{
+			++NumSimulated;
+			TestEqual(TEXT("Skipped time is carried over"), A.Node.DeltaTime, Dt * 3.0f, KINDA_SMALL_NUMBER);
+		}
+	}
+	TestEqual(TEXT("Simulates every UpdateInterval frames"), NumSimulated, 2);
+	return true;
+}
+
+// ---------------------------------------------------------------------------
+//  低レートの固定サブステップと出力補間（OutputInterpolation）
+//  ステップの無いフレームは直前2ステップの結果を未消費時間の割合で補間（外挿）し、シミュレーション結果は書き換えないこと。
+//  リセットで補間をやめ、ステップの位相はインスタンスごとに 1 ステップ未満ずれること。
+// ---------------------------------------------------------------------------
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKawaiiPhysicsOutputInterpolationTest,
+                                 "KawaiiPhysics.Simulation.OutputInterpolation",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FKawaiiPhysicsOutputInterpolationTest::RunTest(const FString& Parameters)
+{
+	constexpr float Dt = 1.0f / 60.0f;
+	constexpr float FixedDt = 1.0f / 20.0f;
+	FKawaiiPhysicsTestAccessor A;
+	A.BuildVerticalChain(4, 10.0f);
+	A.SetFixedSubstepping(true, 20);
+	TestEqual(TEXT("No phase offset without interpolation"), A.GetSubstepPhaseOffset(), 0.0f);
+
+	A.Node.OutputInterpolation = EKawaiiPhysicsOutputInterpolation::Interpolate;
+	const float PhaseOffset = A.GetSubstepPhaseOffset();
+	TestTrue(TEXT("Phase offset stays under one step"), PhaseOffset >= 0.0f && PhaseOffset < FixedDt);
+
+	// 先端を横へずらして揺らし、20Hz のステップを 60fps で進める
+	A.Node.ModifyBones[3].Location.X += 5.0f;
+	A.Node.ModifyBones[3].PrevLocation.X += 5.0f;
+	// 境界の丸めでステップ数が揺れないよう、位相を 0.1 ステップ進めておく
+	A.SubstepAccumulator() = FixedDt * 0.1f;
+	A.StepFrames(2, Dt);
+	TestFalse(TEXT("Nothing to interpolate before the first step"), A.IsOutputInterpolationValid());
+	TestFalse(TEXT("Raw output before the first step"), A.CallBeginOutputInterpolation());
+	const FVector BeforeStep = A.Node.ModifyBones[3].Location;
+
+	A.StepFrame(Dt);
+	TestTrue(TEXT("Recorded after a step"), A.IsOutputInterpolationValid());
+	const FVector AfterStep = A.Node.ModifyBones[3].Location;
+	TestTrue(TEXT("The tip swung"), !AfterStep.Equals(BeforeStep, 0.01f));
+
+	// 出力は1ステップ遅れで、未消費時間の割合だけ補間先へ進む
+	TestEqual(TEXT("Carried phase"), A.SubstepAccumulator(), FixedDt * 0.1f, 1.0e-5f);
+	TestTrue(TEXT("Interpolating"), A.CallBeginOutputInterpolation());
+	TestTrue(TEXT("Output trails the last step"),
+	         A.Node.ModifyBones[3].Location.Equals(FMath::Lerp(BeforeStep, AfterStep, 0.1f), 1.0e-3f));
+	A.CallEndOutputInterpolation();
+	TestTrue(TEXT("Simulation result restored"), A.Node.ModifyBones[3].Location.Equals(AfterStep));
+
+	// ステップの無いフレームも未消費時間の割合で進む
+	A.StepFrame(Dt);
+	TestTrue(TEXT("No step on this frame"), A.Node.ModifyBones[3].Location.Equals(AfterStep));
+	const float Alpha = A.SubstepAccumulator() / FixedDt;
+	TestTrue(TEXT("Interpolating between steps"), A.CallBeginOutputInterpolation());
+	TestTrue(TEXT("Output follows the carried time"),
+	         A.Node.ModifyBones[3].Location.Equals(FMath::Lerp(BeforeStep, AfterStep, Alpha), 1.0e-3f));
+	A.CallEndOutputInterpolation();
+
+	A.Node.OutputInterpolation = EKawaiiPhysicsOutputInterpolation::Extrapolate;
+	TestTrue(TEXT("Extrapolating between steps"), A.CallBeginOutputInterpolation());
+	TestTrue(TEXT("Output leads the last step"),
+	         A.Node.ModifyBones[3].Location.Equals(AfterStep + (AfterStep - BeforeStep) * Alpha, 1.0e-3f));
+	A.CallEndOutputInterpolation();
+
+	// リセット後は次のステップが記録されるまで補間しない
+	A.Node.ResetDynamics(ETeleportType::ResetPhysics);
+	TestFalse(TEXT("Reset stops interpolating"), A.CallBeginOutputInterpolation());
+	TestEqual(TEXT("Reset keeps the instance phase"), A.SubstepAccumulator(), PhaseOffset);
+	return true;
+}
+
+// ---------------------------------------------------------------------------
+//  独立した root チェーンのアイランド分割（FKawaiiPhysicsBoneIslands）と並列ソルブ
+//  Constraint で繋がったチェーンは同じアイランドになり、並列ソルブの結果は逐次とビット一致すること。
+// ---------------------------------------------------------------------------
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKawaiiPhysicsBoneIslandsTest,
+                                 "KawaiiPhysics.Simulation.BoneIslands",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FKawaiiPhysicsBoneIslandsTest::RunTest(const FString& Parameters)
+{
+	{
+		FKawaiiPhysicsTestAccessor A;
+		A.BuildTwoVerticalChains(5, 10.0f, 30.0f);
+		A.CallBuildBoneCategories();
+
+		A.CallBuildBoneIslands(1);
+		const FKawaiiPhysicsBoneIslands& Islands = A.BoneIslands();
+		TestEqual(TEXT("Two unconnected chains are two islands"), Islands.Num(), 2);
+		TestEqual(TEXT("Left chain island"), Islands.GetIsland(3), 0);
+		TestEqual(TEXT("Right chain island"), Islands.GetIsland(7), 1);
+		TestTrue(TEXT("Right root follows the pose"),
+		         Islands.Islands[1].Categories.KinematicRoots == TArray<int32>{5});
+		TestTrue(TEXT("Right chain keeps index order"),
+		         Islands.Islands[1].Categories.Simulated == TArray<int32>{6, 7, 8, 9});
+		TestEqual(TEXT("Island bone count"), Islands.Islands[0].NumBones, 5);
+
+		A.CallBuildBoneIslands(6);
+		TestEqual(TEXT("Islands below the minimum are packed into one task (= sequential)"),
+		          A.BoneIslands().Num(), 0);
+		TestEqual(TEXT("No island when sequential"), A.BoneIslands().GetIsland(3), static_cast<int32>(INDEX_NONE));
+
+		A.AddRuntimeBoneConstraint(1, 3, 20.0f);
+		A.CallBuildBoneIslands(1);
+		TestEqual(TEXT("Constraint inside a chain keeps the islands"), A.BoneIslands().Num(), 2);
+		TestTrue(TEXT("Constraint goes to its island"), A.BoneIslands().Islands[0].Constraints == TArray<int32>{0});
+
+		A.AddRuntimeBoneConstraint(2, 7, 30.0f);
+		A.CallBuildBoneIslands(1);
+		TestEqual(TEXT("Constraint across chains joins them"), A.BoneIslands().Num(), 0);
+	}
+
+	for (const bool bSimd : {false, true})
+	{
+		FKawaiiPhysicsScopedSimdIntegration ScopedSimd(bSimd);
+
+		auto Run = [](const bool bParallel)
+		{
+			FKawaiiPhysicsScopedParallelIslands ScopedIslands(bParallel);
+			FKawaiiPhysicsTestAccessor A;
+			A.BuildTwoVerticalChains(6, 10.0f, 30.0f);
+			A.AddRuntimeBoneConstraint(1, 4, 30.0f);
+			A.Node.BoneConstraintIterationCountBeforeCollision = 1;
+			A.Node.BoneConstraintIterationCountAfterCollision = 1;
+			A.Bone(0).PoseLocation += FVector(5.0f, 0.0f, 0.0f);
+			A.CallBuildBoneCategories();
+			A.CallBuildBoneIslands(1);
+			for (int32 Frame = 0; Frame < 30; ++Frame)
+			{
+				A.StepFrameWithSimulateOnce(1.0f / 60.0f);
+			}
+
+			TArray<FVector> Locations;
+			for (int32 i = 0; i < A.Num(); ++i)
+			{
+				Locations.Add(A.Bone(i).Location);
+			}
+			return Locations;
+		};
+
+		const TArray<FVector> Sequential = Run(false);
+		const TArray<FVector> Parallel = Run(true);
+		for (int32 i = 0; i < Sequential.Num(); ++i)
+		{
+			TestTrue(FString::Printf(TEXT("Bone %d matches the sequential solve bit for bit (SIMD=%d)"), i, bSimd),
+			         Sequential[i] == Parallel[i]);
+		}
+	}
+	return true;
+}
+
+// ---------------------------------------------------------------------------
+//  BoneConstraint の彩色（FKawaiiPhysicsConstraintColors）と色ごとのバッチ解法
+//  Constraint 配列は元の並びのまま、同色の Constraint はボーンを共有せず、色の中は元の順序を保ち、
+//  バッチ解法は色順で逐次に解いた結果とビット一致すること。
+// ---------------------------------------------------------------------------
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKawaiiPhysicsBoneConstraintColoringTest,
+                                 "KawaiiPhysics.Simulation.BoneConstraintColoring",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FKawaiiPhysicsBoneConstraintColoringTest::RunTest(const FString& Parameters)
+{
+	// 梯子状（左右チェーンの同じ段を結ぶ）+ 1段飛ばしの Constraint。Length で元の順序を識別する
+	auto AddLadderConstraints = [](FKawaiiPhysicsTestAccessor& A, const int32 NumBonesPerChain)
+	{
+		int32 Order = 0;
+		for (int32 i = 1; i < NumBonesPerChain; ++i)
+		{
+			A.AddRuntimeBoneConstraint(i, NumBonesPerChain + i, 30.0f + 0.01f * Order++);
+			if (i + 2 < NumBonesPerChain)
+			{
+				A.AddRuntimeBoneConstraint(i, i + 2, 20.0f + 0.01f * Order++);
+				A.AddRuntimeBoneConstraint(NumBonesPerChain + i, NumBonesPerChain + i + 2, 20.0f + 0.01f * Order++);
+			}
+		}
+		// 端点が範囲外の Constraint も色分けで落ちないこと
+		A.AddRuntimeBoneConstraint(0, 1000, 5.0f);
+	};
+
+	{
+		constexpr int32 NumBonesPerChain = 10;
+		FKawaiiPhysicsTestAccessor A;
+		A.BuildTwoVerticalChains(NumBonesPerChain, 10.0f, 30.0f);
+		AddLadderConstraints(A, NumBonesPerChain);
+		TArray<FModifyBoneConstraint> Original = A.MergedBoneConstraints();
+		A.CallColorBoneConstraints();
+
+		const FKawaiiPhysicsConstraintColors& Colors = A.BoneConstraintColors();
+		const TArray<FModifyBoneConstraint>& Constraints = A.MergedBoneConstraints();
+		TestTrue(TEXT("Built for the constraint array"),
+		         Colors.IsBuiltFor(A.BoneConstraintGeneration(), Original.Num()));
+		TestEqual(TEXT("Colour offsets cover every constraint"), Colors.GetColorEnd(Colors.Num() - 1), Original.Num());
+		TestTrue(TEXT("More than one colour"), Colors.Num() > 1);
+		TestTrue(TEXT("Far fewer colours than constraints"), Colors.Num() * 4 <= Original.Num());
+
+		// 配列は元の並びのまま（逐次解法は従来どおり元の順で回る）
+		TestEqual(TEXT("Constraint count unchanged"), Constraints.Num(), Original.Num());
+		for (int32 i = 0; i < Original.Num(); ++i)
+		{
+			TestTrue(FString::Printf(TEXT("Constraint %d keeps its authoring slot"), i),
+			         Constraints[i].Length == Original[i].Length &&
+			         Constraints[i].ModifyBoneIndex1 == Original[i].ModifyBoneIndex1 &&
+			         Constraints[i].ModifyBoneIndex2 == Original[i].ModifyBoneIndex2);
+		}
+
+		TBitArray<> Visited(false, Original.Num());
+		for (int32 Color = 0; Color < Colors.Num(); ++Color)
+		{
+			TSet<int32> UsedBones;
+			int32 PrevOrder = INDEX_NONE;
+			for (int32 Slot = Colors.GetColorBegin(Color); Slot < Colors.GetColorEnd(Color); ++Slot)
+			{
+				const int32 ConstraintIndex = Colors.GetConstraintIndex(Slot);
+				if (!TestTrue(TEXT("Permutation index in range"), Constraints.IsValidIndex(ConstraintIndex)))
+				{
+					return false;
+				}
+				TestFalse(FString::Printf(TEXT("Constraint %d appears once in the permutation"), ConstraintIndex),
+				          Visited[ConstraintIndex]);
+				Visited[ConstraintIndex] = true;
+				TestTrue(FString::Printf(TEXT("Colour %d keeps the original order"), Color), ConstraintIndex > PrevOrder);
+				PrevOrder = ConstraintIndex;
+
+				const FModifyBoneConstraint& C = Constraints[ConstraintIndex];
+				if (C.ModifyBoneIndex2 >= A.Num())
+				{
+					continue;
+				}
+				TestFalse(FString::Printf(TEXT("Colour %d shares no bone (%d)"), Color, C.ModifyBoneIndex1),
+				          UsedBones.Contains(C.ModifyBoneIndex1));
+				TestFalse(FString::Printf(TEXT("Colour %d shares no bone (%d)"), Color, C.ModifyBoneIndex2),
+				          UsedBones.Contains(C.ModifyBoneIndex2));
+				UsedBones.Add(C.ModifyBoneIndex1);
+				UsedBones.Add(C.ModifyBoneIndex2);
+			}
+		}
+
+		// 同数のまま作り直した Constraint 配列（世代だけ進む）には古い色分けを使わない
+		++A.BoneConstraintGeneration();
+		TestFalse(TEXT("Stale after the constraint generation changes"),
+		          Colors.IsBuiltFor(A.BoneConstraintGeneration(), Original.Num()));
+	}
+
+	// 色ごとのバッチ解法（ParallelFor の有無とも）が、同じ色順で逐次に解いたスカラー解法とビット一致すること
+	for (const int32 ParallelMinColorSize : {0, 4})
+	{
+		const int32 PrevParallelMinColorSize =
+			CVarAnimNodeKawaiiPhysicsBoneConstraintParallelMinColorSize.GetValueOnAnyThread();
+		CVarAnimNodeKawaiiPhysicsBoneConstraintParallelMinColorSize->Set(ParallelMinColorSize, ECVF_SetByCode);
+
+		auto Run = [&AddLadderConstraints](const bool bColored)
+		{
+			FKawaiiPhysicsScopedColoredBoneConstraints ScopedColored(bColored);
+			constexpr int32 NumBonesPerChain = 12;
+			FKawaiiPhysicsTestAccessor A;
+			A.BuildTwoVerticalChains(NumBonesPerChain, 10.0f, 30.0f);
+			AddLadderConstraints(A, NumBonesPerChain);
+			A.CallColorBoneConstraints();
+			if (!bColored)
+			{
+				// 逐次経路は配列の並びで回るので、比較のために配列そのものを色順にしておく
+				A.ReorderBoneConstraintsByColor();
+			}
+			A.Node.BoneConstraintIterationCountBeforeCollision = 2;
+			A.Node.BoneConstraintIterationCountAfterCollision = 1;
+			A.Bone(0).PoseLocation += FVector(5.0f, 0.0f, 0.0f);
+			A.Bone(NumBonesPerChain).PoseLocation += FVector(-3.0f, 2.0f, 0.0f);
+			A.CallBuildBoneCategories();
+			for (int32 Frame = 0; Frame < 30; ++Frame)
+			{
+				A.StepFrameWithSimulateOnce(1.0f / 60.0f);
+			}
+
+			TArray<FVector> Locations;
+			for (int32 i = 0; i < A.Num(); ++i)
+			{
+				Locations.Add(A.Bone(i).Location);
+			}
+			return Locations;
+		};
+
+		const TArray<FVector> Sequential = Run(false);
+		const TArray<FVector> Colored = Run(true);
+		for (int32 i = 0; i < Sequential.Num(); ++i)
+		{
+			TestTrue(FString::Printf(TEXT("Bone %d matches the colour-ordered sequential solve bit for bit (ParallelMinColorSize=%d)"),
+			                         i, ParallelMinColorSize), Sequential[i] == Colored[i]);
+		}
+
+		CVarAnimNodeKawaiiPhysicsBoneConstraintParallelMinColorSize->Set(PrevParallelMinColorSize, ECVF_SetByCode);
+	}
+	return true;
+}
+
+// ---------------------------------------------------------------------------
+//  ステップ不変量のキャッシュ（UpdateRestPose / UpdateStiffnessFactors）
+//  長さ復元・角度制限・剛性がキャッシュから読む値が、従来ループ内で毎回求めていた値と一致すること。
+// ---------------------------------------------------------------------------
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKawaiiPhysicsStepInvariantCacheTest,
+                                 "KawaiiPhysics.Simulation.StepInvariantCache",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FKawaiiPhysicsStepInvariantCacheTest::RunTest(const FString& Parameters)
+{
+	FKawaiiPhysicsTestAccessor A;
+	A.BuildVerticalChain(4, 10.0f, FVector(3.0f, -2.0f, 50.0f), FVector(1.0f, 0.5f, -2.0f));
+	A.Bone(2).PoseLocation += FVector(1.5f, -4.0f, 0.25f);
+	A.Bone(3).PoseLocation = A.Bone(2).PoseLocation; // 長さ0（GetSafeNormal はゼロ）
+	for (int32 i = 0; i < A.Num(); ++i)
+	{
+		A.Bone(i).bSkipSimulate = (A.Bone(i).ParentIndex < 0);
+		A.Bone(i).PhysicsSettings.Stiffness = 0.1f * i;
+	}
+	A.CallBuildBoneCategories();
+
+	FKawaiiPhysicsSolverState& State = A.SolverState();
+	State.Gather(A.Node.ModifyBones);
+	State.UpdateRestPose(A.BoneCategories().Simulated);
+	constexpr float Exponent = 0.75f;
+	State.UpdateStiffnessFactors(A.BoneCategories().Simulated, Exponent);
+
+	for (const int32 i : A.BoneCategories().Simulated)
+	{
+		const FVector PoseVector = State.PoseLocation[i] - State.PoseLocation[State.ParentIndex[i]];
+		TestEqual(FString::Printf(TEXT("RestLength[%d]"), i), State.RestLength[i], static_cast<float>(PoseVector.Size()));
+		TestTrue(FString::Printf(TEXT("PoseDirection[%d]"), i), State.PoseDirection[i] == PoseVector.GetSafeNormal());
+		TestEqual(FString::Printf(TEXT("StiffnessFactor[%d]"), i), State.StiffnessFactor[i],
+		          1.0f - FMath::Pow(1.0f - State.Stiffness[i], Exponent));
+	}
+
+	// 方向を受け取る角度制限はポーズ位置を受け取る版と同じ結果
+	const FVector ParentLocation = State.PoseLocation[1];
+	const FQuat ParentPoseRotation = FQuat(FVector::UpVector, 0.3f);
+	FVector FromPose = ParentLocation + FVector(0.0f, 10.0f, 0.0f);
+	FVector FromCache = FromPose;
+	A.CallAngleLimit(FromPose, State.PoseLocation[2], ParentLocation, State.PoseLocation[1], ParentPoseRotation,
+	                 20.0f);
+	A.CallAngleLimitWithPoseDir(FromCache, ParentLocation, State.PoseDirection[2], ParentPoseRotation, 20.0f);
+	TestTrue(TEXT("Angle limit with cached pose direction matches"), FromCache == FromPose);
+	TestFalse(TEXT("Angle limit moved the bone"), FromPose.Equals(ParentLocation + FVector(0.0f, 10.0f, 0.0f)));
+	return true;
+}
+
+// ---------------------------------------------------------------------------
+//  サブステップのポーズ補間（InterpolateSubstepPose / NeedsSubstepPoseRotation）
+//  一括の位置補間が FMath::Lerp とビット一致し、回転は読む処理があるときだけ補間されること。
+//  どちらも SolverState（裏バッファ）上で補間し、出力済みの ModifyBones には触れないこと。
+// ---------------------------------------------------------------------------
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKawaiiPhysicsSubstepPoseInterpolationTest,
+                                 "KawaiiPhysics.Simulation.SubstepPoseInterpolation",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FKawaiiPhysicsSubstepPoseInterpolationTest::RunTest(const FString& Parameters)
+{
+	// 5ボーン = 15成分（4成分単位の端数も通す）
+	FKawaiiPhysicsTestAccessor A;
+	A.BuildVerticalChain(5, 10.0f, FVector(1.0e5f, -3.0f, 20.0f));
+	for (int32 i = 0; i < A.Num(); ++i)
+	{
+		FKawaiiPhysicsModifyBone& Bone = A.Bone(i);
+		Bone.bSkipSimulate = (Bone.ParentIndex < 0);
+		Bone.PrevPoseLocation = Bone.PoseLocation;
+		Bone.CurrentPoseLocation = Bone.PoseLocation + FVector(0.3f * i, -1.7f, 2.9f * i);
+		Bone.PrevPoseRotation = FQuat::Identity;
+		Bone.CurrentPoseRotation = FQuat(FVector::ForwardVector, 0.2f * i);
+		Bone.PoseRotation = Bone.CurrentPoseRotation;
+	}
+	A.CallBuildBoneCategories();
+	FKawaiiPhysicsSolverState& State = A.SolverState();
+	State.Gather(A.Node.ModifyBones);
+	State.GatherSubstepPoseTargets(A.Node.ModifyBones);
+
+	constexpr float Alpha = 0.37f;
+	A.CallInterpolateSubstepPose(Alpha, false, false);
+	for (int32 i = 0; i < A.Num(); ++i)
+	{
+		const FVector Expected = FMath::Lerp(A.Bone(i).PrevPoseLocation, A.Bone(i).CurrentPoseLocation, Alpha);
+		TestTrue(FString::Printf(TEXT("Lerped pose location %d is bit-identical"), i), State.PoseLocation[i] == Expected);
+		TestTrue(FString::Printf(TEXT("Rotation %d untouched when skipped"), i),
+		         State.PoseRotation[i] == A.Bone(i).CurrentPoseRotation);
+	}
+
+	A.CallInterpolateSubstepPose(Alpha, true, false);
+	const FQuat Slerped = State.PoseRotation[4];
+	TestTrue(TEXT("Slerp matches FQuat::Slerp"),
+	         Slerped == FQuat::Slerp(FQuat::Identity, A.Bone(4).CurrentPoseRotation, Alpha).GetNormalized());
+	A.CallInterpolateSubstepPose(Alpha, true, true);
+	TestTrue(TEXT("NLerp is normalized"), State.PoseRotation[4].IsNormalized());
+	TestTrue(TEXT("NLerp stays close to Slerp"), State.PoseRotation[4].AngularDistance(Slerped) < 0.01f);
+	for (int32 i = 0; i < A.Num(); ++i)
+	{
+		TestTrue(FString::Printf(TEXT("Published rotation %d is not written"), i),
+		         A.Bone(i).PoseRotation == A.Bone(i).CurrentPoseRotation);
+	}
+
+	State.RestoreCurrentPoseLocation();
+	TestTrue(TEXT("Restore brings back the current pose"), State.PoseLocation[3] == A.Bone(3).CurrentPoseLocation);
+	State.RestoreCurrentPoseRotation();
+	TestTrue(TEXT("Restore brings back the current rotation"),
+	         State.PoseRotation[4] == A.Bone(4).CurrentPoseRotation);
+
+	// 回転を読む処理の有無
+	TestFalse(TEXT("Plain chain does not read the rotation"), A.CallNeedsSubstepPoseRotation());
+	A.Node.PlanarConstraint = EPlanarConstraint::Y;
+	TestTrue(TEXT("Planar constraint reads the rotation"), A.CallNeedsSubstepPoseRotation());
+	A.Node.PlanarConstraint = EPlanarConstraint::None;
+	State.LimitAngle[2] = 30.0f;
+	TestTrue(TEXT("Angle limit reads the rotation"), A.CallNeedsSubstepPoseRotation());
+	return true;
+}
+
 // ---------------------------------------------------------------------------
 //  抽出した物理計算関数の検証（解析的）
 //  抽出した経路（速度寄与(wind)・legacy gravity・simple external force）を直接検証する。
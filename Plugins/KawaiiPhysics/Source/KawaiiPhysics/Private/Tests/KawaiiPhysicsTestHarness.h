@@ -8,6 +8,7 @@
 #include "AnimNode_KawaiiPhysics.h"
 #include "KawaiiPhysicsTypes.h"
 #include "KawaiiPhysicsCollisionLimits.h"
+#include "KawaiiPhysicsSimulationSubsystem.h"
 
 /**
  * 自動テスト用アクセサ
@@ -15,6 +16,7 @@
  * FAnimNode_KawaiiPhysics の friend として private/protected の sim 状態・物理計算・コリジョン関数へアクセスし、Output 無しで物理コアをヘッドレス実行する。
  *
  * StepOnce()/StepFrame() は SimulateOnce()/SimulateModifyBones() の Output 非依存部分を単純な縦チェーン用に複製する（数式は本番と同一関数を呼ぶので数式リグレッションを検出でき、複製は呼び出し順序のみ＝本番と二重管理。ダミー/ブリッジ/LOD/外力/world collision/BaseBoneSpace は非対応）。
+ * 本番同様、ステップは SolverState（SoA）上で進め、StepFrame 末尾で ModifyBones へ書き戻す。
  */
 struct FKawaiiPhysicsTestAccessor
 {
@@ -47,10 +49,7 @@ struct FKawaiiPhysicsTestAccessor
 			Bone.BoneLength = (i > 0) ? Spacing : 0.0f;
 			Node.ModifyBones.Add(Bone);
 		}
-		for (int32 i = 1; i < NumBones; ++i)
-		{
-			Node.ModifyBones[i - 1].ChildIndices.Add(i);
-		}
+		Node.BoneTopology.Build(Node.ModifyBones);
 	}
 
 	/**
@@ -78,11 +77,68 @@ struct FKawaiiPhysicsTestAccessor
 				Bone.BoneLength = (i > 0) ? Spacing : 0.0f;
 				Node.ModifyBones.Add(Bone);
 			}
-			for (int32 i = 1; i < NumBonesPerChain; ++i)
+		}
+		Node.BoneTopology.Build(Node.ModifyBones);
+	}
+
+	/**
+	 * 実ボーン NumRealBones 本の縦チェーンの各区間へ、InsertInterBoneDummyBonesCore と同じ並びで inter-bone dummy を
+	 * SubdivisionCount 本ずつ挿入する（実親 → dummy... → 実子の順に ParentIndex を繋ぐ）。
+	 */
+	void BuildSubdividedVerticalChain(int32 NumRealBones, float Spacing, int32 SubdivisionCount,
+	                                  const FVector& Origin = FVector::ZeroVector)
+	{
+		Node.ModifyBones.Reset();
+		Node.BoneSubdivisionCount = SubdivisionCount;
+		int32 PrevRealIndex = INDEX_NONE;
+		for (int32 i = 0; i < NumRealBones; ++i)
+		{
+			const FVector Loc = Origin + FVector(0.0f, 0.0f, -Spacing * i);
+			int32 ParentIndex = PrevRealIndex;
+			const int32 FirstDummyIndex = Node.ModifyBones.Num();
+			if (PrevRealIndex != INDEX_NONE)
 			{
-				Node.ModifyBones[BaseIndex + i - 1].ChildIndices.Add(BaseIndex + i);
+				const FVector ParentLoc = Node.ModifyBones[PrevRealIndex].Location;
+				for (int32 j = 0; j < SubdivisionCount; ++j)
+				{
+					const float Alpha = static_cast<float>(j + 1) / (SubdivisionCount + 1);
+					FKawaiiPhysicsModifyBone Dummy;
+					Dummy.Index = Node.ModifyBones.Num();
+					Dummy.ParentIndex = ParentIndex;
+					Dummy.bDummy = true;
+					Dummy.bInterBoneDummy = true;
+					Dummy.InterBoneAlpha = Alpha;
+					Dummy.InterBoneRealParentIndex = PrevRealIndex;
+					const FVector DummyLoc = FMath::Lerp(ParentLoc, Loc, Alpha);
+					Dummy.PoseLocation = DummyLoc;
+					Dummy.Location = DummyLoc;
+					Dummy.PrevLocation = DummyLoc;
+					Dummy.PrevPoseLocation = DummyLoc;
+					Dummy.CurrentPoseLocation = DummyLoc;
+					Dummy.BoneLength = Spacing / (SubdivisionCount + 1);
+					Dummy.LengthFromRoot = Spacing * (i - 1 + Alpha);
+					ParentIndex = Node.ModifyBones.Add(Dummy);
+				}
 			}
+
+			FKawaiiPhysicsModifyBone Bone;
+			Bone.Index = Node.ModifyBones.Num();
+			Bone.ParentIndex = ParentIndex;
+			Bone.PoseLocation = Loc;
+			Bone.Location = Loc;
+			Bone.PrevLocation = Loc;
+			Bone.PrevPoseLocation = Loc;
+			Bone.CurrentPoseLocation = Loc;
+			Bone.BoneLength = (ParentIndex != INDEX_NONE) ? Spacing / (SubdivisionCount + 1) : 0.0f;
+			Bone.LengthFromRoot = Spacing * i;
+			const int32 RealIndex = Node.ModifyBones.Add(Bone);
+			for (int32 DummyIndex = FirstDummyIndex; DummyIndex < RealIndex; ++DummyIndex)
+			{
+				Node.ModifyBones[DummyIndex].InterBoneRealChildIndex = RealIndex;
+			}
+			PrevRealIndex = RealIndex;
 		}
+		Node.BoneTopology.Build(Node.ModifyBones);
 	}
 
 	/**
@@ -137,10 +193,7 @@ struct FKawaiiPhysicsTestAccessor
 		AddBone(4, 3, FVector(14.0f, 0.0f, 0.0f), 14.0f, 2.0f, true, false, 2);
 		AddBone(5, 0, FVector(0.0f, 4.0f, 0.0f), 4.0f, 4.0f, true, false);
 
-		Node.ModifyBones[0].ChildIndices = {1, 5};
-		Node.ModifyBones[1].ChildIndices = {2};
-		Node.ModifyBones[2].ChildIndices = {3};
-		Node.ModifyBones[3].ChildIndices = {4};
+		Node.BoneTopology.Build(Node.ModifyBones);
 	}
 
 	/** 全ボーンに同一の PhysicsSettings を適用 */
@@ -235,6 +288,8 @@ struct FKawaiiPhysicsTestAccessor
 			{
 				Node.DeltaTimeOld = 1.0f / Node.GetEffectiveTargetFramerate();
 			}
+			Node.SolverState.UpdateRestPose(Node.BoneCategories.Simulated);
+			UpdateStepInvariants();
 			StepOnce();
 			Node.DeltaTimeOld = FrameDt;
 		}
@@ -249,34 +304,44 @@ struct FKawaiiPhysicsTestAccessor
 			const float MoveFrac = FixedDt / RawElapsed;
 			const FVector FullSkelCompMove = Node.SkelCompMoveVector;
 			const FQuat FullSkelCompRot = Node.SkelCompMoveRotation;
+			// 既定設定（SlerpWhenUsed）と同じ判定
+			const bool bInterpolateRotation = Node.NeedsSubstepPoseRotation();
+			Node.SolverState.GatherSubstepPoseTargets(Node.ModifyBones);
 
 			Node.bInSubstep = true;
 			Node.StepDeltaTime = FixedDt;
 			Node.DeltaTimeOld = FixedDt;
+			Node.SkelCompMoveVector = FullSkelCompMove * MoveFrac;
+			Node.SkelCompMoveRotation = FQuat::Slerp(FQuat::Identity, FullSkelCompRot, MoveFrac).GetNormalized();
+			UpdateStepInvariants();
 			for (int32 SubstepIndex = 0; SubstepIndex < NumSteps; ++SubstepIndex)
 			{
 				const float SubstepAlpha = static_cast<float>(SubstepIndex + 1) / static_cast<float>(NumSteps);
-				for (FKawaiiPhysicsModifyBone& Bone : Node.ModifyBones)
+				if (SubstepIndex == NumSteps - 1)
 				{
-					Bone.PoseLocation = FMath::Lerp(Bone.PrevPoseLocation, Bone.CurrentPoseLocation, SubstepAlpha);
-					Bone.PoseRotation =
-						FQuat::Slerp(Bone.PrevPoseRotation, Bone.CurrentPoseRotation, SubstepAlpha).GetNormalized();
+					Node.CaptureOutputInterpolationFrom(static_cast<float>(SubstepIndex) / static_cast<float>(NumSteps));
 				}
-				Node.SkelCompMoveVector = FullSkelCompMove * MoveFrac;
-				Node.SkelCompMoveRotation = FQuat::Slerp(FQuat::Identity, FullSkelCompRot, MoveFrac).GetNormalized();
+				Node.InterpolateSubstepPose(SubstepAlpha, bInterpolateRotation, false);
+				Node.SolverState.UpdateRestPose(Node.BoneCategories.Simulated);
 				StepOnce();
 			}
 			Node.bInSubstep = false;
+			if (NumSteps > 0)
+			{
+				Node.CaptureOutputInterpolationTo();
+			}
 			Node.SkelCompMoveVector = FullSkelCompMove;
 			Node.SkelCompMoveRotation = FullSkelCompRot;
 
-			for (FKawaiiPhysicsModifyBone& Bone : Node.ModifyBones)
+			Node.SolverState.RestoreCurrentPoseLocation();
+			if (bInterpolateRotation)
 			{
-				Bone.PoseLocation = Bone.CurrentPoseLocation;
-				Bone.PoseRotation = Bone.CurrentPoseRotation;
+				Node.SolverState.RestoreCurrentPoseRotation();
 			}
 		}
 
+		Node.SolverState.Scatter(Node.ModifyBones);
+
 		for (FKawaiiPhysicsModifyBone& Bone : Node.ModifyBones)
 		{
 			Bone.PrevPoseLocation = Bone.CurrentPoseLocation;
@@ -284,6 +349,89 @@ struct FKawaiiPhysicsTestAccessor
 		}
 	}
 
+	/**
+	 * legacy（サブステップ無し）の1フレームを、複製の StepOnce ではなく本番の SimulateOnce で進める。
+	 * Output / Scene が無いので、フック・外力・world collision を使わない構成に限る。
+	 */
+	void StepFrameWithSimulateOnce(float FrameDt)
+	{
+		Node.DeltaTime = FrameDt;
+		Node.FrameDeltaTime = FrameDt;
+		PrepareFrame();
+
+		Node.bInSubstep = false;
+		if (Node.DeltaTimeOld <= 0.0f)
+		{
+			Node.DeltaTimeOld = 1.0f / Node.GetEffectiveTargetFramerate();
+		}
+		Node.SolverState.UpdateRestPose(Node.BoneCategories.Simulated);
+		UpdateStepInvariants();
+		Node.SimulateOnce(nullptr, FTransform::Identity, nullptr, nullptr);
+		Node.DeltaTimeOld = FrameDt;
+
+		Node.SolverState.Scatter(Node.ModifyBones);
+		for (FKawaiiPhysicsModifyBone& Bone : Node.ModifyBones)
+		{
+			Bone.PrevPoseLocation = Bone.CurrentPoseLocation;
+			Bone.PrevPoseRotation = Bone.CurrentPoseRotation;
+		}
+	}
+
+	/**
+	 * StepFrameInline と同じフレームを本番の順でパイプライン実行に回す（PreUpdate で前フレームのタスクを取り込み、
+	 * Update で DeltaTime を設定し、評価で入力を確定して最後にタスクを起動）。予約したら true。
+	 * 結果は次の呼び出しの PreUpdate か CompletePipelinedSimulation で ModifyBones に入る。
+	 * ボーン分類は本番どおり BoneRef から作るので、実ボーンの BoneRef.BoneIndex は呼び出し側で埋めておく。
+	 */
+	bool StepFramePipelined(FComponentSpacePoseContext& Output, float FrameDt)
+	{
+		Node.PreUpdate(nullptr);
+		Node.DeltaTime = FrameDt;
+		if (Node.DeltaTimeOld <= 0.0f)
+		{
+			Node.DeltaTimeOld = 1.0f / Node.GetEffectiveTargetFramerate();
+		}
+		Node.CompletePipelinedSimulation();
+		const bool bScheduled = Node.TryPreparePipelinedSimulation(Output);
+		Node.LaunchPipelinedSimulation();
+		return bScheduled;
+	}
+	void CallPreUpdate() { Node.PreUpdate(nullptr); }
+	void CallCompletePipelinedSimulation() { Node.CompletePipelinedSimulation(); }
+	bool PipelinedSimulationInFlight() const { return Node.bPipelinedSimulationInFlight; }
+	bool PipelinedSimulationTaskValid() const { return Node.PipelinedSimulationTask.IsValid(); }
+
+	/**
+	 * 本番の SimulateModifyBones（Prepare → Step → Finish）で1フレーム進める。Output は SkelComp を持たない空のプロキシでよい。
+	 * ボーン分類は本番どおり BoneRef から作るので、実ボーンの BoneRef.BoneIndex は呼び出し側で埋めておく。
+	 */
+	void StepFrameInline(FComponentSpacePoseContext& Output, float FrameDt)
+	{
+		Node.DeltaTime = FrameDt;
+		if (Node.DeltaTimeOld <= 0.0f)
+		{
+			Node.DeltaTimeOld = 1.0f / Node.GetEffectiveTargetFramerate();
+		}
+		Node.SimulateModifyBones(Output, FTransform::Identity);
+	}
+
+	/**
+	 * StepFrameInline と同じフレームを評価と同じ手順でバッチ実行に回す（前回の保留を済ませてから入力を確定し、Subsystem に登録）。
+	 * Subsystem 自身を所有者にするので、RunPendingSimulations で実行される。登録したら true。
+	 */
+	bool StepFrameBatched(FComponentSpacePoseContext& Output, float FrameDt, UKawaiiPhysicsSimulationSubsystem* Subsystem)
+	{
+		Node.RunBatchedSimulation();
+		Node.DeltaTime = FrameDt;
+		if (Node.DeltaTimeOld <= 0.0f)
+		{
+			Node.DeltaTimeOld = 1.0f / Node.GetEffectiveTargetFramerate();
+		}
+		Node.CachedSimulationSubsystem = Subsystem;
+		Node.CachedSimulationOwner = Subsystem;
+		return Node.TryEnqueueBatchedSimulation(Output);
+	}
+
 	/** 固定フレーム dt で N フレーム進める */
 	void StepFrames(int32 NumFrames, float FrameDt)
 	{
@@ -333,10 +481,129 @@ struct FKawaiiPhysicsTestAccessor
 		}
 		Node.AdjustByPlanerCollision(Bone, Limits);
 	}
+	/** ノードの limit 配列をコンパイルしてバッファ経由で押し出す（SimulateOnce と同じ経路） */
+	void CallCompiledCollision(FKawaiiPhysicsModifyBone& Bone)
+	{
+		Node.PrepareCollisionShapeCaches();
+		Node.AdjustByColliderBuffer(Bone.Location, Bone.PrevLocation, Bone.PhysicsSettings.Radius,
+		                            Node.CompiledColliders);
+		Node.AdjustByColliderBuffer(Bone.Location, Bone.PrevLocation, Bone.PhysicsSettings.Radius,
+		                            Node.CompiledSharedColliders);
+	}
+	TArray<FCapsuleLimit>& SharedCapsuleLimits() { return Node.SharedCapsuleLimits; }
+	/** limit 配列のコンパイルだけを行う（ナローフェーズ経路もここで CVar から決まる） */
+	void CompileColliders()
+	{
+		Node.PrepareCollisionShapeCaches();
+	}
+	/** コンパイル済みバッファで押し出す（再コンパイルしない。ベンチマーク用） */
+	void CallCompiledCollisionNoCompile(FVector& Location, const FVector& PrevLocation, const float Radius) const
+	{
+		Node.AdjustByColliderBuffer(Location, PrevLocation, Radius, Node.CompiledColliders);
+	}
+	/** コンパイル済みバッファで BoneIndex のボーンとして押し出す（関連マスクを引く。再コンパイルしない） */
+	void CallCompiledCollisionForBone(FVector& Location, const float Radius, const int32 BoneIndex) const
+	{
+		Node.AdjustByColliderBuffer(Location, Location, Radius, Node.CompiledColliders, BoneIndex);
+	}
+	/** 現在の ModifyBones で区間コリジョン（AdjustBoneSegmentsByCollision）だけを1回解いて書き戻す */
+	void CallBoneSegmentCollision()
+	{
+		PrepareFrame();
+		Node.PrepareCollisionShapeCaches();
+		Node.AdjustBoneSegmentsByCollision(Node.BoneCategories.Simulated);
+		Node.SolverState.Scatter(Node.ModifyBones);
+	}
+	/** 現在の ModifyBones で BoneConstraint の辺コリジョン（AdjustBoneConstraintEdgesByCollision）だけを1回解いて書き戻す */
+	void CallBoneConstraintEdgeCollision()
+	{
+		PrepareFrame();
+		Node.PrepareCollisionShapeCaches();
+		Node.AdjustBoneConstraintEdgesByCollision(nullptr);
+		Node.SolverState.Scatter(Node.ModifyBones);
+	}
+	/** MergedBoneConstraints に沿って bridge dummy を挿入する（InitBoneConstraints の末尾と同じ） */
+	void CallInsertBridgeDummiesForConstraints()
+	{
+		Node.InsertBridgeDummiesForConstraints();
+	}
+	/** 自ノードの limit の関連マスクを作る（RefSkeleton でボーン名と参照ポーズを解決） */
+	void CallBuildColliderRelevanceMasks(const FReferenceSkeleton& RefSkeleton)
+	{
+		Node.BuildColliderRelevanceMasks(RefSkeleton);
+	}
+	/** limit の関連マスクで BoneIndex のビットが立っているか（マスクを持たない limit は全ボーン） */
+	bool IsLimitRelevantToBone(const FCollisionLimitBase& Limit, const int32 BoneIndex) const
+	{
+		if (Limit.CachedRelevanceMask == INDEX_NONE)
+		{
+			return true;
+		}
+		const uint32 Word = Node.ColliderRelevanceMasks[Limit.CachedRelevanceMask + BoneIndex / 32];
+		return (Word & (1u << (BoneIndex % 32))) != 0;
+	}
+	/** 非同期ワールドコリジョンの接触平面（シミュレーション空間）を直接与える */
+	void SetAsyncWorldContactPlanes(const TArray<FPlane>& Planes) { Node.AsyncWorldContactPlanes = Planes; }
+	void CallAsyncWorldContact(FVector& Location, int32 BoneIndex) const
+	{
+		Node.AdjustByAsyncWorldContact(Location, BoneIndex);
+	}
+	bool CallIsIgnoredWorldCollisionBone(FName BoneName) { return Node.IsIgnoredWorldCollisionBone(BoneName); }
+	const TArray<FPlane>& AsyncWorldContactPlanes() const { return Node.AsyncWorldContactPlanes; }
+	TSharedPtr<FKawaiiPhysicsAsyncWorldCollision, ESPMode::ThreadSafe>& AsyncWorldCollision()
+	{
+		return Node.AsyncWorldCollision;
+	}
+	void CallUpdateAsyncWorldCollision(FComponentSpacePoseContext& Output)
+	{
+		Node.UpdateAsyncWorldCollision(Output, nullptr);
+	}
+	/** Broadphase で見つかったボディ1つ分の形状変換（ワールドトランスフォームはスケール込み） */
+	void CallAddWorldCollisionAggGeomShapes(FComponentSpacePoseContext& Output, const FKAggregateGeom& AggGeom,
+	                                        const FTransform& BodyTransform)
+	{
+		Node.AddWorldCollisionAggGeomShapes(Output, AggGeom, BodyTransform);
+	}
+	const TArray<FSphericalLimit>& WorldSphericalLimits() const { return Node.WorldSphericalLimits; }
+	const TArray<FCapsuleLimit>& WorldCapsuleLimits() const { return Node.WorldCapsuleLimits; }
+	const TArray<FBoxLimit>& WorldBoxLimits() const { return Node.WorldBoxLimits; }
+
+	// ---- FKawaiiPhysicsAsyncWorldCollision（World 無しで発行と完了コールバックを再現する） ----
+	/** IssueStagedSweeps の発行前半（バッチの切り替え）だけを行う */
+	static bool BeginAsyncSweepBatch(FKawaiiPhysicsAsyncWorldCollision& AsyncWorldCollision)
+	{
+		FScopeLock ScopeLock(&AsyncWorldCollision.Lock);
+		return AsyncWorldCollision.BeginIssuedBatch();
+	}
+	static uint32 AsyncSweepBatchSerial(const FKawaiiPhysicsAsyncWorldCollision& AsyncWorldCollision)
+	{
+		FScopeLock ScopeLock(&AsyncWorldCollision.Lock);
+		return AsyncWorldCollision.BatchSerial;
+	}
+	/** AsyncSweepByChannel の完了コールバックを、バッチ BatchSerial の SweepIndex 本目として呼ぶ */
+	static void CompleteAsyncSweep(FKawaiiPhysicsAsyncWorldCollision& AsyncWorldCollision, uint32 BatchSerial,
+	                               int32 SweepIndex, const TArray<FHitResult>& Hits)
+	{
+		FTraceDatum Datum;
+		Datum.UserData = static_cast<uint32>(SweepIndex);
+		Datum.OutHits = Hits;
+		AsyncWorldCollision.OnSweepCompleted(FTraceHandle(), Datum, BatchSerial);
+	}
 	void CallAngleLimit(FKawaiiPhysicsModifyBone& Bone, const FKawaiiPhysicsModifyBone& ParentBone)
 	{
 		Node.AdjustByAngleLimit(Bone, ParentBone);
 	}
+	void CallAngleLimit(FVector& Location, const FVector& PoseLocation, const FVector& ParentLocation,
+	                    const FVector& ParentPoseLocation, const FQuat& ParentPoseRotation, float LimitAngle)
+	{
+		Node.AdjustByAngleLimit(Location, PoseLocation, ParentLocation, ParentPoseLocation, ParentPoseRotation,
+		                        LimitAngle);
+	}
+	void CallAngleLimitWithPoseDir(FVector& Location, const FVector& ParentLocation, const FVector& PoseDir,
+	                               const FQuat& ParentPoseRotation, float LimitAngle)
+	{
+		Node.AdjustByAngleLimit(Location, ParentLocation, PoseDir, ParentPoseRotation, LimitAngle);
+	}
 
 	// 物理計算関数の直接呼び出し（抽出した処理を解析的に検証する用）
 	FVector CallComputeVerletStepVelocity(FKawaiiPhysicsModifyBone& Bone, const FVector& WindVelocity)
@@ -361,7 +628,9 @@ struct FKawaiiPhysicsTestAccessor
 	}
 	void CallBoneConstraints()
 	{
-		Node.AdjustByBoneConstraints();
+		Node.SolverState.Gather(Node.ModifyBones);
+		Node.AdjustByBoneConstraints(Node.SolverState.Location);
+		Node.SolverState.Scatter(Node.ModifyBones);
 	}
 	void CallUpdatePhysicsSettings()
 	{
@@ -454,6 +723,83 @@ struct FKawaiiPhysicsTestAccessor
 	// ========================================================================
 
 	int32 Num() const { return Node.ModifyBones.Num(); }
+	FKawaiiPhysicsSolverState& SolverState() { return Node.SolverState; }
+	const FKawaiiPhysicsColliderBuffer& CompiledColliders() const { return Node.CompiledColliders; }
+	const FKawaiiPhysicsColliderBuffer& CompiledSharedColliders() const { return Node.CompiledSharedColliders; }
+	FBox CallComputeCollisionCullBounds() const { return Node.ComputeCollisionCullBounds(); }
+	const FKawaiiPhysicsBoneCategories& BoneCategories() const { return Node.BoneCategories; }
+	uint32& BoneLayoutGeneration() { return Node.BoneLayoutGeneration; }
+	void CallBuildBoneCategories() { Node.BuildBoneCategories(); }
+	FKawaiiPhysicsBoneTopology& BoneTopology() { return Node.BoneTopology; }
+	bool CallNeedsSubstepPoseRotation() const { return Node.NeedsSubstepPoseRotation(); }
+	void CallInterpolateSubstepPose(float SubstepAlpha, bool bInterpolateRotation, bool bUseNLerp)
+	{
+		Node.InterpolateSubstepPose(SubstepAlpha, bInterpolateRotation, bUseNLerp);
+	}
+	void CallBuildBoneTopology() { Node.BoneTopology.Build(Node.ModifyBones); }
+	bool& BatchedSimulationPending() { return Node.bBatchedSimulationPending; }
+	bool CallCanBatchSimulation() const { return Node.CanBatchSimulation(nullptr); }
+	void CallRunBatchedSimulation() { Node.RunBatchedSimulation(); }
+	EKawaiiPhysicsBudgetTier& SimulationBudgetTier() { return Node.SimulationBudgetTier; }
+	bool CallShouldSimulateUnderBudget() { return Node.ShouldSimulateUnderBudget(); }
+	bool CallUpdateSleepState(bool bHasActiveSettingsOverride = false)
+	{
+		return Node.UpdateSleepState(bHasActiveSettingsOverride);
+	}
+	bool IsSleeping() const { return Node.bSleeping; }
+	const TArray<float>& IslandKineticEnergy() const { return Node.IslandKineticEnergy; }
+	static int32 CallSelectLODTier(const TArray<FKawaiiPhysicsLODTier>& Tiers, EKawaiiPhysicsLODMetric Metric,
+	                               float MetricValue, int32 CurrentTier)
+	{
+		return FAnimNode_KawaiiPhysics::SelectLODTier(Tiers, Metric, MetricValue, CurrentTier);
+	}
+	/** Subsystem が書き込む画面サイズとカメラ距離を差し替える */
+	void SetLODViewMetrics(float ScreenSize, float ViewDistance)
+	{
+		Node.LODScreenSize = ScreenSize;
+		Node.LODViewDistance = ViewDistance;
+	}
+	void CallUpdateLODTier() { Node.UpdateLODTier(); }
+	int32 ActiveLODTier() const { return Node.ActiveLODTier; }
+	float LODTierBlendAlpha() const { return Node.LODTierBlendAlpha; }
+	bool CallBeginLODTierBlend() { return Node.BeginLODTierBlend(); }
+	void CallEndLODTierBlend() { Node.EndLODTierBlend(); }
+	int32 GetEffectiveBoneConstraintIterationCount(bool bAfterCollision) const
+	{
+		return Node.GetEffectiveBoneConstraintIterationCount(bAfterCollision);
+	}
+	int32 GetEffectiveMaxSubsteps(int32 ProjectMaxSubsteps) const { return Node.GetEffectiveMaxSubsteps(ProjectMaxSubsteps); }
+	bool IsWorldCollisionActive() const { return Node.IsWorldCollisionActive(); }
+	float& SubstepAccumulator() { return Node.SubstepAccumulator; }
+	float GetSubstepPhaseOffset() const { return Node.GetSubstepPhaseOffset(); }
+	bool IsOutputInterpolationValid() const { return Node.bOutputInterpolationValid; }
+	bool CallBeginOutputInterpolation() { return Node.BeginOutputInterpolation(); }
+	void CallEndOutputInterpolation() { Node.EndOutputInterpolation(); }
+	const FKawaiiPhysicsBoneIslands& BoneIslands() const { return Node.BoneIslands; }
+	/** 現在の ModifyBones / MergedBoneConstraints / BoneCategories からアイランドを作る */
+	void CallBuildBoneIslands(int32 MinBonesPerIsland)
+	{
+		Node.BoneIslands.Build(Node.ModifyBones, Node.MergedBoneConstraints, Node.BoneCategories, MinBonesPerIsland);
+	}
+	const FKawaiiPhysicsConstraintColors& BoneConstraintColors() const { return Node.BoneConstraintColors; }
+	const TArray<FModifyBoneConstraint>& MergedBoneConstraints() const { return Node.MergedBoneConstraints; }
+	/** InitBoneConstraints と同じく世代を進めて MergedBoneConstraints を彩色する（配列の並びは変えない） */
+	void CallColorBoneConstraints()
+	{
+		++Node.BoneConstraintGeneration;
+		Node.BoneConstraintColors.Build(Node.MergedBoneConstraints, Node.ModifyBones.Num(), Node.BoneConstraintGeneration);
+	}
+	uint32& BoneConstraintGeneration() { return Node.BoneConstraintGeneration; }
+	/** MergedBoneConstraints を彩色の色順へ並べ替える（バッチ解法と同じ順で逐次に解く比較用） */
+	void ReorderBoneConstraintsByColor()
+	{
+		TArray<FModifyBoneConstraint> Reordered;
+		for (int32 Slot = 0; Slot < Node.MergedBoneConstraints.Num(); ++Slot)
+		{
+			Reordered.Add(Node.MergedBoneConstraints[Node.BoneConstraintColors.GetConstraintIndex(Slot)]);
+		}
+		Node.MergedBoneConstraints = MoveTemp(Reordered);
+	}
 	FKawaiiPhysicsModifyBone& Bone(int32 Index) { return Node.ModifyBones[Index]; }
 	const FKawaiiPhysicsModifyBone& Bone(int32 Index) const { return Node.ModifyBones[Index]; }
 	FVector TipLocation() const { return Node.ModifyBones.Last().Location; }
@@ -505,6 +851,18 @@ private:
 			}
 		}
 		Node.bSubstepPoseInitialized = true;
+		// フィクスチャは ModifyBones を直接組み替えるため、分類リストは毎フレーム作り直す
+		Node.BoneCategories.Build(Node.ModifyBones, Node.BoneLayoutGeneration);
+		Node.SolverState.Gather(Node.ModifyBones);
+	}
+
+	/**
+	 * UpdateStepInvariants の Output 非依存部分（剛性係数）。BaseBoneSpace は非対応なので world 移動量の変換は不要。
+	 */
+	void UpdateStepInvariants()
+	{
+		Node.SolverState.UpdateStiffnessFactors(Node.BoneCategories.Simulated,
+		                                        Node.GetEffectiveTargetFramerate() * Node.GetStepDeltaTime());
 	}
 
 	/**
@@ -513,33 +871,47 @@ private:
 	 */
 	void StepOnce()
 	{
-		// root bone の kinematic follow（SimulateOnce 274-281）
-		for (FKawaiiPhysicsModifyBone& Bone : Node.ModifyBones)
+		FKawaiiPhysicsSolverState& State = Node.SolverState;
+		const int32 NumBones = State.Num();
+
+		// root bone の kinematic follow（単純チェーンでは ParentIndex<0 を root とする）
+		for (int32 i = 0; i < NumBones; ++i)
 		{
-			if (Bone.ParentIndex < 0)
+			if (State.ParentIndex[i] < 0)
 			{
-				Bone.PrevLocation = Bone.Location;
-				Bone.Location = Bone.PoseLocation;
+				State.PrevLocation[i] = State.Location[i];
+				State.Location[i] = State.PoseLocation[i];
 			}
 		}
 
-		const float Exponent = Node.GetEffectiveTargetFramerate() * Node.GetStepDeltaTime();
-
-		// 積分（Simulate() の純粋部分。wind/外力なし）
-		for (FKawaiiPhysicsModifyBone& Bone : Node.ModifyBones)
+		// 積分（SimulateOnce のフック無し高速パス。wind/外力なし）
+		// 本番と同じく cvar で SIMD カーネル / スカラー経路を切り替える（BaseBoneSpace は非対応なので条件は cvar のみ）
+		if (CVarAnimNodeKawaiiPhysicsSimdIntegration.GetValueOnAnyThread())
 		{
-			if (Bone.bSkipSimulate)
+			Node.IntegrateSolverStateSimd();
+		}
+		else
+		{
+			for (const int32 i : Node.BoneCategories.GetIntegrated(Node.bBoneSubdivisionCollisionOnly))
 			{
-				continue;
+				FVector& Location = State.Location[i];
+				FVector& PrevLocation = State.PrevLocation[i];
+				const int32 ParentIndex = State.ParentIndex[i];
+				const FVector Velocity =
+					Node.ComputeVerletStepVelocity(Location, PrevLocation, State.Damping[i], FVector::ZeroVector);
+				Node.IntegrateVerletStepPosition(Location, Velocity);
+				Node.ApplySimpleExternalForce(Location);
+				Node.ApplyWorldMoveFollowNonBaseBone(Location, PrevLocation, State.WorldDampingLocation[i],
+				                                     State.WorldDampingRotation[i]);
+				Node.ApplyStiffnessPull(Location, State.PoseLocation[i], State.Location[ParentIndex],
+				                        State.PoseLocation[ParentIndex], State.StiffnessFactor[i]);
 			}
-			const FVector Velocity = Node.ComputeVerletStepVelocity(Bone, FVector::ZeroVector);
-			Node.IntegrateVerletStepPosition(Bone, Velocity);
-			Node.ApplySimpleExternalForce(Bone);
-			Node.ApplyWorldMoveFollowNonBaseBone(Bone);
-			Node.ApplyStiffnessPull(Bone, Node.ModifyBones[Bone.ParentIndex], Exponent);
 		}
 
-		// BoneConstraint before collision（SimulateOnce 397-403）
+		// 本番 SimulateOnce と同様、形状キャッシュはステップ毎に再計算
+		Node.PrepareCollisionShapeCaches();
+
+		// BoneConstraint before collision
 		if (Node.BoneConstraintIterationCountBeforeCollision > 0)
 		{
 			for (FModifyBoneConstraint& BoneConstraint : Node.MergedBoneConstraints)
@@ -548,33 +920,28 @@ private:
 			}
 			for (int32 i = 0; i < Node.BoneConstraintIterationCountBeforeCollision; ++i)
 			{
-				Node.AdjustByBoneConstraints();
+				Node.AdjustByBoneConstraints(State.Location);
 			}
 		}
 
-		// 本番 SimulateOnce と同様、形状キャッシュはステップ毎に再計算
-		Node.PrepareCollisionShapeCaches();
-
-		// コリジョン（SimulateOnce 413-445、AnimNode 側 limits のみ）
-		for (FKawaiiPhysicsModifyBone& Bone : Node.ModifyBones)
+		// コリジョン（AnimNode 側 limits のみ。ハーネスは bridge dummy 非対応なので Simulated のみ）
+		for (const int32 i : Node.BoneCategories.Simulated)
 		{
-			if (Bone.bSkipSimulate)
-			{
-				continue;
-			}
-			Node.AdjustBySphereCollision(Bone, Node.SphericalLimits);
-			Node.AdjustBySphereCollision(Bone, Node.SphericalLimitsData);
-			Node.AdjustByCapsuleCollision(Bone, Node.CapsuleLimits);
-			Node.AdjustByCapsuleCollision(Bone, Node.CapsuleLimitsData);
-			Node.AdjustByTaperedCapsuleCollision(Bone, Node.TaperedCapsuleLimits);
-			Node.AdjustByTaperedCapsuleCollision(Bone, Node.TaperedCapsuleLimitsData);
-			Node.AdjustByBoxCollision(Bone, Node.BoxLimits);
-			Node.AdjustByBoxCollision(Bone, Node.BoxLimitsData);
-			Node.AdjustByPlanerCollision(Bone, Node.PlanarLimits);
-			Node.AdjustByPlanerCollision(Bone, Node.PlanarLimitsData);
-		}
-
-		// BoneConstraint after collision（SimulateOnce 516-522）
+			FVector& Location = State.Location[i];
+			const FVector& PrevLocation = State.PrevLocation[i];
+			const float Radius = State.Radius[i];
+			Node.AdjustByColliderBuffer(Location, PrevLocation, Radius, Node.CompiledColliders, i);
+		}
+		if (Node.bBoneSegmentCollision)
+		{
+			Node.AdjustBoneSegmentsByCollision(Node.BoneCategories.Simulated);
+		}
+		if (Node.bBoneConstraintEdgeCollision)
+		{
+			Node.AdjustBoneConstraintEdgesByCollision(nullptr);
+		}
+
+		// BoneConstraint after collision
 		if (Node.BoneConstraintIterationCountAfterCollision > 0)
 		{
 			for (FModifyBoneConstraint& BoneConstraint : Node.MergedBoneConstraints)
@@ -583,24 +950,141 @@ private:
 			}
 			for (int32 i = 0; i < Node.BoneConstraintIterationCountAfterCollision; ++i)
 			{
-				Node.AdjustByBoneConstraints();
+				Node.AdjustByBoneConstraints(State.Location);
 			}
 		}
 
-		// 角度制限 + 平面拘束 + ボーン長復元（SimulateOnce 528-555）
-		for (FKawaiiPhysicsModifyBone& Bone : Node.ModifyBones)
+		// 角度制限 + 平面拘束 + ボーン長復元
+		for (const int32 i : Node.BoneCategories.Simulated)
 		{
-			if (Bone.bSkipSimulate)
-			{
-				continue;
-			}
-			FKawaiiPhysicsModifyBone& ParentBone = Node.ModifyBones[Bone.ParentIndex];
-			Node.AdjustByAngleLimit(Bone, ParentBone);
-			Node.AdjustByPlanarConstraint(Bone, ParentBone);
-			const float BoneLength = (Bone.PoseLocation - ParentBone.PoseLocation).Size();
-			Bone.Location = (Bone.Location - ParentBone.Location).GetSafeNormal() * BoneLength + ParentBone.Location;
+			const int32 ParentIndex = State.ParentIndex[i];
+			FVector& Location = State.Location[i];
+			const FVector& ParentLocation = State.Location[ParentIndex];
+			const FQuat& ParentPoseRotation = Node.ModifyBones[ParentIndex].PoseRotation;
+			Node.AdjustByAngleLimit(Location, ParentLocation, State.PoseDirection[i], ParentPoseRotation,
+			                        State.LimitAngle[i]);
+			Node.AdjustByPlanarConstraint(Location, ParentLocation, ParentPoseRotation);
+			Location = (Location - ParentLocation).GetSafeNormal() * State.RestLength[i] + ParentLocation;
 		}
 	}
 };
 
+/**
+ * スコープ中だけ bool の CVar を固定し、抜けるときに元の値へ戻す。
+ * Pins a bool CVar for the scope and restores the previous value on exit.
+ */
+struct FKawaiiPhysicsScopedBoolCVar
+{
+	FKawaiiPhysicsScopedBoolCVar(TAutoConsoleVariable<bool>& InCVar, const bool bValue)
+		: CVar(InCVar)
+		, bPrevValue(InCVar.GetValueOnAnyThread())
+	{
+		CVar->Set(bValue, ECVF_SetByCode);
+	}
+
+	~FKawaiiPhysicsScopedBoolCVar()
+	{
+		CVar->Set(bPrevValue, ECVF_SetByCode);
+	}
+
+private:
+	TAutoConsoleVariable<bool>& CVar;
+	bool bPrevValue;
+};
+
+/**
+ * スコープ中だけ int の CVar を固定し、抜けるときに元の値へ戻す。
+ * Pins an int CVar for the scope and restores the previous value on exit.
+ */
+struct FKawaiiPhysicsScopedIntCVar
+{
+	FKawaiiPhysicsScopedIntCVar(TAutoConsoleVariable<int32>& InCVar, const int32 Value)
+		: CVar(InCVar)
+		, PrevValue(InCVar.GetValueOnAnyThread())
+	{
+		CVar->Set(Value, ECVF_SetByCode);
+	}
+
+	~FKawaiiPhysicsScopedIntCVar()
+	{
+		CVar->Set(PrevValue, ECVF_SetByCode);
+	}
+
+private:
+	TAutoConsoleVariable<int32>& CVar;
+	int32 PrevValue;
+};
+
+/**
+ * スコープ中だけ積分経路（SIMD / スカラー）を固定する。ゴールデン値のビット一致比較はスカラー経路で行う。
+ * Pins the integration path (SIMD / scalar) for the scope. Bit-exact golden comparisons run on the scalar path.
+ */
+struct FKawaiiPhysicsScopedSimdIntegration : FKawaiiPhysicsScopedBoolCVar
+{
+	explicit FKawaiiPhysicsScopedSimdIntegration(const bool bEnable)
+		: FKawaiiPhysicsScopedBoolCVar(CVarAnimNodeKawaiiPhysicsSimdIntegration, bEnable)
+	{
+	}
+};
+
+/**
+ * スコープ中だけアイランドの並列ソルブを固定する。
+ * Pins the parallel island solve for the scope.
+ */
+struct FKawaiiPhysicsScopedParallelIslands : FKawaiiPhysicsScopedBoolCVar
+{
+	explicit FKawaiiPhysicsScopedParallelIslands(const bool bEnable)
+		: FKawaiiPhysicsScopedBoolCVar(CVarAnimNodeKawaiiPhysicsParallelIslands, bEnable)
+	{
+	}
+};
+
+/**
+ * スコープ中だけコリジョンのナローフェーズ（SIMD / スカラー）を固定する。
+ * Pins the collision narrowphase (SIMD / scalar) for the scope.
+ */
+struct FKawaiiPhysicsScopedSimdNarrowphase : FKawaiiPhysicsScopedBoolCVar
+{
+	explicit FKawaiiPhysicsScopedSimdNarrowphase(const bool bEnable)
+		: FKawaiiPhysicsScopedBoolCVar(CVarAnimNodeKawaiiPhysicsSimdNarrowphase, bEnable)
+	{
+	}
+};
+
+/**
+ * スコープ中だけチェーン AABB によるコライダーカリングを固定する。
+ * Pins the collider culling against the chain AABB for the scope.
+ */
+struct FKawaiiPhysicsScopedColliderCulling : FKawaiiPhysicsScopedBoolCVar
+{
+	explicit FKawaiiPhysicsScopedColliderCulling(const bool bEnable)
+		: FKawaiiPhysicsScopedBoolCVar(CVarAnimNodeKawaiiPhysicsColliderCulling, bEnable)
+	{
+	}
+};
+
+/**
+ * スコープ中だけコライダーグリッドを使う最小コライダー数を固定する（0 で常に総当たり）。
+ * Pins the minimum collider count for the collider grid for the scope (0 always uses brute force).
+ */
+struct FKawaiiPhysicsScopedColliderGridMinColliders : FKawaiiPhysicsScopedIntCVar
+{
+	explicit FKawaiiPhysicsScopedColliderGridMinColliders(const int32 MinColliders)
+		: FKawaiiPhysicsScopedIntCVar(CVarAnimNodeKawaiiPhysicsColliderGridMinColliders, MinColliders)
+	{
+	}
+};
+
+/**
+ * スコープ中だけ BoneConstraint の色ごとのバッチ解法を固定する。
+ * Pins the colour-batched BoneConstraint solve for the scope.
+ */
+struct FKawaiiPhysicsScopedColoredBoneConstraints : FKawaiiPhysicsScopedBoolCVar
+{
+	explicit FKawaiiPhysicsScopedColoredBoneConstraints(const bool bEnable)
+		: FKawaiiPhysicsScopedBoolCVar(CVarAnimNodeKawaiiPhysicsColoredBoneConstraints, bEnable)
+	{
+	}
+};
+
 #endif // WITH_DEV_AUTOMATION_TESTS
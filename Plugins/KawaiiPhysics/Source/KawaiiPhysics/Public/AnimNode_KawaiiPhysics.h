@@ -9,8 +9,14 @@
 #include "BoneControllers/AnimNode_AnimDynamics.h"
 #include "BoneControllers/AnimNode_SkeletalControlBase.h"
 #include "Engine/HitResult.h"
+#if UE_VERSION_OLDER_THAN(5, 3, 0)
+#include "WorldCollision.h"
+#else
+#include "Engine/OverlapResult.h"
+#endif
 #include "HAL/CriticalSection.h"
 #include "Templates/SharedPointer.h"
+#include "Tasks/Task.h"
 
 #if !UE_VERSION_OLDER_THAN(5, 5, 0)
 #include "StructUtils/InstancedStruct.h"
@@ -28,12 +34,17 @@
 #include "KawaiiPhysicsSharedCollisionSubsystem.h"
 #include "KawaiiPhysicsTypes.h"
 #include "KawaiiPhysicsBoneConstraintTypes.h"
+#include "KawaiiPhysicsSolverState.h"
+#include "KawaiiPhysicsColliderBuffer.h"
+#include "KawaiiPhysicsAsyncWorldCollision.h"
 #include "AnimNode_KawaiiPhysics.generated.h"
 
 class UKawaiiPhysics_CustomExternalForce;
 class UKawaiiPhysicsLimitsDataAsset;
 class UKawaiiPhysicsBoneConstraintsDataAsset;
+class UKawaiiPhysicsSimulationSubsystem;
 class UMirrorDataTable;
+struct FKAggregateGeom;
 
 #if ENABLE_ANIM_DEBUG
 extern KAWAIIPHYSICS_API TAutoConsoleVariable<bool> CVarAnimNodeKawaiiPhysicsEnable;
@@ -43,6 +54,17 @@ extern KAWAIIPHYSICS_API TAutoConsoleVariable<float> CVarAnimNodeKawaiiPhysicsDe
 #endif
 
 extern KAWAIIPHYSICS_API TAutoConsoleVariable<bool> CVarAnimNodeKawaiiPhysicsUseBoneContainerRefSkeletonWhenInit;
+extern KAWAIIPHYSICS_API TAutoConsoleVariable<bool> CVarAnimNodeKawaiiPhysicsSimdIntegration;
+extern KAWAIIPHYSICS_API TAutoConsoleVariable<bool> CVarAnimNodeKawaiiPhysicsSimdNarrowphase;
+extern KAWAIIPHYSICS_API TAutoConsoleVariable<bool> CVarAnimNodeKawaiiPhysicsColliderCulling;
+extern KAWAIIPHYSICS_API TAutoConsoleVariable<float> CVarAnimNodeKawaiiPhysicsColliderCullingMargin;
+extern KAWAIIPHYSICS_API TAutoConsoleVariable<int32> CVarAnimNodeKawaiiPhysicsColliderGridMinColliders;
+extern KAWAIIPHYSICS_API TAutoConsoleVariable<bool> CVarAnimNodeKawaiiPhysicsBatchedSimulation;
+extern KAWAIIPHYSICS_API TAutoConsoleVariable<bool> CVarAnimNodeKawaiiPhysicsPipelinedSimulation;
+extern KAWAIIPHYSICS_API TAutoConsoleVariable<bool> CVarAnimNodeKawaiiPhysicsParallelIslands;
+extern KAWAIIPHYSICS_API TAutoConsoleVariable<int32> CVarAnimNodeKawaiiPhysicsParallelIslandMinBones;
+extern KAWAIIPHYSICS_API TAutoConsoleVariable<bool> CVarAnimNodeKawaiiPhysicsColoredBoneConstraints;
+extern KAWAIIPHYSICS_API TAutoConsoleVariable<int32> CVarAnimNodeKawaiiPhysicsBoneConstraintParallelMinColorSize;
 
 // 一時外力の実体と寿命
 struct FKawaiiPhysicsTransientExternalForce
@@ -120,6 +142,62 @@ struct FKawaiiPhysicsTransientForceStore
 	FKawaiiPhysicsTransientForceStore& operator=(const FKawaiiPhysicsTransientForceStore&) { return *this; }
 };
 
+/**
+ * ApplySimulateResult の出力先スロット表。compact pose index を持つ実ボーンだけを index 昇順に並べ、
+ * ボーン毎にスロット番号を引けるようにする（dummy / LOD で外れたボーンは INDEX_NONE）。
+ * compact pose index は InitializeBoneReferences でしか変わらないので、毎フレームの RemoveAll / Sort が要らない。
+ * Output slot table of ApplySimulateResult. Only real bones with a compact pose index get a slot, in ascending index
+ * order, and each bone can look its slot up (INDEX_NONE for dummies and LOD-culled bones). Compact pose indices only
+ * change in InitializeBoneReferences, so the per-frame RemoveAll / Sort is no longer needed.
+ */
+struct KAWAIIPHYSICS_API FKawaiiPhysicsOutputSlots
+{
+	/**
+	 * 各ボーンの BoneRef（キャッシュ済み compact pose index）から組み立てる。LayoutGeneration は構築元のボーン構成の世代
+	 * Build from each bone's cached BoneRef. LayoutGeneration identifies the bone layout the table is built from
+	 */
+	void Build(const TArray<FKawaiiPhysicsModifyBone>& Bones, uint32 LayoutGeneration);
+
+	void Reset();
+
+	/**
+	 * 同じ世代・同じボーン数の構成に対して構築済みか（同数のボーンで init し直した場合も世代で作り直す）
+	 * Whether built for this layout generation and bone count (a reinit with the same bone count still rebuilds)
+	 */
+	bool IsBuiltFor(const uint32 LayoutGeneration, const int32 NumBones) const
+	{
+		return bBuilt && BuiltLayoutGeneration == LayoutGeneration && BoneSlots.Num() == NumBones;
+	}
+
+	/** 出力するボーン数 / Number of output bone transforms */
+	int32 Num() const { return SlotBones.Num(); }
+
+	/** スロットに書くボーンの index / Bone written to a slot */
+	int32 GetSlotBone(const int32 Slot) const { return SlotBones[Slot]; }
+
+	/** スロットの compact pose index / Compact pose index of a slot */
+	FCompactPoseBoneIndex GetSlotCompactIndex(const int32 Slot) const { return SlotCompactIndices[Slot]; }
+
+	/** ボーンの出力スロット（出力しないボーンは INDEX_NONE） / Output slot of a bone (INDEX_NONE if not written) */
+	int32 GetSlot(const int32 BoneIndex) const
+	{
+		return BoneSlots.IsValidIndex(BoneIndex) ? BoneSlots[BoneIndex] : INDEX_NONE;
+	}
+
+	SIZE_T GetAllocatedSize() const
+	{
+		return BoneSlots.GetAllocatedSize() + SlotBones.GetAllocatedSize() + SlotCompactIndices.GetAllocatedSize();
+	}
+
+private:
+	// スロット順（compact pose index 昇順）のボーン index / Bone index per slot (ascending compact pose index)
+	TArray<int32> SlotBones;
+	TArray<FCompactPoseBoneIndex> SlotCompactIndices;
+	TArray<int32> BoneSlots;
+	uint32 BuiltLayoutGeneration = 0;
+	bool bBuilt = false;
+};
+
 USTRUCT(BlueprintType)
 struct KAWAIIPHYSICS_API FAnimNode_KawaiiPhysics : public FAnimNode_SkeletalControlBase
 {
@@ -183,6 +261,19 @@ struct KAWAIIPHYSICS_API FAnimNode_KawaiiPhysics : public FAnimNode_SkeletalCont
 		meta = (PinHiddenByDefault, EditCondition = "BoneSubdivisionCount > 0"))
 	bool bBoneSubdivisionDensifyByRadius = false;
 
+	/**
+	* 親→子のボーン区間を半径つきのカプセルとして Sphere / Capsule / TaperedCapsule と判定し、押し出しを区間上の接触位置に応じて
+	* 両端のボーンへ配分する。ダミーボーンを増やさずに関節の間をコライダーがすり抜けるのを防ぐ（BoneSubdivisionCount の代替）。
+	* Box / Plane / Inner スフィアは従来どおりボーン位置だけで判定するため、関節の間だけを横切る薄い Box / Plane は今もすり抜ける。
+	* Collide each parent-to-child bone segment, as a capsule of the bone radius, against spheres, capsules and tapered
+	* capsules, and split the push-out between both end bones by where the contact lies on the segment. Stops colliders
+	* slipping between joints without adding dummy bones (an alternative to BoneSubdivisionCount).
+	* Boxes, planes and Inner spheres still only test the bone positions, so a thin box or plane crossing only between
+	* joints still tunnels.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Bones|Bone Subdivision", meta = (PinHiddenByDefault))
+	bool bBoneSegmentCollision = false;
+
 	/**
 	* 横方向BoneConstraintに沿って挿入するコリジョン代理ダミーの分割数。隣接チェーン（列）間の隙間をコリジョン点で埋めて貫通を防ぐ。
 	* Number of collision-proxy dummies to insert along each horizontal BoneConstraint. Fills horizontal gaps between adjacent chains (columns) to prevent penetration.
@@ -190,7 +281,7 @@ struct KAWAIIPHYSICS_API FAnimNode_KawaiiPhysics : public FAnimNode_SkeletalCont
 	* Combine with BoneSubdivisionCount for a 2D grid of collision points. 0 to disable. Skipped where the endpoint collisions already overlap (spacing <= 2*radius). Independent of BoneSubdivisionCount.
 	*/
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Bones|Bone Subdivision",
-		meta = (PinHiddenByDefault, ClampMin = "0", ClampMax = "10"))
+		meta = (PinHiddenByDefault, ClampMin = "0", ClampMax = "10", EditCondition = "!bBoneConstraintEdgeCollision"))
 	int32 BoneConstraintSubdivisionCount = 0;
 
 	/**
@@ -200,9 +291,20 @@ struct KAWAIIPHYSICS_API FAnimNode_KawaiiPhysics : public FAnimNode_SkeletalCont
 	* push weighted by proximity). This is what lets a collider moving between columns actually push the real bones.
 	*/
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Bones|Bone Subdivision",
-		meta = (PinHiddenByDefault, ClampMin = "0.0", ClampMax = "2.0", UIMin = "0.0", UIMax = "2.0", EditCondition = "BoneConstraintSubdivisionCount > 0"))
+		meta = (PinHiddenByDefault, ClampMin = "0.0", ClampMax = "2.0", UIMin = "0.0", UIMax = "2.0", EditCondition = "BoneConstraintSubdivisionCount > 0 && !bBoneConstraintEdgeCollision"))
 	float BoneConstraintSubdivisionFeedbackScale = 1.0f;
 
+	/**
+	* 横方向BoneConstraintの辺そのものを端点の半径を補間したカプセルとしてSphere/Capsule/TaperedCapsuleと判定し、押し出しを接触位置に応じて両端のボーンへ直接配分する。
+	* 有効時は bridge dummy を生成しない（BoneConstraintSubdivisionCount / FeedbackScale は無視）。列の間をコライダーが抜けるのを、追加ボーン無しで防ぐ。
+	* Collide each horizontal BoneConstraint edge itself, as a capsule interpolating the endpoint radii, against spheres,
+	* capsules and tapered capsules, and split the push-out straight to both endpoint bones by where the contact lies.
+	* No bridge dummies are generated while enabled (BoneConstraintSubdivisionCount / FeedbackScale are ignored).
+	* Keeps colliders from slipping between columns without adding bones.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Bones|Bone Subdivision", meta = (PinHiddenByDefault))
+	bool bBoneConstraintEdgeCollision = false;
+
 	/**
 	* ボーンの前方。物理制御やダミーボーンの配置位置に影響
 	* Bone forward direction. Affects the placement of physical controls and dummy bones
@@ -241,6 +343,18 @@ struct KAWAIIPHYSICS_API FAnimNode_KawaiiPhysics : public FAnimNode_SkeletalCont
 	UPROPERTY(EditAnywhere, Category = "Physics Settings", meta = (ClampMin = "1", UIMin = "1"))
 	int32 TargetFramerate = 60;
 
+	/**
+	* 固定サブステップの合間のフレームで出力する姿勢。TargetFramerate が描画より低いとき、直前2ステップの結果を補間
+	* （または外挿）して毎フレーム滑らかに出力する。有効なノードはステップのタイミングをインスタンスごとにずらし、
+	* 多数のキャラクターのステップが同じフレームに集まらないようにする
+	* Pose output on frames between fixed substeps. When TargetFramerate is below the render rate, the last two step
+	* results are interpolated (or extrapolated) so the output stays smooth every frame. Enabled nodes also stagger their
+	* step phase per instance so the steps of many characters do not pile up on the same frame
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics Settings", AdvancedDisplay,
+		meta = (PinHiddenByDefault))
+	EKawaiiPhysicsOutputInterpolation OutputInterpolation = EKawaiiPhysicsOutputInterpolation::None;
+
 	/** 
 	* 物理の空回し回数。物理処理が落ち着いてから開始・表示したい際に使用
 	* Number of times physics has been idle. Used when you want to start/display after physics processing has settled down
@@ -275,6 +389,37 @@ struct KAWAIIPHYSICS_API FAnimNode_KawaiiPhysics : public FAnimNode_SkeletalCont
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics Settings", meta = (PinHiddenByDefault))
 	float TeleportRotationThreshold = 10.0f;
 
+	/**
+	* 静止したチェーンのスリープ。ボーンの速度と入力ポーズの変化が閾値未満の状態が SleepFrames 続いたら、
+	* シミュレーションとコリジョンを止めて直前の結果を出力し続ける。ポーズ・Component の移動、一時外力 / 突風、
+	* 物理設定オーバーライド、チェーン付近へのコライダーの出入りで起きる。wind・外力・world collision を使うノードは眠らない
+	* Put settled chains to sleep. Once bone speeds and input pose changes stay under the thresholds for SleepFrames,
+	* simulation and collision stop and the last result keeps being output. Pose or component movement, transient forces
+	* / gusts, physics settings overrides and colliders entering or leaving the chain's bounds wake it up. Nodes using
+	* wind, external forces or world collision never sleep.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics Settings", AdvancedDisplay,
+		meta = (PinHiddenByDefault))
+	bool bAllowSleep = false;
+
+	/** この速度（cm/s）未満のボーンだけのアイランドは静止とみなす / Islands whose bones are all slower than this (cm/s) are at rest */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics Settings", AdvancedDisplay,
+		meta = (PinHiddenByDefault, EditCondition = "bAllowSleep", ClampMin = "0.0", Units = "cm/s"))
+	float SleepVelocityThreshold = 1.0f;
+
+	/**
+	* 入力ポーズ・Component の1フレームの移動（cm）がこれ以上ならスリープしない / 起きる
+	* Pose or component movement per frame (cm) at or above this keeps the node awake / wakes it up
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics Settings", AdvancedDisplay,
+		meta = (PinHiddenByDefault, EditCondition = "bAllowSleep", ClampMin = "0.0", Units = "cm"))
+	float SleepPoseThreshold = 0.01f;
+
+	/** 静止がこのフレーム数続いたらスリープする / Frames at rest before the node goes to sleep */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics Settings", AdvancedDisplay,
+		meta = (PinHiddenByDefault, EditCondition = "bAllowSleep", ClampMin = "1"))
+	int32 SleepFrames = 30;
+
 	/** 
 	* 指定した軸に応じた平面上に各ボーンを固定
 	* Fix the bone on the specified plane 
@@ -308,6 +453,41 @@ struct KAWAIIPHYSICS_API FAnimNode_KawaiiPhysics : public FAnimNode_SkeletalCont
 		meta = (PinHiddenByDefault))
 	bool ResetBoneTransformWhenBoneNotFound = false;
 
+	/**
+	* フレーム予算（プロジェクト設定 Kawaii Physics > Budget）での優先度。大きいほど優先して毎フレーム更新される。
+	* 画面サイズと同じ 0〜1 の範囲で指定する（1 が最優先。1 を超える値は 1 として扱う）。負の値ならスキンメッシュの
+	* 画面サイズで代用する。同じ値のノード同士はコンポーネントとノードの ID 順。予算が無効なら使われない
+	* Priority under the frame budget (Project Settings > Kawaii Physics > Budget); higher values keep updating every
+	* frame first. Uses the same 0-1 range as the screen size (1 is the highest priority; values above 1 count as 1).
+	* A negative value uses the skinned mesh's screen size instead. Ties are broken by component and node id. Unused
+	* while the budget is off. Also picks the LOD tier when LODTierMetric is Significance.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics Settings", AdvancedDisplay,
+		meta = (PinHiddenByDefault, UIMin = "-1", UIMax = "1"))
+	float Significance = -1.0f;
+
+	/**
+	* 遠景・小さく映るときの LOD 段階（細かい順）。LODTierMetric が閾値を越えた最も粗い段階を使い、どれにも当たらなければ
+	* ノードの設定のまま動く。コンパクトポーズによるボーンの除外とは独立
+	* LOD tiers for distant or small-on-screen nodes, finest first. The coarsest tier whose threshold LODTierMetric has
+	* crossed is used; with none the node runs on its own settings. Independent of compact-pose bone removal.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD", meta = (TitleProperty = "Threshold"))
+	TArray<FKawaiiPhysicsLODTier> LODTiers;
+
+	/** LOD 段階を選ぶ指標 / Metric that picks the LOD tier */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD", meta = (PinHiddenByDefault))
+	EKawaiiPhysicsLODMetric LODTierMetric = EKawaiiPhysicsLODMetric::ScreenSize;
+
+	/**
+	* 段階が切り替わったときに出力をなじませる時間（秒）。切り替え直前のポーズからの揺れを新しい段階の結果へ補間する
+	* Time (s) to blend the output across a tier change, from the sway relative to the pose just before the change to
+	* the new tier's result
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD",
+		meta = (PinHiddenByDefault, ClampMin = "0.0", Units = "s"))
+	float LODTierBlendTime = 0.25f;
+
 	/** 
 	* 各ボーンに適用するPhysics Settings/ Damping パラメータを補正。
 	* 「RootBoneから特定のボーンまでの長さ / RootBoneから末端のボーンまでの長さ」(0.0~1.0)の値におけるカーブの値を各パラメータに乗算
@@ -431,6 +611,28 @@ struct KAWAIIPHYSICS_API FAnimNode_KawaiiPhysics : public FAnimNode_SkeletalCont
 	UPROPERTY(EditAnywhere, Category = "Collision", meta = (PinHiddenByDefault))
 	bool bSkipMirroredBoneWithExistingCollision = true;
 
+	/**
+	* ONの場合、参照ポーズでチェーンの長さでは届かないコライダーとボーンの組を初期化時に判定対象から外す。
+	* 到達距離には、共通祖先から DrivingBone とチェーン root それぞれまでのチェーン長と、コライダーの OffsetLocation の
+	* 長さも含める。どの関節がどう回っても届く組は外さないので、同じスケルトン上のコライダーは実質外れない。
+	* 確実に外したい組は BoneFilter で指定すること（Inner スフィア / 平面は常に判定する）
+	* If true, pairs of a collider and a bone that the chain cannot reach in the reference pose are excluded on init.
+	* The reach includes the chain lengths from the common ancestor to both the collider's driving bone and the chain
+	* root, plus the length of the collider's OffsetLocation. A pair that can meet under any joint rotation is kept, so
+	* in practice colliders driven by the same skeleton are not excluded; use BoneFilter to exclude pairs explicitly
+	* (inner spheres and planes are always tested).
+	*/
+	UPROPERTY(EditAnywhere, AdvancedDisplay, Category = "Collision", meta = (PinHiddenByDefault))
+	bool bAutoColliderRelevance = false;
+
+	/**
+	* bAutoColliderRelevance で到達可能とみなす距離の余裕
+	* Extra distance added to the reach when bAutoColliderRelevance decides which pairs are reachable
+	*/
+	UPROPERTY(EditAnywhere, AdvancedDisplay, Category = "Collision",
+		meta = (PinHiddenByDefault, EditCondition = "bAutoColliderRelevance", ClampMin = "0", Units = "cm"))
+	float ColliderRelevanceMargin = 20.0f;
+
 	/**
 	* コリジョン設定（DataAsset版）における球コリジョンのプレビュー
 	* Preview of sphere collision in collision settings (DataAsset version)
@@ -491,6 +693,13 @@ struct KAWAIIPHYSICS_API FAnimNode_KawaiiPhysics : public FAnimNode_SkeletalCont
 	void RequestSharedCollisionReinit() { bSharedCollisionNeedsReinit = true; }
 	/** ボーン構造に依存する設定変更後の再初期化を要求 / Request modify-bone rebuild after topology-affecting settings change */
 	void RequestModifyBonesReinit() { bModifyBonesNeedsReinit = true; }
+	/** コライダーの関連マスクの作り直しを要求 / Request a rebuild of the collider relevance masks */
+	void RequestColliderRelevanceRebuild() { bColliderRelevanceMasksDirty = true; }
+	/**
+	 * 実行中のパイプライン実行タスクを待って結果を取り込む。ゲームスレッドからノードを書き換える前に呼ぶ
+	 * Join the pipelined solve in flight and scatter its result. Call before the game thread writes to the node
+	 */
+	void JoinPipelinedSimulation() { CompletePipelinedSimulation(); }
 
 	/**
 	* Bone Constraintで用いる剛性タイプ
@@ -723,6 +932,27 @@ struct KAWAIIPHYSICS_API FAnimNode_KawaiiPhysics : public FAnimNode_SkeletalCont
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Collision|World Collision", meta = (PinHiddenByDefault))
 	bool bAllowWorldCollision = false;
 
+	/**
+	* WorldCollision の判定方式。Sweep 以外はシーンクエリがフレーム毎に1回になりヒッチが減るが、厳密さが必要な
+	* シネマティック等では Sweep（ボーン・サブステップ毎の同期スイープ）のままにする。
+	* Broadphase は凸包（Convex）の要素を無視するので、凸包だけのコリジョンを持つメッシュとは当たらない
+	* How the WorldCollision is queried. Modes other than Sweep issue one scene query batch per frame and avoid hitches;
+	* keep Sweep (synchronous sweeps per bone and substep) where exactness matters, e.g. cinematics.
+	* Broadphase skips convex elements, so meshes whose simple collision is only convex hulls are not collided with.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Collision|World Collision",
+		meta = (PinHiddenByDefault, EditCondition = "bAllowWorldCollision"))
+	EKawaiiPhysicsWorldCollisionMode WorldCollisionMode = EKawaiiPhysicsWorldCollisionMode::Sweep;
+
+	/**
+	* Broadphase の重なり判定でチェーンのバウンディングボックスを広げる量。1フレームでボーンが動く距離より大きくする
+	* Margin added to the chain's bounding box for the Broadphase overlap query. Make it larger than a bone moves in a frame
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Collision|World Collision",
+		meta = (PinHiddenByDefault, ClampMin = "0", EditCondition =
+			"bAllowWorldCollision && WorldCollisionMode == EKawaiiPhysicsWorldCollisionMode::Broadphase"))
+	float WorldCollisionQueryRadius = 20.0f;
+
 
 	/** WorldCollisionで独自のコリジョン設定を使用するフラグ / Flag to use custom collision settings in WorldCollision */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Collision|World Collision",
@@ -819,7 +1049,6 @@ private:
 	* Removes inserted inter-bone dummy bones when the real child bone cannot be added.
 	*/
 	void RollbackInterBoneDummyBones(TArray<FKawaiiPhysicsModifyBone>& InModifyBones,
-	                                 int32 ParentModifyBoneIndex,
 	                                 const TArray<int32>& InsertedInterBoneDummyIndices) const;
 
 	/**
@@ -849,6 +1078,12 @@ private:
 	 */
 	FQuat SkelCompMoveRotation = FQuat::Identity;
 
+	/**
+	 * SkelCompMoveVector を BaseBoneSpace へ変換したもの（UpdateStepInvariants で評価毎に1回求める）。
+	 * SkelCompMoveVector converted to BaseBoneSpace (computed once per evaluation by UpdateStepInvariants).
+	 */
+	FVector SkelCompMoveVectorBaseBoneSpace = FVector::ZeroVector;
+
 	/**
 	 * Flag indicating whether to reset or skip the dynamics.
 	 */
@@ -892,6 +1127,78 @@ private:
 	TWeakObjectPtr<UKawaiiPhysicsSharedCollisionSubsystem> CachedSharedCollisionSubsystem;
 	TWeakObjectPtr<AActor> CachedSharedCollisionOwnerActor;
 
+	// --- Batched Simulation ---
+	// バッチ実行用の Subsystem と、登録の生存確認に使う AnimInstance（GameThread の OnInitializeAnimInstance で解決）
+	// Subsystem for batched solves and the AnimInstance used to check the registration is still alive (resolved on the GameThread)
+	TWeakObjectPtr<UKawaiiPhysicsSimulationSubsystem> CachedSimulationSubsystem;
+	TWeakObjectPtr<const UObject> CachedSimulationOwner;
+	// 入力を確定して Subsystem に登録済みで、ソルバがまだ走っていない。Evaluate と バッチ（全 Actor Tick 後）は
+	// 同時に走らないのでロックは不要。
+	// Inputs are settled and registered with the subsystem but the solve has not run yet. Evaluate and the batch (after
+	// all actor ticks) never overlap, so no lock is needed.
+	bool bBatchedSimulationPending = false;
+
+	// --- Pipelined Simulation ---
+	// 入力を確定済みで、評価の最後にバックグラウンドタスクとして起動するソルバがある
+	// Inputs are settled and the solve is to be launched as a background task at the end of the evaluation
+	bool bPipelinedSimulationPending = false;
+	// 実行中（または完了後まだ取り込んでいない）ソルバのタスク。タスクは SolverState（裏バッファ）だけを進め、
+	// ModifyBones（表バッファ = 出力済みの結果）へは次の PreUpdate（ピン / setter より前）で書き戻す。
+	// Task of the solve in flight (or finished but not yet picked up). It only advances SolverState (the back buffer);
+	// the result is scattered into ModifyBones (the front buffer = published result) in the next PreUpdate, before
+	// exposed pins and setters run.
+	UE::Tasks::FTask PipelinedSimulationTask;
+	bool bPipelinedSimulationInFlight = false;
+
+	// --- Simulation Budget ---
+	// Subsystem が全 Actor Tick 後に割り当てた更新頻度（次の Evaluate から適用。Evaluate とは同時に走らない）
+	// Update rate assigned by the subsystem after all actor ticks (applies from the next Evaluate; never overlaps it)
+	EKawaiiPhysicsBudgetTier SimulationBudgetTier = EKawaiiPhysicsBudgetTier::Full;
+	// 前回シミュレーションしたときの段階（Frozen からの復帰検出用） / Tier of the last evaluation (detects leaving Frozen)
+	EKawaiiPhysicsBudgetTier LastSimulationBudgetTier = EKawaiiPhysicsBudgetTier::Full;
+	// Reduced でスキップしたフレーム数と、その間の未シミュレーション時間 / Frames skipped under Reduced and the time they covered
+	int32 BudgetSkippedFrames = 0;
+	float BudgetSkippedDeltaTime = 0.0f;
+	// Significance が並んだときの割り当て順を決める安定なキー（スキンメッシュの UniqueID と AnimGraph 内のノード ID）
+	// Stable key that orders nodes of equal significance (the skinned mesh's UniqueID and the node's id in the AnimGraph)
+	uint32 BudgetComponentId = 0;
+	int32 BudgetNodeId = INDEX_NONE;
+
+	// --- Sleep ---
+	bool bSleeping = false;
+	// 静止が続いているフレーム数 / Consecutive frames at rest
+	int32 SleepRestFrames = 0;
+	// アイランドごとの運動エネルギー（単位質量、ボーン平均） / Kinetic energy per island (unit mass, averaged per bone)
+	TArray<float> IslandKineticEnergy;
+	// 眠ったときのチェーンの範囲と、そこに掛かっていたコライダーの数・中心の和（出入りの検出用）
+	// Chain bounds at sleep time and the count / sum of centres of the colliders touching them (detects colliders moving)
+	FBox SleepBounds = FBox(ForceInit);
+	int32 SleepColliderCount = 0;
+	FVector SleepColliderCenterSum = FVector::ZeroVector;
+
+	// --- LOD tier ---
+	// 適用中の段階（INDEX_NONE ならノードの設定のまま） / Active tier (INDEX_NONE runs on the node's own settings)
+	int32 ActiveLODTier = INDEX_NONE;
+	// Subsystem が全 Actor Tick 後に書き込む（1フレーム遅れ） / Written by the subsystem after all actors have ticked (one frame late)
+	float LODScreenSize = 1.0f;
+	float LODViewDistance = 0.0f;
+	// 段階切り替えのブレンド率（1 で完了）と、切り替え直前のポーズからの揺れ（SimulationSpace）
+	// Tier change blend (1 when done) and the sway relative to the pose just before the change (SimulationSpace)
+	float LODTierBlendAlpha = 1.0f;
+	TArray<FVector> LODTierBlendFromOffsets;
+	// ブレンド中に出力する間だけ退避するシミュレーション結果 / Simulation result stashed while the blended output is applied
+	TArray<FVector> LODTierBlendSavedLocations;
+
+	// --- Output interpolation ---
+	// 直前2ステップの結果を、各ステップ時点のポーズからの揺れとして保持する（SimulationSpace）
+	// Results of the last two steps, kept as sway from the pose at each step (SimulationSpace)
+	TArray<FVector> OutputInterpolationFromOffsets;
+	TArray<FVector> OutputInterpolationToOffsets;
+	// 両方が記録済みか（テレポート・リセット・WarmUp で無効にする） / Both recorded (cleared by teleport, reset and WarmUp)
+	bool bOutputInterpolationValid = false;
+	// 補間した出力を適用する間だけ退避するシミュレーション結果 / Simulation result stashed while the interpolated output is applied
+	TArray<FVector> OutputInterpolationSavedLocations;
+
 	// 共有コリジョン用キャッシュ（Evaluate(AnyThread)で初期化・参照。Subsystemはロックでスレッドセーフ）
 	// Cached shared collision pointers (initialized and referenced in Evaluate on AnyThread; the subsystem is lock-protected)
 	TSharedPtr<FKawaiiPhysicsSharedCollisionEntry> CachedSharedCollisionEntry;
@@ -930,6 +1237,27 @@ private:
 	TArray<FName> IgnoreBoneNamePrefixCache;
 	// sweep結果を受け取る使い回しバッファ（フレーム間で確保済みメモリを再利用） / Sweep-result scratch (reuses capacity across frames)
 	TArray<FHitResult> WorldCollisionHitsScratch;
+	// 非同期ワールドコリジョンの要求と結果（AsyncSweep 時に遅延生成。発行は SimulationSubsystem）
+	// Requests and results of the async world collision (created lazily; issued by the simulation subsystem)
+	TSharedPtr<FKawaiiPhysicsAsyncWorldCollision, ESPMode::ThreadSafe> AsyncWorldCollision;
+	TArray<FKawaiiPhysicsAsyncWorldCollision::FSweep> AsyncWorldSweepsScratch;
+	TArray<FKawaiiPhysicsAsyncWorldCollision::FSweepResult> AsyncWorldResultsScratch;
+	// フレーム開始時のボーン位置（非同期スイープの始点） / Bone locations at the start of the frame (async sweep starts)
+	TArray<FVector> AsyncWorldSweepStartScratch;
+	// 最新の非同期スイープから作ったボーン毎の接触平面。WS はワールド空間で保持し、評価毎にシミュレーション空間へ変換する。
+	// 法線が0の平面は接触なし。 / Per-bone contact planes from the latest async sweeps, kept in world space (WS) and
+	// converted to simulation space each evaluation. A plane with a zero normal means no contact.
+	TArray<FPlane> AsyncWorldContactPlanesWS;
+	TArray<FPlane> AsyncWorldContactPlanes;
+	// Broadphase: 重なり判定で見つけた単純コリジョン形状（シミュレーション空間、フレーム毎に作り直す）と、そのコンパイル済みバッファ
+	// Broadphase: simple collision shapes found by the overlap query (simulation space, rebuilt every frame) and their
+	// compiled buffer
+	TArray<FOverlapResult> WorldCollisionOverlapsScratch;
+	TArray<FSphericalLimit> WorldSphericalLimits;
+	TArray<FCapsuleLimit> WorldCapsuleLimits;
+	TArray<FTaperedCapsuleLimit> WorldTaperedCapsuleLimits;
+	TArray<FBoxLimit> WorldBoxLimits;
+	FKawaiiPhysicsColliderBuffer CompiledWorldColliders;
 
 	// bridge dummy feedback の集計用使い回しバッファ（端点index→押し出し/重み）。SimulateOnce毎のTMap確保を避け、
 	// フレーム間で確保済みメモリを再利用する。 / Bridge-dummy feedback accumulation scratch (endpoint index -> push/weight);
@@ -937,6 +1265,58 @@ private:
 	TArray<FVector> BridgeFeedbackPushScratch;
 	TArray<float> BridgeFeedbackWeightScratch;
 
+	// ソルバ内部のSoAホット状態。SimulateModifyBones冒頭でModifyBonesから集め、末尾で書き戻す。
+	// 外力フック/Blueprint/デバッグ描画はModifyBones側を参照する。
+	// Solver-internal SoA hot state. Gathered from ModifyBones at the start of SimulateModifyBones and scattered back at
+	// the end; external-force hooks, Blueprint and debug drawing keep reading ModifyBones.
+	FKawaiiPhysicsSolverState SolverState;
+
+	// ボーン構成の世代。InitModifyBones / bridge dummy の追加で進め、ボーン構成から作るキャッシュの作り直し判定に使う
+	// （ボーン数だけでは、同数のボーンで init し直したときに古いキャッシュを使い続けてしまう）
+	// Generation of the bone layout, bumped by InitModifyBones and when bridge dummies are added. Caches derived from
+	// the layout compare against it, since the bone count alone misses a reinit that yields the same number of bones
+	uint32 BoneLayoutGeneration = 0;
+
+	// ボーン分類ごとの index リスト（BuildBoneCategories で init / reinit 時に構築）
+	// Per-category bone index lists (built by BuildBoneCategories on init / reinit)
+	FKawaiiPhysicsBoneCategories BoneCategories;
+
+	// 子ボーンの隣接リスト（InitModifyBones で ParentIndex から構築）
+	// Child adjacency of ModifyBones (built from ParentIndex by InitModifyBones)
+	FKawaiiPhysicsBoneTopology BoneTopology;
+
+	// ApplySimulateResult の出力先スロット（init 時に構築、InitializeBoneReferences で破棄）
+	// Output slots of ApplySimulateResult (built on init, dropped by InitializeBoneReferences)
+	FKawaiiPhysicsOutputSlots OutputSlots;
+
+	// 並列にソルブできるボーンのアイランド（init 時に構築）
+	// Bone islands that can be solved in parallel (built on init)
+	FKawaiiPhysicsBoneIslands BoneIslands;
+
+	// MergedBoneConstraints の世代。InitBoneConstraints で進め、BoneConstraintColors の作り直し判定に使う
+	// Generation of MergedBoneConstraints, bumped by InitBoneConstraints and checked against BoneConstraintColors
+	uint32 BoneConstraintGeneration = 0;
+
+	// MergedBoneConstraints の色分け（InitBoneConstraints で構築。配列は元の並びのまま、色順は index 列で持つ）
+	// Colouring of MergedBoneConstraints (built by InitBoneConstraints; the array keeps its authoring order and the
+	// colour order lives in an index permutation)
+	FKawaiiPhysicsConstraintColors BoneConstraintColors;
+
+	// PrepareCollisionShapeCaches がステップ毎にコンパイルする有効コライダーの SoA（自ノード分 / 共有コリジョン分）
+	// Enabled-collider SoA compiled every step by PrepareCollisionShapeCaches (own limits / shared collision)
+	FKawaiiPhysicsColliderBuffer CompiledColliders;
+	FKawaiiPhysicsColliderBuffer CompiledSharedColliders;
+
+	// 自ノードの limit の関連マスク（BuildColliderRelevanceMasks で構築。1 limit あたり ColliderRelevanceMaskWords 語）
+	// Relevance masks of this node's limits (built by BuildColliderRelevanceMasks; ColliderRelevanceMaskWords per limit)
+	TArray<uint32> ColliderRelevanceMasks;
+	int32 ColliderRelevanceMaskWords = 0;
+	bool bColliderRelevanceMasksDirty = true;
+
+	// SIMD ナローフェーズを使うか（PrepareCollisionShapeCaches で CVar からステップ毎に取得）
+	// Whether AdjustByColliderBuffer uses the SIMD narrowphase (read from the CVar by PrepareCollisionShapeCaches)
+	bool bUseSimdNarrowphase = true;
+
 	/**
 	* Stores the delta time from the previous frame.
 	*/
@@ -962,6 +1342,13 @@ private:
 	// Fraction of elapsed real time consumed this frame (0..1). PreSkelCompTransform advances by this fraction so
 	// unconsumed component movement carries to the next stepping frame (0 holds it when NumSteps==0). 1 for legacy/teleport.
 	float PreSkelCompTransformConsumeFraction = 1.0f;
+	// PrepareSimulateModifyBones が決めたこの評価のサブステップ数と world 移動の分配率（StepModifyBones が使う）
+	// Substep count and per-step share of the world move settled by PrepareSimulateModifyBones (used by StepModifyBones)
+	int32 PlannedSubstepCount = 0;
+	float PlannedSubstepMoveFraction = 1.0f;
+	// SubstepRotationInterpolation を毎フレーム1回キャッシュ / SubstepRotationInterpolation cached once per frame
+	bool bSubstepAlwaysInterpolateRotationCached = false;
+	bool bSubstepNLerpRotationCached = false;
 
 #if WITH_EDITORONLY_DATA
 	bool bEditing = false;
@@ -970,6 +1357,7 @@ private:
 
 public:
 	FAnimNode_KawaiiPhysics();
+	~FAnimNode_KawaiiPhysics();
 
 	// FAnimNode_Base interface
 	virtual void UpdateInternal(const FAnimationUpdateContext& Context) override;
@@ -982,6 +1370,12 @@ public:
 	// Called once on the GameThread. Collects warning-log identifier names and resolves bEditing here (to avoid a per-frame PreUpdate)
 	virtual bool NeedsOnInitializeAnimInstance() const override { return true; }
 	virtual void OnInitializeAnimInstance(const FAnimInstanceProxy* InProxy, const UAnimInstance* InAnimInstance) override;
+	// パイプライン実行のタスクはノードの設定と ModifyBones の冷データを読むので、ピンの評価や BP setter より前の PreUpdate で
+	// 取り込む。タスクが無ければ何もしない
+	// The pipelined task reads the node settings and the cold ModifyBones data, so it is joined in PreUpdate, before
+	// exposed pins and Blueprint setters run. A no-op when no task is in flight
+	virtual bool HasPreUpdate() const override { return true; }
+	virtual void PreUpdate(const UAnimInstance* InAnimInstance) override;
 	// End of FAnimNode_Base interface
 
 	// FAnimNode_SkeletalControlBase interface
@@ -1021,7 +1415,8 @@ public:
 
 	int32 GetEffectiveTargetFramerate() const
 	{
-		return FMath::Max(1, TargetFramerate);
+		const FKawaiiPhysicsLODTier* Tier = GetActiveLODTier();
+		return FMath::Max(1, Tier && Tier->TargetFramerate > 0 ? Tier->TargetFramerate : TargetFramerate);
 	}
 
 	/**
@@ -1035,6 +1430,15 @@ public:
 		return bInSubstep ? StepDeltaTime : DeltaTime;
 	}
 
+	/**
+	 * ModifyBones[ModifyBoneIndex] の子の index（index 昇順。範囲外なら空）。
+	 * Child indices of ModifyBones[ModifyBoneIndex] in ascending order (empty when out of range).
+	 */
+	TConstArrayView<int32> GetModifyBoneChildIndices(const int32 ModifyBoneIndex) const
+	{
+		return BoneTopology.GetChildren(ModifyBoneIndex);
+	}
+
 	/**
 	 * Get Transform from BaseBoneSpace to ComponentSpace.
 	 */
@@ -1159,6 +1563,18 @@ protected:
 	 */
 	void InitBoneConstraints();
 
+	/**
+	 * ボーン構成だけで決まる skip フラグ（LOD で無効な実ボーン / root）を設定し、BoneCategories を作り直す。
+	 * Set the layout-only skip flags (LOD-invalid real bones / roots) and rebuild BoneCategories.
+	 */
+	void BuildBoneCategories();
+
+	/**
+	 * BoneCategories と MergedBoneConstraints から並列ソルブ用のアイランドを作る（最小ボーン数は CVar）。
+	 * Build the islands for the parallel solve from BoneCategories and MergedBoneConstraints (minimum size from a CVar).
+	 */
+	void BuildBoneIslands();
+
 	/**
 	* 横方向Constraintに沿ってコリジョンセンサーとなるbridge dummyをModifyBonesに追加する（元Constraintは温存）。
 	* 実ボーンへのフィードバックは毎フレームの直接変位転送(SimulateModifyBones)が担う。
@@ -1223,6 +1639,7 @@ protected:
 	                        TArray<int32>& Children) const;
 	/**
 	 * Calculates the length of a bone from the root and updates the total bone length.
+	 * The parent's LengthFromRoot must already be set (call in index order; parents precede children).
 	 *
 	 * @param Bone The bone to calculate the length for.
 	 * @param InModifyBones An array of bones to modify.
@@ -1356,6 +1773,201 @@ protected:
 	void SimulateModifyBones(FComponentSpacePoseContext& Output,
 	                         const FTransform& ComponentTransform);
 
+	/**
+	 * SimulateModifyBones の Output に依存する前半（外力の PreApply / ポーズのスナップショット / SolverState への収集 /
+	 * ステップ数の決定）。DeltaTime が0以下なら何もせず false を返す。
+	 * The Output-dependent first half of SimulateModifyBones (force PreApply, pose snapshot, SolverState gather, step
+	 * count). Does nothing and returns false when DeltaTime is not positive.
+	 */
+	bool PrepareSimulateModifyBones(FComponentSpacePoseContext& Output);
+
+	/**
+	 * 決定済みのステップ数だけ SimulateOnce を回す。Output はフック / 外力の PostApply / world collision でのみ使い、
+	 * それらが無いノード（CanBatchSimulation）は nullptr で呼べる。
+	 * Run SimulateOnce for the settled number of steps. Output is only used by hooks, force PostApply and world
+	 * collision, so nodes without them (CanBatchSimulation) can pass nullptr.
+	 */
+	void StepModifyBones(FComponentSpacePoseContext* Output, const FTransform& ComponentTransform,
+	                     const FSceneInterface* Scene, const USkeletalMeshComponent* SkelComp);
+
+	/** SolverState を ModifyBones へ書き戻し、次フレームのポーズ補間の基準を確定する / Scatter and latch the pose targets */
+	void FinishSimulateModifyBones();
+
+	/**
+	 * ソルバを Output 無しで後から実行できるか（wind / 外力 / world collision を使わない）。
+	 * Whether the solve can run later without Output (no wind, external forces or world collision).
+	 */
+	bool CanBatchSimulation(const FSceneInterface* Scene) const;
+
+	/**
+	 * a.AnimNode.KawaiiPhysics.BatchedSimulation が有効でバッチ可能なら、入力を確定して Subsystem に登録する。
+	 * 登録した（= このフレームのソルバはバッチで走る）なら true。
+	 * When a.AnimNode.KawaiiPhysics.BatchedSimulation is on and the node can be batched, settle its inputs and register
+	 * it with the subsystem. Returns true if registered (this frame's solve will run in the batch).
+	 */
+	bool TryEnqueueBatchedSimulation(FComponentSpacePoseContext& Output);
+
+	/**
+	 * 登録済みのソルバを実行する（保留が無ければ何もしない）。Subsystem のバッチから呼ばれるほか、
+	 * 保留中に再評価 / 再初期化が来た場合はその場で実行して状態を揃える。
+	 * Run the registered solve (no-op if none is pending). Called by the subsystem batch, and inline when the node is
+	 * re-evaluated or re-initialised while a solve is still pending.
+	 */
+	void RunBatchedSimulation();
+
+	/**
+	 * a.AnimNode.KawaiiPhysics.PipelinedSimulation が有効でバッチ可能（CanBatchSimulation）なら、入力を確定して
+	 * 評価の最後にタスクとして起動する予約をする。予約した（= このフレームのソルバはタスクで走る）なら true。
+	 * When a.AnimNode.KawaiiPhysics.PipelinedSimulation is on and the node can be batched (CanBatchSimulation), settle
+	 * its inputs and schedule the solve to launch as a task at the end of the evaluation. Returns true if scheduled.
+	 */
+	bool TryPreparePipelinedSimulation(FComponentSpacePoseContext& Output);
+
+	/** 予約済みのソルバをバックグラウンドタスクとして起動する / Launch the scheduled solve as a background task */
+	void LaunchPipelinedSimulation();
+
+	/** 実行中のタスクの完了を待つ（結果はまだ書き戻さない） / Wait for the task in flight (the result is not scattered yet) */
+	void WaitPipelinedSimulation();
+
+	/**
+	 * タスクの完了を待ち、結果を ModifyBones へ書き戻す。評価 / 再初期化で状態を触る前に呼ぶ。
+	 * Wait for the task and scatter its result into ModifyBones. Call before evaluation / re-init touches the state.
+	 */
+	void CompletePipelinedSimulation();
+
+	/**
+	 * フレーム予算の段階と LOD 段階の更新間隔に従って、このフレームをシミュレーションするかを決める
+	 * （スキップ分の時間は次のシミュレーションへ繰り越す）。
+	 * Decide from the budget tier and the LOD tier's update interval whether this frame is simulated (skipped time
+	 * carries over to the next simulated frame).
+	 */
+	bool ShouldSimulateUnderBudget();
+
+	/**
+	 * 予算でシミュレーションしないフレームの処理。WorldSpace ではボーンを Component の移動に剛体的に追従させる。
+	 * Handle a frame the budget does not simulate. In WorldSpace the bones follow the component's movement rigidly.
+	 */
+	void HoldSimulationForBudget(FComponentSpacePoseContext& Output, const FTransform& ComponentTransform);
+
+	/**
+	 * 1フレームあたりのシミュレーション負荷の見積もり（ミリ秒）。ボーン数・コライダー数・ステップ数・BoneConstraint 数から求める。
+	 * Estimated simulation cost per frame in milliseconds, from the bone, collider, step and BoneConstraint counts.
+	 */
+	float EstimateSimulationCostMs() const;
+
+	/** wind・外力・world collision を使わず、スリープしてよい構成か / Whether the node setup allows sleeping */
+	bool CanSleep() const;
+
+	/**
+	 * スリープ状態を更新し、このフレームのシミュレーションを省くなら true を返す。
+	 * 速度は ModifyBones の Location - PrevLocation から求めるので、バッチ / パイプラインの結果を取り込んだ後に呼ぶ。
+	 * Update the sleep state and return true when this frame's simulation is skipped. Speeds come from
+	 * ModifyBones' Location - PrevLocation, so call after batched / pipelined results have been picked up.
+	 */
+	bool UpdateSleepState(bool bHasActiveSettingsOverride);
+
+	/** スリープを解除して静止カウントを戻す / Leave sleep and reset the rest counter */
+	void WakeFromSleep();
+
+	/** アイランドごとの運動エネルギーを更新し、その最大値を返す / Update the per-island kinetic energy and return the max */
+	float UpdateIslandKineticEnergy();
+
+	/** SleepBounds に掛かるコライダーの数と中心の和 / Count and sum of centres of the colliders touching SleepBounds */
+	void GatherSleepColliderSignature(int32& OutCount, FVector& OutCenterSum) const;
+
+	/** 適用中の LOD 段階（無ければ nullptr） / Active LOD tier (nullptr when none) */
+	const FKawaiiPhysicsLODTier* GetActiveLODTier() const
+	{
+		return LODTiers.IsValidIndex(ActiveLODTier) ? &LODTiers[ActiveLODTier] : nullptr;
+	}
+
+	/**
+	 * 指標の値から段階を選ぶ。閾値を越えた最も粗い段階を返し（無ければ INDEX_NONE）、CurrentTier より細かい段階へ戻るのは
+	 * 閾値から少し離れてからにする（境界でのばたつき防止）。
+	 * Pick the tier for a metric value: the coarsest tier whose threshold is crossed (INDEX_NONE if none). Going back to
+	 * a finer tier than CurrentTier waits until the value is clearly past the threshold, so tiers do not flicker.
+	 */
+	static int32 SelectLODTier(const TArray<FKawaiiPhysicsLODTier>& Tiers, EKawaiiPhysicsLODMetric Metric,
+	                           float MetricValue, int32 CurrentTier);
+
+	/** このフレームの段階を選び、切り替わったらブレンドを始める / Pick this frame's tier and start a blend on change */
+	void UpdateLODTier();
+
+	/** 出力をブレンド結果に差し替える（ApplySimulateResult の前） / Swap in the blended output (before ApplySimulateResult) */
+	bool BeginLODTierBlend();
+
+	/** ブレンド前のシミュレーション結果を戻す（率は UpdateLODTier が進める） / Restore the unblended result (UpdateLODTier advances the blend) */
+	void EndLODTierBlend();
+
+	/**
+	 * サブステップの未消費時間の初期値。OutputInterpolation が有効ならインスタンスごとに 0..1 ステップずらす
+	 * Initial substep accumulator. Staggered by 0..1 step per instance when OutputInterpolation is on
+	 */
+	float GetSubstepPhaseOffset() const;
+
+	/**
+	 * 最後のサブステップの直前の状態を補間元として記録する（PoseAlpha はそのステップ直前のポーズ補間率）
+	 * Record the state before the last substep as the interpolation source (PoseAlpha is the pose lerp before that step)
+	 */
+	void CaptureOutputInterpolationFrom(float PoseAlpha);
+
+	/** 全サブステップ後の状態を補間先として記録する / Record the state after all substeps as the interpolation target */
+	void CaptureOutputInterpolationTo();
+
+	/** 補間（外挿）率。次のステップまでに経過した割合 / Interpolation (extrapolation) alpha: progress towards the next step */
+	float GetOutputInterpolationAlpha() const;
+
+	/** 出力を補間結果に差し替える（ApplySimulateResult の前） / Swap in the interpolated output (before ApplySimulateResult) */
+	bool BeginOutputInterpolation();
+
+	/** 補間前のシミュレーション結果を戻す / Restore the uninterpolated simulation result */
+	void EndOutputInterpolation();
+
+	bool IsWorldCollisionActive() const
+	{
+		const FKawaiiPhysicsLODTier* Tier = GetActiveLODTier();
+		return bAllowWorldCollision && (!Tier || Tier->bEnableWorldCollision);
+	}
+
+	bool AreExternalForcesActive() const
+	{
+		const FKawaiiPhysicsLODTier* Tier = GetActiveLODTier();
+		return !Tier || Tier->bEnableExternalForces;
+	}
+
+	bool ShouldSimulateDummyBones() const
+	{
+		const FKawaiiPhysicsLODTier* Tier = GetActiveLODTier();
+		return !Tier || Tier->bSimulateDummyBones;
+	}
+
+	/** inter-bone dummy を積分せず配置だけにするか / Whether inter-bone dummies are only placed, not integrated */
+	bool IsInterBoneDummyCollisionOnly() const { return bBoneSubdivisionCollisionOnly || !ShouldSimulateDummyBones(); }
+
+	int32 GetEffectiveBoneConstraintIterationCount(const bool bAfterCollision) const
+	{
+		const FKawaiiPhysicsLODTier* Tier = GetActiveLODTier();
+		if (Tier)
+		{
+			const int32 TierCount = bAfterCollision
+				                        ? Tier->BoneConstraintIterationCountAfterCollision
+				                        : Tier->BoneConstraintIterationCountBeforeCollision;
+			if (TierCount >= 0)
+			{
+				return TierCount;
+			}
+		}
+		return bAfterCollision ? BoneConstraintIterationCountAfterCollision : BoneConstraintIterationCountBeforeCollision;
+	}
+
+	/** 段階の MaxSubsteps でプロジェクト設定の上限を絞る / Clamp the project's substep cap by the tier's MaxSubsteps */
+	int32 GetEffectiveMaxSubsteps(const int32 ProjectMaxSubsteps) const
+	{
+		const FKawaiiPhysicsLODTier* Tier = GetActiveLODTier();
+		const int32 MaxSubsteps = FMath::Max(1, ProjectMaxSubsteps);
+		return Tier && Tier->MaxSubsteps > 0 ? FMath::Min(MaxSubsteps, Tier->MaxSubsteps) : MaxSubsteps;
+	}
+
 	/**
 	 * シミュレーションの1ステップ分（Simulate ループ＋ダミー配置＋コリジョン＋拘束＋長さ復元）を
 	 * 現在の GetStepDeltaTime() で1回実行する。SimulateModifyBones から legacy で1回、
@@ -1363,41 +1975,140 @@ protected:
 	 * Runs ONE simulation step (Simulate loop + dummy placement + collision + constraints + length restore)
 	 * at the current GetStepDeltaTime(). Called once (legacy) or N times (fixed substepping) from SimulateModifyBones.
 	 */
-	void SimulateOnce(FComponentSpacePoseContext& Output, const FTransform& ComponentTransform,
+	void SimulateOnce(FComponentSpacePoseContext* Output, const FTransform& ComponentTransform,
 	                  const FSceneInterface* Scene, const USkeletalMeshComponent* SkelComp);
 
+	/**
+	 * SimulateOnce の root 追従後をアイランド単位で並列に回せるか。アイランドが2つ以上あり、
+	 * ノード全体を触る処理（フック / 外力の PostApply / world collision）が無いとき。
+	 * Whether the part of SimulateOnce after the root follow can run per island in parallel: there are at least two
+	 * islands and nothing touches the whole node (hooks / force PostApply / world collision).
+	 */
+	bool CanSimulateIslandsInParallel(const FSceneInterface* Scene) const;
+
+	/**
+	 * アイランドごとの1ステップ（積分〜長さ復元）。アイランド同士は位置も Constraint も共有しないので、
+	 * 並列に回しても逐次の SimulateOnce と同じ結果になる。
+	 * One step of a single island (integration to length restore). Islands share no positions or constraints, so
+	 * running them in parallel gives the same result as the sequential SimulateOnce.
+	 */
+	void SimulateIslandOnce(const FKawaiiPhysicsBoneIsland& Island, bool bIntegrate);
+
+	/** フック無しのスカラー積分 / Hook-free scalar integration of the given bones */
+	void IntegrateBones(const TArray<int32>& Bones);
+
+	/** inter-bone dummy（コリジョン専用モード）と bridge dummy を端点間へ配置 / Place inter-bone and bridge dummies */
+	void PlaceDummyBones(const FKawaiiPhysicsBoneCategories& Categories);
+
+	/**
+	 * Lambda を戻して BoneConstraint を IterationCount 回解く（ConstraintIndices が nullptr なら全 Constraint）。
+	 * Reset Lambda and solve the BoneConstraints IterationCount times (all of them when ConstraintIndices is nullptr).
+	 */
+	void SolveBoneConstraints(int32 IterationCount, const TArray<int32>* ConstraintIndices);
+
+	/**
+	 * bridge dummy のコリジョン変位を端点ボーンへ転送する。集計バッファは使った端点だけを0へ戻す。
+	 * Transfer the collision push of the bridge dummies to their endpoint bones. Only the endpoints that were used are
+	 * cleared in the scratch buffers.
+	 */
+	void ApplyBridgeDummyFeedback(const TArray<int32>& BridgeDummies);
+
+	/** 角度制限 + 平面拘束 + ボーン長復元 / Angle limit + planar constraint + bone length restore */
+	void AdjustByLimitsAndLength(const TArray<int32>& Bones);
+
+	/**
+	 * 評価中のステップで変わらない値を1回だけ求める（剛性係数 / BaseBoneSpace の world 移動量）。
+	 * GetStepDeltaTime() と SkelCompMoveVector がこの評価のステップ値になった後、最初の SimulateOnce の前に呼ぶ。
+	 * Compute the values that stay fixed across the steps of this evaluation (stiffness factors / BaseBoneSpace world
+	 * move). Call after GetStepDeltaTime() and SkelCompMoveVector hold this evaluation's per-step values and before the
+	 * first SimulateOnce.
+	 */
+	void UpdateStepInvariants();
+
 	/**
 	 * Simulates the physics for a single bone.
 	 *
 	 * @param Bone The bone to simulate.
 	 * @param Scene The scene interface.
 	 * @param ComponentTransform The component transform.
-	 * @param Exponent The exponent for the simulation.
 	 * @param SkelComp The skeletal mesh component.
 	 * @param Output The pose context.
 	 */
 	void Simulate(FKawaiiPhysicsModifyBone& Bone, const FSceneInterface* Scene, const FTransform& ComponentTransform,
-	              const float& Exponent, const USkeletalMeshComponent* SkelComp,
-	              FComponentSpacePoseContext& Output);
+	              const USkeletalMeshComponent* SkelComp, FComponentSpacePoseContext& Output);
 
 	// ===== 物理計算の各ステップ（引数に FComponentSpacePoseContext を取らない。Simulate() から呼ばれる）=====
 	// Each physics step; takes no FComponentSpacePoseContext. Called from Simulate().
 
+	// 各関数は位置ストリーム（SolverState の要素）を直接受け取る版が本体で、FKawaiiPhysicsModifyBone 版はそれへ転送する。
+	// The location-based overloads (operating on SolverState elements) hold the math; the FKawaiiPhysicsModifyBone
+	// overloads forward to them.
+
 	/** このステップの速度を作る（速度の再構成→減衰→+wind→重力）。ユーザー外力(ApplyToVelocity)の前に呼ぶ。 */
 	FVector ComputeVerletStepVelocity(FKawaiiPhysicsModifyBone& Bone, const FVector& WindVelocity);
+	FVector ComputeVerletStepVelocity(FVector& Location, FVector& PrevLocation, float Damping,
+	                                  const FVector& WindVelocity) const;
 
 	/** Verlet ステップ後半。ComputeVerletStepVelocity が作り、外力フック(ApplyToVelocity)で調整された後の
 	 *  速度から位置を更新する（Location += Velocity * GetStepDeltaTime()）。 */
 	void IntegrateVerletStepPosition(FKawaiiPhysicsModifyBone& Bone, const FVector& Velocity);
+	void IntegrateVerletStepPosition(FVector& Location, const FVector& Velocity) const;
 
 	/** simple external force（速度を経由しない位置オフセット。位置空間の後処理）。 */
 	void ApplySimpleExternalForce(FKawaiiPhysicsModifyBone& Bone);
+	void ApplySimpleExternalForce(FVector& Location) const;
 
-	/** ComponentSpace/WorldSpace の world 移動追従（BaseBoneSpace は Simulate() 側で別処理、Output依存）。 */
+	/** ComponentSpace/WorldSpace の world 移動追従（BaseBoneSpace は ApplyWorldMoveFollowBaseBone、Output依存）。 */
 	void ApplyWorldMoveFollowNonBaseBone(FKawaiiPhysicsModifyBone& Bone);
+	void ApplyWorldMoveFollowNonBaseBone(FVector& Location, const FVector& PrevLocation, float WorldDampingLocation,
+	                                     float WorldDampingRotation) const;
+
+	/** BaseBoneSpace の world 移動追従（移動量は UpdateStepInvariants で変換済みの SkelCompMoveVectorBaseBoneSpace）。 */
+	void ApplyWorldMoveFollowBaseBone(FVector& Location, const FVector& PrevLocation, float WorldDampingLocation,
+	                                  float WorldDampingRotation) const;
 
 	/** Pull to Pose Location（剛性）。 */
 	void ApplyStiffnessPull(FKawaiiPhysicsModifyBone& Bone, const FKawaiiPhysicsModifyBone& ParentBone, float Exponent);
+	void ApplyStiffnessPull(FVector& Location, const FVector& PoseLocation, const FVector& ParentLocation,
+	                        const FVector& ParentPoseLocation, float Stiffness, float Exponent) const;
+	/** 係数 1-(1-Stiffness)^Exponent を求め済みの版（SolverState.StiffnessFactor）。 */
+	void ApplyStiffnessPull(FVector& Location, const FVector& PoseLocation, const FVector& ParentLocation,
+	                        const FVector& ParentPoseLocation, float StiffnessFactor) const;
+
+	/**
+	 * フック無しの積分フェーズを SolverState 上で4ボーンずつSIMD処理する（BaseBoneSpace 以外）。
+	 * 位置更新は転置した4ボーン分の double レーンで行い、親位置に依存する剛性の引き戻しだけを
+	 * index 順のスカラーで行う（係数は UpdateStepInvariants で求め済みの SolverState.StiffnessFactor）。
+	 * Integrates the hook-free phase on SolverState four bones at a time (non-BaseBoneSpace only). Position updates run
+	 * on transposed double lanes and only the parent-dependent stiffness pull stays scalar in index order (its factor is
+	 * SolverState.StiffnessFactor from UpdateStepInvariants).
+	 */
+	void IntegrateSolverStateSimd();
+
+	/**
+	 * 積分フェーズでボーン単位のフック（wind / CustomExternalForce / ExternalForce / Transient）が必要か。
+	 * false なら SolverState 上の高速パスで積分し、true なら ModifyBones へ同期して Simulate() を呼ぶ。
+	 * Whether the integration phase needs per-bone hooks (wind / custom / external / transient forces). When false the
+	 * fast path integrates directly on SolverState; otherwise ModifyBones is synced and Simulate() is used.
+	 */
+	bool NeedsPerBoneSimulateHooks(const FSceneInterface* Scene) const;
+
+	/**
+	 * サブステップ中にポーズ回転を読む処理があるか（平面拘束 / 角度制限の代替軸 / カスタム外力・BoneSpace の外力）。
+	 * false なら回転の補間を省いてもシミュレーション結果は変わらない。
+	 * Whether anything reads the pose rotation during substeps (planar constraint / angle-limit fallback axis / custom
+	 * or bone-space forces). When false, skipping the rotation interpolation leaves the simulation unchanged.
+	 */
+	bool NeedsSubstepPoseRotation() const;
+
+	/**
+	 * サブステップのポーズ目標を SolverState 上で補間する。位置は一括、回転は bInterpolateRotation のときだけ
+	 * Slerp（bUseNLerp なら NLerp）。ModifyBones には触れない。SolverState.GatherSubstepPoseTargets の後に呼ぶ。
+	 * Interpolate the substep pose target on SolverState. Locations are lerped in one pass; rotations are only
+	 * interpolated when bInterpolateRotation (Slerp, or NLerp with bUseNLerp). ModifyBones is not touched. Call after
+	 * SolverState.GatherSubstepPoseTargets.
+	 */
+	void InterpolateSubstepPose(float SubstepAlpha, bool bInterpolateRotation, bool bUseNLerp);
 
 	// 自動テスト用アクセサ。private/protected の sim 状態・物理計算・コリジョン関数へアクセスする。
 	// Shipping/Test（WITH_DEV_AUTOMATION_TESTS==0）では宣言ごと除外し、出荷ビルドにテスト表面を残さない。
@@ -1406,6 +2117,8 @@ protected:
 #if WITH_DEV_AUTOMATION_TESTS
 	friend struct FKawaiiPhysicsTestAccessor;
 #endif
+	// バッチ実行（RunBatchedSimulation）は Subsystem からだけ呼ぶ / The batch (RunBatchedSimulation) is only driven by the subsystem
+	friend class UKawaiiPhysicsSimulationSubsystem;
 
 	/**
 	 * Adjusts the bone position based on world collision.
@@ -1422,6 +2135,52 @@ protected:
 	void AdjustByWorldCollision(FComponentSpacePoseContext& Output, FKawaiiPhysicsModifyBone& Bone,
 	                            const USkeletalMeshComponent* OwningComp);
 
+	/** WorldCollision のトレースチャンネルとクエリ設定 / Trace channel and query settings of the world collision */
+	void MakeWorldCollisionQuery(const USkeletalMeshComponent* OwningComp, ECollisionChannel& OutTraceChannel,
+	                             FCollisionQueryParams& OutQueryParams,
+	                             FCollisionResponseParams& OutResponseParams) const;
+
+	/** IgnoreBones / IgnoreBoneNamePrefix で無視する自コンポーネントへのヒットか / Whether a hit on the own component is ignored */
+	bool IsIgnoredWorldCollisionHit(const FHitResult& Result, const FKawaiiPhysicsModifyBone& Bone,
+	                                const USkeletalMeshComponent* OwningComp);
+
+	/** IgnoreBones / IgnoreBoneNamePrefix に該当する骨名か / Whether the bone name matches IgnoreBones / IgnoreBoneNamePrefix */
+	bool IsIgnoredWorldCollisionBone(FName BoneName);
+
+	/**
+	 * Broadphase: チェーンのバウンディングボックスで1回だけ重なり判定し、見つかった単純コリジョン形状を
+	 * シミュレーション空間へ変換して CompiledWorldColliders にコンパイルする（ステップ前、フレーム毎に1回）。
+	 * Broadphase: run a single overlap query over the chain's bounding box, convert the simple collision shapes found to
+	 * simulation space and compile them into CompiledWorldColliders (once per frame, before stepping).
+	 */
+	void UpdateWorldCollisionBroadphase(FComponentSpacePoseContext& Output, const USkeletalMeshComponent* OwningComp);
+
+	/** 1ボディ分の単純コリジョン形状を World*Limits へ追加する / Add the simple collision shapes of one body to World*Limits */
+	void AddWorldCollisionBodyShapes(FComponentSpacePoseContext& Output, const FBodyInstance& Body);
+
+	/**
+	 * AggGeom の単純コリジョン形状を、ワールドトランスフォーム BodyTransform（スケール込み）のボディとして World*Limits へ追加する
+	 * Add the simple collision shapes of AggGeom to World*Limits as a body at world transform BodyTransform (scale included)
+	 */
+	void AddWorldCollisionAggGeomShapes(FComponentSpacePoseContext& Output, const FKAggregateGeom& AggGeom,
+	                                    FTransform BodyTransform);
+
+	/**
+	 * 非同期ワールドコリジョン: 揃った結果から接触平面を更新してシミュレーション空間へ変換し、スイープ始点を記録する（ステップ前）。
+	 * Async world collision: refresh the contact planes from completed results, convert them to simulation space and
+	 * record the sweep starts (before stepping).
+	 */
+	void UpdateAsyncWorldCollision(FComponentSpacePoseContext& Output, const USkeletalMeshComponent* OwningComp);
+
+	/**
+	 * 非同期ワールドコリジョン: このフレームの移動を覆うスイープを積み、Subsystem に発行を頼む（ステップ後）。
+	 * Async world collision: stage sweeps covering this frame's motion and ask the subsystem to issue them (after stepping).
+	 */
+	void StageAsyncWorldCollision(FComponentSpacePoseContext& Output, const USkeletalMeshComponent* OwningComp);
+
+	/** 接触平面の裏に入った球の中心を平面上へ戻す / Push a sphere centre that went behind its contact plane back onto it */
+	void AdjustByAsyncWorldContact(FVector& Location, int32 BoneIndex) const;
+
 	/**
 	 * Adjusts the bone position based on spherical collision limits.
 	 *
@@ -1429,10 +2188,63 @@ protected:
 	 * @param Limits An array of spherical limits.
 	 */
 	void AdjustBySphereCollision(FKawaiiPhysicsModifyBone& Bone, TArray<FSphericalLimit>& Limits);
+	void AdjustBySphereCollision(FVector& Location, float Radius, TArray<FSphericalLimit>& Limits);
 
-	// コリジョン形状の派生値キャッシュを再計算 / Recompute derived-value caches of collision shapes
+	/**
+	 * コリジョン形状の派生値キャッシュを再計算し、有効な limit を CompiledColliders / CompiledSharedColliders へ詰める。
+	 * Recompute derived-value caches of collision shapes and pack the enabled limits into CompiledColliders /
+	 * CompiledSharedColliders.
+	 */
 	void PrepareCollisionShapeCaches();
 
+	/**
+	 * コリジョン対象ボーン（simulate 対象 + bridge dummy）の掃引 AABB を、現在位置・前回位置・1ステップ先の外挿位置・
+	 * ポーズ位置から求め、最大ボーン半径と ColliderCullingMargin で広げて返す。
+	 * カリング無効時 / 対象ボーンが無い時は無効な箱（何も間引かない）を返す。
+	 * Swept AABB of the colliding bones (simulated + bridge dummies) over the current, previous, one-step extrapolated
+	 * and pose locations, grown by the largest bone radius and ColliderCullingMargin. Returns an invalid box (culls
+	 * nothing) when culling is disabled or no bone collides.
+	 */
+	FBox ComputeCollisionCullBounds() const;
+
+	/**
+	 * 自ノードの limit ごとに、判定するボーンのビットマスクを作る（limit の BoneFilter と bAutoColliderRelevance から）。
+	 * 全ボーンと判定する limit はマスクを持たない。limit とボーン構成が変わった時に作り直す。
+	 * Build, for each of this node's limits, the bitmask of bones it is tested against (from the limit's BoneFilter and
+	 * bAutoColliderRelevance). Limits tested against every bone get no mask. Rebuild when the limits or bones change.
+	 */
+	void BuildColliderRelevanceMasks(const FReferenceSkeleton& RefSkeleton);
+
+	/**
+	 * コンパイル済みバッファの全コライダーで押し出す（形状ごとに1パス。順序は Sphere→Capsule→Tapered→Box→Planar）。
+	 * bUseSimdNarrowphase なら Planar 以外は4コライダー単位の SIMD 判定で候補を絞ってから押し出す。
+	 * Push the location out of every collider in a compiled buffer (one pass per shape type, in the order
+	 * Sphere -> Capsule -> TaperedCapsule -> Box -> Planar). With bUseSimdNarrowphase, every shape but planes is culled
+	 * by a 4-collider SIMD test first. Buffers with a grid only resolve the colliders of the bone's cell (same order).
+	 * BoneIndex を渡すと、関連マスクでそのボーンと無関係なコライダーを飛ばす。
+	 * Passing BoneIndex skips the colliders whose relevance mask excludes that bone.
+	 */
+	void AdjustByColliderBuffer(FVector& Location, const FVector& PrevLocation, float Radius,
+	                            const FKawaiiPhysicsColliderBuffer& Colliders, int32 BoneIndex = INDEX_NONE) const;
+
+	/**
+	 * bBoneSegmentCollision: Bones の各ボーンと実親を結ぶ区間をカプセルとしてコンパイル済みバッファ（自ノード / 共有）の
+	 * Sphere / Capsule / TaperedCapsule と判定し、押し出しを接触位置に応じて両端へ配分する（固定された親は動かさない）。
+	 * bBoneSegmentCollision: collide the segment from each bone in Bones to its real parent, as a capsule, against the
+	 * spheres, capsules and tapered capsules of the compiled buffers (own / shared), splitting each push-out between
+	 * both ends by where the contact lies (a pinned parent does not move).
+	 */
+	void AdjustBoneSegmentsByCollision(const TArray<int32>& Bones);
+
+	/**
+	 * bBoneConstraintEdgeCollision: MergedBoneConstraints（ConstraintIndices 指定時はその分だけ）の辺をカプセルとして
+	 * AdjustBoneSegmentsByCollision と同じ形状と判定し、押し出しを両端点のボーンへ配分する（固定された端点は動かさない）。
+	 * bBoneConstraintEdgeCollision: collide the edges of MergedBoneConstraints (only ConstraintIndices when given), as
+	 * capsules, against the same shapes as AdjustBoneSegmentsByCollision and split each push-out between the two
+	 * endpoint bones (a pinned endpoint does not move).
+	 */
+	void AdjustBoneConstraintEdgesByCollision(const TArray<int32>* ConstraintIndices);
+
 	/**
 	 * Adjusts the bone position based on capsule collision limits.
 	 *
@@ -1440,6 +2252,7 @@ protected:
 	 * @param Limits An array of capsule limits.
 	 */
 	void AdjustByCapsuleCollision(FKawaiiPhysicsModifyBone& Bone, TArray<FCapsuleLimit>& Limits);
+	void AdjustByCapsuleCollision(FVector& Location, float Radius, TArray<FCapsuleLimit>& Limits);
 
 	/**
 	 * Adjusts the bone position based on tapered capsule collision limits.
@@ -1448,6 +2261,7 @@ protected:
 	 * @param Limits An array of tapered capsule limits.
 	 */
 	void AdjustByTaperedCapsuleCollision(FKawaiiPhysicsModifyBone& Bone, TArray<FTaperedCapsuleLimit>& Limits);
+	void AdjustByTaperedCapsuleCollision(FVector& Location, float Radius, TArray<FTaperedCapsuleLimit>& Limits);
 
 	/**
 	 * Adjusts the bone position based on box collision limits.
@@ -1456,6 +2270,7 @@ protected:
 	 * @param Limits An array of box limits.
 	 */
 	void AdjustByBoxCollision(FKawaiiPhysicsModifyBone& Bone, TArray<FBoxLimit>& Limits);
+	void AdjustByBoxCollision(FVector& Location, float Radius, TArray<FBoxLimit>& Limits);
 
 	/**
 	 * Adjusts the bone position based on planar collision limits.
@@ -1464,6 +2279,8 @@ protected:
 	 * @param Limits An array of planar limits.
 	 */
 	void AdjustByPlanerCollision(FKawaiiPhysicsModifyBone& Bone, TArray<FPlanarLimit>& Limits);
+	void AdjustByPlanerCollision(FVector& Location, const FVector& PrevLocation, float Radius,
+	                             TArray<FPlanarLimit>& Limits);
 
 	/**
 	 * Adjusts the bone position based on angle limits.
@@ -1474,6 +2291,11 @@ protected:
 	void AdjustByAngleLimit(
 		FKawaiiPhysicsModifyBone& Bone,
 		const FKawaiiPhysicsModifyBone& ParentBone);
+	void AdjustByAngleLimit(FVector& Location, const FVector& PoseLocation, const FVector& ParentLocation,
+	                        const FVector& ParentPoseLocation, const FQuat& ParentPoseRotation, float LimitAngle);
+	/** 親→子のポーズ方向を求め済みの版（SolverState.PoseDirection） / Variant taking the precomputed pose direction */
+	void AdjustByAngleLimit(FVector& Location, const FVector& ParentLocation, const FVector& PoseDir,
+	                        const FQuat& ParentPoseRotation, float LimitAngle);
 
 	/**
 	 * Adjusts the bone position based on planar constraints.
@@ -1482,11 +2304,29 @@ protected:
 	 * @param ParentBone The parent bone.
 	 */
 	void AdjustByPlanarConstraint(FKawaiiPhysicsModifyBone& Bone, const FKawaiiPhysicsModifyBone& ParentBone);
+	void AdjustByPlanarConstraint(FVector& Location, const FVector& ParentLocation, const FQuat& ParentPoseRotation);
 
 	/**
 	 * Adjusts the bone positions based on bone constraints.
+	 *
+	 * @param Locations SolverState.Location（ModifyBones と同じindex） / SolverState.Location (indexed like ModifyBones)
 	 */
-	void AdjustByBoneConstraints();
+	void AdjustByBoneConstraints(TArray<FVector>& Locations);
+	/** ConstraintIndices の Constraint だけを解く / Solve only the constraints in ConstraintIndices */
+	void AdjustByBoneConstraints(TArray<FVector>& Locations, const TArray<int32>& ConstraintIndices);
+	void AdjustByBoneConstraint(FModifyBoneConstraint& BoneConstraint, TArray<FVector>& Locations);
+
+	/**
+	 * 色ごとのバッチで全 Constraint を1回解く（BoneConstraintColors の色順。同じ順で逐次に解いた結果とビット一致）。
+	 * 1色を4本ずつ SIMD で解き、色が大きければバッチを ParallelFor で分ける。
+	 * Solve every constraint once, colour by colour (BoneConstraintColors order; bit-identical to a sequential solve in
+	 * that order). Each colour runs four constraints at a time with SIMD and large colours are split across
+	 * ParallelFor.
+	 */
+	void AdjustByBoneConstraintsColored(TArray<FVector>& Locations);
+
+	/** XPBD の Lambda 増分（compliance は GetStepDeltaTime() で換算） / XPBD lambda increment (compliance scaled by GetStepDeltaTime()) */
+	float ComputeBoneConstraintDeltaLambda(const FModifyBoneConstraint& BoneConstraint, float DeltaLength) const;
 
 	/**
 	 * Applies the simulation results to the bone transforms.
@@ -1537,6 +2377,7 @@ private:
 	bool bModifyBonesNeedsReinit = false;
 	int32 LastInitializedBoneSubdivisionCount = 0;
 	int32 LastInitializedBoneConstraintSubdivisionCount = 0;
+	bool LastInitializedBoneConstraintEdgeCollision = false;
 	// DensifyByRadiusは配置数（生成トポロジ）を左右するため再構築判定に含める。既定値はプロパティのデフォルトに合わせる
 	// DensifyByRadius affects the placed dummy count (generation topology), so it's part of the reinit check. Default matches the property.
 	bool LastInitializedBoneSubdivisionDensifyByRadius = false;
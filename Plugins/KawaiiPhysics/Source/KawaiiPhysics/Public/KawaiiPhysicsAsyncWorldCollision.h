@@ -0,0 +1,94 @@
+// Copyright 2019-2026 pafuhana1213. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CollisionQueryParams.h"
+#include "Engine/HitResult.h"
+#include "HAL/CriticalSection.h"
+#include "Templates/SharedPointer.h"
+#include "WorldCollision.h"
+
+class UWorld;
+
+/**
+ * 非同期ワールドコリジョン（EKawaiiPhysicsWorldCollisionMode::AsyncSweep）の1ノード分のスイープ要求と結果。
+ * ノードは Evaluate(AnyThread) でフレーム分のスイープを積み、UKawaiiPhysicsSimulationSubsystem が全 Actor Tick 後に
+ * GameThread で AsyncSweepByChannel として発行する。結果はバッチ単位で揃ってから次の Evaluate に渡す。
+ * Sweep requests and results of one node for async world collision (EKawaiiPhysicsWorldCollisionMode::AsyncSweep).
+ * The node stages one frame of sweeps in Evaluate (AnyThread), UKawaiiPhysicsSimulationSubsystem issues them on the
+ * GameThread as AsyncSweepByChannel after all actors have ticked, and the results are handed to a later Evaluate once
+ * the whole batch has come back.
+ */
+class KAWAIIPHYSICS_API FKawaiiPhysicsAsyncWorldCollision
+	: public TSharedFromThis<FKawaiiPhysicsAsyncWorldCollision, ESPMode::ThreadSafe>
+{
+public:
+	/** ワールド空間の球スイープ1本 / One sphere sweep in world space */
+	struct FSweep
+	{
+		int32 BoneIndex = INDEX_NONE;
+		FVector Start = FVector::ZeroVector;
+		FVector End = FVector::ZeroVector;
+		float Radius = 0.0f;
+	};
+
+	/** ヒットのあったスイープの結果 / Result of a sweep that hit something */
+	struct FSweepResult
+	{
+		int32 BoneIndex = INDEX_NONE;
+		TArray<FHitResult> Hits;
+	};
+
+	/**
+	 * 次に発行するスイープを積む（ワーカースレッド）。未発行の前回分は置き換える。
+	 * InOutSweeps とは中身を入れ替えるので、呼び出し側はそのまま次フレームのスクラッチに使える。
+	 * Stage the sweeps to issue next (worker thread), replacing any batch not issued yet. The contents are swapped with
+	 * InOutSweeps so the caller can keep using it as next frame's scratch.
+	 */
+	void StageSweeps(TArray<FSweep>& InOutSweeps, ECollisionChannel InTraceChannel,
+	                 const FCollisionQueryParams& InQueryParams, const FCollisionResponseParams& InResponseParams,
+	                 bool bInMultiHit);
+
+	/** 積まれたスイープを発行し、発行数を返す（GameThread） / Issue the staged sweeps and return how many (GameThread) */
+	int32 IssueStagedSweeps(UWorld& World);
+
+	/**
+	 * 前回の取り出し以降にバッチが揃っていれば OutResults と入れ替えて true を返す（ワーカースレッド）。
+	 * If a batch has completed since the last call, swap it into OutResults and return true (worker thread).
+	 */
+	bool ConsumeResults(TArray<FSweepResult>& OutResults);
+
+	/** 発行済みで未完了のスイープ数 / Number of issued sweeps that have not completed yet */
+	int32 GetNumInFlight() const;
+
+private:
+	friend struct FKawaiiPhysicsTestAccessor;
+
+	/**
+	 * 積まれたスイープを次のバッチとして発行済みへ移す（Lock 保持中）。積まれていなければ false
+	 * Move the staged sweeps into a new issued batch (Lock held). Returns false if nothing was staged
+	 */
+	bool BeginIssuedBatch();
+
+	void OnSweepCompleted(const FTraceHandle& Handle, FTraceDatum& Datum, uint32 InBatchSerial);
+
+	mutable FCriticalSection Lock;
+
+	// 発行待ち / Waiting to be issued
+	TArray<FSweep> StagedSweeps;
+	ECollisionChannel TraceChannel = ECC_WorldDynamic;
+	FCollisionQueryParams QueryParams;
+	FCollisionResponseParams ResponseParams;
+	bool bMultiHit = false;
+
+	// 発行済みのバッチ（UserData がこの index） / Issued batch (UserData is the index into it)
+	TArray<FSweep> IssuedSweeps;
+	TArray<FSweepResult> PendingResults;
+	uint32 BatchSerial = 0;
+	int32 NumInFlight = 0;
+
+	// 揃ったバッチ / Completed batch
+	TArray<FSweepResult> CompletedResults;
+	bool bHasCompletedResults = false;
+};
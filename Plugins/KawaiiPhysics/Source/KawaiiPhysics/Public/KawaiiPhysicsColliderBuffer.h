@@ -0,0 +1,280 @@
+// Copyright 2019-2026 pafuhana1213. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "KawaiiPhysicsCollisionLimits.h"
+
+/**
+ * ナローフェーズ用にコンパイルしたコライダーの SoA バッファ。
+ * PrepareCollisionShapeCaches が有効かつ非縮退の limit だけを形状ごとに詰め、押し出し計算に要る派生値
+ * （中心 / 軸端点 / 半径 / 逆変換用トランスフォーム）のみを持つ。bEnable や半径の判定、DrivingBone 等の冷データは
+ * ボーンループに持ち込まない。
+ * Structure-of-arrays buffer of colliders compiled for the narrowphase. PrepareCollisionShapeCaches packs only the
+ * enabled, non-degenerate limits per shape type and keeps just the derived values the push-out needs (center, segment
+ * endpoints, radii, transform for the inverse mapping). bEnable / radius checks and cold data such as DrivingBone stay
+ * out of the per-bone loop.
+ */
+struct KAWAIIPHYSICS_API FKawaiiPhysicsColliderBuffer
+{
+	/** SIMD 判定の1ブロックあたりのコライダー数 / Colliders per SIMD test block */
+	static constexpr int32 SimdBlockSize = 4;
+
+	// ===== SIMD 判定用ブロック（4コライダーを成分ごとに転置。端数レーンは絶対に当たらない値で埋める） =====
+	// SIMD test blocks (4 colliders transposed per component; tail lanes are padded with values that never hit)
+	struct FSphereBlock
+	{
+		double CenterX[SimdBlockSize];
+		double CenterY[SimdBlockSize];
+		double CenterZ[SimdBlockSize];
+		// Inner は判定を常に候補扱いにするため巨大値 / Huge for Inner so the test always reports a candidate
+		double Radius[SimdBlockSize];
+	};
+
+	struct FCapsuleBlock
+	{
+		double StartX[SimdBlockSize];
+		double StartY[SimdBlockSize];
+		double StartZ[SimdBlockSize];
+		double SegmentX[SimdBlockSize];
+		double SegmentY[SimdBlockSize];
+		double SegmentZ[SimdBlockSize];
+		double RcpSegmentSizeSq[SimdBlockSize];
+		// テーパーカプセルは Max(Radius0, Radius1, 0) / Max(Radius0, Radius1, 0) for tapered capsules
+		double Radius[SimdBlockSize];
+	};
+
+	struct FBoxBlock
+	{
+		double CenterX[SimdBlockSize];
+		double CenterY[SimdBlockSize];
+		double CenterZ[SimdBlockSize];
+		double RotationX[SimdBlockSize];
+		double RotationY[SimdBlockSize];
+		double RotationZ[SimdBlockSize];
+		double RotationW[SimdBlockSize];
+		double ExtentX[SimdBlockSize];
+		double ExtentY[SimdBlockSize];
+		// 負の Extent を含む Box は巨大値（常に候補） / Huge (always a candidate) for boxes with a negative extent
+		double ExtentZ[SimdBlockSize];
+	};
+
+	struct FSpheres
+	{
+		TArray<FVector> Center;
+		TArray<float> Radius;
+		// 1 = Inner（内側に拘束） / 1 = Inner (keep bodies inside)
+		TArray<uint8> bInner;
+		TArray<FSphereBlock> Blocks;
+		// 関連マスクの位置（RelevanceMasks がある時だけ詰める） / Relevance mask offsets (only filled with RelevanceMasks)
+		TArray<int32> RelevanceMask;
+
+		int32 Num() const { return Center.Num(); }
+	};
+
+	struct FCapsules
+	{
+		TArray<FVector> Start;
+		TArray<FVector> End;
+		TArray<FVector> FallbackPushDir;
+		TArray<float> Radius;
+		TArray<FCapsuleBlock> Blocks;
+		// 関連マスクの位置（RelevanceMasks がある時だけ詰める） / Relevance mask offsets (only filled with RelevanceMasks)
+		TArray<int32> RelevanceMask;
+
+		int32 Num() const { return Start.Num(); }
+	};
+
+	struct FTaperedCapsules
+	{
+		// 長さ0のカプセルは Segment=0 / SegmentSizeSq=1 / Radius0=Radius1=最大半径 として球に畳み込む
+		// Zero-length capsules are folded into a sphere: Segment=0, SegmentSizeSq=1, Radius0=Radius1=max radius
+		TArray<FVector> Start;
+		TArray<FVector> Segment;
+		TArray<FVector> FallbackPushDir;
+		TArray<FVector::FReal> SegmentSizeSq;
+		TArray<float> Radius0;
+		TArray<float> Radius1;
+		TArray<FCapsuleBlock> Blocks;
+		// 関連マスクの位置（RelevanceMasks がある時だけ詰める） / Relevance mask offsets (only filled with RelevanceMasks)
+		TArray<int32> RelevanceMask;
+
+		int32 Num() const { return Start.Num(); }
+	};
+
+	struct FBoxes
+	{
+		TArray<FTransform> Transform;
+		TArray<FVector> Extent;
+		TArray<FBoxBlock> Blocks;
+		// 関連マスクの位置（RelevanceMasks がある時だけ詰める） / Relevance mask offsets (only filled with RelevanceMasks)
+		TArray<int32> RelevanceMask;
+
+		int32 Num() const { return Transform.Num(); }
+	};
+
+	struct FPlanes
+	{
+		TArray<FPlane> Plane;
+		TArray<FVector> Normal;
+		// 関連マスクの位置（RelevanceMasks がある時だけ詰める） / Relevance mask offsets (only filled with RelevanceMasks)
+		TArray<int32> RelevanceMask;
+
+		int32 Num() const { return Plane.Num(); }
+	};
+
+	/** グリッドに登録する形状（キーの上位ビット。値の順が押し出しの適用順） / Shape stored in a grid key (upper bits; value order is the push-out order) */
+	enum class EGridShape : uint32
+	{
+		Sphere,
+		Capsule,
+		TaperedCapsule,
+		Box,
+	};
+
+	static constexpr uint32 GridKeyIndexBits = 30;
+
+	/** 形状と index を1語に詰める。キーの昇順がそのままブロードフェーズ無しの適用順になる / Pack shape and index; ascending keys follow the brute-force order */
+	static uint32 MakeGridKey(const EGridShape Shape, const int32 Index)
+	{
+		return (static_cast<uint32>(Shape) << GridKeyIndexBits) | static_cast<uint32>(Index);
+	}
+
+	static EGridShape GetGridKeyShape(const uint32 Key) { return static_cast<EGridShape>(Key >> GridKeyIndexBits); }
+	static int32 GetGridKeyIndex(const uint32 Key) { return static_cast<int32>(Key & ((1u << GridKeyIndexBits) - 1)); }
+
+	/**
+	 * Sphere / Capsule / TaperedCapsule / Box の AABB を登録した一様グリッド（セルごとのキー列を CSR で保持）。
+	 * 各セルのキーは昇順なので、1セルの列を順に確定すれば総当たりと同じ順序で押し出せる。範囲はコライダー AABB の
+	 * 和集合で、外側の点は端のセルへ丸める（範囲外にコライダーは無いので取りこぼさない）。Inner スフィアと負の Extent
+	 * の Box は全セルに入れる。
+	 * Uniform grid over the AABBs of spheres, capsules, tapered capsules and boxes (per-cell key lists in CSR form).
+	 * Keys in a cell are ascending, so resolving one cell's list in order pushes in the same order as brute force. The
+	 * grid spans the union of the collider AABBs and clamps outside points to the border cells (no collider lies out
+	 * there). Inner spheres and boxes with a negative extent are stored in every cell.
+	 */
+	struct FGrid
+	{
+		FVector Origin = FVector::ZeroVector;
+		FVector InvCellSize = FVector::ZeroVector;
+		FIntVector Dims = FIntVector::ZeroValue;
+		// セル c のキーは CellEntries[CellOffsets[c], CellOffsets[c + 1]) / Keys of cell c
+		TArray<int32> CellOffsets;
+		TArray<uint32> CellEntries;
+
+		bool IsValid() const { return CellOffsets.Num() > 0; }
+
+		/**
+		 * Center ± Extent の箱が収まる1セルを返す。複数セルにまたがるなら false。
+		 * Find the single cell containing the box Center ± Extent; false if it spans several cells.
+		 */
+		bool FindCell(const FVector& Center, double Extent, int32& OutCell) const;
+
+		TConstArrayView<uint32> GetCellEntries(const int32 Cell) const
+		{
+			return MakeArrayView(CellEntries.GetData() + CellOffsets[Cell], CellOffsets[Cell + 1] - CellOffsets[Cell]);
+		}
+
+		FIntVector GetCellCoord(const FVector& Location) const;
+		int32 GetCellIndex(const FIntVector& Coord) const { return (Coord.Z * Dims.Y + Coord.Y) * Dims.X + Coord.X; }
+	};
+
+	FSpheres Spheres;
+	FCapsules Capsules;
+	FTaperedCapsules TaperedCapsules;
+	FBoxes Boxes;
+	FPlanes Planes;
+	FGrid Grid;
+
+	/**
+	 * ブロードフェーズのカリング範囲（チェーンの掃引 AABB を最大ボーン半径＋マージンで広げたもの）。
+	 * Append はこの箱と AABB が重ならないコライダーを詰めない。無効な箱なら何も間引かない。Reset 後、Append の前に設定する。
+	 * Inner スフィア / 負の Extent の Box / Plane は範囲外でも押し出し得るため常に残す。
+	 * Broadphase cull bounds (the swept AABB of the chains grown by the largest bone radius plus a margin). The Appends
+	 * skip colliders whose AABB does not overlap it; an invalid box culls nothing. Set after Reset and before the Appends.
+	 * Inner spheres, boxes with a negative extent and planes can push from outside the bounds, so they are always kept.
+	 */
+	FBox CullBounds = FBox(ForceInit);
+
+	/** 直近の Reset 以降に CullBounds で間引いたコライダー数 / Colliders culled against CullBounds since the last Reset */
+	int32 NumCulled = 0;
+
+	/**
+	 * コライダーとボーンの関連マスク（limit の CachedRelevanceMask が指す先。1コライダー RelevanceMaskWords 語で、
+	 * bit i が ModifyBone i）。空なら何もマスクしない。CullBounds と同じく Reset 後、Append の前に設定する。
+	 * Collider-to-bone relevance masks (what each limit's CachedRelevanceMask points into; RelevanceMaskWords words per
+	 * collider, bit i is ModifyBone i). Empty masks nothing. Set after Reset and before the Appends, like CullBounds.
+	 */
+	TConstArrayView<uint32> RelevanceMasks;
+	int32 RelevanceMaskWords = 0;
+
+	/** 1ボーン分の関連判定 / Relevance test for one bone */
+	struct FRelevanceFilter
+	{
+		// nullptr なら何も飛ばさない / Skips nothing when null
+		const uint32* Masks = nullptr;
+		int32 Word = 0;
+		uint32 Bit = 0;
+
+		/** 形状の i 番目のコライダーをこのボーンで飛ばすか / Whether this bone skips collider i of a shape */
+		bool Skips(const TArray<int32>& ShapeMasks, const int32 i) const
+		{
+			if (!Masks)
+			{
+				return false;
+			}
+			const int32 Offset = ShapeMasks[i];
+			return Offset != INDEX_NONE && (Masks[Offset + Word] & Bit) == 0;
+		}
+	};
+
+	/**
+	 * BoneIndex のボーン用の関連判定。マスクが無い、または BoneIndex がマスクの範囲外なら何も飛ばさない。
+	 * Relevance test for the bone at BoneIndex. Skips nothing without masks or when BoneIndex is outside them.
+	 */
+	FRelevanceFilter MakeRelevanceFilter(int32 BoneIndex) const;
+
+	/** 確保済みメモリを保ったまま空にする / Empty while keeping the allocations */
+	void Reset();
+
+	bool IsEmpty() const
+	{
+		return Spheres.Num() == 0 && Capsules.Num() == 0 && TaperedCapsules.Num() == 0 && Boxes.Num() == 0 &&
+			Planes.Num() == 0;
+	}
+
+	int32 Num() const
+	{
+		return Spheres.Num() + Capsules.Num() + TaperedCapsules.Num() + Boxes.Num() + Planes.Num();
+	}
+
+	/**
+	 * 有効な limit の実行時キャッシュを更新し、縮退しておらず CullBounds と重なるものだけを末尾に追加する（配列内の順序は保持）。
+	 * Refresh the runtime cache of each enabled limit and append the non-degenerate ones that overlap CullBounds (array
+	 * order is preserved).
+	 */
+	void Append(TArray<FSphericalLimit>& Limits);
+	void Append(TArray<FCapsuleLimit>& Limits);
+	void Append(TArray<FTaperedCapsuleLimit>& Limits);
+	void Append(TArray<FBoxLimit>& Limits);
+	void Append(TArray<FPlanarLimit>& Limits);
+
+	/** RelevanceMasks があれば limit のマスク位置を形状の列へ積む（範囲外なら INDEX_NONE） / Push the limit's mask offset when masking (INDEX_NONE if out of range) */
+	void AddRelevanceMask(TArray<int32>& ShapeMasks, const FCollisionLimitBase& Limit);
+
+	/**
+	 * Append 済みの Sphere / Capsule / TaperedCapsule / Box から SIMD 判定用ブロックを作る（Append の後に1回呼ぶ）。
+	 * Build the SIMD test blocks of spheres, capsules, tapered capsules and boxes (call once after the Appends).
+	 */
+	void BuildSimdBlocks();
+
+	/**
+	 * Plane 以外のコライダー数が MinColliders 以上なら一様グリッドを作る（未満 / MinColliders<=0 なら作らない）。
+	 * Append の後に1回呼ぶ。
+	 * Build the uniform grid when there are at least MinColliders non-plane colliders (none below that, or when
+	 * MinColliders <= 0). Call once after the Appends.
+	 */
+	void BuildGrid(int32 MinColliders);
+
+	SIZE_T GetAllocatedSize() const;
+};
@@ -38,6 +38,28 @@ enum class ECollisionSourceType : uint8
 	Mirror,
 };
 
+/**
+ * コリジョンを判定するボーンの絞り込み。空なら全ボーンと判定する。
+ * ダミーボーンは元になった実ボーン（ボーン間 / ブリッジは両端のどちらか）で判定する。
+ * Restricts which bones a collision is tested against. Empty tests every bone.
+ * Dummy bones are matched by the real bones they come from (either end for inter-bone and bridge dummies).
+ */
+USTRUCT(BlueprintType)
+struct FKawaiiPhysicsLimitBoneFilter
+{
+	GENERATED_BODY()
+
+	/** 判定するボーン / Bones to test */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Bone Filter")
+	TArray<FBoneReference> Bones;
+
+	/** このボーンとその子孫を判定する / Test these bones and their descendants */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Bone Filter")
+	TArray<FBoneReference> RootBones;
+
+	bool IsEmpty() const { return Bones.IsEmpty() && RootBones.IsEmpty(); }
+};
+
 /**
  * コリジョンLimitの基底構造体。
  * Base structure for defining collision limits in KawaiiPhysics.
@@ -75,6 +97,14 @@ struct FCollisionLimitBase
 	UPROPERTY(VisibleAnywhere, Category = "Collision Limit Base")
 	ECollisionSourceType SourceType = ECollisionSourceType::AnimNode;
 
+	/** 判定するボーンの絞り込み（空なら全ボーン） / Bones this collision is tested against (empty = all bones) */
+	UPROPERTY(EditAnywhere, AdvancedDisplay, Category = "Collision Limit Base")
+	FKawaiiPhysicsLimitBoneFilter BoneFilter;
+
+	// 実行時キャッシュ：ノードの関連マスク配列内の位置（INDEX_NONE = 全ボーン）。BuildColliderRelevanceMasks が設定する
+	// Runtime cache: offset into the node's relevance masks (INDEX_NONE = all bones), set by BuildColliderRelevanceMasks
+	int32 CachedRelevanceMask = INDEX_NONE;
+
 #if WITH_EDITORONLY_DATA
 
 	/** コリジョンの一意な識別子（エディタ専用） / Unique identifier for the collision limit (editor only) */
@@ -97,6 +127,9 @@ struct FCollisionLimitBase
 		Rotation = Other.Rotation;
 		bEnable = Other.bEnable;
 		SourceType = Other.SourceType;
+		BoneFilter = Other.BoneFilter;
+		// 別の limit を代入したらマスクは次の再構築まで全ボーン扱いに戻す（古いマスクを別の limit に当てない）
+		CachedRelevanceMask = INDEX_NONE;
 #if WITH_EDITORONLY_DATA
 		Guid = Other.Guid;
 		Type = Other.Type;
@@ -271,13 +304,10 @@ struct FBoxLimit : public FCollisionLimitBase
 
 	// 実行時キャッシュ（毎ステップ再計算、シリアライズ対象外） / Runtime cache (recomputed every step, not serialized)
 	FTransform CachedBoxTransform = FTransform::Identity;
-	// FBox は既定構築で Min/Max が未初期化のため ForceInit で明示ゼロ化 / FBox default construction leaves Min/Max uninitialized, so ForceInit explicitly zeroes it
-	FBox CachedLocalBox = FBox(ForceInit);
 
 	void UpdateRuntimeCache()
 	{
 		CachedBoxTransform = FTransform(Rotation, Location);
-		CachedLocalBox = FBox(-Extent, Extent);
 	}
 
 	/** Assignment operator */
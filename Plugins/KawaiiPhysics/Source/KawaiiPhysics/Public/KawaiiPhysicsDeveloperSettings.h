@@ -20,6 +20,25 @@ enum class EKawaiiPhysicsMcpNodePlacementDirection : uint8
 	Horizontal,
 };
 
+/** サブステップ中のポーズ回転の補間方法 / How fixed substeps interpolate the pose rotation. */
+UENUM(BlueprintType)
+enum class EKawaiiPhysicsSubstepRotationInterpolation : uint8
+{
+	/** 常に Slerp（従来挙動） / Always Slerp (legacy behavior). */
+	Slerp,
+	/**
+	 * 回転を読む処理（平面拘束 / 角度制限 / BoneSpace の外力）が無いフレームは補間を省き、あれば Slerp。
+	 * Skip the interpolation on frames where nothing reads the rotation (planar constraint / angle limit / bone-space
+	 * forces), otherwise Slerp.
+	 */
+	SlerpWhenUsed,
+	/**
+	 * SlerpWhenUsed と同じ判定で、補間するときは正規化付きの線形補間（NLerp。近似だが Slerp より軽い）。
+	 * Same check as SlerpWhenUsed, but interpolate with a normalized lerp (NLerp; approximate, cheaper than Slerp).
+	 */
+	NLerpWhenUsed,
+};
+
 /**
  * KawaiiPhysics のプロジェクト全体設定 / Project-wide settings for KawaiiPhysics.
  * Project Settings > Plugins > Kawaii Physics に表示される。
@@ -51,6 +70,71 @@ public:
 			EditCondition = "bUseFixedSubstepping"))
 	int32 MaxSubsteps = 4;
 
+	/**
+	* サブステップ毎のポーズ回転の補間方法。位置は常に線形補間する。
+	* How each substep interpolates the pose rotation. Pose locations are always lerped.
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Simulation",
+		meta = (DisplayName = "Substep Rotation Interpolation", EditCondition = "bUseFixedSubstepping"))
+	EKawaiiPhysicsSubstepRotationInterpolation SubstepRotationInterpolation =
+		EKawaiiPhysicsSubstepRotationInterpolation::SlerpWhenUsed;
+
+	/**
+	* 全ノード合計のシミュレーション負荷にフレーム予算を設ける。各ノードの負荷をボーン数・コライダー数・サブステップ数・
+	* BoneConstraint 数から見積もり、Significance（未設定なら画面サイズ）の高い順に予算を割り当て、超えた分は
+	* 低頻度更新または停止にする。割り当ては全 Actor Tick 後に行い、次のフレームから適用される。
+	* Put a frame budget on the total simulation cost of all nodes. Each node's cost is estimated from its bone, collider,
+	* substep and BoneConstraint counts; the budget is handed out by descending Significance (screen size when unset)
+	* and nodes past it drop to a reduced update rate or are frozen. The allocation runs after all actors have ticked
+	* and applies from the next frame.
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Budget",
+		meta = (DisplayName = "Use Simulation Budget"))
+	bool bUseSimulationBudget = false;
+
+	/**
+	* 1フレームあたりの予算（ミリ秒、見積もり値）。最も優先度の高いノードは予算を超えても毎フレーム更新する。
+	* Budget per frame in milliseconds (estimated). The highest priority node is always updated every frame, even if it
+	* alone exceeds the budget.
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Budget",
+		meta = (DisplayName = "Simulation Budget (ms)", ClampMin = "0.0", UIMin = "0.0", UIMax = "10.0",
+			EditCondition = "bUseSimulationBudget"))
+	float SimulationBudgetMs = 2.0f;
+
+	/**
+	* Reduced になったノードの更新間隔（フレーム）。予算上は負荷をこの値で割って計上する。
+	* Update interval in frames of nodes in the Reduced tier. Their cost is divided by this when charged to the budget.
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Budget",
+		meta = (DisplayName = "Reduced Update Interval", ClampMin = "2", UIMin = "2", ClampMax = "16",
+			EditCondition = "bUseSimulationBudget"))
+	int32 ReducedUpdateInterval = 3;
+
+	/**
+	* 負荷見積もり：1ボーン・1ステップあたりのコスト（マイクロ秒）。stat KawaiiPhysics の実測に合わせて調整する。
+	* Cost estimate: microseconds per simulated bone per step. Tune against the measured stat KawaiiPhysics numbers.
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Budget", AdvancedDisplay,
+		meta = (DisplayName = "Cost per Bone Step (us)", ClampMin = "0.0", EditCondition = "bUseSimulationBudget"))
+	float BudgetCostPerBoneStepUs = 0.2f;
+
+	/**
+	* 負荷見積もり：1ボーン・1コライダー・1ステップあたりのコスト（マイクロ秒）。
+	* Cost estimate: microseconds per bone-collider pair per step.
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Budget", AdvancedDisplay,
+		meta = (DisplayName = "Cost per Collider Test (us)", ClampMin = "0.0", EditCondition = "bUseSimulationBudget"))
+	float BudgetCostPerColliderTestUs = 0.02f;
+
+	/**
+	* 負荷見積もり：1 BoneConstraint・1反復・1ステップあたりのコスト（マイクロ秒）。
+	* Cost estimate: microseconds per BoneConstraint per iteration per step.
+	*/
+	UPROPERTY(EditAnywhere, config, Category = "Budget", AdvancedDisplay,
+		meta = (DisplayName = "Cost per Bone Constraint (us)", ClampMin = "0.0", EditCondition = "bUseSimulationBudget"))
+	float BudgetCostPerBoneConstraintUs = 0.1f;
+
 #if WITH_EDITORONLY_DATA
 	/**
 	* MCPコメント枠のタイトルに付与するプレフィックス。
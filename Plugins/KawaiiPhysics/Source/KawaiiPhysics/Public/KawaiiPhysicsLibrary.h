@@ -38,6 +38,7 @@ enum class EKawaiiPhysicsAccessResult : uint8
     KawaiiPhysics.CallAnimNodeFunction<FAnimNode_KawaiiPhysics>( \
         TEXT("Set" #PropertyName), \
         [PropertyName](FAnimNode_KawaiiPhysics& InKawaiiPhysics) { \
+            InKawaiiPhysics.JoinPipelinedSimulation(); \
             InKawaiiPhysics.PropertyName = PropertyName; \
         }); \
     return KawaiiPhysics; \
@@ -162,6 +163,11 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Kawaii Physics", meta=(BlueprintThreadSafe))
 	static TArray<FName> GetExcludeBoneNames(const FKawaiiPhysicsReference& KawaiiPhysics);
 
+	/** Get child indices of ModifyBones[ModifyBoneIndex] */
+	UFUNCTION(BlueprintPure, Category = "Kawaii Physics", meta=(BlueprintThreadSafe))
+	static TArray<int32> GetModifyBoneChildIndices(const FKawaiiPhysicsReference& KawaiiPhysics,
+	                                               int32 ModifyBoneIndex);
+
 	// PhysicsSettings
 	UFUNCTION(BlueprintCallable, Category = "Kawaii Physics", meta=(BlueprintThreadSafe))
 	static FKawaiiPhysicsReference SetPhysicsSettings(const FKawaiiPhysicsReference& KawaiiPhysics,
@@ -184,6 +190,7 @@ public:
 		KawaiiPhysics.CallAnimNodeFunction<FAnimNode_KawaiiPhysics>(
 			TEXT("SetDummyBoneLength"),
 			[DummyBoneLength](FAnimNode_KawaiiPhysics& InKawaiiPhysics) {
+				InKawaiiPhysics.JoinPipelinedSimulation();
 				InKawaiiPhysics.DummyBoneLength = FMath::Max(DummyBoneLength, 0.0f);
 				InKawaiiPhysics.RequestModifyBonesReinit();
 			});
@@ -204,6 +211,7 @@ public:
 		KawaiiPhysics.CallAnimNodeFunction<FAnimNode_KawaiiPhysics>(
 			TEXT("SetBoneSubdivisionCount"),
 			[BoneSubdivisionCount](FAnimNode_KawaiiPhysics& InKawaiiPhysics) {
+				InKawaiiPhysics.JoinPipelinedSimulation();
 				InKawaiiPhysics.BoneSubdivisionCount = FMath::Clamp(BoneSubdivisionCount, 0, 10);
 				InKawaiiPhysics.RequestModifyBonesReinit();
 			});
@@ -224,6 +232,7 @@ public:
 		KawaiiPhysics.CallAnimNodeFunction<FAnimNode_KawaiiPhysics>(
 			TEXT("SetbBoneSubdivisionCollisionOnly"),
 			[bBoneSubdivisionCollisionOnly](FAnimNode_KawaiiPhysics& InKawaiiPhysics) {
+				InKawaiiPhysics.JoinPipelinedSimulation();
 				InKawaiiPhysics.bBoneSubdivisionCollisionOnly = bBoneSubdivisionCollisionOnly;
 				InKawaiiPhysics.RequestModifyBonesReinit();
 			});
@@ -236,6 +245,20 @@ public:
 		KAWAIIPHYSICS_VALUE_GETTER(bool, bBoneSubdivisionCollisionOnly);
 	}
 
+	// BoneSegmentCollision（ランタイムで切り替え可 / can be toggled at runtime）
+	UFUNCTION(BlueprintCallable, Category = "Kawaii Physics", meta=(BlueprintThreadSafe))
+	static FKawaiiPhysicsReference SetBoneSegmentCollision(const FKawaiiPhysicsReference& KawaiiPhysics,
+	                                                       bool bBoneSegmentCollision)
+	{
+		KAWAIIPHYSICS_VALUE_SETTER(bool, bBoneSegmentCollision);
+	}
+
+	UFUNCTION(BlueprintPure, Category = "Kawaii Physics", meta=(BlueprintThreadSafe))
+	static bool GetBoneSegmentCollision(const FKawaiiPhysicsReference& KawaiiPhysics)
+	{
+		KAWAIIPHYSICS_VALUE_GETTER(bool, bBoneSegmentCollision);
+	}
+
 	// BoneConstraintSubdivisionCount
 	UFUNCTION(BlueprintCallable, Category = "Kawaii Physics", meta=(BlueprintThreadSafe))
 	static FKawaiiPhysicsReference SetBoneConstraintSubdivisionCount(const FKawaiiPhysicsReference& KawaiiPhysics,
@@ -244,6 +267,7 @@ public:
 		KawaiiPhysics.CallAnimNodeFunction<FAnimNode_KawaiiPhysics>(
 			TEXT("SetBoneConstraintSubdivisionCount"),
 			[BoneConstraintSubdivisionCount](FAnimNode_KawaiiPhysics& InKawaiiPhysics) {
+				InKawaiiPhysics.JoinPipelinedSimulation();
 				InKawaiiPhysics.BoneConstraintSubdivisionCount = FMath::Clamp(BoneConstraintSubdivisionCount, 0, 10);
 				InKawaiiPhysics.RequestModifyBonesReinit();
 			});
@@ -270,6 +294,27 @@ public:
 		KAWAIIPHYSICS_VALUE_GETTER(float, BoneConstraintSubdivisionFeedbackScale);
 	}
 
+	// BoneConstraintEdgeCollision（bridge dummy の有無が変わるため reinit / toggles bridge dummies, so it reinitializes）
+	UFUNCTION(BlueprintCallable, Category = "Kawaii Physics", meta=(BlueprintThreadSafe))
+	static FKawaiiPhysicsReference SetBoneConstraintEdgeCollision(const FKawaiiPhysicsReference& KawaiiPhysics,
+	                                                              bool bBoneConstraintEdgeCollision)
+	{
+		KawaiiPhysics.CallAnimNodeFunction<FAnimNode_KawaiiPhysics>(
+			TEXT("SetBoneConstraintEdgeCollision"),
+			[bBoneConstraintEdgeCollision](FAnimNode_KawaiiPhysics& InKawaiiPhysics) {
+				InKawaiiPhysics.JoinPipelinedSimulation();
+				InKawaiiPhysics.bBoneConstraintEdgeCollision = bBoneConstraintEdgeCollision;
+				InKawaiiPhysics.RequestModifyBonesReinit();
+			});
+		return KawaiiPhysics;
+	}
+
+	UFUNCTION(BlueprintPure, Category = "Kawaii Physics", meta=(BlueprintThreadSafe))
+	static bool GetBoneConstraintEdgeCollision(const FKawaiiPhysicsReference& KawaiiPhysics)
+	{
+		KAWAIIPHYSICS_VALUE_GETTER(bool, bBoneConstraintEdgeCollision);
+	}
+
 	/** TeleportDistanceThreshold */
 	UFUNCTION(BlueprintCallable, Category = "Kawaii Physics", meta=(BlueprintThreadSafe))
 	static FKawaiiPhysicsReference SetTeleportDistanceThreshold(const FKawaiiPhysicsReference& KawaiiPhysics,
@@ -298,6 +343,19 @@ public:
 		KAWAIIPHYSICS_VALUE_GETTER(float, TeleportRotationThreshold);
 	}
 
+	/** AllowSleep */
+	UFUNCTION(BlueprintCallable, Category = "Kawaii Physics", meta=(BlueprintThreadSafe))
+	static FKawaiiPhysicsReference SetAllowSleep(const FKawaiiPhysicsReference& KawaiiPhysics, bool bAllowSleep)
+	{
+		KAWAIIPHYSICS_VALUE_SETTER(bool, bAllowSleep);
+	}
+
+	UFUNCTION(BlueprintPure, Category = "Kawaii Physics", meta=(BlueprintThreadSafe))
+	static bool GetAllowSleep(const FKawaiiPhysicsReference& KawaiiPhysics)
+	{
+		KAWAIIPHYSICS_VALUE_GETTER(bool, bAllowSleep);
+	}
+
 	/** Gravity */
 	UFUNCTION(BlueprintCallable, Category = "Kawaii Physics", meta=(BlueprintThreadSafe))
 	static FKawaiiPhysicsReference SetGravity(const FKawaiiPhysicsReference& KawaiiPhysics, FVector Gravity)
@@ -351,6 +409,89 @@ public:
 		KAWAIIPHYSICS_VALUE_GETTER(bool, bAllowWorldCollision);
 	}
 
+	/** WorldCollisionMode */
+	UFUNCTION(BlueprintCallable, Category = "Kawaii Physics", meta=(BlueprintThreadSafe))
+	static FKawaiiPhysicsReference SetWorldCollisionMode(const FKawaiiPhysicsReference& KawaiiPhysics,
+	                                                     EKawaiiPhysicsWorldCollisionMode WorldCollisionMode)
+	{
+		KAWAIIPHYSICS_VALUE_SETTER(EKawaiiPhysicsWorldCollisionMode, WorldCollisionMode);
+	}
+
+	UFUNCTION(BlueprintPure, Category = "Kawaii Physics", meta=(BlueprintThreadSafe))
+	static EKawaiiPhysicsWorldCollisionMode GetWorldCollisionMode(const FKawaiiPhysicsReference& KawaiiPhysics)
+	{
+		KAWAIIPHYSICS_VALUE_GETTER(EKawaiiPhysicsWorldCollisionMode, WorldCollisionMode);
+	}
+
+	/** WorldCollisionQueryRadius */
+	UFUNCTION(BlueprintCallable, Category = "Kawaii Physics", meta=(BlueprintThreadSafe))
+	static FKawaiiPhysicsReference SetWorldCollisionQueryRadius(const FKawaiiPhysicsReference& KawaiiPhysics,
+	                                                            float WorldCollisionQueryRadius)
+	{
+		KAWAIIPHYSICS_VALUE_SETTER(float, WorldCollisionQueryRadius);
+	}
+
+	UFUNCTION(BlueprintPure, Category = "Kawaii Physics", meta=(BlueprintThreadSafe))
+	static float GetWorldCollisionQueryRadius(const FKawaiiPhysicsReference& KawaiiPhysics)
+	{
+		KAWAIIPHYSICS_VALUE_GETTER(float, WorldCollisionQueryRadius);
+	}
+
+	/** Significance */
+	UFUNCTION(BlueprintCallable, Category = "Kawaii Physics", meta=(BlueprintThreadSafe))
+	static FKawaiiPhysicsReference SetSignificance(const FKawaiiPhysicsReference& KawaiiPhysics, float Significance)
+	{
+		KAWAIIPHYSICS_VALUE_SETTER(float, Significance);
+	}
+
+	UFUNCTION(BlueprintPure, Category = "Kawaii Physics", meta=(BlueprintThreadSafe))
+	static float GetSignificance(const FKawaiiPhysicsReference& KawaiiPhysics)
+	{
+		KAWAIIPHYSICS_VALUE_GETTER(float, Significance);
+	}
+
+	/** OutputInterpolation */
+	UFUNCTION(BlueprintCallable, Category = "Kawaii Physics", meta=(BlueprintThreadSafe))
+	static FKawaiiPhysicsReference SetOutputInterpolation(const FKawaiiPhysicsReference& KawaiiPhysics,
+	                                                      EKawaiiPhysicsOutputInterpolation OutputInterpolation)
+	{
+		KAWAIIPHYSICS_VALUE_SETTER(EKawaiiPhysicsOutputInterpolation, OutputInterpolation);
+	}
+
+	UFUNCTION(BlueprintPure, Category = "Kawaii Physics", meta=(BlueprintThreadSafe))
+	static EKawaiiPhysicsOutputInterpolation GetOutputInterpolation(const FKawaiiPhysicsReference& KawaiiPhysics)
+	{
+		KAWAIIPHYSICS_VALUE_GETTER(EKawaiiPhysicsOutputInterpolation, OutputInterpolation);
+	}
+
+	/** LODTierMetric */
+	UFUNCTION(BlueprintCallable, Category = "Kawaii Physics", meta=(BlueprintThreadSafe))
+	static FKawaiiPhysicsReference SetLODTierMetric(const FKawaiiPhysicsReference& KawaiiPhysics,
+	                                                EKawaiiPhysicsLODMetric LODTierMetric)
+	{
+		KAWAIIPHYSICS_VALUE_SETTER(EKawaiiPhysicsLODMetric, LODTierMetric);
+	}
+
+	UFUNCTION(BlueprintPure, Category = "Kawaii Physics", meta=(BlueprintThreadSafe))
+	static EKawaiiPhysicsLODMetric GetLODTierMetric(const FKawaiiPhysicsReference& KawaiiPhysics)
+	{
+		KAWAIIPHYSICS_VALUE_GETTER(EKawaiiPhysicsLODMetric, LODTierMetric);
+	}
+
+	/** LODTierBlendTime */
+	UFUNCTION(BlueprintCallable, Category = "Kawaii Physics", meta=(BlueprintThreadSafe))
+	static FKawaiiPhysicsReference SetLODTierBlendTime(const FKawaiiPhysicsReference& KawaiiPhysics,
+	                                                   float LODTierBlendTime)
+	{
+		KAWAIIPHYSICS_VALUE_SETTER(float, LODTierBlendTime);
+	}
+
+	UFUNCTION(BlueprintPure, Category = "Kawaii Physics", meta=(BlueprintThreadSafe))
+	static float GetLODTierBlendTime(const FKawaiiPhysicsReference& KawaiiPhysics)
+	{
+		KAWAIIPHYSICS_VALUE_GETTER(float, LODTierBlendTime);
+	}
+
 	/** NeedWarmUp */
 	UFUNCTION(BlueprintCallable, Category = "Kawaii Physics", meta=(BlueprintThreadSafe))
 	static FKawaiiPhysicsReference SetNeedWarmUp(const FKawaiiPhysicsReference& KawaiiPhysics, bool bNeedWarmUp)
@@ -373,6 +514,7 @@ public:
 		KawaiiPhysics.CallAnimNodeFunction<FAnimNode_KawaiiPhysics>(
 			TEXT("SetLimitsDataAsset"),
 			[LimitsDataAsset](FAnimNode_KawaiiPhysics& InKawaiiPhysics) {
+				InKawaiiPhysics.JoinPipelinedSimulation();
 				InKawaiiPhysics.LimitsDataAsset = LimitsDataAsset;
 				InKawaiiPhysics.RequestModifyBonesReinit();
 			});
@@ -397,6 +539,7 @@ public:
 		KawaiiPhysics.CallAnimNodeFunction<FAnimNode_KawaiiPhysics>(
 			TEXT("SetMirrorDataTableForLimits"),
 			[MirrorDataTableForLimits](FAnimNode_KawaiiPhysics& InKawaiiPhysics) {
+				InKawaiiPhysics.JoinPipelinedSimulation();
 				InKawaiiPhysics.MirrorDataTableForLimits = MirrorDataTableForLimits;
 				InKawaiiPhysics.RequestModifyBonesReinit();
 			});
@@ -424,6 +567,7 @@ public:
 		KawaiiPhysics.CallAnimNodeFunction<FAnimNode_KawaiiPhysics>(
 			TEXT("SetbSkipMirroredBoneWithExistingCollision"),
 			[bSkipMirroredBoneWithExistingCollision](FAnimNode_KawaiiPhysics& InKawaiiPhysics) {
+				InKawaiiPhysics.JoinPipelinedSimulation();
 				InKawaiiPhysics.bSkipMirroredBoneWithExistingCollision = bSkipMirroredBoneWithExistingCollision;
 				InKawaiiPhysics.RequestModifyBonesReinit();
 			});
@@ -440,6 +584,62 @@ public:
 		KAWAIIPHYSICS_VALUE_GETTER(bool, bSkipMirroredBoneWithExistingCollision);
 	}
 
+	/**
+	 * 参照ポーズで届かないコライダーとボーンの組を判定から外すかを設定（次の Evaluate でマスクを作り直す）
+	 * Set whether collider-bone pairs that are unreachable in the reference pose are excluded (masks are rebuilt on the next Evaluate).
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Kawaii Physics", meta=(BlueprintThreadSafe))
+	static FKawaiiPhysicsReference SetAutoColliderRelevance(const FKawaiiPhysicsReference& KawaiiPhysics,
+	                                                        bool bAutoColliderRelevance)
+	{
+		KawaiiPhysics.CallAnimNodeFunction<FAnimNode_KawaiiPhysics>(
+			TEXT("SetAutoColliderRelevance"),
+			[bAutoColliderRelevance](FAnimNode_KawaiiPhysics& InKawaiiPhysics) {
+				InKawaiiPhysics.JoinPipelinedSimulation();
+				InKawaiiPhysics.bAutoColliderRelevance = bAutoColliderRelevance;
+				InKawaiiPhysics.RequestColliderRelevanceRebuild();
+			});
+		return KawaiiPhysics;
+	}
+
+	/**
+	 * 参照ポーズで届かないコライダーとボーンの組を判定から外すかを取得
+	 * Get whether collider-bone pairs that are unreachable in the reference pose are excluded.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Kawaii Physics", meta=(BlueprintThreadSafe))
+	static bool GetAutoColliderRelevance(const FKawaiiPhysicsReference& KawaiiPhysics)
+	{
+		KAWAIIPHYSICS_VALUE_GETTER(bool, bAutoColliderRelevance);
+	}
+
+	/**
+	 * 到達判定の余裕を設定（次の Evaluate でマスクを作り直す）
+	 * Set the reach margin of the relevance test (masks are rebuilt on the next Evaluate).
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Kawaii Physics", meta=(BlueprintThreadSafe))
+	static FKawaiiPhysicsReference SetColliderRelevanceMargin(const FKawaiiPhysicsReference& KawaiiPhysics,
+	                                                          float ColliderRelevanceMargin)
+	{
+		KawaiiPhysics.CallAnimNodeFunction<FAnimNode_KawaiiPhysics>(
+			TEXT("SetColliderRelevanceMargin"),
+			[ColliderRelevanceMargin](FAnimNode_KawaiiPhysics& InKawaiiPhysics) {
+				InKawaiiPhysics.JoinPipelinedSimulation();
+				InKawaiiPhysics.ColliderRelevanceMargin = ColliderRelevanceMargin;
+				InKawaiiPhysics.RequestColliderRelevanceRebuild();
+			});
+		return KawaiiPhysics;
+	}
+
+	/**
+	 * 到達判定の余裕を取得
+	 * Get the reach margin of the relevance test.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Kawaii Physics", meta=(BlueprintThreadSafe))
+	static float GetColliderRelevanceMargin(const FKawaiiPhysicsReference& KawaiiPhysics)
+	{
+		KAWAIIPHYSICS_VALUE_GETTER(float, ColliderRelevanceMargin);
+	}
+
 	/** Add ExternalForce With ExecResult */
 	UFUNCTION(BlueprintCallable, Category = "Kawaii Physics",
 		meta=(BlueprintThreadSafe, ExpandEnumAsExecs = "ExecResult"))
@@ -901,6 +1101,7 @@ public:
 		KawaiiPhysics.CallAnimNodeFunction<FAnimNode_KawaiiPhysics>(
 			TEXT("SetbSharedCollisionSource"),
 			[bSharedCollisionSource](FAnimNode_KawaiiPhysics& InKawaiiPhysics) {
+				InKawaiiPhysics.JoinPipelinedSimulation();
 				InKawaiiPhysics.bSharedCollisionSource = bSharedCollisionSource;
 				InKawaiiPhysics.RequestSharedCollisionReinit();
 			});
@@ -924,6 +1125,7 @@ public:
 		KawaiiPhysics.CallAnimNodeFunction<FAnimNode_KawaiiPhysics>(
 			TEXT("SetbUseSharedCollision"),
 			[bUseSharedCollision](FAnimNode_KawaiiPhysics& InKawaiiPhysics) {
+				InKawaiiPhysics.JoinPipelinedSimulation();
 				InKawaiiPhysics.bUseSharedCollision = bUseSharedCollision;
 				InKawaiiPhysics.RequestSharedCollisionReinit();
 			});
@@ -947,6 +1149,7 @@ public:
 		KawaiiPhysics.CallAnimNodeFunction<FAnimNode_KawaiiPhysics>(
 			TEXT("SetSharedCollisionGroupTag"),
 			[SharedCollisionGroupTag](FAnimNode_KawaiiPhysics& InKawaiiPhysics) {
+				InKawaiiPhysics.JoinPipelinedSimulation();
 				InKawaiiPhysics.SharedCollisionGroupTag = SharedCollisionGroupTag;
 				InKawaiiPhysics.RequestSharedCollisionReinit();
 			});
@@ -1544,6 +1747,7 @@ bool UKawaiiPhysicsLibrary::SetNodePropertyValue(FAnimNode_KawaiiPhysics& Node,
 		return false;
 	}
 
+	Node.JoinPipelinedSimulation();
 	if (void* ValuePtr = Property->ContainerPtrToValuePtr<void>(&Node))
 	{
 		Property->SetPropertyValue(ValuePtr, Value);
@@ -1609,6 +1813,7 @@ bool UKawaiiPhysicsLibrary::SetNodeStructPropertyValue(FAnimNode_KawaiiPhysics&
 		return false;
 	}
 
+	Node.JoinPipelinedSimulation();
 	if (void* ValuePtr = StructProperty->ContainerPtrToValuePtr<void>(&Node))
 	{
 		StructProperty->CopyCompleteValue(ValuePtr, &Value);
@@ -1675,6 +1880,7 @@ FKawaiiPhysicsReference UKawaiiPhysicsLibrary::SetExternalForceProperty(
 		TEXT("SetExternalForceProperty"),
 		[&ExecResult, &ExternalForceIndex, &PropertyName, &Value](FAnimNode_KawaiiPhysics& InKawaiiPhysics)
 		{
+			InKawaiiPhysics.JoinPipelinedSimulation();
 			if (InKawaiiPhysics.ExternalForces.IsValidIndex(ExternalForceIndex) &&
 				InKawaiiPhysics.ExternalForces[ExternalForceIndex].IsValid())
 			{
@@ -1737,6 +1943,7 @@ FKawaiiPhysicsReference UKawaiiPhysicsLibrary::SetExternalForceStructProperty(
 		TEXT("SetExternalForceStructProperty"),
 		[&ExecResult, &ExternalForceIndex, &PropertyName, &Value](FAnimNode_KawaiiPhysics& InKawaiiPhysics)
 		{
+			InKawaiiPhysics.JoinPipelinedSimulation();
 			if (InKawaiiPhysics.ExternalForces.IsValidIndex(ExternalForceIndex) &&
 				InKawaiiPhysics.ExternalForces[ExternalForceIndex].IsValid())
 			{
@@ -36,6 +36,9 @@ struct FCollisionLimitDataBase
 	UPROPERTY(meta=(DeprecatedProperty, IgnoreForMemberInitializationTest))
 	FGuid Guid = FGuid::NewGuid();
 
+	UPROPERTY(meta=(DeprecatedProperty))
+	FKawaiiPhysicsLimitBoneFilter BoneFilter;
+
 protected:
 	void ConvertBase(FCollisionLimitBase& Limit) const
 	{
@@ -44,6 +47,7 @@ protected:
 		Limit.OffsetRotation = OffsetRotation;
 		Limit.Location = Location;
 		Limit.Rotation = Rotation;
+		Limit.BoneFilter = BoneFilter;
 
 #if  WITH_EDITORONLY_DATA
 		Limit.SourceType = ECollisionSourceType::DataAsset;
@@ -30,6 +30,12 @@ namespace KawaiiPhysicsMirror
 	 */
 	void BuildComponentSpaceRefRotations(const FReferenceSkeleton& RefSkeleton, TArray<FQuat>& OutCSRotations);
 
+	/**
+	 * BoneFilter のボーン名をミラー先へ置き換える（ミラー先の無い中央ボーンはそのまま）
+	 * Replaces the bone names of a BoneFilter with their mirrored bones (center bones without a mirror are kept).
+	 */
+	void MirrorBoneFilter(FKawaiiPhysicsLimitBoneFilter& Filter, TFunctionRef<FName(FName)> ResolveMirrorBoneName);
+
 	/**
 	 * 既存コリジョンをミラー先ボーンへ複製し、生成結果をOutNewLimitsへ追加。DrivingBone.Initializeは呼び出し側で行うこと
 	 * Duplicates existing collisions onto mirrored bones and appends generated results to OutNewLimits. DrivingBone.Initialize is the caller's responsibility.
@@ -86,6 +92,8 @@ namespace KawaiiPhysicsMirror
 			                                               CSRefRotations[SourceBoneIndex],
 			                                               CSRefRotations[TargetBoneIndex], MirrorAxis).Rotator();
 			NewLimit.SourceType = ECollisionSourceType::Mirror;
+			MirrorBoneFilter(NewLimit.BoneFilter, ResolveMirrorBoneName);
+			NewLimit.CachedRelevanceMask = INDEX_NONE;
 #if WITH_EDITORONLY_DATA
 			NewLimit.Guid = FGuid::NewGuid();
 #endif
@@ -0,0 +1,149 @@
+// Copyright 2019-2026 pafuhana1213. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "HAL/CriticalSection.h"
+#include "KawaiiPhysicsTypes.h"
+
+#include "KawaiiPhysicsSimulationSubsystem.generated.h"
+
+struct FAnimNode_KawaiiPhysics;
+class FKawaiiPhysicsAsyncWorldCollision;
+
+/**
+ * KawaiiPhysics のシミュレーションをワールド単位でまとめて実行する WorldSubsystem
+ * WorldSubsystem that runs the KawaiiPhysics solves of a world as one batch
+ *
+ * a.AnimNode.KawaiiPhysics.BatchedSimulation が有効なとき、各ノードは Evaluate(AnyThread) で入力（ポーズ・外力・
+ * ステップ数）だけを確定して自分を登録し、ソルバ本体はワールドの全 Actor Tick 後に ParallelFor で一括実行される。
+ * 結果は次の Evaluate で出力されるため、1フレーム遅れになる。
+ * When a.AnimNode.KawaiiPhysics.BatchedSimulation is on, each node only settles its inputs (pose, forces, step count)
+ * in Evaluate (AnyThread) and registers itself; the solves then run as one ParallelFor batch after all actors of the
+ * world have ticked. The result is output by the next Evaluate, i.e. with one frame of latency.
+ */
+UCLASS()
+class KAWAIIPHYSICS_API UKawaiiPhysicsSimulationSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * ワーカースレッドから呼び出し可能 / Can be called from any thread.
+	 * Owner（ノードを持つ AnimInstance）が破棄されていればバッチ実行時に読み飛ばす。
+	 * The entry is skipped at batch time if Owner (the AnimInstance holding the node) has been destroyed.
+	 */
+	void EnqueueSimulation(FAnimNode_KawaiiPhysics* Node, const TWeakObjectPtr<const UObject>& Owner);
+
+	/** 登録済みのソルバを全て実行する（GameThread） / Run every registered solve (GameThread) */
+	void RunPendingSimulations();
+
+	/** 登録数（読み取りロック内） / Number of registered solves (under the lock) */
+	int32 GetNumPendingSimulations() const;
+
+	/**
+	 * ワーカースレッドから呼び出し可能 / Can be called from any thread.
+	 * 積まれた非同期ワールドコリジョンのスイープを、全 Actor Tick 後に GameThread で発行する。
+	 * The staged async world collision sweeps are issued on the GameThread after all actors have ticked.
+	 */
+	void EnqueueAsyncWorldCollision(const TSharedRef<FKawaiiPhysicsAsyncWorldCollision, ESPMode::ThreadSafe>& AsyncWorldCollision);
+
+	/** 登録済みの非同期スイープを全て発行する（GameThread） / Issue every registered async sweep (GameThread) */
+	void IssueAsyncWorldCollisions();
+
+	/** フレーム予算の割り当て対象1ノード分 / One node competing for the frame budget */
+	struct FBudgetRequest
+	{
+		FAnimNode_KawaiiPhysics* Node = nullptr;
+		TWeakObjectPtr<const UObject> Owner;
+		float CostMs = 0.0f;
+		// 0〜1。負なら割り当て時に画面サイズで置き換える / 0-1; replaced by the screen size at allocation time when negative
+		float Significance = 0.0f;
+		// Significance が並んだときの順序（小さい順） / Order among equal significance (ascending)
+		uint32 ComponentId = 0;
+		int32 NodeId = INDEX_NONE;
+		EKawaiiPhysicsBudgetTier Tier = EKawaiiPhysicsBudgetTier::Full;
+	};
+
+	/**
+	 * ワーカースレッドから呼び出し可能 / Can be called from any thread.
+	 * このフレームの見積もり負荷と Significance を登録し、全 Actor Tick 後の割り当てに参加する。
+	 * Register this frame's estimated cost and significance to take part in the allocation after all actors have ticked.
+	 */
+	void ReportSimulationCost(FAnimNode_KawaiiPhysics* Node, const TWeakObjectPtr<const UObject>& Owner,
+	                          float CostMs, float Significance, uint32 ComponentId, int32 NodeId);
+
+	/** 登録されたノードに予算を割り当て、次フレームの更新頻度を設定する（GameThread） / Allocate the budget (GameThread) */
+	void AllocateSimulationBudget();
+
+	/**
+	 * Significance の高い順に予算を割り当てる。同じ Significance は ComponentId、NodeId の小さい順（登録順に依らない）。
+	 * 段階は優先度の順に単調（上位より良い段階にはならない）で、最上位は常に Full。
+	 * Requests は並べ替えられる。使った予算（ミリ秒）を返す。
+	 * Hand out the budget by descending significance, breaking ties by ascending ComponentId then NodeId (independent of
+	 * registration order). Tiers are monotonic in priority order (never better than a higher-priority node) and the top
+	 * node is always Full. Requests is reordered. Returns the budget used in ms.
+	 */
+	static float AssignBudgetTiers(TArray<FBudgetRequest>& Requests, float BudgetMs, int32 ReducedUpdateInterval);
+
+	/**
+	 * 予算と LOD で比べる Significance / 画面サイズを共通の 0〜1 に揃える（負は画面サイズで代用する印なのでそのまま）
+	 * Normalise a significance or screen size to the common 0-1 range used by the budget and LOD (negative values, which
+	 * mean "use the screen size", are passed through)
+	 */
+	static float NormalizeSignificance(float Significance);
+
+	/**
+	 * ワーカースレッドから呼び出し可能 / Can be called from any thread.
+	 * LOD 段階の選択に使う画面サイズとカメラ距離を、全 Actor Tick 後にノードへ書き込むよう要求する。
+	 * Ask for the screen size and camera distance used to pick the LOD tier to be written to the node after all actors
+	 * have ticked.
+	 */
+	void RequestLODViewMetrics(FAnimNode_KawaiiPhysics* Node, const TWeakObjectPtr<const UObject>& Owner);
+
+	/** 要求したノードに画面サイズとカメラ距離を書き込む（GameThread） / Write the view metrics to the nodes (GameThread) */
+	void UpdateLODViewMetrics();
+
+	// USubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+private:
+	void OnWorldPostActorTick(UWorld* InWorld, ELevelTick InTickType, float InDeltaSeconds);
+
+	struct FPendingSimulation
+	{
+		FAnimNode_KawaiiPhysics* Node = nullptr;
+		TWeakObjectPtr<const UObject> Owner;
+	};
+
+	/** Evaluate から積まれるソルバ / Solves queued from Evaluate */
+	TArray<FPendingSimulation> PendingSimulations;
+
+	/** 実行中のバッチ（確保済みメモリを使い回す） / Batch being run (keeps its allocation across frames) */
+	TArray<FPendingSimulation> RunningSimulations;
+
+	/** PendingSimulations をワーカーの登録と GameThread の取り出しから守る / Guards PendingSimulations */
+	mutable FCriticalSection PendingLock;
+
+	/** スイープを積んだノード（ノード破棄後は弱参照が切れる） / Nodes with staged sweeps (weak once the node is gone) */
+	TArray<TWeakPtr<FKawaiiPhysicsAsyncWorldCollision, ESPMode::ThreadSafe>> PendingAsyncWorldCollisions;
+	TArray<TWeakPtr<FKawaiiPhysicsAsyncWorldCollision, ESPMode::ThreadSafe>> IssuingAsyncWorldCollisions;
+	FCriticalSection AsyncWorldCollisionLock;
+
+	/** 未完了のスイープを持ちうるノード（GameThread のみ） / Nodes that may still have sweeps in flight (GameThread only) */
+	TArray<TWeakPtr<FKawaiiPhysicsAsyncWorldCollision, ESPMode::ThreadSafe>> InFlightAsyncWorldCollisions;
+
+	/** 今フレームに負荷を登録したノード / Nodes that reported their cost this frame */
+	TArray<FBudgetRequest> PendingBudgetRequests;
+	TArray<FBudgetRequest> AllocatingBudgetRequests;
+	FCriticalSection BudgetLock;
+
+	/** LOD の指標を要求したノード / Nodes that asked for their LOD view metrics */
+	TArray<FPendingSimulation> PendingLODViewMetrics;
+	TArray<FPendingSimulation> UpdatingLODViewMetrics;
+	FCriticalSection LODViewMetricsLock;
+
+	FDelegateHandle PostActorTickHandle;
+};
@@ -0,0 +1,356 @@
+// Copyright 2019-2026 pafuhana1213. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "KawaiiPhysicsBoneConstraintTypes.h"
+#include "KawaiiPhysicsTypes.h"
+
+/**
+ * ソルバ内部で使うボーン状態の SoA（Structure of Arrays）バッファ。
+ * FKawaiiPhysicsModifyBone は BoneRef / サブステップ用スナップショット等の冷データを抱えて1ボーン300B超になるため、
+ * 積分・コリジョン・長さ復元の各パスはここに連続配置したホットデータだけを走査する。
+ * ModifyBones への書き戻し(Scatter)は Blueprint / デバッグ描画 / 外力フックが参照する箇所に限る。
+ * Structure-of-arrays buffer of the bone state used inside the solver. FKawaiiPhysicsModifyBone carries cold data
+ * (BoneRef / substep snapshots) and exceeds 300 bytes per bone, so the integration, collision and
+ * length-restore passes walk only the contiguous hot streams here. Syncing back to ModifyBones (Scatter) is limited to
+ * the points where Blueprint, debug drawing or external-force hooks read it.
+ */
+struct KAWAIIPHYSICS_API FKawaiiPhysicsSolverState
+{
+	/** ボーン分類フラグ / Per-bone category flags */
+	enum EFlags : uint8
+	{
+		Flag_None = 0,
+		Flag_SkipSimulate = 1 << 0,
+		Flag_Dummy = 1 << 1,
+		Flag_InterBoneDummy = 1 << 2,
+		Flag_BridgeDummy = 1 << 3,
+		// 実ポーズへ追従する root（ParentIndex<0 の実ボーン / tip を除く） / Root that follows the animated pose
+		Flag_KinematicRoot = 1 << 4,
+	};
+
+	// ===== 位置ストリーム / Position streams =====
+	TArray<FVector> Location;
+	TArray<FVector> PrevLocation;
+	TArray<FVector> PoseLocation;
+	// 角度制限の代替軸 / 平面拘束の法線に使うポーズ回転（サブステップ中は補間値） / Pose rotation read by the angle limit
+	// fallback axis and the planar constraint normal (the interpolated value while substepping)
+	TArray<FQuat> PoseRotation;
+
+	// ===== 物理設定ストリーム（UpdatePhysicsSettingsOfModifyBones の結果） / Physics-settings streams =====
+	TArray<float> Damping;
+	TArray<float> Stiffness;
+	TArray<float> WorldDampingLocation;
+	TArray<float> WorldDampingRotation;
+	TArray<float> Radius;
+	TArray<float> LimitAngle;
+
+	// ===== トポロジ / Topology =====
+	TArray<int32> ParentIndex;
+	// inter-bone / bridge dummy の端点と補間率 / Endpoints and lerp alpha of inter-bone / bridge dummies
+	TArray<int32> InterBoneRealParentIndex;
+	TArray<int32> InterBoneRealChildIndex;
+	TArray<float> InterBoneAlpha;
+	TArray<uint8> Flags;
+
+	// ===== ポーズ目標が変わったときだけ更新する派生値（長さ復元・角度制限・剛性で再計算しない） =====
+	// Derived values refreshed only when the pose target changes (not recomputed by length restore / angle limit / stiffness)
+	// 親とのポーズ上の距離と向き（UpdateRestPose） / Pose distance and direction to the parent (UpdateRestPose)
+	TArray<float> RestLength;
+	TArray<FVector> PoseDirection;
+	// 1-(1-Stiffness)^Exponent（UpdateStiffnessFactors） / 1-(1-Stiffness)^Exponent (UpdateStiffnessFactors)
+	TArray<float> StiffnessFactor;
+
+	// ===== サブステップのポーズ補間元（GatherSubstepPoseTargets） / Substep pose-lerp endpoints =====
+	TArray<FVector> PrevPoseLocation;
+	TArray<FVector> CurrentPoseLocation;
+	TArray<FQuat> PrevPoseRotation;
+	TArray<FQuat> CurrentPoseRotation;
+
+	int32 Num() const { return Location.Num(); }
+
+	bool HasFlag(const int32 Index, const uint8 Flag) const { return (Flags[Index] & Flag) != 0; }
+
+	void SetFlag(const int32 Index, const uint8 Flag, const bool bSet)
+	{
+		Flags[Index] = bSet ? (Flags[Index] | Flag) : (Flags[Index] & ~Flag);
+	}
+
+	void Reset();
+
+	/** ModifyBones の全ホットデータを読み込む（必要なら再確保） / Load all hot data from ModifyBones (reallocates if needed) */
+	void Gather(const TArray<FKawaiiPhysicsModifyBone>& Bones);
+
+	/** 1ボーン分を読み込む / Load a single bone */
+	void GatherBone(const FKawaiiPhysicsModifyBone& Bone, int32 Index);
+
+	/**
+	 * ソルバが書き換える状態（位置 / Pose位置 / skipフラグ）を ModifyBones へ書き戻す。
+	 * Write the solver-mutated state (positions / pose location / skip flag) back to ModifyBones.
+	 */
+	void Scatter(TArray<FKawaiiPhysicsModifyBone>& Bones) const;
+
+	/** 1ボーン分を書き戻す / Write back a single bone */
+	void ScatterBone(FKawaiiPhysicsModifyBone& Bone, int32 Index) const;
+
+	/**
+	 * サブステップ補間中の PoseRotation を ModifyBones へ書き出す（同期実行の外力フック用。Scatter は回転を書かない）。
+	 * Write the substep-interpolated PoseRotation to ModifyBones (for external-force hooks on the synchronous path;
+	 * Scatter does not write rotations).
+	 */
+	void ScatterPoseRotation(TArray<FKawaiiPhysicsModifyBone>& Bones) const;
+
+	/**
+	 * 指定ボーンの RestLength / PoseDirection を現在の PoseLocation から求める（ポーズ目標の更新毎に1回）。
+	 * Compute RestLength / PoseDirection of the given bones from the current PoseLocation (once per pose-target update).
+	 */
+	void UpdateRestPose(const TArray<int32>& Bones);
+
+	/**
+	 * 指定ボーンの StiffnessFactor を求める。Exponent はステップ dt から決まり評価中は変わらないので評価毎に1回。
+	 * Compute StiffnessFactor of the given bones. Exponent follows the step dt and is fixed for the evaluation, so this
+	 * runs once per evaluation.
+	 */
+	void UpdateStiffnessFactors(const TArray<int32>& Bones, float Exponent);
+
+	/**
+	 * サブステップ補間の両端（前フレーム / 現フレームのポーズ位置と回転）を ModifyBones から読み込む（サブステップ時のみ、フレーム毎に1回）。
+	 * Load the substep lerp endpoints (previous / current frame pose locations and rotations) from ModifyBones
+	 * (substepping only, once per frame).
+	 */
+	void GatherSubstepPoseTargets(const TArray<FKawaiiPhysicsModifyBone>& Bones);
+
+	/**
+	 * PoseLocation = Lerp(PrevPoseLocation, CurrentPoseLocation, Alpha) を全ボーン分まとめて計算する（FMath::Lerp とビット一致）。
+	 * PoseLocation = Lerp(PrevPoseLocation, CurrentPoseLocation, Alpha) for every bone in one vectorized pass
+	 * (bit-identical to FMath::Lerp).
+	 */
+	void LerpPoseLocation(float Alpha);
+
+	/** PoseLocation を現フレームの値へ戻す / Restore PoseLocation to the current frame's pose */
+	void RestoreCurrentPoseLocation();
+
+	/**
+	 * PoseRotation を前フレーム / 現フレームの回転の間で補間する（bUseNLerp なら正規化付き NLerp、それ以外は Slerp）。
+	 * Interpolate PoseRotation between the previous and current frame rotations (normalized NLerp when bUseNLerp,
+	 * Slerp otherwise).
+	 */
+	void InterpolatePoseRotation(float Alpha, bool bUseNLerp);
+
+	/** PoseRotation を現フレームの値へ戻す / Restore PoseRotation to the current frame's pose */
+	void RestoreCurrentPoseRotation();
+
+	/**
+	 * 実ポーズへ追従する root か（ParentIndex<0 の実ボーン。bridge dummy と LOD で無効な実ボーンを除く）。
+	 * Whether the bone is a root that follows the animated pose (excludes bridge dummies and LOD-invalid real bones).
+	 */
+	static bool IsKinematicRoot(const FKawaiiPhysicsModifyBone& Bone)
+	{
+		return Bone.ParentIndex < 0 && !Bone.bBridgeDummy && !(Bone.BoneRef.BoneIndex < 0 && !Bone.bDummy);
+	}
+
+	SIZE_T GetAllocatedSize() const;
+};
+
+/**
+ * ボーン分類ごとの index リスト。ボーン構成（init / reinit）でしか変わらない分類を一度だけ求め、
+ * SimulateOnce の各パスはフラグ判定で全ボーンを走査する代わりに該当リストだけを回す。
+ * すべて index 昇順（= ModifyBones の親→子順）で、適用順は従来の全走査と同じ。
+ * Per-category bone index lists. Categories only change with the bone layout (init / reinit), so they are computed
+ * once and each SimulateOnce pass walks its own list instead of flag-testing every bone. All lists are in ascending
+ * index order (parent before child in ModifyBones), so passes apply in the same order as the former full scans.
+ */
+struct KAWAIIPHYSICS_API FKawaiiPhysicsBoneCategories
+{
+	// 実ポーズへ追従する root / Roots that follow the animated pose
+	TArray<int32> KinematicRoots;
+	// skip / bridge dummy 以外（積分・角度制限・長さ復元の対象。inter-bone dummy を含む）
+	// Neither skipped nor bridge dummies (integration, angle limit and length restore; includes inter-bone dummies)
+	TArray<int32> Simulated;
+	// Simulated から inter-bone dummy を除いたもの（bBoneSubdivisionCollisionOnly 時の積分対象）
+	// Simulated minus inter-bone dummies (integrated when bBoneSubdivisionCollisionOnly)
+	TArray<int32> SimulatedWithoutInterBoneDummies;
+	TArray<int32> InterBoneDummies;
+	// LOD による skip はステップ中に変わるため、利用側でフラグを確認する
+	// Their LOD skip can change mid-step, so users still check the flag
+	TArray<int32> BridgeDummies;
+
+	/**
+	 * bSkipSimulate 等の分類フラグからリストを作る。LayoutGeneration は構築元のボーン構成の世代
+	 * Build the lists from the bones' category flags. LayoutGeneration identifies the bone layout they are built from
+	 */
+	void Build(const TArray<FKawaiiPhysicsModifyBone>& Bones, uint32 LayoutGeneration);
+
+	void Reset();
+
+	/**
+	 * 同じ世代・同じボーン数の構成に対して構築済みか（同数のボーンで init し直した場合も世代で作り直す）
+	 * Whether built for this layout generation and bone count (a reinit with the same bone count still rebuilds)
+	 */
+	bool IsBuiltFor(const uint32 LayoutGeneration, const int32 NumBones) const
+	{
+		return BuiltNumBones == NumBones && BuiltLayoutGeneration == LayoutGeneration;
+	}
+
+	/** 積分対象 / Bones to integrate */
+	const TArray<int32>& GetIntegrated(const bool bSkipInterBoneDummies) const
+	{
+		return bSkipInterBoneDummies ? SimulatedWithoutInterBoneDummies : Simulated;
+	}
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	int32 BuiltNumBones = INDEX_NONE;
+	uint32 BuiltLayoutGeneration = 0;
+};
+
+/**
+ * 子ボーンの隣接リスト（CSR: ボーン毎のオフセット + 子 index の連結配列）。
+ * ボーン毎の TArray を持たないので init 時の小確保がボーン数に比例せず、子数の取得もオフセットの差で済む。
+ * ParentIndex から作るので、子の並びは index 昇順（= 構築時の追加順）。親を持たない bridge dummy は誰の子にもならない。
+ * Child adjacency in compressed sparse row form (per-bone offsets + one concatenated child-index list). No per-bone
+ * TArray, so init does not make one small allocation per bone and reading a child count needs no pointer chase.
+ * Built from ParentIndex, so children are in ascending index order (the order they were added); bridge dummies have no
+ * parent and are nobody's child.
+ */
+struct KAWAIIPHYSICS_API FKawaiiPhysicsBoneTopology
+{
+	/** ParentIndex から組み立てる / Build from each bone's ParentIndex */
+	void Build(const TArray<FKawaiiPhysicsModifyBone>& Bones);
+
+	void Reset();
+
+	/** 子 index（範囲外の index は空） / Child indices (empty for out-of-range indices) */
+	TConstArrayView<int32> GetChildren(const int32 BoneIndex) const
+	{
+		if (BoneIndex < 0 || BoneIndex + 1 >= ChildOffsets.Num())
+		{
+			return {};
+		}
+		return MakeArrayView(Children.GetData() + ChildOffsets[BoneIndex],
+		                     ChildOffsets[BoneIndex + 1] - ChildOffsets[BoneIndex]);
+	}
+
+	int32 NumChildren(const int32 BoneIndex) const { return GetChildren(BoneIndex).Num(); }
+
+	/** 構築時のボーン数 / Number of bones at build time */
+	int32 Num() const { return FMath::Max(ChildOffsets.Num() - 1, 0); }
+
+	SIZE_T GetAllocatedSize() const { return ChildOffsets.GetAllocatedSize() + Children.GetAllocatedSize(); }
+
+private:
+	// ボーン i の子は Children[ChildOffsets[i] .. ChildOffsets[i+1]) / Children of bone i
+	TArray<int32> ChildOffsets;
+	TArray<int32> Children;
+};
+
+/**
+ * 互いに影響しないボーン群（アイランド）1つ分の index リスト。分類ごとの並びは全体リストと同じ index 昇順。
+ * Index lists of one group of bones that do not affect any other group (an island). Each category keeps the ascending
+ * order of the node-wide lists.
+ */
+struct KAWAIIPHYSICS_API FKawaiiPhysicsBoneIsland
+{
+	// 全体の FKawaiiPhysicsBoneCategories をこのアイランドのボーンに絞ったもの
+	// The node-wide FKawaiiPhysicsBoneCategories restricted to this island's bones
+	FKawaiiPhysicsBoneCategories Categories;
+	// MergedBoneConstraints のうち両端がこのアイランドにあるもの / MergedBoneConstraints whose ends lie in this island
+	TArray<int32> Constraints;
+	int32 NumBones = 0;
+};
+
+/**
+ * 親子・inter-bone / bridge dummy の端点・BoneConstraint で連結したボーンをアイランドにまとめた表。
+ * 連結していない root チェーン同士（スカートのパネル、ツインテール等）は別アイランドになり、並列にソルブできる。
+ * MinBonesPerIsland 未満の小さいアイランドはタスクの固定費を払わないよう隣と1タスクにまとめ、
+ * 1タスクにしかならなければ空（= 逐次実行）になる。
+ * Bones joined by parent links, inter-bone / bridge dummy endpoints or BoneConstraints grouped into islands.
+ * Unconnected root chains (skirt panels, twin tails, ...) land in separate islands and can be solved in parallel.
+ * Islands smaller than MinBonesPerIsland are packed together with their neighbours so tiny chains do not pay the task
+ * overhead; when everything ends up in a single task the table stays empty (= solve sequentially).
+ */
+struct KAWAIIPHYSICS_API FKawaiiPhysicsBoneIslands
+{
+	/** 連結成分を求めてアイランドごとのリストを作る / Find the connected components and build per-island lists */
+	void Build(const TArray<FKawaiiPhysicsModifyBone>& Bones, const TArray<FModifyBoneConstraint>& Constraints,
+	           const FKawaiiPhysicsBoneCategories& Categories, int32 MinBonesPerIsland);
+
+	void Reset();
+
+	/** 同じボーン数・Constraint 数・最小ボーン数で構築済みか / Whether built for this layout and minimum island size */
+	bool IsBuiltFor(const int32 NumBones, const int32 NumConstraints, const int32 MinBonesPerIsland) const
+	{
+		return BuiltNumBones == NumBones && BuiltNumConstraints == NumConstraints &&
+			BuiltMinBonesPerIsland == MinBonesPerIsland;
+	}
+
+	/** 並列実行するアイランド数（0 なら逐次） / Number of islands to run in parallel (0 means sequential) */
+	int32 Num() const { return Islands.Num(); }
+
+	/** ボーンの属するアイランド（並列化しない場合は INDEX_NONE） / Island of a bone (INDEX_NONE when not split) */
+	int32 GetIsland(const int32 BoneIndex) const
+	{
+		return BoneIslands.IsValidIndex(BoneIndex) ? BoneIslands[BoneIndex] : INDEX_NONE;
+	}
+
+	SIZE_T GetAllocatedSize() const;
+
+	TArray<FKawaiiPhysicsBoneIsland> Islands;
+
+private:
+	TArray<int32> BoneIslands;
+	int32 BuiltNumBones = INDEX_NONE;
+	int32 BuiltNumConstraints = INDEX_NONE;
+	int32 BuiltMinBonesPerIsland = INDEX_NONE;
+};
+
+/**
+ * BoneConstraint のグラフ彩色（貪欲法）。同じ色の Constraint はボーンを共有しないので、色ごとに独立したバッチとして解ける。
+ * Constraint 配列自体は並べ替えず、色順（色の中は元の順）の index 列を持つ。色 c はその [GetColorBegin(c), GetColorEnd(c)) の区間。
+ * 逐次の Gauss-Seidel は元の並びのまま回るので、色ごとのバッチ解法とは解く順序が違い、結果はビット一致しない。
+ * Greedy graph colouring of the BoneConstraints. Constraints of one colour share no bone, so each colour can be solved
+ * as an independent batch. The constraint array itself is left in authoring order; the colouring keeps a permutation of
+ * constraint indices sorted by colour (original order inside a colour), and colour c is its slot range
+ * [GetColorBegin(c), GetColorEnd(c)). The sequential Gauss-Seidel still walks the authoring order, so it visits the
+ * constraints in a different order from the per-colour batch solve and the two are not bit-identical.
+ */
+struct KAWAIIPHYSICS_API FKawaiiPhysicsConstraintColors
+{
+	/**
+	 * 彩色して色順の index 列を作る（Constraints は変更しない）。Generation は Constraint 配列の世代
+	 * Colour the constraints and build the colour-ordered index permutation (Constraints is not modified). Generation is
+	 * the generation of the constraint array
+	 */
+	void Build(const TArray<FModifyBoneConstraint>& Constraints, int32 NumBones, uint32 Generation);
+
+	void Reset();
+
+	/** 世代 Generation の NumConstraints 本に対して構築済みか / Whether built for this generation of NumConstraints constraints */
+	bool IsBuiltFor(const uint32 Generation, const int32 NumConstraints) const
+	{
+		return bBuilt && BuiltGeneration == Generation && ColorOrder.Num() == NumConstraints;
+	}
+
+	/** 色数 / Number of colours */
+	int32 Num() const { return FMath::Max(ColorOffsets.Num() - 1, 0); }
+
+	int32 GetColorBegin(const int32 Color) const { return ColorOffsets[Color]; }
+	int32 GetColorEnd(const int32 Color) const { return ColorOffsets[Color + 1]; }
+
+	/** 色順の Slot 番目の Constraint index / Constraint index at colour-ordered slot Slot */
+	int32 GetConstraintIndex(const int32 Slot) const { return ColorOrder[Slot]; }
+
+	SIZE_T GetAllocatedSize() const { return ColorOffsets.GetAllocatedSize() + ColorOrder.GetAllocatedSize(); }
+
+private:
+	// 色ごとの先頭 slot（末尾に Constraint 数） / First slot of each colour (plus the constraint count at the end)
+	TArray<int32> ColorOffsets;
+
+	// 色順に並べた Constraint index / Constraint indices sorted by colour
+	TArray<int32> ColorOrder;
+
+	uint32 BuiltGeneration = 0;
+	bool bBuilt = false;
+};
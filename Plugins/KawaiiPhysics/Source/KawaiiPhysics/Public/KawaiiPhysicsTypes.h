@@ -17,6 +17,75 @@ enum class EKawaiiPhysicsSimulationSpace : uint8
 	BaseBoneSpace,
 };
 
+/**
+ * WorldCollision の判定方式。
+ * How the world collision is queried.
+ */
+UENUM(BlueprintType)
+enum class EKawaiiPhysicsWorldCollisionMode : uint8
+{
+	/** ボーン・サブステップ毎に同期スイープ（厳密。シネマティック向け） / Synchronous sweep per bone and substep (exact; for cinematics) */
+	Sweep,
+	/**
+	 * フレーム毎に1回まとめて非同期スイープし、返ってきたヒットを以降の評価で接触平面として適用（1～2フレーム遅れ）
+	 * One asynchronous batch of sweeps per frame; the returned hits are applied as contact planes in the following
+	 * evaluations (one or two frames late)
+	 */
+	AsyncSweep,
+	/**
+	 * フレーム毎に1回、チェーンのバウンディングボックスで重なり判定し、見つかった単純コリジョン形状をローカルで判定。
+	 * 対象はスフィア / カプセル / テーパードカプセル / ボックスのみで、凸包（Convex）の要素は無視する
+	 * One overlap query per frame over the chain's bounding box; the simple collision shapes found are then tested
+	 * locally like the collision limits. Only sphere, capsule, tapered capsule and box elements are used; convex
+	 * elements are skipped
+	 */
+	Broadphase,
+};
+
+/**
+ * フレーム予算（UKawaiiPhysicsDeveloperSettings::bUseSimulationBudget）によってノードに割り当てられた更新頻度。
+ * Update rate assigned to a node by the frame budget (UKawaiiPhysicsDeveloperSettings::bUseSimulationBudget).
+ */
+UENUM(BlueprintType)
+enum class EKawaiiPhysicsBudgetTier : uint8
+{
+	/** 毎フレームシミュレーションする / Simulate every frame */
+	Full,
+	/** ReducedUpdateInterval フレームに1回、経過時間をまとめてシミュレーションする / Simulate once every ReducedUpdateInterval frames over the accumulated time */
+	Reduced,
+	/** シミュレーションせず直前の結果を保持する / Do not simulate; hold the last result */
+	Frozen,
+};
+
+/**
+ * LOD 段階（FKawaiiPhysicsLODTier）を選ぶ指標。
+ * Metric used to pick a LOD tier (FKawaiiPhysicsLODTier).
+ */
+UENUM(BlueprintType)
+enum class EKawaiiPhysicsLODMetric : uint8
+{
+	/** ローカルプレイヤーのカメラから見た画面サイズ（0〜1）。Threshold 以下で段階を適用 / Screen size seen from the local players' cameras (0-1); tier applies at or below Threshold */
+	ScreenSize,
+	/** 最も近いローカルプレイヤーのカメラまでの距離。Threshold 以上で段階を適用 / Distance to the nearest local player camera; tier applies at or above Threshold */
+	Distance,
+	/** ゲームが設定する Significance（0〜1、負なら画面サイズ）。Threshold 以下で段階を適用 / Game-supplied Significance (0-1, screen size when negative); tier applies at or below Threshold */
+	Significance,
+};
+
+/**
+ * 固定サブステップの合間のフレームで出力する姿勢 / Pose output on frames between fixed substeps
+ */
+UENUM(BlueprintType)
+enum class EKawaiiPhysicsOutputInterpolation : uint8
+{
+	/** 最後のステップの結果をそのまま出力（従来挙動） / Output the last step's result as is (legacy behavior) */
+	None,
+	/** 直前2ステップの結果を補間する（最大1ステップ遅れる） / Interpolate the last two steps (lags by up to one step) */
+	Interpolate,
+	/** 直前2ステップの差分から先の姿勢を予測する（遅れは無いが行き過ぎることがある） / Extrapolate from the last two steps (no lag, may overshoot) */
+	Extrapolate,
+};
+
 /**
  * Enum representing the planar constraint axis in KawaiiPhysics.
  */
@@ -229,6 +298,74 @@ struct KAWAIIPHYSICS_API FKawaiiPhysicsSettings
 	float LimitAngle = 0.0f;
 };
 
+/**
+ * 遠景・小さく映るノード向けの LOD 段階。ノードの設定より軽くする項目だけを持ち、段階が無効な間はノードの設定そのままで動く。
+ * Threshold は粗い段階ほど「遠い / 小さい」側に並べる。
+ * A LOD tier for distant or small-on-screen nodes. It only holds what can be made cheaper than the node's settings; with no
+ * tier active the node runs on its own settings. List tiers from finest to coarsest.
+ */
+USTRUCT(BlueprintType)
+struct KAWAIIPHYSICS_API FKawaiiPhysicsLODTier
+{
+	GENERATED_BODY()
+
+	/**
+	* 段階を適用する閾値（LODTierMetric が Distance なら距離 cm 以上、それ以外は 0〜1 の画面サイズ / Significance 以下）
+	* Threshold that enables the tier (distance in cm and above for LODTierMetric Distance, otherwise the 0-1 screen size /
+	* Significance and below)
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD", meta = (ClampMin = "0"))
+	float Threshold = 0.0f;
+
+	/** 何フレームに1回シミュレーションするか（経過時間はまとめて進める） / Simulate once every N frames over the accumulated time */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD", meta = (ClampMin = "1"))
+	int32 UpdateInterval = 1;
+
+	/** 固定サブステップの上限（0 ならプロジェクト設定） / Cap on fixed substeps (0 uses the project setting) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD", meta = (ClampMin = "0"))
+	int32 MaxSubsteps = 0;
+
+	/**
+	* 固定サブステップのレート（0 ならノードの TargetFramerate）。OutputInterpolation と組み合わせると低レートでも滑らかに出力できる
+	* Fixed substep rate (0 uses the node's TargetFramerate). Combine with OutputInterpolation to keep a low rate smooth
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD", meta = (ClampMin = "0"))
+	int32 TargetFramerate = 0;
+
+	/** ノード / DataAsset のコリジョン / Collision limits of the node and its data assets */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD")
+	bool bEnableCollision = true;
+
+	/** 共有コリジョン / Shared collision from other nodes */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD")
+	bool bEnableSharedCollision = true;
+
+	/** ワールドコリジョン / World collision */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD")
+	bool bEnableWorldCollision = true;
+
+	/** Before Collision の BoneConstraint 反復回数（負ならノードの値） / BoneConstraint iterations before collision (node value when negative) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD")
+	int32 BoneConstraintIterationCountBeforeCollision = -1;
+
+	/** After Collision の BoneConstraint 反復回数（負ならノードの値） / BoneConstraint iterations after collision (node value when negative) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD")
+	int32 BoneConstraintIterationCountAfterCollision = -1;
+
+	/**
+	* inter-bone / bridge dummy をシミュレーションする。無効なら inter-bone dummy は実ボーン間に配置するだけになり、
+	* bridge dummy はコリジョンを判定しない
+	* Simulate inter-bone / bridge dummy bones. When off, inter-bone dummies are only placed between their real bones
+	* and bridge dummies skip collision
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD")
+	bool bSimulateDummyBones = true;
+
+	/** ExternalForces / CustomExternalForces を実行する（一時外力・突風は常に実行） / Run ExternalForces / CustomExternalForces (transient forces and gusts always run) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD")
+	bool bEnableExternalForces = true;
+};
+
 /**
  * Structure representing a bone that can be modified by the KawaiiPhysics system.
  */
@@ -249,10 +386,6 @@ struct KAWAIIPHYSICS_API FKawaiiPhysicsModifyBone
 	UPROPERTY(BlueprintReadOnly, Category = "Kawaii Physics|ModifyBone")
 	int32 ParentIndex = -1;
 
-	/** Indices of the child bones */
-	UPROPERTY(BlueprintReadOnly, Category = "Kawaii Physics|ModifyBone")
-	TArray<int32> ChildIndices;
-
 	/** Physics settings for the bone */
 	UPROPERTY(BlueprintReadOnly, Category = "Kawaii Physics|ModifyBone")
 	FKawaiiPhysicsSettings PhysicsSettings;
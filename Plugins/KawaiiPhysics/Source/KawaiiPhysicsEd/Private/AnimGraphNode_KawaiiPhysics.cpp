@@ -317,6 +317,7 @@ void UAnimGraphNode_KawaiiPhysics::PushProceduralWindEditToLiveInstance(
 	{
 		return;
 	}
+	RuntimeNode->JoinPipelinedSimulation();
 
 	const FName EditedPropertyName = PropertyChangedEvent.Property
 		                                 ? PropertyChangedEvent.Property->GetFName()
@@ -410,6 +411,8 @@ void UAnimGraphNode_KawaiiPhysics::ValidateAnimNodePostCompile(FCompilerResultsL
 void UAnimGraphNode_KawaiiPhysics::CopyNodeDataToPreviewNode(FAnimNode_Base* AnimNode)
 {
 	FAnimNode_KawaiiPhysics* KawaiiPhysics = static_cast<FAnimNode_KawaiiPhysics*>(AnimNode);
+	// 実行中のパイプライン実行タスクを合流させてから書き換える（最後に ModifyBones も空にするため）
+	KawaiiPhysics->JoinPipelinedSimulation();
 
 	// pushing properties to preview instance, for live editing
 	// Default
@@ -194,7 +194,7 @@ void FKawaiiPhysicsEditMode::RenderModifyBones(FPrimitiveDrawInterface* PDI) con
 				DrawWireSphere(PDI, BoneLocation, Color, Bone.PhysicsSettings.Radius, 16, SDPG_Foreground);
 			}
 
-			for (const int32 ChildIndex : Bone.ChildIndices)
+			for (const int32 ChildIndex : RuntimeNode->GetModifyBoneChildIndices(Bone.Index))
 			{
 				FVector ChildBoneLocation = RuntimeNode->ModifyBones[ChildIndex].Location;
 				if (RuntimeNode->SimulationSpace == EKawaiiPhysicsSimulationSpace::BaseBoneSpace)